@@ -74,6 +74,10 @@ OPTION(BUILD_WITH_PYTHON "Build with python support." ON)
 # Configure tetgen
 OPTION(WITH_TETGEN "Build Tetgen." OFF)
 
+###########################################
+# Configure HDF5, found on the system
+OPTION(HAVE_HDF5 "Build with HDF5 support." OFF)
+
 ###########################################
 # Configure data
 OPTION(BUILD_WITH_SCIRUN_DATA "Svn checkout data" OFF)
@@ -217,6 +221,7 @@ SET(SCIRUN_CACHE_ARGS
     "-DSCIRUN_TEST_RESOURCE_DIR:PATH=${SCIRUN_TEST_RESOURCE_DIR}"
     "-DBUILD_WITH_PYTHON:BOOL=${BUILD_WITH_PYTHON}"
     "-DWITH_TETGEN:BOOL=${WITH_TETGEN}"
+    "-DHAVE_HDF5:BOOL=${HAVE_HDF5}"
     "-DREGENERATE_MODULE_FACTORY_CODE:BOOL=${REGENERATE_MODULE_FACTORY_CODE}"
     "-DGENERATE_MODULE_FACTORY_CODE:BOOL=${GENERATE_MODULE_FACTORY_CODE}"
     "-DZlib_DIR:PATH=${Zlib_DIR}"
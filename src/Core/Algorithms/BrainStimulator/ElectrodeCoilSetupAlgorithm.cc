@@ -53,12 +53,17 @@
 #include <boost/algorithm/string/split.hpp>
 #include <boost/format.hpp>
 #include <Core/Math/MiscMath.h>
+#include <Core/Thread/Parallel.h>
+#include <map>
+#include <limits>
+#include <algorithm>
 
 using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Algorithms::BrainStimulator;
 using namespace SCIRun::Core::Algorithms::Fields;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Thread;
 using namespace SCIRun;
 
 ALGORITHM_PARAMETER_DEF(BrainStimulator, NumberOfPrototypes);
@@ -119,6 +124,142 @@ ElectrodeCoilSetupAlgorithm::ElectrodeCoilSetupAlgorithm()
 }
 
 
+namespace
+{
+  /// Closest scalp node of a candidate electrode/coil position and the scalp normal there.
+  struct ScalpProjection
+  {
+    VMesh::Node::index_type node;
+    Point point;
+    Vector normal;
+    double distance;
+  };
+
+  /// Balanced kd-tree over the scalp nodes, stored implicitly: the median of every range is its splitting node.
+  /// Unlike the mesh's node locate grid, whose shell search grows with the distance to the surface, a query
+  /// costs O(log n) wherever the candidate lies.
+  class ScalpNodeTree
+  {
+  public:
+    explicit ScalpNodeTree(VMesh* scalp_vmesh) : nodes_(scalp_vmesh->num_nodes()), points_(nodes_.size()), axes_(nodes_.size(), 0)
+    {
+      for (size_t j = 0; j < nodes_.size(); j++)
+      {
+        nodes_[j] = static_cast<VMesh::Node::index_type>(j);
+        scalp_vmesh->get_center(points_[j], nodes_[j]);
+      }
+      build(0, nodes_.size());
+    }
+
+    /// Closest node of p; ties go to the lowest node index.
+    VMesh::Node::index_type closest(const Point& p, double& distance2) const
+    {
+      VMesh::Node::index_type best = 0;
+      distance2 = std::numeric_limits<double>::max();
+      search(p, 0, nodes_.size(), best, distance2);
+      return best;
+    }
+
+  private:
+    void build(size_t begin, size_t end)
+    {
+      if (end - begin < 2)
+        return;
+      Point lo = points_[nodes_[begin]], hi = lo;
+      for (size_t j = begin + 1; j < end; j++)
+      {
+        lo = Min(lo, points_[nodes_[j]]);
+        hi = Max(hi, points_[nodes_[j]]);
+      }
+      const Vector extent = hi - lo;
+      const int axis = extent.x() >= extent.y() ? (extent.x() >= extent.z() ? 0 : 2) : (extent.y() >= extent.z() ? 1 : 2);
+      const size_t mid = begin + (end - begin) / 2;
+      std::nth_element(nodes_.begin() + begin, nodes_.begin() + mid, nodes_.begin() + end,
+        [&](VMesh::Node::index_type a, VMesh::Node::index_type b) { return points_[a][axis] < points_[b][axis]; });
+      axes_[mid] = axis;
+      build(begin, mid);
+      build(mid + 1, end);
+    }
+
+    void search(const Point& p, size_t begin, size_t end, VMesh::Node::index_type& best, double& best2) const
+    {
+      if (begin >= end)
+        return;
+      const size_t mid = begin + (end - begin) / 2;
+      const VMesh::Node::index_type node = nodes_[mid];
+      const double d2 = (p - points_[node]).length2();
+      if (d2 < best2 || (d2 == best2 && node < best))
+      {
+        best = node;
+        best2 = d2;
+      }
+      const double offset = p[axes_[mid]] - points_[node][axes_[mid]];
+      const bool below = offset < 0;
+      search(p, below ? begin : mid + 1, below ? mid : end, best, best2);
+      if (offset * offset <= best2)
+        search(p, below ? mid + 1 : begin, below ? end : mid, best, best2);
+    }
+
+    std::vector<VMesh::Node::index_type> nodes_;
+    std::vector<Point> points_;
+    std::vector<int> axes_;
+  };
+
+  /// Projects all candidates at once: the scalp kd-tree and normals are built a single time and the read-only
+  /// closest node searches are spread over the thread pool.
+  std::vector<ScalpProjection> project_onto_scalp(VMesh* scalp_vmesh, const std::vector<Point>& candidates)
+  {
+    std::vector<ScalpProjection> projections(candidates.size());
+    if (candidates.empty() || scalp_vmesh->num_nodes() == 0)
+      return projections;
+
+    const ScalpNodeTree tree(scalp_vmesh);
+    scalp_vmesh->synchronize(Mesh::NORMALS_E);
+    const int np = std::max(1, std::min(static_cast<int>(Parallel::NumCores()), static_cast<int>(candidates.size())));
+    Parallel::RunTasks([&](int proc)
+    {
+      const size_t begin = candidates.size() * proc / np;
+      const size_t end = candidates.size() * (proc + 1) / np;
+      for (size_t i = begin; i < end; i++)
+      {
+        ScalpProjection& projection = projections[i];
+        double distance2;
+        projection.node = tree.closest(candidates[i], distance2);
+        projection.distance = std::sqrt(distance2);
+        scalp_vmesh->get_center(projection.point, projection.node);
+        scalp_vmesh->get_normal(projection.normal, projection.node);
+      }
+    }, np);
+    return projections;
+  }
+
+  /// Prototype node positions relative to their mean, so that placing it is a rotation plus a translation.
+  std::vector<Vector> centered_nodes(VMesh* vmesh)
+  {
+    std::vector<Vector> offsets(vmesh->num_nodes());
+    Vector mean(0, 0, 0);
+    for (VMesh::Node::index_type j = 0; j < static_cast<VMesh::index_type>(offsets.size()); j++)
+    {
+      Point p;
+      vmesh->get_center(p, j);
+      offsets[j] = Vector(p);
+      mean += offsets[j];
+    }
+    if (!offsets.empty())
+      mean /= static_cast<double>(offsets.size());
+    for (auto& offset : offsets)
+      offset -= mean;
+    return offsets;
+  }
+
+  Vector rotate(const DenseMatrix& rotation, const Vector& v)
+  {
+    return Vector(rotation(0, 0) * v.x() + rotation(0, 1) * v.y() + rotation(0, 2) * v.z(),
+                  rotation(1, 0) * v.x() + rotation(1, 1) * v.y() + rotation(1, 2) * v.z(),
+                  rotation(2, 0) * v.x() + rotation(2, 1) * v.y() + rotation(2, 2) * v.z());
+  }
+}
+
 VariableHandle ElectrodeCoilSetupAlgorithm::fill_table(FieldHandle, DenseMatrixHandle locations, const std::vector<FieldHandle>&) const
 {
   Variable::List table;
@@ -292,12 +433,23 @@ FieldHandle ElectrodeCoilSetupAlgorithm::make_tms(FieldHandle scalp, const std::
   VMesh* tms_coils_vmesh = tms_coils_field->vmesh();
   VField* tms_coils_vfld = tms_coils_field->vfield();
   std::vector<Point> tms_coils_field_values;
+
+  bool OrientTMSCoilRadiallyToHead = get(Parameters::OrientTMSCoilRadialToScalpCheckBox).toBool();
+  std::vector<ScalpProjection> projections;
+  if (OrientTMSCoilRadiallyToHead)
+  {
+    std::vector<Point> coil_positions;
+    for (int i = 0; i < coil_prototyp_map.size() && i < coil_x.size() && i < coil_y.size() && i < coil_z.size(); i++)
+      coil_positions.push_back(Point(coil_x[i], coil_y[i], coil_z[i]));
+    projections = project_onto_scalp(scalp->vmesh(), coil_positions);
+  }
+  std::map<int, std::pair<DenseMatrixHandle, std::vector<Vector>>> prototypes; /// data and centered positions once per prototype
   
   for (int i = 0; i < coil_prototyp_map.size(); i++)
   {
     if (coil_prototyp_map[i] <= elc_coil_proto.size() && coil_prototyp_map[i] >= 0)
     {
-      if (!(coil_x.size() - 1 >= i && coil_y.size() - 1 >= i && coil_z.size() - 1 >= i))
+      if (!(i < coil_x.size() && i < coil_y.size() && i < coil_z.size()))
       {
         THROW_ALGORITHM_PROCESSING_ERROR("Internal error: definition of coil (x,y,z) seems to be empty.");
       }
@@ -312,48 +464,29 @@ FieldHandle ElectrodeCoilSetupAlgorithm::make_tms(FieldHandle scalp, const std::
       FieldInformation fi(coil_fld);
       if (fi.is_pointcloudmesh())
       {
-        GetFieldDataAlgo algo_getfielddata;
-        DenseMatrixHandle fielddata;
-        try
-        {
-          fielddata = algo_getfielddata.runMatrix(coil_fld);
-        }
-        catch (...)
+        const int prototype_index = static_cast<int>(coil_prototyp_map[i]) - 1;
+        auto cached = prototypes.find(prototype_index);
+        if (cached == prototypes.end())
         {
-        }
+          GetFieldDataAlgo algo_getfielddata;
+          DenseMatrixHandle fielddata;
+          try
+          {
+            fielddata = algo_getfielddata.runMatrix(coil_fld);
+          }
+          catch (...)
+          {
+          }
 
-        GetMeshNodesAlgo algo_getfieldnodes;
-        DenseMatrixHandle fieldnodes;
-        try
-        {
-          algo_getfieldnodes.run(coil_fld, fieldnodes);
-        }
-        catch (...)
-        {
-          THROW_ALGORITHM_PROCESSING_ERROR("Internal error: could not retrieve coil prototype positions ");
+          /// subtract the mean from the coil positions to move them accourding to GUI table entries
+          cached = prototypes.insert(std::make_pair(prototype_index, std::make_pair(fielddata, centered_nodes(coil_fld->vmesh())))).first;
         }
+        DenseMatrixHandle fielddata = cached->second.first;
+        const std::vector<Vector>& offsets = cached->second.second;
+        std::vector<Point> fieldnodes(offsets.size());
 
         auto magnetic_dipoles(boost::make_shared<DenseMatrix>(fielddata->nrows(), 3ul));
 
-        /// subtract the mean from the coil positions to move them accourding to GUI table entries
-        double mean_loc_x = 0, mean_loc_y = 0, mean_loc_z = 0;
-        for (int j = 0; j < fieldnodes->nrows(); j++)
-        {
-          mean_loc_x += (*fieldnodes)(j, 0);
-          mean_loc_y += (*fieldnodes)(j, 1);
-          mean_loc_z += (*fieldnodes)(j, 2);
-        }
-        mean_loc_x /= fieldnodes->nrows();
-        mean_loc_y /= fieldnodes->nrows();
-        mean_loc_z /= fieldnodes->nrows();
-
-        for (int j = 0; j < fieldnodes->nrows(); j++)
-        {
-          (*fieldnodes)(j, 0) -= mean_loc_x;
-          (*fieldnodes)(j, 1) -= mean_loc_y;
-          (*fieldnodes)(j, 2) -= mean_loc_z;
-        }
-
         /// 2) create normals and rotate if needed
         if (coil_nx.size() - 1 >= i && coil_ny.size() - 1 >= i && coil_nz.size() - 1 >= i && coil_angle_rotation.size() - 1 >= i)
         {
@@ -362,19 +495,14 @@ FieldHandle ElectrodeCoilSetupAlgorithm::make_tms(FieldHandle scalp, const std::
           // 2.1) create rotation matrices
           std::vector<double> coil_vector;
 
-          bool OrientTMSCoilRadiallyToHead = get(Parameters::OrientTMSCoilRadialToScalpCheckBox).toBool();
-
           Vector norm;
           if (OrientTMSCoilRadiallyToHead)
           {
-            VMesh* scalp_vmesh = scalp->vmesh();
-            VMesh::Node::index_type didx;
-            Point tms_coil(coil_x[i], coil_y[i], coil_z[i]), r;
-            scalp_vmesh->synchronize(Mesh::NODE_LOCATE_E);
-            double distance = 0;
-            scalp_vmesh->find_closest_node(distance, r, didx, tms_coil);
-            scalp_vmesh->synchronize(Mesh::NORMALS_E);
-            scalp_vmesh->get_normal(norm, didx);
+            if (i >= projections.size())
+            {
+              THROW_ALGORITHM_PROCESSING_ERROR("Internal error: definition of coil (x,y,z) seems to be empty.");
+            }
+            norm = projections[i].normal;
             if (norm.length())
             {
               coil_nx[i] = norm[0];
@@ -400,33 +528,14 @@ FieldHandle ElectrodeCoilSetupAlgorithm::make_tms(FieldHandle scalp, const std::
           }
 
           /// 2.2) apply rotation and move points
-          for (int j = 0; j < fieldnodes->nrows(); j++)
+          if (!(i < coil_x.size() && i < coil_y.size() && i < coil_z.size()))
           {
-            if (coil_x.size() - 1 >= i && coil_y.size() - 1 >= i && coil_z.size() - 1 >= i)
-            {
-              DenseMatrixHandle pos_vec(boost::make_shared<DenseMatrix>(3, 1));
-
-              (*pos_vec)(0, 0) = (*fieldnodes)(j, 0);
-              (*pos_vec)(1, 0) = (*fieldnodes)(j, 1);
-              (*pos_vec)(2, 0) = (*fieldnodes)(j, 2);
-
-              DenseMatrixHandle rotated_positions;
-
-              if (angle == 0)
-                rotated_positions = boost::make_shared<DenseMatrix>((*rotation_matrix1) * (*pos_vec));
-              else
-                rotated_positions = boost::make_shared<DenseMatrix>((*rotation_matrix) * (*pos_vec));
-
-              (*fieldnodes)(j, 0) = (*rotated_positions)(0, 0) + coil_x[i];
-              (*fieldnodes)(j, 1) = (*rotated_positions)(1, 0) + coil_y[i];
-              (*fieldnodes)(j, 2) = (*rotated_positions)(2, 0) + coil_z[i];
-
-            }
-            else
-            {
-              THROW_ALGORITHM_PROCESSING_ERROR("Internal error: definition of coil (x,y,z) seems to be empty.");
-            }
+            THROW_ALGORITHM_PROCESSING_ERROR("Internal error: definition of coil (x,y,z) seems to be empty.");
           }
+          const DenseMatrix& rotation = (angle == 0) ? *rotation_matrix1 : *rotation_matrix;
+          const Point coil(coil_x[i], coil_y[i], coil_z[i]);
+          for (size_t j = 0; j < offsets.size(); j++)
+            fieldnodes[j] = coil + rotate(rotation, offsets[j]);
 
           /// 2.3) use normal as magnetic dipole orientation if there are no normals defined at prototyp
           if (coil_nx.size() - 1 >= i && coil_ny.size() - 1 >= i && coil_nz.size() - 1 >= i)
@@ -443,24 +552,13 @@ FieldHandle ElectrodeCoilSetupAlgorithm::make_tms(FieldHandle scalp, const std::
             else
               if (fielddata->ncols() == 3) /// roatate magnetic dipoles
               {
+                const DenseMatrix& dipole_rotation = (angle == 0 || IsNan(angle)) ? *rotation_matrix1 : *rotation_matrix;
                 for (int j = 0; j < fielddata->nrows(); j++)
                 {
-                  auto pos_vec(boost::make_shared<DenseMatrix>(3, 1));
-                  (*pos_vec)(0, 0) = (*fielddata)(j, 0);
-                  (*pos_vec)(1, 0) = (*fielddata)(j, 1);
-                  (*pos_vec)(2, 0) = (*fielddata)(j, 2);
-
-                  DenseMatrixHandle rotated_positions;
-                  if (angle == 0 || IsNan(angle))
-                  {
-                    rotated_positions = boost::make_shared<DenseMatrix>((*rotation_matrix1) * (*pos_vec));
-                  }
-                  else
-                    rotated_positions = boost::make_shared<DenseMatrix>((*rotation_matrix) * (*pos_vec));
-
-                  (*magnetic_dipoles)(j, 0) = (*rotated_positions)(0, 0);
-                  (*magnetic_dipoles)(j, 1) = (*rotated_positions)(1, 0);
-                  (*magnetic_dipoles)(j, 2) = (*rotated_positions)(2, 0);
+                  Vector dipole = rotate(dipole_rotation, Vector((*fielddata)(j, 0), (*fielddata)(j, 1), (*fielddata)(j, 2)));
+                  (*magnetic_dipoles)(j, 0) = dipole.x();
+                  (*magnetic_dipoles)(j, 1) = dipole.y();
+                  (*magnetic_dipoles)(j, 2) = dipole.z();
                 }
               }
             if (fielddata->ncols() != 3)
@@ -477,10 +575,9 @@ FieldHandle ElectrodeCoilSetupAlgorithm::make_tms(FieldHandle scalp, const std::
         }
 
         /// 4) join coil to output coil Field 
-        for (VMesh::index_type j = 0; j < fieldnodes->nrows(); j++)
+        for (size_t j = 0; j < fieldnodes.size(); j++)
         {
-          Point p((*fieldnodes)(j, 0), (*fieldnodes)(j, 1), (*fieldnodes)(j, 2));
-          tms_coils_vmesh->add_point(p);
+          tms_coils_vmesh->add_point(fieldnodes[j]);
           Point vec((*magnetic_dipoles)(j, 0), (*magnetic_dipoles)(j, 1), (*magnetic_dipoles)(j, 2));
           tms_coils_field_values.push_back(vec);
         }
@@ -643,6 +740,14 @@ boost::tuple<DenseMatrixHandle, FieldHandle, FieldHandle, VariableHandle> Electr
     auto scalp_vmesh = scalp->vmesh();
     auto scalp_vfld = scalp->vfield();
     valid_electrode_definition.resize(elc_prototyp_map.size());
+
+    /// project all GUI (x,y,z) onto the scalp at once
+    std::vector<Point> elc_positions;
+    for (int i = 0; i < elc_prototyp_map.size(); i++)
+      elc_positions.push_back(Point(elc_x[i], elc_y[i], elc_z[i]));
+    auto projections = project_onto_scalp(scalp_vmesh, elc_positions);
+    std::map<int, std::pair<FieldHandle, std::vector<Vector>>> prototypes; /// converted and centered once per prototype
+
     for (int i = 0; i < elc_prototyp_map.size(); i++)
     {
       if (elc_thickness[i] <= 0 || IsNan(elc_thickness[i]))
@@ -653,17 +758,13 @@ boost::tuple<DenseMatrixHandle, FieldHandle, FieldHandle, VariableHandle> Electr
         continue;
       }
 
-      double distance = 0;
-      VMesh::Node::index_type didx;
-      Point elc(elc_x[i], elc_y[i], elc_z[i]), r;
-      scalp_vmesh->synchronize(Mesh::NODE_LOCATE_E);
-      scalp_vmesh->find_closest_node(distance, r, didx, elc);  /// project GUI (x,y,z) onto scalp and ...   
+      double distance = projections[i].distance;
+      VMesh::Node::index_type didx = projections[i].node;
+      Point elc(elc_x[i], elc_y[i], elc_z[i]), r = projections[i].point;  /// GUI (x,y,z) projected onto scalp and ...
       std::ostringstream ostr3;
       ostr3 << " Distance of electrode " << i + 1 << " to scalp surface is " << distance << " [distance units]." << std::endl;
       remark(ostr3.str());
-      Vector norm;
-      scalp_vmesh->synchronize(Mesh::NORMALS_E);
-      scalp_vmesh->get_normal(norm, didx); /// ... get its normal
+      Vector norm = projections[i].normal; /// ... its normal
       /// update GUI table normals
       double nx, ny, nz;
       Variable::List new_row;
@@ -694,70 +795,41 @@ boost::tuple<DenseMatrixHandle, FieldHandle, FieldHandle, VariableHandle> Electr
         rotation_matrix2 = make_rotation_matrix_around_axis(angle, axis);
         rotation_matrix = boost::make_shared<DenseMatrix>((*rotation_matrix2) * (*rotation_matrix1));
       }
-      FieldHandle prototype, prototype_mesh = elc_coil_proto[elc_prototyp_map[i] - 1];
-      FieldInformation fi(prototype_mesh);
+      const int prototype_index = static_cast<int>(elc_prototyp_map[i]) - 1;
+      auto cached = prototypes.find(prototype_index);
+      if (cached == prototypes.end())
+      {
+        FieldHandle prototype, prototype_mesh = elc_coil_proto[prototype_index];
+        FieldInformation fi(prototype_mesh);
 
-      if (fi.is_quadsurfmesh())
-        conv_algo.run(prototype_mesh, prototype);
-      else
-        prototype = prototype_mesh;
+        if (fi.is_quadsurfmesh())
+          conv_algo.run(prototype_mesh, prototype);
+        else
+          prototype = prototype_mesh;
+
+        std::vector<Vector> offsets;
+        if (FieldInformation(prototype).is_trisurfmesh())
+          offsets = centered_nodes(prototype->vmesh());
+        cached = prototypes.insert(std::make_pair(prototype_index, std::make_pair(prototype, offsets))).first;
+      }
+      FieldHandle prototype = cached->second.first;
+      const std::vector<Vector>& offsets = cached->second.second;
 
       FieldInformation fi_proto(prototype);
 
       if (fi_proto.is_trisurfmesh())
       {
-        GetMeshNodesAlgo algo_getfieldnodes;
-        DenseMatrixHandle fieldnodes;
-        try
-        {
-          algo_getfieldnodes.run(prototype, fieldnodes);
-        }
-        catch (...)
-        {
-          THROW_ALGORITHM_PROCESSING_ERROR("Internal error: could not retrieve positions from assigned prototype ");
-        }
-        if (fieldnodes->nrows() == 0) // put this to tms as well
+        if (offsets.empty()) // put this to tms as well
         {
           THROW_ALGORITHM_PROCESSING_ERROR("Internal error: could not retrieve positions from assigned prototype ");
         }
-        ///second, subtract the mean of the prototyp positions to center it in origin
-        double mean_loc_x = 0, mean_loc_y = 0, mean_loc_z = 0;
-        for (int j = 0; j < fieldnodes->nrows(); j++)
-        {
-          mean_loc_x += (*fieldnodes)(j, 0);
-          mean_loc_y += (*fieldnodes)(j, 1);
-          mean_loc_z += (*fieldnodes)(j, 2);
-        }
-        mean_loc_x /= fieldnodes->nrows();
-        mean_loc_y /= fieldnodes->nrows();
-        mean_loc_z /= fieldnodes->nrows();
-
-        for (int j = 0; j < fieldnodes->nrows(); j++)
-        {
-          (*fieldnodes)(j, 0) -= mean_loc_x;
-          (*fieldnodes)(j, 1) -= mean_loc_y;
-          (*fieldnodes)(j, 2) -= mean_loc_z;
-        }
 
-        DenseMatrixHandle rotated_positions;
+        ///second, rotate the prototype (centered in origin) and move it to the electrode location
+        const DenseMatrix& rotation = (angle == 0) ? *rotation_matrix1 : *rotation_matrix;
+        std::vector<Point> fieldnodes(offsets.size());
+        for (size_t j = 0; j < offsets.size(); j++)
+          fieldnodes[j] = elc + rotate(rotation, offsets[j]);
 
-        for (int j = 0; j < fieldnodes->nrows(); j++)
-        {
-          auto pos_vec(boost::make_shared<DenseMatrix>(3, 1));
-
-          (*pos_vec)(0, 0) = (*fieldnodes)(j, 0);
-          (*pos_vec)(1, 0) = (*fieldnodes)(j, 1);
-          (*pos_vec)(2, 0) = (*fieldnodes)(j, 2);
-
-          if (angle == 0)
-            rotated_positions = boost::make_shared<DenseMatrix>((*rotation_matrix1) * (*pos_vec));
-          else
-            rotated_positions = boost::make_shared<DenseMatrix>((*rotation_matrix) * (*pos_vec));
-
-          (*fieldnodes)(j, 0) = (*rotated_positions)(0, 0) + elc_x[i];
-          (*fieldnodes)(j, 1) = (*rotated_positions)(1, 0) + elc_y[i];
-          (*fieldnodes)(j, 2) = (*rotated_positions)(2, 0) + elc_z[i];
-        }
         VMesh* prototype_vmesh = prototype->vmesh();
 
         FieldInformation fieldinfo("TriSurfMesh", CONSTANTDATA_E, "double"); /// this is the final moved prototype for elc i
@@ -766,11 +838,10 @@ boost::tuple<DenseMatrixHandle, FieldHandle, FieldHandle, VariableHandle> Electr
         VField* tmp_tdcs_elc_vfld = tmp_tdcs_elc->vfield();
 
         Point p;
-        for (int l = 0; l < fieldnodes->nrows(); l++)
+        for (size_t l = 0; l < fieldnodes.size(); l++)
         {
-          Point p((*fieldnodes)(l, 0), (*fieldnodes)(l, 1), (*fieldnodes)(l, 2));
-          tdcs_vmesh->add_point(p);
-          tmp_tdcs_elc_vmesh->add_point(p);
+          tdcs_vmesh->add_point(fieldnodes[l]);
+          tmp_tdcs_elc_vmesh->add_point(fieldnodes[l]);
         }
 
         for (VMesh::Elem::index_type l = 0; l < prototype_vmesh->num_elems(); l++)
@@ -784,7 +855,7 @@ boost::tuple<DenseMatrixHandle, FieldHandle, FieldHandle, VariableHandle> Electr
           tdcs_vmesh->add_elem(onodes);
           field_values.push_back(i);
         }
-        nr_elc_sponge_triangles += fieldnodes->nrows();
+        nr_elc_sponge_triangles += fieldnodes.size();
         valid_electrode_definition[i] = 1;
         num_valid_electrode_definition++;
 
@@ -1726,6 +1797,95 @@ boost::tuple<VariableHandle, DenseMatrixHandle, FieldHandle, FieldHandle, FieldH
 }
 
 
+boost::tuple<DenseMatrixHandle, FieldHandle> ElectrodeCoilSetupAlgorithm::place_prototypes(const FieldHandle scalp_mesh, const FieldHandle prototype_mesh, const DenseMatrixHandle candidates) const
+{
+  if (!scalp_mesh || !prototype_mesh || !candidates)
+  {
+    THROW_ALGORITHM_INPUT_ERROR("Scalp, prototype and candidate locations are required.");
+  }
+
+  FieldInformation scalp_info(scalp_mesh), prototype_info(prototype_mesh);
+  if (!(scalp_info.is_trisurfmesh() || scalp_info.is_quadsurfmesh()))
+  {
+    THROW_ALGORITHM_INPUT_ERROR("Scalp needs to be a triangular (TRISURF) or rectangular (QUADSURF) mesh.");
+  }
+  if (!(prototype_info.is_trisurfmesh() || prototype_info.is_quadsurfmesh() || prototype_info.is_pointcloudmesh()))
+  {
+    THROW_ALGORITHM_INPUT_ERROR("Prototype needs to be a TRISURF, QUADSURF or point cloud mesh.");
+  }
+  if (candidates->ncols() != 3 && candidates->ncols() != 4)
+  {
+    THROW_ALGORITHM_INPUT_ERROR("Candidate locations need three (x, y, z) or four (x, y, z, angle) columns.");
+  }
+
+  ConvertMeshToTriSurfMeshAlgo conv_algo;
+  FieldHandle scalp = scalp_mesh, prototype = prototype_mesh;
+  if (scalp_info.is_quadsurfmesh())
+    conv_algo.run(scalp_mesh, scalp);
+  if (prototype_info.is_quadsurfmesh())
+    conv_algo.run(prototype_mesh, prototype);
+
+  const size_t num_candidates = candidates->nrows();
+  std::vector<Point> positions(num_candidates);
+  for (size_t i = 0; i < num_candidates; i++)
+    positions[i] = Point((*candidates)(i, 0), (*candidates)(i, 1), (*candidates)(i, 2));
+  auto projections = project_onto_scalp(scalp->vmesh(), positions);
+
+  auto locations(boost::make_shared<DenseMatrix>(num_candidates, 6ul));
+  for (size_t i = 0; i < num_candidates; i++)
+  {
+    (*locations)(i, 0) = projections[i].point.x();
+    (*locations)(i, 1) = projections[i].point.y();
+    (*locations)(i, 2) = projections[i].point.z();
+    (*locations)(i, 3) = projections[i].normal.x();
+    (*locations)(i, 4) = projections[i].normal.y();
+    (*locations)(i, 5) = projections[i].normal.z();
+  }
+
+  /// every candidate is a rotated and translated copy of the same centered prototype
+  VMesh* prototype_vmesh = prototype->vmesh();
+  const std::vector<Vector> offsets = centered_nodes(prototype_vmesh);
+  const size_t num_nodes = offsets.size();
+  const bool point_cloud = prototype_info.is_pointcloudmesh();
+  const size_t num_elems = point_cloud ? num_nodes : static_cast<size_t>(prototype_vmesh->num_elems());
+
+  FieldInformation fieldinfo(point_cloud ? "PointCloudMesh" : "TriSurfMesh", point_cloud ? LINEARDATA_E : CONSTANTDATA_E, "int");
+  FieldHandle placed = CreateField(fieldinfo);
+  VMesh* placed_vmesh = placed->vmesh();
+  placed_vmesh->resize_nodes(num_candidates * num_nodes);
+  if (!point_cloud)
+    placed_vmesh->resize_elems(num_candidates * num_elems);
+  Point* placed_points = placed_vmesh->get_points_pointer();
+
+  const int np = std::max(1, std::min(static_cast<int>(Parallel::NumCores()), static_cast<int>(num_candidates)));
+  Parallel::RunTasks([&](int proc)
+  {
+    const size_t begin = num_candidates * proc / np;
+    const size_t end = num_candidates * (proc + 1) / np;
+    for (size_t i = begin; i < end; i++)
+    {
+      double angle = candidates->ncols() == 4 ? (*candidates)(i, 3) : 0.0;
+      std::vector<double> axis{ projections[i].normal.x(), projections[i].normal.y(), projections[i].normal.z() };
+      DenseMatrixHandle rotation = make_rotation_matrix(angle, axis);
+      if (angle != 0)
+        rotation = boost::make_shared<DenseMatrix>((*make_rotation_matrix_around_axis(angle, axis)) * (*rotation));
+
+      for (size_t j = 0; j < num_nodes; j++)
+        placed_points[i * num_nodes + j] = projections[i].point + rotate(*rotation, offsets[j]);
+      if (!point_cloud)
+        placed_vmesh->copy_elems(prototype_vmesh, 0, i * num_elems, num_elems, i * num_nodes);
+    }
+  }, np);
+
+  std::vector<int> candidate_index(num_candidates * num_elems);
+  for (size_t i = 0; i < candidate_index.size(); i++)
+    candidate_index[i] = static_cast<int>(i / num_elems);
+  placed->vfield()->resize_values();
+  placed->vfield()->set_values(candidate_index);
+
+  return boost::make_tuple(locations, placed);
+}
+
 AlgorithmOutput ElectrodeCoilSetupAlgorithm::run(const AlgorithmInput& input) const
 {
   auto scalp = input.get<Field>(SCALP_SURF);
@@ -81,6 +81,10 @@ namespace BrainStimulator {
     static const AlgorithmOutputName COILS_FIELD;
       
     boost::tuple<VariableHandle, Datatypes::DenseMatrixHandle, FieldHandle, FieldHandle, FieldHandle> run(const FieldHandle scalp, const Datatypes::DenseMatrixHandle locations, const std::vector<FieldHandle>& elc_coil_proto) const;
+    /// Batched placement for montage searches: projects all candidates (rows x, y, z and optionally a rotation angle) onto the scalp
+    /// in parallel and moves the prototype to each projected location, oriented along the scalp normal. Returns one row x, y, z, nx, ny, nz
+    /// per candidate and a single field holding all placed prototypes, with the candidate index as element data.
+    boost::tuple<Datatypes::DenseMatrixHandle, FieldHandle> place_prototypes(const FieldHandle scalp, const FieldHandle prototype, const Datatypes::DenseMatrixHandle candidates) const;
     static const int number_of_columns = 10; /// number of GUI columns
     static const double direction_bound;
     static const AlgorithmParameterName columnNames[number_of_columns];
@@ -44,8 +44,12 @@ DEALINGS IN THE SOFTWARE.
 #include <boost/format.hpp>
 #include <boost/assign.hpp>
 #include <Core/Logging/Log.h>
+#include <Core/Thread/Parallel.h>
 #include <string> 
 #include <iostream>
+#include <map>
+#include <algorithm>
+#include <limits>
 
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Algorithms;
@@ -53,6 +57,7 @@ using namespace SCIRun::Core::Algorithms::BrainStimulator;
 using namespace SCIRun::Core::Geometry;
 using namespace SCIRun;
 using namespace SCIRun::Core::Logging;
+using namespace SCIRun::Core::Thread;
 using namespace boost::assign;
 
 const AlgorithmInputName GenerateROIStatisticsAlgorithm::MeshDataOnElements("MeshDataOnElements");
@@ -93,6 +98,101 @@ namespace
       return "NaN";
     return boost::str(boost::format("%d") % x);
   }
+
+  /// Running count, mean, sum of squared deviations, min and max of one ROI (Welford's update), so that the
+  /// variance needs no second pass and does not cancel catastrophically like sum(x^2) - n avr^2.
+  struct ROIAccumulator
+  {
+    ROIAccumulator() : count(0), mean(0), m2(0), min(std::numeric_limits<double>::max()), max(-std::numeric_limits<double>::max()) {}
+
+    void add(double value)
+    {
+      count++;
+      const double delta = value - mean;
+      mean += delta / count;
+      m2 += delta * (value - mean);
+      min = std::min(min, value);
+      max = std::max(max, value);
+    }
+
+    /// combines the partial results of two threads (Chan et al.)
+    void merge(const ROIAccumulator& other)
+    {
+      if (other.count == 0)
+        return;
+      const size_t total = count + other.count;
+      const double delta = other.mean - mean;
+      mean += delta * other.count / total;
+      m2 += other.m2 + delta * delta * (static_cast<double>(count) * other.count / total);
+      count = total;
+      min = std::min(min, other.min);
+      max = std::max(max, other.max);
+    }
+
+    size_t count;
+    double mean, m2, min, max;
+  };
+
+  /// keyed and sorted by atlas label
+  typedef std::map<int, ROIAccumulator> ROIAccumulators;
+
+  /// Single parallel pass over the elements: every thread fills its own accumulators for a contiguous range of
+  /// elements and those are merged afterwards. With all_materials every label found in the atlas gets an entry,
+  /// also if none of its elements is selected; otherwise only target_material does (0 meaning any material).
+  ROIAccumulators accumulate_roi_statistics(VField* data, VField* atlas, const std::vector<bool>& element_selection, bool all_materials, int target_material)
+  {
+    const VMesh::size_type num_elems = atlas->vmesh()->num_elems();
+    const int np = std::max(1, std::min(static_cast<int>(Parallel::NumCores()), static_cast<int>(num_elems / 10000)));
+    std::vector<ROIAccumulators> partial(np);
+
+    Parallel::RunTasks([&](int proc)
+    {
+      ROIAccumulators& local = partial[proc];
+      if (!all_materials)
+        local[target_material];
+      const VMesh::index_type begin = static_cast<VMesh::index_type>(static_cast<long long>(num_elems) * proc / np);
+      const VMesh::index_type end = static_cast<VMesh::index_type>(static_cast<long long>(num_elems) * (proc + 1) / np);
+
+      /// neighboring elements mostly share their label, so remember the last accumulator instead of a map lookup per element
+      int last_label = 0;
+      ROIAccumulator* last = nullptr;
+      for (VMesh::Elem::index_type i = begin; i < end; i++)
+      {
+        int label = 0;
+        atlas->get_value(label, i);
+        if (all_materials)
+        {
+          if (!last || label != last_label)
+          {
+            last = &local[label];
+            last_label = label;
+          }
+        }
+        else if (label == target_material || target_material == 0)
+        {
+          last = &local[target_material];
+        }
+        else
+        {
+          continue;
+        }
+
+        if (element_selection[i])
+        {
+          double value = 0;
+          data->get_value(value, i);
+          last->add(value);
+        }
+      }
+    }, np);
+
+    ROIAccumulators result;
+    result.swap(partial[0]);
+    for (int proc = 1; proc < np; proc++)
+      for (const auto& accumulator : partial[proc])
+        result[accumulator.first].merge(accumulator.second);
+    return result;
+  }
 }
 
 /// the run function can deal with multiple inputs and performs the analysis for all ROIs in the atlas mesh and for the user specified ROI
@@ -134,92 +234,31 @@ boost::tuple<DenseMatrixHandle, VariableHandle> GenerateROIStatisticsAlgorithm::
     THROW_ALGORITHM_INPUT_ERROR("Internal Error: Element selection vector does not match number of mesh elements "); 
   }
 
-  size_t number_of_atlas_materials;
+  /// one sweep over the elements finds the atlas labels and accumulates the statistics of every label at the same time
+  const bool all_materials = target_material == -1 || radius == 0;
+  const ROIAccumulators accumulators = accumulate_roi_statistics(vfield1, vfield2, element_selection, all_materials, static_cast<int>(target_material));
 
-  std::set<int> labelSet;
+  const size_t number_of_atlas_materials = accumulators.size();
 
-  if (target_material==-1 || radius==0) /// if default consider all materials
-  {
-    for (VMesh::Elem::index_type i=0; i < vfield2->vmesh()->num_elems(); i++) // loop over all tetrahedral elements (mesh)
-    {
-      int Label;
-      vfield2->get_value(Label, i);
-      labelSet.insert(Label);  
-    }
-  } else
-  {
-    labelSet.insert(static_cast<int>(target_material));
-  }
-
-  number_of_atlas_materials = labelSet.size();
-
-  std::vector<int> labelVector(labelSet.begin(), labelSet.end()); 
-
-  std::ostringstream ostr; /// sort element labels ascending 
-  std::copy(labelSet.begin(), labelSet.end(), std::ostream_iterator<int>(ostr, ", "));
+  std::ostringstream ostr; /// labels come out of the map sorted ascending
+  for (const auto& accumulator : accumulators)
+    ostr << accumulator.first << ", ";
   LOG_DEBUG("Sorted set of label numbers: " << ostr.str() << std::endl);
 
-  std::vector<double> value_avr(number_of_atlas_materials);
-  std::vector<int> value_count(number_of_atlas_materials);
-  std::vector<double> value_min(number_of_atlas_materials);
-  std::vector<double> value_max(number_of_atlas_materials);
-  std::vector<double> value_std(number_of_atlas_materials); 
-  std::vector<double> Sxsqr(number_of_atlas_materials);
-  std::vector<double> stddev(number_of_atlas_materials);
-  std::vector<double> var(number_of_atlas_materials);
-
-  /// to do the actual statistics we need to precompute parts of it to make it efficient (don't loop over elements twice)
-  for (VMesh::Elem::index_type i=0; i < vfield1->vmesh()->num_elems(); i++) /// loop over all tetrahedral elements (AtlasMesh)
-  {
-
-    if(element_selection[i]) ///is an particular element selected?
-    {
-      double value = 0;
-      vfield1->get_value(value, i); 
-
-      int Label = 0;
-      vfield2->get_value(Label, i);   
-
-      for (VMesh::Elem::index_type j=0; j < number_of_atlas_materials; j++) /// loop over determined materials
-      {
-        if (Label==labelVector[j] || (target_material==0 && number_of_atlas_materials==1) ) /// if label is known or if default situation precalculate sum, min, max, sum^2, number of selected elements
-        {
-          value_avr[j] += value; 
-          value_count[j]++;   
-          if (value>value_max[j]) value_max[j]=value;
-          if (value<value_min[j] || value_min[j]==0) value_min[j]=value;
-          Sxsqr[j]+=value*value;
-        }
-      }
-    }
-  }
-
   DenseMatrixHandle output(new DenseMatrix(number_of_atlas_materials, 5));
   const double invalidDouble = std::numeric_limits<double>::quiet_NaN();
 
-  /// efficient way to compute std dev. in just one loop over all mesh elements: sqrt ( 1/(n-1) (Sx^2 - avr Sx + n avr^2 )
-  for (VMesh::Elem::index_type j=0; j < number_of_atlas_materials; j++)
+  int j = 0;
+  for (const auto& accumulator : accumulators)
   {
-    double Sx=value_avr[j];
-
-    if (value_count[j]!=0)
+    const ROIAccumulator& roi = accumulator.second;
+    if (roi.count != 0)
     {
-      value_avr[j]/=value_count[j]; 
-      if (value_count[j]>1)
-      {
-        var[j]=static_cast<double>(1./(value_count[j]-1)*(Sxsqr[j]-2*value_avr[j]*Sx+value_count[j]*value_avr[j]*value_avr[j]));
-        stddev[j]=static_cast<double>(std::sqrt(var[j])); /// compute standard deviation, average, variance
-      } else
-      {
-        var[j]=invalidDouble;
-        stddev[j]=invalidDouble;
-      }
-
-      (*output)(j,0)=value_avr[j]; /// save statistical measures in output (DenseMatrix)
-      (*output)(j,1)=stddev[j];
-      (*output)(j,2)=value_min[j];
-      (*output)(j,3)=value_max[j];  
-      (*output)(j,4)=value_count[j];  
+      (*output)(j,0)=roi.mean; /// save statistical measures in output (DenseMatrix)
+      (*output)(j,1)=roi.count > 1 ? std::sqrt(roi.m2 / (roi.count - 1)) : invalidDouble; /// sample standard deviation, undefined for a single element
+      (*output)(j,2)=roi.min;
+      (*output)(j,3)=roi.max;
+      (*output)(j,4)=static_cast<double>(roi.count);
     } else
     {
       (*output)(j,0)=invalidDouble;  /// if the number of elements is 0, provide NaN as output
@@ -228,7 +267,8 @@ boost::tuple<DenseMatrixHandle, VariableHandle> GenerateROIStatisticsAlgorithm::
       (*output)(j,3)=invalidDouble;
       (*output)(j,4)=invalidDouble;
     }
-  }  
+    j++;
+  }
 
   std::vector<std::string> AtlasMeshLabels_vector;
   if (!AtlasMeshLabels.empty())
@@ -35,6 +35,7 @@ DEALINGS IN THE SOFTWARE.
 #include <Core/Datatypes/Legacy/Field/VField.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 #include <Core/GeometryPrimitives/Point.h>
+#include <Core/GeometryPrimitives/PointVectorOperators.h>
 #include <Core/GeometryPrimitives/Tensor.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
@@ -53,6 +54,8 @@ using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Algorithms::BrainStimulator;
 using namespace SCIRun::Core::Logging;
 
+ALGORITHM_PARAMETER_DEF(BrainStimulator, TreecodeOpeningAngle);
+
 AlgorithmInputName SimulateForwardMagneticFieldAlgo::ElectricField("ElectricField");
 AlgorithmInputName SimulateForwardMagneticFieldAlgo::ConductivityTensor("ConductivityTensor");
 AlgorithmInputName SimulateForwardMagneticFieldAlgo::DipoleSources("DipoleSources");
@@ -60,11 +63,184 @@ AlgorithmInputName SimulateForwardMagneticFieldAlgo::DetectorLocations("Detector
 AlgorithmOutputName SimulateForwardMagneticFieldAlgo::MagneticField("MagneticField");
 AlgorithmOutputName SimulateForwardMagneticFieldAlgo::MagneticFieldMagnitudes("MagneticFieldMagnitudes");
 
+SimulateForwardMagneticFieldAlgo::SimulateForwardMagneticFieldAlgo()
+{
+  using namespace Parameters;
+  addParameter(TreecodeOpeningAngle, 0.1);
+}
+
+namespace
+{
+  /// Octree over current dipoles (current density times volume of every element, and every dipole source) for a
+  /// Barnes-Hut evaluation of the Biot-Savart sum. Each cluster stores its total moment and its first moment about
+  /// the cluster center, so a cluster seen under less than the opening angle contributes through a dipole-corrected
+  /// expansion whose error falls with the square of that angle. Clusters that are too close are opened down to
+  /// leaves, which are summed directly.
+  class SourceTree
+  {
+    public:
+      SourceTree(const std::vector<Point>& positions, const std::vector<Vector>& moments);
+
+      /// Sum of m x (p - r) / |p - r|^3 over all sources but 'excluded' (-1 keeps all of them).
+      Vector field(const Point& p, double opening_angle, VMesh::index_type excluded) const;
+
+    private:
+      static const size_t leaf_size_ = 16;
+      static const int max_depth_ = 32;
+
+      struct node
+      {
+        Point  center_;
+        double radius2_;
+        Vector moment_;
+        Vector curl_;       // sum of m x s, with s the source position relative to center_
+        double first_[9];   // sum of m s^T
+        size_t begin_, end_;
+        int    children_[8];
+        int    num_children_;
+      };
+
+      int build(size_t begin, size_t end, int depth);
+
+      std::vector<Point>  positions_;
+      std::vector<Vector> moments_;
+      std::vector<size_t> order_;
+      std::vector<size_t> rank_;
+      std::vector<node>   nodes_;
+  };
+
+  SourceTree::SourceTree(const std::vector<Point>& positions, const std::vector<Vector>& moments) :
+    positions_(positions), moments_(moments), order_(positions.size()), rank_(positions.size())
+  {
+    for (size_t k = 0; k < order_.size(); k++) order_[k] = k;
+    if (!order_.empty()) build(0, order_.size(), 0);
+
+    // store the sources in tree order so leaves are contiguous
+    for (size_t k = 0; k < order_.size(); k++)
+    {
+      positions_[k] = positions[order_[k]];
+      moments_[k] = moments[order_[k]];
+      rank_[order_[k]] = k;
+    }
+  }
+
+  int SourceTree::build(size_t begin, size_t end, int depth)
+  {
+    Point lo = positions_[order_[begin]];
+    Point hi = lo;
+    for (size_t k = begin + 1; k < end; k++)
+    {
+      const Point& p = positions_[order_[k]];
+      lo = Min(lo, p);
+      hi = Max(hi, p);
+    }
+
+    node n;
+    n.center_ = Interpolate(lo, hi, 0.5);
+    n.radius2_ = 0.0;
+    n.moment_ = Vector(0.0, 0.0, 0.0);
+    std::fill(n.first_, n.first_ + 9, 0.0);
+    n.begin_ = begin;
+    n.end_ = end;
+    n.num_children_ = 0;
+
+    for (size_t k = begin; k < end; k++)
+    {
+      const Vector s = positions_[order_[k]] - n.center_;
+      const Vector& m = moments_[order_[k]];
+      n.moment_ += m;
+      n.radius2_ = std::max(n.radius2_, s.length2());
+      for (int a = 0; a < 3; a++)
+        for (int b = 0; b < 3; b++)
+          n.first_[3 * a + b] += m[a] * s[b];
+    }
+    n.curl_ = Vector(n.first_[5] - n.first_[7], n.first_[6] - n.first_[2], n.first_[1] - n.first_[3]);
+
+    const int id = static_cast<int>(nodes_.size());
+    nodes_.push_back(n);
+
+    if (end - begin <= leaf_size_ || depth >= max_depth_ || lo == hi)
+      return id;
+
+    // split into octants around the box center
+    auto first = order_.begin();
+    size_t bounds[9];
+    bounds[0] = begin;
+    bounds[8] = end;
+    const Point c = n.center_;
+    auto side = [this, &c](int axis) { return [this, &c, axis](size_t i) { return positions_[i][axis] < c[axis]; }; };
+    bounds[4] = std::partition(first + begin, first + end, side(0)) - first;
+    for (int h = 0; h < 8; h += 4)
+    {
+      bounds[h + 2] = std::partition(first + bounds[h], first + bounds[h + 4], side(1)) - first;
+      for (int q = h; q < h + 4; q += 2)
+        bounds[q + 1] = std::partition(first + bounds[q], first + bounds[q + 2], side(2)) - first;
+    }
+
+    int children[8];
+    int num_children = 0;
+    for (int o = 0; o < 8; o++)
+    {
+      if (bounds[o] < bounds[o + 1])
+        children[num_children++] = build(bounds[o], bounds[o + 1], depth + 1);
+    }
+    std::copy(children, children + num_children, nodes_[id].children_);
+    nodes_[id].num_children_ = num_children;
+    return id;
+  }
+
+  Vector SourceTree::field(const Point& p, double opening_angle, VMesh::index_type excluded) const
+  {
+    Vector result(0.0, 0.0, 0.0);
+    if (nodes_.empty()) return result;
+
+    const double theta2 = opening_angle * opening_angle;
+    const size_t skip = excluded >= 0 ? rank_[excluded] : positions_.size();
+
+    int stack[7 * max_depth_ + 8];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+      const node& n = nodes_[stack[--top]];
+      const Vector r = p - n.center_;
+      const double r2 = r.length2();
+      const bool holds_skip = skip >= n.begin_ && skip < n.end_;
+
+      if (!holds_skip && n.radius2_ < theta2 * r2)
+      {
+        // terms of m x f(r - s), f(r) = r / |r|^3, expanded to first order in s
+        const double inv_r3 = 1.0 / (r2 * std::sqrt(r2));
+        const Vector fr(n.first_[0] * r[0] + n.first_[1] * r[1] + n.first_[2] * r[2],
+                        n.first_[3] * r[0] + n.first_[4] * r[1] + n.first_[5] * r[2],
+                        n.first_[6] * r[0] + n.first_[7] * r[1] + n.first_[8] * r[2]);
+        result += (Cross(n.moment_, r) - n.curl_ + Cross(fr, r) * (3.0 / r2)) * inv_r3;
+      }
+      else if (n.num_children_ == 0)
+      {
+        for (size_t k = n.begin_; k < n.end_; k++)
+        {
+          if (k == skip) continue;
+          const Vector radius = p - positions_[k];
+          const double length = radius.length();
+          result += Cross(moments_[k], radius) / (length * length * length);
+        }
+      }
+      else
+      {
+        for (int c = 0; c < n.num_children_; c++)
+          stack[top++] = n.children_[c];
+      }
+    }
+    return result;
+  }
+}
+
 class CalcFMField
 {
   public:
 
-    CalcFMField(const AlgorithmBase* algo) : algo_(algo),
+    CalcFMField(const AlgorithmBase* algo, double opening_angle) : algo_(algo), opening_angle_(opening_angle),
       np_(-1),efld_(0),ctfld_(0),dipfld_(0),detfld_(0),emsh_(0),ctmsh_(0),dipmsh_(0),detmsh_(0),magfld_(0),magmagfld_(0)
     {
     }
@@ -77,9 +253,11 @@ class CalcFMField
   private:
     void interpolate(int proc, Point p);
     void set_up_cell_cache();
+    void set_up_source_tree();
     void calc_parallel(int proc);
 
     const AlgorithmBase* algo_;
+    double opening_angle_;
     int np_;
     std::vector<Vector> interp_value_;
     std::vector<std::pair<std::string, Tensor> > tens_;
@@ -92,6 +270,7 @@ class CalcFMField
     };
 
     std::vector<per_cell_cache>  cell_cache_;
+    boost::shared_ptr<SourceTree> tree_;
 
     VField* efld_; // Electric Field
     VField* ctfld_; // Conductivity Field
@@ -109,14 +288,12 @@ class CalcFMField
 
 void CalcFMField::interpolate(int proc, Point p)  
 {
-  emsh_->synchronize(Mesh::ELEM_LOCATE_E);
-
   VMesh::Elem::index_type inside_cell = 0;
   bool outside = !(emsh_->locate(inside_cell, p));
 
   VMesh::size_type num_elems = emsh_->num_elems();
 
-  for (VMesh::Elem::index_type idx; idx<num_elems; idx++)
+  for (VMesh::Elem::index_type idx=0; idx<num_elems; idx++)
   {    
     if (outside || idx != inside_cell) 
     {
@@ -186,6 +363,28 @@ void CalcFMField::set_up_cell_cache()
   }
 }
 
+void CalcFMField::set_up_source_tree()
+{
+  // volume currents come first so that element indices address their sources
+  VMesh::size_type num_elems = emsh_->num_elems();
+  VMesh::size_type num_dipoles = dipmsh_->num_nodes();
+  std::vector<Point> positions(num_elems + num_dipoles);
+  std::vector<Vector> moments(num_elems + num_dipoles);
+
+  for (VMesh::Elem::index_type idx=0; idx<num_elems; idx++)
+  {
+    positions[idx] = cell_cache_[idx].center_;
+    moments[idx] = cell_cache_[idx].cur_density_ * cell_cache_[idx].volume_;
+  }
+  for (VMesh::Node::index_type idx=0; idx<num_dipoles; idx++)
+  {
+    dipmsh_->get_center(positions[num_elems + idx], idx);
+    dipfld_->value(moments[num_elems + idx], idx);
+  }
+
+  tree_.reset(new SourceTree(positions, moments));
+}
+
 void CalcFMField::calc_parallel(int proc)
 {
 
@@ -211,26 +410,36 @@ void CalcFMField::calc_parallel(int proc)
     
     detmsh_->get_center(pt, idx);
 
-    // init the interp val to 0 
-    interp_value_[proc] = Vector(0,0,0);
-    interpolate(proc, pt);
-
-    mag_field = interp_value_[proc];
-
     Vector normal;
     detfld_->get_value(normal,idx); 
 
-    // iterate over the dipoles.
-    for (VMesh::Node::index_type dip_idx = 0; dip_idx < num_dipoles; dip_idx++)
+    if (tree_)
     {
-      dipmsh_->get_center(pt2, dip_idx);
-      dipfld_->value(P,dip_idx);
-      
-      Vector radius = pt - pt2; // detector - source
-      Vector valuePXR = Cross(P, radius);
-      double length = radius.length();
- 
-      mag_field += valuePXR / (length * length * length);
+      // the element holding the detector is left out, as in the direct sum
+      VMesh::Elem::index_type inside_cell = 0;
+      bool inside = emsh_->locate(inside_cell, pt);
+      mag_field = tree_->field(pt, opening_angle_, inside ? VMesh::index_type(inside_cell) : -1);
+    }
+    else
+    {
+      // init the interp val to 0 
+      interp_value_[proc] = Vector(0,0,0);
+      interpolate(proc, pt);
+
+      mag_field = interp_value_[proc];
+
+      // iterate over the dipoles.
+      for (VMesh::Node::index_type dip_idx = 0; dip_idx < num_dipoles; dip_idx++)
+      {
+        dipmsh_->get_center(pt2, dip_idx);
+        dipfld_->value(P,dip_idx);
+        
+        Vector radius = pt - pt2; // detector - source
+        Vector valuePXR = Cross(P, radius);
+        double length = radius.length();
+   
+        mag_field += valuePXR / (length * length * length);
+      }
     }
     
     mag_field *= one_over_4_pi;
@@ -303,6 +512,12 @@ boost::tuple<FieldHandle,FieldHandle> CalcFMField::calc_forward_magnetic_field(F
   // cache per cell calculations that are used over and over again.
   set_up_cell_cache();
 
+  // an opening angle of zero keeps the exact direct sum
+  if (opening_angle_ > 0.0)
+    set_up_source_tree();
+
+  emsh_->synchronize(Mesh::ELEM_LOCATE_E);
+
 #ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER  
   // do the parallel work.
   Thread::parallel(this, &CalcFMField::calc_parallel, np_, mod);
@@ -335,8 +550,14 @@ boost::tuple<FieldHandle, FieldHandle> SimulateForwardMagneticFieldAlgo::run(Fie
   {
     THROW_ALGORITHM_INPUT_ERROR("Must have Vector field as Detector Locations input");
   }
+
+  const double opening_angle = get(Parameters::TreecodeOpeningAngle).toDouble();
+  if (opening_angle < 0.0 || opening_angle >= 1.0)
+  {
+    THROW_ALGORITHM_INPUT_ERROR("Treecode opening angle must be at least 0 and less than 1");
+  }
   
-  CalcFMField algo(this);
+  CalcFMField algo(this, opening_angle);
   FieldHandle MField, MFieldMagnitudes;
   
   boost::tie(MField,MFieldMagnitudes) = algo.calc_forward_magnetic_field(ElectricField, ConductivityTensors, DipoleSources, DetectorLocations); 
@@ -36,6 +36,9 @@
 ///  The modules has four inputs: an electric field distribution (first) for mesh elements with defnied conductivity tensors (second), dipole sources (third)
 ///  within that mesh and detector locations (fourth) to compute the magnetic field at. All inputs are of Field datatype. The algorithm/module is multi-threaded and
 ///  outputs the magnetic vector potential and its magnitudes as first and second output.
+///  Sources are summed with a Barnes-Hut treecode: clusters of current elements and dipoles that appear smaller than
+///  TreecodeOpeningAngle from a detector are evaluated through their dipole-corrected cluster moment. An opening angle of
+///  zero evaluates the exact direct sum.
 
 #ifndef CORE_ALGORITHMS_BRAINSTIMULATOR_SIMULATEFORWARDMAGNETICFIELD_H
 #define CORE_ALGORITHMS_BRAINSTIMULATOR_SIMULATEFORWARDMAGNETICFIELD_H 1
@@ -50,10 +53,13 @@ namespace SCIRun {
 		namespace Algorithms {
 			namespace BrainStimulator {
 
+  ALGORITHM_PARAMETER_DECL(TreecodeOpeningAngle);
+
 class SCISHARE SimulateForwardMagneticFieldAlgo : public AlgorithmBase
 {
   public:
-    
+    SimulateForwardMagneticFieldAlgo();
+
     static AlgorithmInputName ElectricField;
     static AlgorithmInputName ConductivityTensor;
     static AlgorithmInputName DipoleSources;
@@ -44,6 +44,10 @@
 #include <vector>
 #include <iostream>
 #include <Core/Math/MiscMath.h>
+#include <Core/Thread/Parallel.h>
+#include <Core/GeometryPrimitives/PointVectorOperators.h>
+#include <chrono>
+#include <limits>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Geometry;
@@ -72,6 +76,82 @@ namespace
 
    return m;
   }
+
+  /// latitude/longitude sphere around the origin with outward facing triangles
+  FieldHandle SphereScalp(double radius, int rings, int segments)
+  {
+    FieldInformation fi("TriSurfMesh", LINEARDATA_E, "double");
+    FieldHandle scalp = CreateField(fi);
+    VMesh* vmesh = scalp->vmesh();
+    vmesh->add_point(Point(0, 0, radius));
+    for (int r = 1; r < rings; r++)
+    {
+      double theta = M_PI * r / rings;
+      for (int k = 0; k < segments; k++)
+      {
+        double phi = 2 * M_PI * k / segments;
+        vmesh->add_point(Point(radius * sin(theta) * cos(phi), radius * sin(theta) * sin(phi), radius * cos(theta)));
+      }
+    }
+    const VMesh::index_type south = vmesh->num_nodes();
+    vmesh->add_point(Point(0, 0, -radius));
+
+    auto ring_node = [segments](int r, int k) { return static_cast<VMesh::index_type>(1 + (r - 1) * segments + (k % segments)); };
+    VMesh::Node::array_type tri(3);
+    for (int k = 0; k < segments; k++)
+    {
+      tri[0] = 0; tri[1] = ring_node(1, k); tri[2] = ring_node(1, k + 1);
+      vmesh->add_elem(tri);
+      for (int r = 1; r < rings - 1; r++)
+      {
+        tri[0] = ring_node(r, k); tri[1] = ring_node(r + 1, k); tri[2] = ring_node(r + 1, k + 1);
+        vmesh->add_elem(tri);
+        tri[0] = ring_node(r, k); tri[1] = ring_node(r + 1, k + 1); tri[2] = ring_node(r, k + 1);
+        vmesh->add_elem(tri);
+      }
+      tri[0] = ring_node(rings - 1, k); tri[1] = south; tri[2] = ring_node(rings - 1, k + 1);
+      vmesh->add_elem(tri);
+    }
+    scalp->vfield()->resize_values();
+    return scalp;
+  }
+
+  /// flat square electrode away from the origin, two triangles
+  FieldHandle SquareElectrode(double side)
+  {
+    FieldInformation fi("TriSurfMesh", CONSTANTDATA_E, "double");
+    FieldHandle electrode = CreateField(fi);
+    VMesh* vmesh = electrode->vmesh();
+    const double h = side / 2;
+    vmesh->add_point(Point(100 - h, 50 - h, 3));
+    vmesh->add_point(Point(100 + h, 50 - h, 3));
+    vmesh->add_point(Point(100 + h, 50 + h, 3));
+    vmesh->add_point(Point(100 - h, 50 + h, 3));
+    VMesh::Node::array_type tri(3);
+    tri[0] = 0; tri[1] = 1; tri[2] = 2;
+    vmesh->add_elem(tri);
+    tri[0] = 0; tri[1] = 2; tri[2] = 3;
+    vmesh->add_elem(tri);
+    electrode->vfield()->resize_values();
+    return electrode;
+  }
+
+  /// candidates spread over a sphere of the given radius, with a rotation angle per candidate
+  DenseMatrixHandle CandidateLocations(int count, double radius)
+  {
+    DenseMatrixHandle m(boost::make_shared<DenseMatrix>(count, 4));
+    for (int i = 0; i < count; i++)
+    {
+      double z = 1.0 - (2.0 * i + 1.0) / count;
+      double rho = sqrt(1.0 - z * z);
+      double phi = 2.399963 * i;
+      (*m)(i, 0) = radius * rho * cos(phi);
+      (*m)(i, 1) = radius * rho * sin(phi);
+      (*m)(i, 2) = radius * z;
+      (*m)(i, 3) = 15.0 * (i % 7);
+    }
+    return m;
+  }
 }
 
 
@@ -109,3 +189,88 @@ TEST(ElectrodeCoilSetupAlgorithmTests, AlgoCorrect)
   */
 }
 
+TEST(ElectrodeCoilSetupAlgorithmTests, PlacesPrototypesOnProjectedScalpLocations)
+{
+  ElectrodeCoilSetupAlgorithm algo;
+  const int count = 50;
+  FieldHandle scalp = SphereScalp(80, 60, 120);
+  DenseMatrixHandle candidates = CandidateLocations(count, 100);
+
+  DenseMatrixHandle locations;
+  FieldHandle placed;
+  boost::tie(locations, placed) = algo.place_prototypes(scalp, SquareElectrode(10), candidates);
+
+  ASSERT_EQ(count, locations->nrows());
+  ASSERT_EQ(6, locations->ncols());
+  ASSERT_EQ(4 * count, placed->vmesh()->num_nodes());
+  ASSERT_EQ(2 * count, placed->vmesh()->num_elems());
+
+  for (int i = 0; i < count; i++)
+  {
+    Vector direction = Vector((*candidates)(i, 0), (*candidates)(i, 1), (*candidates)(i, 2)).normal();
+    Point location((*locations)(i, 0), (*locations)(i, 1), (*locations)(i, 2));
+    Vector normal((*locations)(i, 3), (*locations)(i, 4), (*locations)(i, 5));
+    EXPECT_NEAR(80.0, Vector(location).length(), 1e-9);
+    EXPECT_GT(Dot(Vector(location).normal(), direction), 0.995);
+    EXPECT_GT(Dot(normal, direction), 0.99);
+
+    /// the projection is the closest scalp node, not just a nearby one
+    Point query((*candidates)(i, 0), (*candidates)(i, 1), (*candidates)(i, 2));
+    double closest = std::numeric_limits<double>::max();
+    for (VMesh::Node::index_type j = 0; j < scalp->vmesh()->num_nodes(); j++)
+    {
+      Point p;
+      scalp->vmesh()->get_center(p, j);
+      closest = std::min(closest, (p - query).length());
+    }
+    EXPECT_DOUBLE_EQ(closest, (location - query).length());
+
+    /// the square is centered on the projected location and lies in the tangent plane
+    Vector center(0, 0, 0);
+    for (int j = 0; j < 4; j++)
+    {
+      Point p;
+      placed->vmesh()->get_center(p, VMesh::Node::index_type(4 * i + j));
+      center += Vector(p);
+      EXPECT_NEAR(0.0, Dot(p - location, normal.normal()), 1e-9);
+      EXPECT_NEAR(5 * sqrt(2.0), (p - location).length(), 1e-9);
+    }
+    EXPECT_NEAR(0.0, (center / 4.0 - Vector(location)).length(), 1e-9);
+
+    for (int j = 0; j < 2; j++)
+    {
+      int value;
+      placed->vfield()->get_value(value, VMesh::Elem::index_type(2 * i + j));
+      EXPECT_EQ(i, value);
+    }
+  }
+}
+
+TEST(ElectrodeCoilSetupAlgorithmTests, PlacementRejectsCandidatesWithoutPositions)
+{
+  ElectrodeCoilSetupAlgorithm algo;
+  DenseMatrixHandle candidates(boost::make_shared<DenseMatrix>(5, 2));
+  EXPECT_THROW(algo.place_prototypes(SphereScalp(80, 10, 20), SquareElectrode(10), candidates), AlgorithmInputException);
+}
+
+TEST(ElectrodeCoilSetupAlgorithmTests, DISABLED_BatchedPlacementTiming)
+{
+  ElectrodeCoilSetupAlgorithm algo;
+  FieldHandle scalp = SphereScalp(80, 300, 600);
+  FieldHandle electrode = SquareElectrode(10);
+
+  for (unsigned int cores : { 1u, 1000u })
+  {
+    SCIRun::Core::Thread::Parallel::SetMaximumCores(cores);
+    for (int count : { 100, 1000, 10000, 100000 })
+    {
+      DenseMatrixHandle candidates = CandidateLocations(count, 100), locations;
+      FieldHandle placed;
+      auto start = std::chrono::steady_clock::now();
+      boost::tie(locations, placed) = algo.place_prototypes(scalp, electrode, candidates);
+      auto end = std::chrono::steady_clock::now();
+      std::cout << count << " candidates on " << SCIRun::Core::Thread::Parallel::NumCores() << " cores: "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms" << std::endl;
+    }
+  }
+}
@@ -35,6 +35,9 @@
 #include <Testing/Utils/SCIRunUnitTests.h>
 #include <Testing/Utils/MatrixTestUtilities.h>
 #include <Core/Datatypes/String.h>
+#include <map>
+#include <algorithm>
+#include <chrono>
 //////////////////////////////////////////////////////////////////////////
 /// @todo MORITZ
 //////////////////////////////////////////////////////////////////////////
@@ -172,3 +175,100 @@ TEST(GenerateROIStatisticsAlgorithm, ValidInput_TestCoordinateSpace)
           EXPECT_NEAR((*outputMatrix)(i, j), (*expected_result)(i,j), 1e-10);
 
 }
+
+namespace
+{
+  struct LabeledSolution
+  {
+    FieldHandle solution, atlas;
+  };
+
+  // n^3 lattice with labels in slabs along x, sprinkled with single elements of other labels, and data that is
+  // partly negative and sits on a large offset inside a few labels.
+  LabeledSolution makeLabeledSolution(int n, int num_labels)
+  {
+    LabeledSolution problem;
+    FieldInformation sfi(LATVOLMESH_E, CONSTANTDATA_E, DOUBLE_E);
+    MeshHandle mesh = CreateMesh(sfi, n + 1, n + 1, n + 1, Point(0, 0, 0), Point(1, 1, 1));
+    problem.solution = CreateField(sfi, mesh);
+    FieldInformation afi(LATVOLMESH_E, CONSTANTDATA_E, INT_E);
+    problem.atlas = CreateField(afi, mesh);
+
+    VMesh* vmesh = problem.solution->vmesh();
+    VField* sfld = problem.solution->vfield();
+    VField* afld = problem.atlas->vfield();
+    sfld->resize_values();
+    afld->resize_values();
+    for (VMesh::Elem::index_type idx = 0; idx < vmesh->num_elems(); idx++)
+    {
+      Point c;
+      vmesh->get_center(c, idx);
+      int label = 1 + static_cast<int>(c.x() * num_labels);
+      if (idx % 97 == 0)
+        label = 1 + (idx / 97) % num_labels;
+      double value = std::sin(7 * c.y()) - c.z() * c.x();
+      if (label % 5 == 0)
+        value += 1e6;
+      afld->set_value(label, idx);
+      sfld->set_value(value, idx);
+    }
+    return problem;
+  }
+}
+
+TEST(GenerateROIStatisticsAlgorithm, SingleSweepMatchesStatisticsPerLabel)
+{
+  GenerateROIStatisticsAlgorithm algo;
+  const int num_labels = 12;
+  LabeledSolution problem = makeLabeledSolution(40, num_labels);
+  // label 13 only occurs once, so its standard deviation is undefined
+  problem.atlas->vfield()->set_value(num_labels + 1, VMesh::Elem::index_type(5));
+
+  DenseMatrixHandle outputMatrix = algo.run(problem.solution, problem.atlas).get<0>();
+
+  std::map<int, std::vector<double>> values;
+  for (VMesh::Elem::index_type idx = 0; idx < problem.atlas->vmesh()->num_elems(); idx++)
+  {
+    int label;
+    double value;
+    problem.atlas->vfield()->get_value(label, idx);
+    problem.solution->vfield()->get_value(value, idx);
+    values[label].push_back(value);
+  }
+
+  ASSERT_EQ(num_labels + 1, outputMatrix->rows());
+  ASSERT_EQ(5, outputMatrix->cols());
+  int row = 0;
+  for (const auto& label : values)
+  {
+    const std::vector<double>& v = label.second;
+    double mean = 0;
+    for (double x : v)
+      mean += x;
+    mean /= v.size();
+    double ss = 0;
+    for (double x : v)
+      ss += (x - mean) * (x - mean);
+
+    EXPECT_NEAR(mean, (*outputMatrix)(row, 0), 1e-9 * std::max(1.0, std::abs(mean)));
+    if (v.size() > 1)
+      EXPECT_NEAR(std::sqrt(ss / (v.size() - 1)), (*outputMatrix)(row, 1), 1e-9);
+    else
+      EXPECT_TRUE(IsNan((*outputMatrix)(row, 1)));
+    EXPECT_EQ(*std::min_element(v.begin(), v.end()), (*outputMatrix)(row, 2));
+    EXPECT_EQ(*std::max_element(v.begin(), v.end()), (*outputMatrix)(row, 3));
+    EXPECT_EQ(static_cast<double>(v.size()), (*outputMatrix)(row, 4));
+    row++;
+  }
+}
+
+TEST(GenerateROIStatisticsAlgorithm, DISABLED_SingleSweepTiming)
+{
+  LabeledSolution problem = makeLabeledSolution(215, 200);
+  GenerateROIStatisticsAlgorithm algo;
+  auto start = std::chrono::steady_clock::now();
+  DenseMatrixHandle outputMatrix = algo.run(problem.solution, problem.atlas).get<0>();
+  auto end = std::chrono::steady_clock::now();
+  std::cout << outputMatrix->rows() << " labels on " << problem.atlas->vmesh()->num_elems() << " elements: "
+    << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms" << std::endl;
+}
@@ -45,10 +45,13 @@ last change: 09/17/2014
 #include <Core/Datatypes/Matrix.h>
 #include <Core/Datatypes/DenseMatrix.h>
 #include <Testing/Utils/MatrixTestUtilities.h>
+#include <Core/GeometryPrimitives/PointVectorOperators.h>
+#include <chrono>
 
 using namespace SCIRun;
 using namespace SCIRun::Core;
 using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Geometry;
 using namespace SCIRun::TestUtils;
 using namespace SCIRun::Core::Algorithms::DataIO;
 using namespace SCIRun::Core::Algorithms::Fields;
@@ -110,6 +113,7 @@ TEST(SimulateForwardMagneticFieldAlgoTest, TestOnLatVol)
   FieldHandle second_with_tensor = algo.runImpl(second, tensor_matrix);
 
   SimulateForwardMagneticFieldAlgo algo2;
+  algo2.set(Algorithms::BrainStimulator::Parameters::TreecodeOpeningAngle, 0.0);
 
   FieldHandle MField, MFieldMagnitudes;
   boost::tie(MField,MFieldMagnitudes) = algo2.run(first,second_with_tensor,third,fourth);
@@ -128,3 +132,142 @@ TEST(SimulateForwardMagneticFieldAlgoTest, TestOnLatVol)
   EXPECT_MATRIX_EQ_TOLERANCE(*MField_matrix, *MField_expected_matrix, 1e-16);
   EXPECT_MATRIX_EQ_TOLERANCE(*MFieldMagnitudes_matrix, *MFieldMagnitudes_expected_matrix, 1e-16);
 }
+
+namespace
+{
+  struct MagneticFieldProblem
+  {
+    FieldHandle efield, conductivity, dipoles, detectors;
+  };
+
+  // Smoothly varying currents on an n^3 lattice, a few dipoles and detectors both outside and inside the volume.
+  MagneticFieldProblem makeProblem(int n, int num_detectors)
+  {
+    MagneticFieldProblem problem;
+    FieldInformation efi(LATVOLMESH_E, CONSTANTDATA_E, VECTOR_E);
+    MeshHandle mesh = CreateMesh(efi, n + 1, n + 1, n + 1, Point(-1, -1, -1), Point(1, 1, 1));
+    problem.efield = CreateField(efi, mesh);
+    FieldInformation cfi(LATVOLMESH_E, CONSTANTDATA_E, DOUBLE_E);
+    problem.conductivity = CreateField(cfi, mesh);
+
+    VMesh* vmesh = problem.efield->vmesh();
+    VField* efld = problem.efield->vfield();
+    VField* cfld = problem.conductivity->vfield();
+    efld->resize_values();
+    cfld->resize_values();
+    for (VMesh::Elem::index_type idx = 0; idx < vmesh->num_elems(); idx++)
+    {
+      Point c;
+      vmesh->get_center(c, idx);
+      efld->set_value(Vector(std::sin(3 * c.y()), std::cos(2 * c.z()) + c.x(), c.x() * c.y() - 0.5), idx);
+      cfld->set_value(c.z() > 0 ? 0.33 : 0.142, idx);
+    }
+
+    FieldInformation pfi(POINTCLOUDMESH_E, LINEARDATA_E, VECTOR_E);
+    problem.dipoles = CreateField(pfi);
+    problem.dipoles->vmesh()->add_point(Point(0.1, 0.2, -0.3));
+    problem.dipoles->vmesh()->add_point(Point(-0.4, 0.05, 0.5));
+    problem.dipoles->vfield()->resize_values();
+    problem.dipoles->vfield()->set_value(Vector(0, 0, 1), VMesh::index_type(0));
+    problem.dipoles->vfield()->set_value(Vector(1, -1, 0), VMesh::index_type(1));
+
+    problem.detectors = CreateField(pfi);
+    for (int k = 0; k < num_detectors; k++)
+    {
+      // spiral over a sphere of radius 2, every tenth detector inside the volume
+      double z = 1.0 - (2.0 * k + 1.0) / num_detectors;
+      double rho = std::sqrt(1.0 - z * z);
+      double phi = 2.399963 * k;
+      double radius = (k % 10 == 0) ? 0.77 : 2.0;
+      problem.detectors->vmesh()->add_point(Point(radius * rho * std::cos(phi), radius * rho * std::sin(phi), radius * z));
+    }
+    VField* dfld = problem.detectors->vfield();
+    dfld->resize_values();
+    for (VMesh::Node::index_type idx = 0; idx < problem.detectors->vmesh()->num_nodes(); idx++)
+    {
+      Point p;
+      problem.detectors->vmesh()->get_center(p, idx);
+      dfld->set_value(Vector(p).safe_normal(), idx);
+    }
+    return problem;
+  }
+
+  double maxDifference(FieldHandle a, FieldHandle b, double& largest)
+  {
+    double difference = 0;
+    largest = 0;
+    for (VMesh::Node::index_type idx = 0; idx < a->vmesh()->num_nodes(); idx++)
+    {
+      Vector va, vb;
+      a->vfield()->get_value(va, idx);
+      b->vfield()->get_value(vb, idx);
+      difference = std::max(difference, (va - vb).length());
+      largest = std::max(largest, vb.length());
+    }
+    return difference;
+  }
+}
+
+TEST(SimulateForwardMagneticFieldAlgoTest, TreecodeMatchesDirectSum)
+{
+  MagneticFieldProblem problem = makeProblem(16, 200);
+
+  SimulateForwardMagneticFieldAlgo direct;
+  direct.set(Algorithms::BrainStimulator::Parameters::TreecodeOpeningAngle, 0.0);
+  FieldHandle directField, directMagnitudes;
+  boost::tie(directField, directMagnitudes) = direct.run(problem.efield, problem.conductivity, problem.dipoles, problem.detectors);
+
+  // the expansion error falls with the square of the opening angle; a tiny angle opens every cluster
+  double previous = std::numeric_limits<double>::max();
+  double largest = 0;
+  for (double angle : { 0.4, 0.2, 0.1, 1e-6 })
+  {
+    SimulateForwardMagneticFieldAlgo tree;
+    tree.set(Algorithms::BrainStimulator::Parameters::TreecodeOpeningAngle, angle);
+    FieldHandle treeField, treeMagnitudes;
+    boost::tie(treeField, treeMagnitudes) = tree.run(problem.efield, problem.conductivity, problem.dipoles, problem.detectors);
+
+    double difference = maxDifference(treeField, directField, largest);
+    EXPECT_LT(difference, previous) << angle;
+    previous = difference;
+
+    for (VMesh::Node::index_type idx = 0; idx < problem.detectors->vmesh()->num_nodes(); idx++)
+    {
+      Vector b, normal;
+      double magnitude;
+      treeField->vfield()->get_value(b, idx);
+      treeMagnitudes->vfield()->get_value(magnitude, idx);
+      problem.detectors->vfield()->get_value(normal, idx);
+      EXPECT_DOUBLE_EQ(Dot(b, normal), magnitude);
+    }
+
+    if (angle == 0.1)
+      EXPECT_LT(difference, 5e-3 * largest);
+  }
+  EXPECT_LT(previous, 1e-12 * largest);
+}
+
+TEST(SimulateForwardMagneticFieldAlgoTest, RejectsOpeningAngleOfOneOrMore)
+{
+  MagneticFieldProblem problem = makeProblem(2, 4);
+  SimulateForwardMagneticFieldAlgo algo;
+  algo.set(Algorithms::BrainStimulator::Parameters::TreecodeOpeningAngle, 1.0);
+  EXPECT_THROW(algo.run(problem.efield, problem.conductivity, problem.dipoles, problem.detectors), Core::Algorithms::AlgorithmInputException);
+}
+
+TEST(SimulateForwardMagneticFieldAlgoTest, DISABLED_TreecodeTiming)
+{
+  MagneticFieldProblem problem = makeProblem(64, 2000);
+
+  for (double angle : { 0.0, 0.1, 0.2 })
+  {
+    SimulateForwardMagneticFieldAlgo algo;
+    algo.set(Algorithms::BrainStimulator::Parameters::TreecodeOpeningAngle, angle);
+    FieldHandle field, magnitudes;
+    auto start = std::chrono::steady_clock::now();
+    boost::tie(field, magnitudes) = algo.run(problem.efield, problem.conductivity, problem.dipoles, problem.detectors);
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "opening angle " << angle << ": "
+      << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms" << std::endl;
+  }
+}
@@ -33,11 +33,15 @@
 #include <boost/tokenizer.hpp>
 #include <boost/make_shared.hpp>
 
+#include <algorithm>
+#include <cctype>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 #include <streambuf>
 
 #include <Core/Algorithms/DataIO/EigenMatrixFromScirunAsciiFormatConverter.h>
+#include <Core/Algorithms/DataIO/TextNumberParser.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Datatypes/DenseMatrix.h>
 #include <Core/Datatypes/DenseColumnMatrix.h>
@@ -47,24 +51,100 @@
 #include <Core/Utils/StringUtil.h>
 
 
+using namespace SCIRun::Core;
 using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Utility;
+using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Algorithms::DataIO::internal;
 
 EigenMatrixFromScirunAsciiFormatConverter::EigenMatrixFromScirunAsciiFormatConverter(const ProgressReporter* reporter) : reporter_(reporter)
 {
 }
 
+namespace
+{
+  const char* findString(const char* begin, const char* end, const char* str)
+  {
+    const char* found = std::search(begin, end, str, str + strlen(str));
+    return found == end ? 0 : found;
+  }
+
+  /// The matrix contents are on the first line that starts with a digit and
+  /// is longer than two characters, everything before is the Pio header.
+  const char* findMatrixContents(const char* begin, const char* end)
+  {
+    const char* line = begin;
+    while (line != end)
+    {
+      const char* lineEnd = static_cast<const char*>(memchr(line, '\n', end - line));
+      if (!lineEnd)
+        lineEnd = end;
+      if (lineEnd - line > 2 && isdigit(*line))
+        return line;
+      line = lineEnd == end ? end : lineEnd + 1;
+    }
+    return 0;
+  }
+
+  void throwFormatError()
+  {
+    BOOST_THROW_EXCEPTION(AlgorithmInputException() << ErrorMessage("Improper format of SCIRun ASCII matrix file"));
+  }
+
+  void expect(const char*& p, const char* end, char c)
+  {
+    while (p != end && isspace(*p))
+      ++p;
+    if (p == end || *p != c)
+      throwFormatError();
+    ++p;
+  }
+
+  template <class T>
+  T readHeaderNumber(const char*& p, const char* end)
+  {
+    T value;
+    if (!parseNumber(p, end, value))
+      throwFormatError();
+    return value;
+  }
+
+  /// Parse the numbers up to the closing brace of a section.
+  template <class T>
+  void readSection(const char*& p, const char* end, std::vector<T>& values, size_t expected)
+  {
+    const char* close = static_cast<const char*>(memchr(p, '}', end - p));
+    if (!close)
+      throwFormatError();
+    values.reserve(expected);
+    if (!parseNumbersInParallel(p, close, values) || values.size() != expected)
+      throwFormatError();
+    p = close + 1;
+  }
+}
+
 MatrixHandle EigenMatrixFromScirunAsciiFormatConverter::make(const std::string& matFile)
 {
   if (reporter_)
     reporter_->update_progress(0.01);
-  if (fileContainsString(matFile, "DenseMatrix"))
-    return makeDense(matFile);
-  if (fileContainsString(matFile, "SparseRowMatrix"))
-    return makeSparse(matFile);
-  if (fileContainsString(matFile, "ColumnMatrix"))
-    return makeColumn(matFile);
+
+  std::vector<char> buffer;
+  if (!readTextFile(matFile, buffer))
+    BOOST_THROW_EXCEPTION(AlgorithmInputException() << ErrorMessage("Could not read file " + matFile));
+  if (reporter_)
+    reporter_->update_progress(0.1);
+
+  const char* begin = &buffer[0];
+  const char* end = begin + buffer.size() - 1;
+  const char* contents = findMatrixContents(begin, end);
+  const char* header = contents ? contents : end;
+
+  if (findString(begin, header, "DenseMatrix"))
+    return makeDense(contents, end);
+  if (findString(begin, header, "SparseRowMatrix"))
+    return makeSparse(contents, end);
+  if (findString(begin, header, "ColumnMatrix"))
+    return makeColumn(contents, end);
 
   /// @todo: no access to error(), need alternative for logging this exception
   BOOST_THROW_EXCEPTION(AlgorithmInputException() << ErrorMessage("Unknown SCIRun matrix format"));
@@ -72,35 +152,70 @@ MatrixHandle EigenMatrixFromScirunAsciiFormatConverter::make(const std::string&
 
 SparseRowMatrixHandle EigenMatrixFromScirunAsciiFormatConverter::makeSparse(const std::string& matFile)
 {
-  SparseData data = convertRaw(parseSparseMatrixString(getMatrixContentsLine(readFile(matFile)).get()).get());
+  std::vector<char> buffer;
+  if (!readTextFile(matFile, buffer))
+    BOOST_THROW_EXCEPTION(AlgorithmInputException() << ErrorMessage("Could not read file " + matFile));
+  const char* end = &buffer[0] + buffer.size() - 1;
+  return makeSparse(findMatrixContents(&buffer[0], end), end);
+}
+
+SparseRowMatrixHandle EigenMatrixFromScirunAsciiFormatConverter::makeSparse(const char* contents, const char* end)
+{
+  if (!contents)
+    throwFormatError();
+
+  // rows cols nnz {8 row accumulators}{8 column indices}{values}}
+  const char* p = contents;
+  const int rows = readHeaderNumber<int>(p, end);
+  const int cols = readHeaderNumber<int>(p, end);
+  const int nnz = readHeaderNumber<int>(p, end);
+  if (rows < 0 || cols < 0 || nnz < 0)
+    throwFormatError();
+
+  Indices rowAcc, columns;
+  Data values;
+  expect(p, end, '{');
+  readHeaderNumber<int>(p, end);
+  readSection(p, end, rowAcc, rows + 1);
+  expect(p, end, '{');
+  readHeaderNumber<int>(p, end);
+  readSection(p, end, columns, nnz);
+  if (reporter_)
+    reporter_->update_progress(0.4);
+  expect(p, end, '{');
+  readSection(p, end, values, nnz);
   if (reporter_)
     reporter_->update_progress(0.7);
-  SparseRowMatrixHandle mat(boost::make_shared<SparseRowMatrix>(data.get<0>(), data.get<1>()));
 
-  typedef Eigen::Triplet<double> T;
-  std::vector<T> tripletList;
+  // The arrays already are in compressed row format, they can be copied as
+  // is if the column indices are sorted within each row.
+  bool sorted = rowAcc[0] == 0 && rowAcc[rows] == nnz;
+  for (int r = 0; sorted && r < rows; ++r)
   {
-    const Indices& rowAcc = data.get<3>();
-    const Indices& cols = data.get<4>();
-    const Data& values = data.get<5>();
-    size_t estimation_of_entries = values.size();
-    tripletList.reserve(estimation_of_entries);
-
-    int count = 0;
-    int nextRow;
-    for (int r = 0; r < mat->rows(); ++r)
-    {
-      nextRow = rowAcc[r+1];
-      while (count < nextRow)
-      {
-        tripletList.push_back(T(r, cols[count], values[count]));
-        count++;
-      }
-    }
+    if (rowAcc[r + 1] < rowAcc[r])
+      sorted = false;
+    for (int k = rowAcc[r]; sorted && k < rowAcc[r + 1]; ++k)
+      sorted = columns[k] >= 0 && columns[k] < cols && (k == rowAcc[r] || columns[k - 1] < columns[k]);
+  }
+
+  SparseRowMatrixHandle mat;
+  if (sorted)
+  {
+    mat = boost::make_shared<SparseRowMatrix>(rows, cols);
+    mat->resizeNonZeros(nnz);
+    std::copy(rowAcc.begin(), rowAcc.end(), mat->outerIndexPtr());
+    std::copy(columns.begin(), columns.end(), mat->innerIndexPtr());
+    std::copy(values.begin(), values.end(), mat->valuePtr());
+  }
+  else
+  {
+    if (rowAcc[rows] != nnz)
+      throwFormatError();
+    std::vector<index_type> rowCounter(rowAcc.begin(), rowAcc.end());
+    std::vector<index_type> columnCounter(columns.begin(), columns.end());
+    mat = boost::make_shared<SparseRowMatrix>(rows, cols, rowCounter.data(), columnCounter.data(), values.data(), static_cast<size_t>(nnz));
   }
 
-  mat->setFromTriplets(tripletList.begin(), tripletList.end());
-  mat->makeCompressed();
   if (reporter_)
     reporter_->update_progress(1);
   return mat;
@@ -133,26 +248,60 @@ std::string EigenMatrixFromScirunAsciiFormatConverter::readFile(const std::strin
 
 DenseMatrixHandle EigenMatrixFromScirunAsciiFormatConverter::makeDense(const std::string& matFile)
 {
-  DenseData data = convertRaw(parseDenseMatrixString(getMatrixContentsLine(readFile(matFile)).get()).get());
-  DenseMatrixHandle mat(boost::make_shared<DenseMatrix>(data.get<0>(), data.get<1>()));
+  std::vector<char> buffer;
+  if (!readTextFile(matFile, buffer))
+    BOOST_THROW_EXCEPTION(AlgorithmInputException() << ErrorMessage("Could not read file " + matFile));
+  const char* end = &buffer[0] + buffer.size() - 1;
+  return makeDense(findMatrixContents(&buffer[0], end), end);
+}
+
+DenseMatrixHandle EigenMatrixFromScirunAsciiFormatConverter::makeDense(const char* contents, const char* end)
+{
+  if (!contents)
+    throwFormatError();
+
+  // rows cols {0 values}}
+  const char* p = contents;
+  const int rows = readHeaderNumber<int>(p, end);
+  const int cols = readHeaderNumber<int>(p, end);
+  if (rows < 0 || cols < 0)
+    throwFormatError();
+  expect(p, end, '{');
+  readHeaderNumber<int>(p, end);
 
-  auto values = data.get<2>().begin();
-  for (int i = 0; i < mat->rows(); ++i)
-    for (int j = 0; j < mat->cols(); ++j)
-      (*mat)(i,j) = *values++;
+  Data values;
+  readSection(p, end, values, static_cast<size_t>(rows) * cols);
 
+  DenseMatrixHandle mat(boost::make_shared<DenseMatrix>(rows, cols));
+  std::copy(values.begin(), values.end(), mat->data());
   return mat;
 }
 
 DenseColumnMatrixHandle EigenMatrixFromScirunAsciiFormatConverter::makeColumn(const std::string& matFile)
 {
-  DenseData data = convertRaw(parseColumnMatrixString(getMatrixContentsLine(readFile(matFile)).get()).get());
-  DenseColumnMatrixHandle mat(boost::make_shared<DenseColumnMatrix>(data.get<0>()));
+  std::vector<char> buffer;
+  if (!readTextFile(matFile, buffer))
+    BOOST_THROW_EXCEPTION(AlgorithmInputException() << ErrorMessage("Could not read file " + matFile));
+  const char* end = &buffer[0] + buffer.size() - 1;
+  return makeColumn(findMatrixContents(&buffer[0], end), end);
+}
+
+DenseColumnMatrixHandle EigenMatrixFromScirunAsciiFormatConverter::makeColumn(const char* contents, const char* end)
+{
+  if (!contents)
+    throwFormatError();
+
+  // rows values}
+  const char* p = contents;
+  const int rows = readHeaderNumber<int>(p, end);
+  if (rows < 0)
+    throwFormatError();
 
-  auto values = data.get<2>().begin();
-  for (int i = 0; i < mat->rows(); ++i)
-      (*mat)(i) = *values++;
+  Data values;
+  readSection(p, end, values, rows);
 
+  DenseColumnMatrixHandle mat(boost::make_shared<DenseColumnMatrix>(rows));
+  std::copy(values.begin(), values.end(), mat->data());
   return mat;
 }
 
@@ -72,6 +72,10 @@ namespace internal
     boost::optional<RawSparseData> parseSparseMatrixString(const std::string& matString);
     SparseData convertRaw(const RawSparseData& data);
   private:
+    Core::Datatypes::SparseRowMatrixHandle makeSparse(const char* contents, const char* end);
+    Core::Datatypes::DenseMatrixHandle makeDense(const char* contents, const char* end);
+    Core::Datatypes::DenseColumnMatrixHandle makeColumn(const char* contents, const char* end);
+
     const Utility::ProgressReporter* reporter_;
   };
 
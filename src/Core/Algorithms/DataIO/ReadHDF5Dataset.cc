@@ -0,0 +1,427 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Core/Algorithms/DataIO/ReadHDF5Dataset.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Datatypes/Legacy/Nrrd/NrrdData.h>
+#include <Core/Thread/ConditionVariable.h>
+#include <Core/Thread/Mutex.h>
+#include <boost/make_shared.hpp>
+#include <boost/thread/thread.hpp>
+#include <algorithm>
+#include <deque>
+#include <hdf5.h>
+
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Thread;
+using namespace SCIRun::Core::Algorithms::DataIO;
+
+namespace
+{
+  const size_t BLOCK_BYTES = 16 << 20;
+
+  enum ValueType { INT8, UINT8, INT16, UINT16, INT32, UINT32, INT64, UINT64, FLOAT32, FLOAT64 };
+
+  /// HDF5 is not thread safe in its default build, every call goes through
+  /// this lock.
+  boost::mutex& hdf5Lock()
+  {
+    static boost::mutex lock;
+    return lock;
+  }
+
+  /// The value type of a native HDF5 type.
+  bool valueType(hid_t memType, ValueType& type, size_t& size)
+  {
+    static const struct { H5T_class_t cls; size_t size; bool sign; ValueType type; } types[] =
+    {
+      { H5T_INTEGER, 1, true, INT8 }, { H5T_INTEGER, 1, false, UINT8 },
+      { H5T_INTEGER, 2, true, INT16 }, { H5T_INTEGER, 2, false, UINT16 },
+      { H5T_INTEGER, 4, true, INT32 }, { H5T_INTEGER, 4, false, UINT32 },
+      { H5T_INTEGER, 8, true, INT64 }, { H5T_INTEGER, 8, false, UINT64 },
+      { H5T_FLOAT, 4, true, FLOAT32 }, { H5T_FLOAT, 8, true, FLOAT64 }
+    };
+    const H5T_class_t cls = H5Tget_class(memType);
+    const size_t memSize = H5Tget_size(memType);
+    const bool sign = cls != H5T_INTEGER || H5Tget_sign(memType) == H5T_SGN_2;
+    for (const auto& t : types)
+    {
+      if (cls == t.cls && memSize == t.size && sign == t.sign)
+      {
+        type = t.type;
+        size = t.size;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <typename T>
+  void convert(const char* source, size_t count, double* values)
+  {
+    const T* typed = reinterpret_cast<const T*>(source);
+    std::copy(typed, typed + count, values);
+  }
+
+  /// One block of slices as stored in the file.
+  struct Block
+  {
+    Block() : first(0), count(0), failed(false) {}
+    std::vector<char> data;
+    size_t first, count;
+    bool failed;
+  };
+  typedef boost::shared_ptr<Block> BlockHandle;
+}
+
+namespace SCIRun {
+namespace Core {
+namespace Algorithms {
+namespace DataIO {
+
+  class ReadHDF5DatasetPrivate
+  {
+  public:
+    ReadHDF5DatasetPrivate();
+    ~ReadHDF5DatasetPrivate() { close(); }
+
+    bool open(const std::string& filename, const std::string& dataset);
+    void close();
+    bool readBlock(size_t first, size_t count, char* data) const;
+    void convertSlice(const char* source, double* values) const;
+
+    std::vector<size_t> dims_;
+    size_t sliceSize_, blockSlices_, valueSize_;
+    ValueType type_;
+    hid_t file_, dataset_, memType_;
+  };
+
+}}}}
+
+ReadHDF5DatasetPrivate::ReadHDF5DatasetPrivate() :
+  sliceSize_(0), blockSlices_(1), valueSize_(8), type_(FLOAT64), file_(-1), dataset_(-1), memType_(-1)
+{
+}
+
+bool ReadHDF5DatasetPrivate::open(const std::string& filename, const std::string& dataset)
+{
+  close();
+
+  boost::lock_guard<boost::mutex> lock(hdf5Lock());
+  H5E_BEGIN_TRY
+  {
+    file_ = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    if (file_ >= 0)
+      dataset_ = H5Dopen2(file_, dataset.c_str(), H5P_DEFAULT);
+  }
+  H5E_END_TRY;
+  if (dataset_ < 0)
+  {
+    if (file_ >= 0)
+      H5Fclose(file_);
+    file_ = -1;
+    return false;
+  }
+
+  bool ok = false;
+  const hid_t fileType = H5Dget_type(dataset_);
+  const hid_t space = H5Dget_space(dataset_);
+  const int rank = space >= 0 ? H5Sget_simple_extent_ndims(space) : -1;
+  if (fileType >= 0)
+    memType_ = H5Tget_native_type(fileType, H5T_DIR_ASCEND);
+  if (memType_ >= 0 && rank > 0 && valueType(memType_, type_, valueSize_))
+  {
+    std::vector<hsize_t> dims(rank);
+    H5Sget_simple_extent_dims(space, &dims[0], nullptr);
+    dims_.assign(dims.begin(), dims.end());
+    sliceSize_ = 1;
+    for (int d = 1; d < rank; ++d)
+      sliceSize_ *= dims_[d];
+
+    const hid_t plist = H5Dget_create_plist(dataset_);
+    std::vector<hsize_t> chunk(rank);
+    if (plist >= 0 && H5Pget_layout(plist) == H5D_CHUNKED && H5Pget_chunk(plist, rank, &chunk[0]) == rank)
+      blockSlices_ = static_cast<size_t>(chunk[0]);
+    else
+      blockSlices_ = std::max<size_t>(1, std::min<size_t>(dims_[0], BLOCK_BYTES / std::max<size_t>(1, sliceSize_ * valueSize_)));
+    if (plist >= 0)
+      H5Pclose(plist);
+    ok = true;
+  }
+  if (space >= 0)
+    H5Sclose(space);
+  if (fileType >= 0)
+    H5Tclose(fileType);
+
+  if (!ok)
+  {
+    if (memType_ >= 0)
+      H5Tclose(memType_);
+    H5Dclose(dataset_);
+    H5Fclose(file_);
+    memType_ = dataset_ = file_ = -1;
+    dims_.clear();
+    sliceSize_ = 0;
+  }
+  return ok;
+}
+
+void ReadHDF5DatasetPrivate::close()
+{
+  if (file_ < 0)
+    return;
+  boost::lock_guard<boost::mutex> lock(hdf5Lock());
+  H5Tclose(memType_);
+  H5Dclose(dataset_);
+  H5Fclose(file_);
+  memType_ = dataset_ = file_ = -1;
+  dims_.clear();
+  sliceSize_ = 0;
+  blockSlices_ = 1;
+}
+
+bool ReadHDF5DatasetPrivate::readBlock(size_t first, size_t count, char* data) const
+{
+  boost::lock_guard<boost::mutex> lock(hdf5Lock());
+
+  std::vector<hsize_t> start(dims_.size(), 0), counts(dims_.begin(), dims_.end());
+  start[0] = first;
+  counts[0] = count;
+
+  const hid_t fileSpace = H5Dget_space(dataset_);
+  if (fileSpace < 0)
+    return false;
+  const hid_t memSpace = H5Screate_simple(static_cast<int>(counts.size()), &counts[0], nullptr);
+  bool ok = memSpace >= 0
+    && H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, &start[0], nullptr, &counts[0], nullptr) >= 0
+    && H5Dread(dataset_, memType_, memSpace, fileSpace, H5P_DEFAULT, data) >= 0;
+  if (memSpace >= 0)
+    H5Sclose(memSpace);
+  H5Sclose(fileSpace);
+  return ok;
+}
+
+void ReadHDF5DatasetPrivate::convertSlice(const char* source, double* values) const
+{
+  switch (type_)
+  {
+  case INT8: convert<int8_t>(source, sliceSize_, values); break;
+  case UINT8: convert<uint8_t>(source, sliceSize_, values); break;
+  case INT16: convert<int16_t>(source, sliceSize_, values); break;
+  case UINT16: convert<uint16_t>(source, sliceSize_, values); break;
+  case INT32: convert<int32_t>(source, sliceSize_, values); break;
+  case UINT32: convert<uint32_t>(source, sliceSize_, values); break;
+  case INT64: convert<int64_t>(source, sliceSize_, values); break;
+  case UINT64: convert<uint64_t>(source, sliceSize_, values); break;
+  case FLOAT32: convert<float>(source, sliceSize_, values); break;
+  case FLOAT64: convert<double>(source, sliceSize_, values); break;
+  }
+}
+
+ReadHDF5DatasetAlgo::ReadHDF5DatasetAlgo() : impl_(new ReadHDF5DatasetPrivate)
+{
+}
+
+ReadHDF5DatasetAlgo::~ReadHDF5DatasetAlgo()
+{
+}
+
+bool ReadHDF5DatasetAlgo::open(const std::string& filename, const std::string& dataset)
+{
+  return impl_->open(filename, dataset);
+}
+
+void ReadHDF5DatasetAlgo::close()
+{
+  impl_->close();
+}
+
+const std::vector<size_t>& ReadHDF5DatasetAlgo::dimensions() const
+{
+  return impl_->dims_;
+}
+
+size_t ReadHDF5DatasetAlgo::numSlices() const
+{
+  return impl_->dims_.empty() ? 0 : impl_->dims_[0];
+}
+
+size_t ReadHDF5DatasetAlgo::sliceSize() const
+{
+  return impl_->sliceSize_;
+}
+
+size_t ReadHDF5DatasetAlgo::blockSlices() const
+{
+  return impl_->blockSlices_;
+}
+
+void ReadHDF5DatasetAlgo::readSlices(size_t first, size_t count, const SliceHandler& handler)
+{
+  if (impl_->dataset_ < 0)
+    THROW_ALGORITHM_INPUT_ERROR_SIMPLE("ReadHDF5Dataset: no dataset is open");
+  if (first > numSlices() || count > numSlices() - first)
+    THROW_ALGORITHM_INPUT_ERROR_SIMPLE("ReadHDF5Dataset: slices out of range");
+  if (count == 0)
+    return;
+
+  const size_t sliceBytes = impl_->sliceSize_ * impl_->valueSize_;
+  const size_t blockSlices = impl_->blockSlices_;
+  const size_t end = first + count;
+
+  // Two blocks: one is being read while the other one is handed out.
+  Mutex lock("ReadHDF5Dataset");
+  ConditionVariable changed("ReadHDF5Dataset");
+  std::vector<BlockHandle> free;
+  free.push_back(boost::make_shared<Block>());
+  free.push_back(boost::make_shared<Block>());
+  std::deque<BlockHandle> ready;
+  bool stop = false;
+
+  auto impl = impl_;
+  boost::thread reader([&, impl]()
+  {
+    size_t slice = first;
+    while (slice < end)
+    {
+      BlockHandle block;
+      {
+        UniqueLock guard(lock.get());
+        while (free.empty() && !stop)
+          changed.wait(guard);
+        if (stop)
+          return;
+        block = free.back();
+        free.pop_back();
+      }
+
+      // Stop at the next block boundary of the file.
+      block->first = slice;
+      block->count = std::min((slice / blockSlices + 1) * blockSlices, end) - slice;
+      block->data.resize(block->count * sliceBytes);
+      block->failed = !impl->readBlock(block->first, block->count, block->data.data());
+
+      {
+        Guard g(lock.get());
+        ready.push_back(block);
+      }
+      changed.conditionBroadcast();
+      if (block->failed)
+        return;
+      slice += block->count;
+    }
+  });
+
+  // Stops and joins the reader also when the handler throws.
+  struct StopReader
+  {
+    Mutex& lock;
+    ConditionVariable& changed;
+    bool& stop;
+    boost::thread& reader;
+    ~StopReader()
+    {
+      {
+        Guard g(lock.get());
+        stop = true;
+      }
+      changed.conditionBroadcast();
+      reader.join();
+    }
+  } stopReader = { lock, changed, stop, reader };
+
+  std::vector<double> values(impl_->sliceSize_);
+  size_t handled = 0;
+  while (handled < count)
+  {
+    BlockHandle block;
+    {
+      UniqueLock guard(lock.get());
+      while (ready.empty())
+        changed.wait(guard);
+      block = ready.front();
+      ready.pop_front();
+    }
+    if (block->failed)
+      THROW_ALGORITHM_INPUT_ERROR_SIMPLE("ReadHDF5Dataset: could not read slices from the dataset");
+
+    for (size_t i = 0; i < block->count; ++i)
+    {
+      impl_->convertSlice(block->data.data() + i * sliceBytes, values.data());
+      handler(block->first + i, values.data());
+    }
+    handled += block->count;
+
+    {
+      Guard g(lock.get());
+      free.push_back(block);
+    }
+    changed.conditionBroadcast();
+  }
+}
+
+DenseMatrixHandle ReadHDF5DatasetAlgo::readMatrix()
+{
+  const size_t cols = sliceSize();
+  DenseMatrixHandle matrix(new DenseMatrix(numSlices(), cols));
+  // Dense matrices are row major, every slice is one contiguous row.
+  double* rows = matrix->data();
+  readSlices(0, numSlices(), [rows, cols](size_t slice, const double* values)
+  {
+    std::copy(values, values + cols, rows + slice * cols);
+  });
+  return matrix;
+}
+
+SCIRun::NrrdDataHandle ReadHDF5DatasetAlgo::readNrrd(size_t first, size_t count)
+{
+  const auto& dims = impl_->dims_;
+  if (dims.empty())
+    THROW_ALGORITHM_INPUT_ERROR_SIMPLE("ReadHDF5Dataset: no dataset is open");
+  if (first > numSlices() || count > numSlices() - first)
+    THROW_ALGORITHM_INPUT_ERROR_SIMPLE("ReadHDF5Dataset: slices out of range");
+
+  std::vector<size_t> sizes(dims.rbegin(), dims.rend());
+  sizes.back() = count;
+
+  NrrdDataHandle nrrd(new NrrdData);
+  {
+    NrrdGuard guard;
+    if (nrrdAlloc_nva(nrrd->getNrrd(), nrrdTypeDouble, static_cast<unsigned int>(sizes.size()), &sizes[0]))
+      THROW_ALGORITHM_INPUT_ERROR_SIMPLE("ReadHDF5Dataset: could not allocate the nrrd");
+  }
+
+  const size_t size = sliceSize();
+  double* data = static_cast<double*>(nrrd->getNrrd()->data);
+  readSlices(first, count, [data, first, size](size_t slice, const double* values)
+  {
+    std::copy(values, values + size, data + (slice - first) * size);
+  });
+  return nrrd;
+}
@@ -0,0 +1,95 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_DATAIO_READHDF5DATASET_H
+#define ALGORITHMS_DATAIO_READHDF5DATASET_H
+
+#include <string>
+#include <vector>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <Core/Datatypes/DatatypeFwd.h>
+#include <Core/Datatypes/MatrixFwd.h>
+#include <Core/Algorithms/DataIO/share.h>
+
+namespace SCIRun {
+namespace Core {
+namespace Algorithms {
+namespace DataIO {
+
+  class ReadHDF5DatasetPrivate;
+
+  /// Reads a numeric HDF5 dataset one slice at a time, where a slice is one
+  /// index along the first (slowest varying) dimension, e.g. a time step.
+  ///
+  /// Slices are read in blocks. For chunked datasets a block covers whole
+  /// rows of chunks, so every chunk is decompressed by exactly one read;
+  /// contiguous datasets are read in blocks of about 16 MB. A background
+  /// thread reads the next block in the type stored in the file while the
+  /// slices of the current block are converted to double and handed out.
+  /// That thread makes all HDF5 calls during a read, and the calls of all
+  /// instances are serialized, so a library built without thread safety
+  /// can be used.
+  class SCISHARE ReadHDF5DatasetAlgo : boost::noncopyable
+  {
+  public:
+    typedef boost::function<void(size_t slice, const double* values)> SliceHandler;
+
+    ReadHDF5DatasetAlgo();
+    ~ReadHDF5DatasetAlgo();
+
+    /// Open a dataset given by its path in the file, e.g. "/group/data".
+    bool open(const std::string& filename, const std::string& dataset);
+    void close();
+
+    const std::vector<size_t>& dimensions() const;
+    size_t numSlices() const;
+    size_t sliceSize() const;
+    /// Number of slices read by one block.
+    size_t blockSlices() const;
+
+    /// Hand the slices [first, first + count) to the handler in order. The
+    /// values are only valid during the call.
+    void readSlices(size_t first, size_t count, const SliceHandler& handler);
+
+    /// The whole dataset with one row per slice.
+    Datatypes::DenseMatrixHandle readMatrix();
+
+    /// The slices [first, first + count) as a nrrd of doubles. The axes are
+    /// those of the dataset in reverse order, so the slices run along the
+    /// last (slowest) nrrd axis.
+    NrrdDataHandle readNrrd(size_t first, size_t count);
+
+  private:
+    boost::shared_ptr<ReadHDF5DatasetPrivate> impl_;
+  };
+
+}}}}
+
+#endif
@@ -33,6 +33,7 @@
 #include <Core/Datatypes/SparseRowMatrix.h>
 #include <Core/Datatypes/MatrixIO.h>
 #include <Core/Algorithms/DataIO/EigenMatrixFromScirunAsciiFormatConverter.h>
+#include <Core/Algorithms/DataIO/TextNumberParser.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <boost/filesystem.hpp>
@@ -71,10 +72,18 @@ ReadMatrixAlgorithm::Outputs ReadMatrixAlgorithm::run(const ReadMatrixAlgorithm:
 
   if (boost::filesystem::extension(filename) == ".txt")
   {
-    std::ifstream reader(filename.c_str());
-    DenseMatrixHandle matrix(boost::make_shared<DenseMatrix>());
-    reader >> *matrix;
+    std::vector<char> buffer;
+    if (!internal::readTextFile(filename, buffer))
+      THROW_ALGORITHM_PROCESSING_ERROR("Error reading file '" + filename + "'.");
 
+    DenseMatrixHandle matrix;
+    internal::parseTextMatrix(&buffer[0], &buffer[0] + buffer.size() - 1, [&](size_t rows, size_t cols)
+    {
+      // The text is no longer needed once it is parsed.
+      std::vector<char>().swap(buffer);
+      matrix = boost::make_shared<DenseMatrix>(rows, cols);
+      return matrix->data();
+    });
     return matrix;
   }
   else if (boost::filesystem::extension(filename) == ".mat")
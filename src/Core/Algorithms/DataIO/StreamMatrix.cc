@@ -0,0 +1,682 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Core/Algorithms/DataIO/StreamMatrix.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Datatypes/SparseRowMatrix.h>
+#include <Core/Thread/ConditionVariable.h>
+#include <Core/Thread/Mutex.h>
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/thread/thread.hpp>
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <list>
+#include <map>
+#include <sstream>
+
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Thread;
+using namespace SCIRun::Core::Algorithms::DataIO;
+
+namespace
+{
+  enum ValueType { INT8, UINT8, INT16, UINT16, INT32, UINT32, INT64, UINT64, FLOAT32, FLOAT64 };
+
+  /// Type names as accepted by the nrrd format.
+  bool parseValueType(const std::string& name, ValueType& type, size_t& size)
+  {
+    static const struct { const char* name; ValueType type; size_t size; } types[] =
+    {
+      { "signed char", INT8, 1 }, { "int8", INT8, 1 }, { "int8_t", INT8, 1 },
+      { "uchar", UINT8, 1 }, { "unsigned char", UINT8, 1 }, { "uint8", UINT8, 1 }, { "uint8_t", UINT8, 1 },
+      { "short", INT16, 2 }, { "short int", INT16, 2 }, { "signed short", INT16, 2 }, { "signed short int", INT16, 2 },
+      { "int16", INT16, 2 }, { "int16_t", INT16, 2 },
+      { "ushort", UINT16, 2 }, { "unsigned short", UINT16, 2 }, { "unsigned short int", UINT16, 2 },
+      { "uint16", UINT16, 2 }, { "uint16_t", UINT16, 2 },
+      { "int", INT32, 4 }, { "signed int", INT32, 4 }, { "int32", INT32, 4 }, { "int32_t", INT32, 4 },
+      { "uint", UINT32, 4 }, { "unsigned int", UINT32, 4 }, { "uint32", UINT32, 4 }, { "uint32_t", UINT32, 4 },
+      { "longlong", INT64, 8 }, { "long long", INT64, 8 }, { "long long int", INT64, 8 }, { "signed long long", INT64, 8 },
+      { "signed long long int", INT64, 8 }, { "int64", INT64, 8 }, { "int64_t", INT64, 8 },
+      { "ulonglong", UINT64, 8 }, { "unsigned long long", UINT64, 8 }, { "unsigned long long int", UINT64, 8 },
+      { "uint64", UINT64, 8 }, { "uint64_t", UINT64, 8 },
+      { "float", FLOAT32, 4 }, { "double", FLOAT64, 8 }
+    };
+    for (const auto& t : types)
+    {
+      if (name == t.name)
+      {
+        type = t.type;
+        size = t.size;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <class T>
+  void convertValues(const char* src, size_t count, bool swap, double* dst)
+  {
+    T value;
+    for (size_t i = 0; i < count; ++i, src += sizeof(T))
+    {
+      if (swap)
+      {
+        char bytes[sizeof(T)];
+        std::reverse_copy(src, src + sizeof(T), bytes);
+        memcpy(&value, bytes, sizeof(T));
+      }
+      else
+        memcpy(&value, src, sizeof(T));
+      dst[i] = static_cast<double>(value);
+    }
+  }
+
+  bool hostIsLittleEndian()
+  {
+    const unsigned short one = 1;
+    return *reinterpret_cast<const unsigned char*>(&one) == 1;
+  }
+
+  struct Block
+  {
+    explicit Block(int size) : blockSize(size), ready(false), failed(false) {}
+    std::vector<double> values;
+    int blockSize;
+    bool ready;
+    bool failed;
+  };
+  typedef boost::shared_ptr<Block> BlockHandle;
+
+  // The block size is captured when a read is requested, the prefetch
+  // thread never looks at the current setting.
+  struct ReadRequest
+  {
+    ReadRequest(int b, int size) : block(b), blockSize(size) {}
+    int block;
+    int blockSize;
+  };
+}
+
+namespace SCIRun {
+namespace Core {
+namespace Algorithms {
+namespace DataIO {
+
+  class StreamMatrixPrivate
+  {
+  public:
+    StreamMatrixPrivate();
+    ~StreamMatrixPrivate();
+
+    bool open(const std::string& filename);
+    void close();
+
+    BlockHandle acquire(int block, int blockSize);
+    void prefetch(int block, int blockSize);
+    bool readColumns(std::ifstream& stream, int first, int count, std::vector<double>& values);
+    void readBlock(std::ifstream& stream, int block, Block& data);
+    void touch(int block);
+    void evict();
+    void runPrefetch();
+    void waitForPrefetch();
+
+    // File layout
+    int rows_, cols_;
+    double rowSpacing_, colSpacing_;
+    ValueType type_;
+    size_t valueSize_;
+    bool swap_;
+    std::string dataFile_;
+    std::streamoff dataOffset_;
+
+    // Block cache, both streams are only used by one thread each.
+    int blockSize_, windowSize_;
+    std::ifstream foreground_, background_;
+    std::map<int, BlockHandle> cache_;
+    std::list<int> recentlyUsed_;
+    std::list<int> readAhead_;
+    std::deque<ReadRequest> queue_;
+    int lastBlock_, direction_, misses_;
+    bool stop_, reading_;
+    Mutex lock_;
+    ConditionVariable changed_;
+    boost::shared_ptr<boost::thread> worker_;
+  };
+
+StreamMatrixPrivate::StreamMatrixPrivate() :
+  rows_(0), cols_(0), rowSpacing_(1.0), colSpacing_(1.0), type_(FLOAT64), valueSize_(8), swap_(false),
+  dataOffset_(0), blockSize_(64), windowSize_(16), lastBlock_(-1), direction_(1), misses_(0), stop_(false), reading_(false),
+  lock_("StreamMatrix"), changed_("StreamMatrix")
+{
+}
+
+StreamMatrixPrivate::~StreamMatrixPrivate()
+{
+  close();
+}
+
+bool StreamMatrixPrivate::open(const std::string& filename)
+{
+  close();
+
+  std::ifstream header(filename.c_str(), std::ios::in | std::ios::binary);
+  std::string line;
+  if (!header || !std::getline(header, line) || line.compare(0, 4, "NRRD") != 0)
+    return false;
+
+  std::map<std::string, std::string> fields;
+  while (std::getline(header, line))
+  {
+    boost::trim_right_if(line, boost::is_any_of("\r"));
+    if (line.empty())
+      break;
+    if (line[0] == '#')
+      continue;
+    const std::string::size_type colon = line.find(':');
+    // Skip key/value pairs, which are written as "key:=value"
+    if (colon == std::string::npos || line.compare(colon, 2, ":=") == 0)
+      continue;
+    std::string key = boost::to_lower_copy(boost::trim_copy(line.substr(0, colon)));
+    fields[key] = boost::trim_copy(line.substr(colon + 1));
+  }
+
+  int dimension = 0;
+  std::istringstream(fields["dimension"]) >> dimension;
+  std::istringstream sizes(fields["sizes"]);
+  cols_ = 1;
+  if (!(dimension == 1 || dimension == 2) || !(sizes >> rows_) || (dimension == 2 && !(sizes >> cols_)))
+    return false;
+  if (rows_ <= 0 || cols_ <= 0)
+    return false;
+
+  if (!parseValueType(fields["type"], type_, valueSize_))
+    return false;
+  if (fields["encoding"] != "raw")
+    return false;
+  if (fields.count("line skip") || fields.count("lineskip"))
+    return false;
+
+  const bool little = hostIsLittleEndian();
+  const std::string endian = fields["endian"];
+  swap_ = valueSize_ > 1 && ((endian == "big" && little) || (endian == "little" && !little));
+
+  std::istringstream spacings(fields["spacings"]);
+  if (!(spacings >> rowSpacing_) || !(rowSpacing_ == rowSpacing_))
+    rowSpacing_ = 1.0;
+  if (!(spacings >> colSpacing_) || !(colSpacing_ == colSpacing_))
+    colSpacing_ = 1.0;
+
+  std::streamoff skip = 0;
+  std::istringstream(fields.count("byte skip") ? fields["byte skip"] : fields["byteskip"]) >> skip;
+
+  std::string dataFile = fields.count("data file") ? fields["data file"] : fields["datafile"];
+  if (dataFile.empty())
+  {
+    // The data is attached to the header
+    dataFile_ = filename;
+    dataOffset_ = static_cast<std::streamoff>(header.tellg()) + skip;
+  }
+  else
+  {
+    boost::filesystem::path path(dataFile);
+    if (path.is_relative())
+      path = boost::filesystem::path(filename).parent_path() / path;
+    dataFile_ = path.string();
+    dataOffset_ = skip;
+  }
+
+  boost::system::error_code ec;
+  const boost::uintmax_t fileSize = boost::filesystem::file_size(dataFile_, ec);
+  if (ec || fileSize < static_cast<boost::uintmax_t>(dataOffset_) + static_cast<boost::uintmax_t>(rows_) * cols_ * valueSize_)
+    return false;
+
+  foreground_.open(dataFile_.c_str(), std::ios::in | std::ios::binary);
+  background_.open(dataFile_.c_str(), std::ios::in | std::ios::binary);
+  if (!foreground_ || !background_)
+  {
+    close();
+    return false;
+  }
+
+  stop_ = false;
+  worker_.reset(new boost::thread([this]() { runPrefetch(); }));
+  return true;
+}
+
+void StreamMatrixPrivate::close()
+{
+  if (worker_)
+  {
+    {
+      Guard g(lock_.get());
+      stop_ = true;
+    }
+    changed_.conditionBroadcast();
+    worker_->join();
+    worker_.reset();
+  }
+
+  foreground_.close();
+  background_.close();
+  foreground_.clear();
+  background_.clear();
+  cache_.clear();
+  recentlyUsed_.clear();
+  readAhead_.clear();
+  queue_.clear();
+  lastBlock_ = -1;
+  misses_ = 0;
+  direction_ = 1;
+  rows_ = cols_ = 0;
+}
+
+bool StreamMatrixPrivate::readColumns(std::ifstream& stream, int first, int count, std::vector<double>& values)
+{
+  const size_t size = static_cast<size_t>(rows_) * count;
+  std::vector<char> buffer(size * valueSize_);
+  stream.clear();
+  stream.seekg(dataOffset_ + static_cast<std::streamoff>(first) * rows_ * valueSize_);
+  if (!stream.read(&buffer[0], buffer.size()))
+    return false;
+
+  values.resize(size);
+  switch (type_)
+  {
+  case INT8:    convertValues<signed char>(&buffer[0], size, swap_, &values[0]); break;
+  case UINT8:   convertValues<unsigned char>(&buffer[0], size, swap_, &values[0]); break;
+  case INT16:   convertValues<short>(&buffer[0], size, swap_, &values[0]); break;
+  case UINT16:  convertValues<unsigned short>(&buffer[0], size, swap_, &values[0]); break;
+  case INT32:   convertValues<int>(&buffer[0], size, swap_, &values[0]); break;
+  case UINT32:  convertValues<unsigned int>(&buffer[0], size, swap_, &values[0]); break;
+  case INT64:   convertValues<long long>(&buffer[0], size, swap_, &values[0]); break;
+  case UINT64:  convertValues<unsigned long long>(&buffer[0], size, swap_, &values[0]); break;
+  case FLOAT32: convertValues<float>(&buffer[0], size, swap_, &values[0]); break;
+  case FLOAT64: convertValues<double>(&buffer[0], size, swap_, &values[0]); break;
+  }
+  return true;
+}
+
+void StreamMatrixPrivate::readBlock(std::ifstream& stream, int block, Block& data)
+{
+  const int first = block * data.blockSize;
+  const int count = std::min(data.blockSize, cols_ - first);
+  data.failed = !readColumns(stream, first, count, data.values);
+}
+
+void StreamMatrixPrivate::touch(int block)
+{
+  readAhead_.remove(block);
+  recentlyUsed_.remove(block);
+  recentlyUsed_.push_front(block);
+}
+
+// Played blocks are evicted least recently played first. Read ahead blocks
+// have not been played yet and only go when no other played block is left,
+// otherwise every block read ahead would be dropped as soon as it arrives.
+void StreamMatrixPrivate::evict()
+{
+  while (static_cast<int>(recentlyUsed_.size() + readAhead_.size()) > windowSize_ && recentlyUsed_.size() > 1)
+  {
+    cache_.erase(recentlyUsed_.back());
+    recentlyUsed_.pop_back();
+  }
+  while (static_cast<int>(recentlyUsed_.size() + readAhead_.size()) > windowSize_ && !readAhead_.empty())
+  {
+    cache_.erase(readAhead_.front());
+    readAhead_.pop_front();
+  }
+}
+
+BlockHandle StreamMatrixPrivate::acquire(int block, int blockSize)
+{
+  UniqueLock lock(lock_.get());
+  for (;;)
+  {
+    auto it = cache_.find(block);
+    if (it == cache_.end() || it->second->blockSize != blockSize)
+      break;
+
+    BlockHandle data = it->second;
+    if (data->ready)
+    {
+      if (data->failed)
+      {
+        cache_.erase(it);
+        recentlyUsed_.remove(block);
+        readAhead_.remove(block);
+        THROW_ALGORITHM_INPUT_ERROR_SIMPLE("StreamMatrix: could not read from " + dataFile_);
+      }
+      touch(block);
+      return data;
+    }
+    // The background thread is reading this block
+    changed_.wait(lock);
+  }
+
+  // Not in memory and not being read ahead, read it on this thread.
+  ++misses_;
+  BlockHandle data = boost::make_shared<Block>(blockSize);
+  cache_[block] = data;
+  queue_.erase(std::remove_if(queue_.begin(), queue_.end(),
+    [block](const ReadRequest& request) { return request.block == block; }), queue_.end());
+  lock.unlock();
+  readBlock(foreground_, block, *data);
+  lock.lock();
+
+  data->ready = true;
+  auto it = cache_.find(block);
+  const bool current = it != cache_.end() && it->second == data;
+  if (data->failed)
+  {
+    if (current)
+      cache_.erase(it);
+    changed_.conditionBroadcast();
+    THROW_ALGORITHM_INPUT_ERROR_SIMPLE("StreamMatrix: could not read from " + dataFile_);
+  }
+  // The block size may have changed while reading, hand out the block
+  // anyway but keep it out of the cache.
+  if (current)
+  {
+    touch(block);
+    evict();
+  }
+  changed_.conditionBroadcast();
+  return data;
+}
+
+void StreamMatrixPrivate::prefetch(int block, int blockSize)
+{
+  const int numBlocks = (cols_ + blockSize - 1) / blockSize;
+  {
+    Guard g(lock_.get());
+    // Requests made with an older block size are stale
+    if (blockSize != blockSize_)
+      return;
+    const int ahead = std::max(1, windowSize_ / 2);
+    // Follow the direction of playback, only the latest position matters
+    if (lastBlock_ >= 0 && block != lastBlock_)
+      direction_ = block > lastBlock_ ? 1 : -1;
+    lastBlock_ = block;
+    queue_.clear();
+    std::vector<int> wanted;
+    for (int b = block + direction_, k = 0; k < ahead && b >= 0 && b < numBlocks; b += direction_, ++k)
+    {
+      wanted.push_back(b);
+      if (!cache_.count(b))
+        queue_.push_back(ReadRequest(b, blockSize));
+    }
+    // Blocks read ahead for an earlier position that will not be played
+    for (auto it = readAhead_.begin(); it != readAhead_.end();)
+    {
+      if (std::find(wanted.begin(), wanted.end(), *it) == wanted.end())
+      {
+        cache_.erase(*it);
+        it = readAhead_.erase(it);
+      }
+      else
+        ++it;
+    }
+  }
+  changed_.conditionBroadcast();
+}
+
+void StreamMatrixPrivate::runPrefetch()
+{
+  UniqueLock lock(lock_.get());
+  while (!stop_)
+  {
+    if (queue_.empty())
+    {
+      changed_.wait(lock);
+      continue;
+    }
+
+    const ReadRequest request = queue_.front();
+    queue_.pop_front();
+    const int block = request.block;
+    if (cache_.count(block))
+      continue;
+
+    BlockHandle data = boost::make_shared<Block>(request.blockSize);
+    cache_[block] = data;
+    reading_ = true;
+    lock.unlock();
+    readBlock(background_, block, *data);
+    lock.lock();
+
+    reading_ = false;
+    data->ready = true;
+    // The cache may have been reset while reading
+    auto it = cache_.find(block);
+    const bool current = it != cache_.end() && it->second == data;
+    if (current && data->failed)
+      cache_.erase(it);
+    else if (current)
+    {
+      readAhead_.push_back(block);
+      evict();
+    }
+    changed_.conditionBroadcast();
+  }
+}
+
+void StreamMatrixPrivate::waitForPrefetch()
+{
+  UniqueLock lock(lock_.get());
+  while (worker_ && !stop_ && (reading_ || !queue_.empty()))
+    changed_.wait(lock);
+}
+
+}}}}
+
+StreamMatrixAlgo::StreamMatrixAlgo() : impl_(new StreamMatrixPrivate)
+{
+}
+
+StreamMatrixAlgo::~StreamMatrixAlgo()
+{
+}
+
+bool StreamMatrixAlgo::open(const std::string& filename)
+{
+  return impl_->open(filename);
+}
+
+void StreamMatrixAlgo::close()
+{
+  impl_->close();
+}
+
+int StreamMatrixAlgo::numRows() const
+{
+  return impl_->rows_;
+}
+
+int StreamMatrixAlgo::numCols() const
+{
+  return impl_->cols_;
+}
+
+double StreamMatrixAlgo::rowSpacing() const
+{
+  return impl_->rowSpacing_;
+}
+
+double StreamMatrixAlgo::colSpacing() const
+{
+  return impl_->colSpacing_;
+}
+
+void StreamMatrixAlgo::setBlockSize(int columns)
+{
+  Guard g(impl_->lock_.get());
+  impl_->blockSize_ = std::max(1, columns);
+  impl_->cache_.clear();
+  impl_->recentlyUsed_.clear();
+  impl_->readAhead_.clear();
+  impl_->queue_.clear();
+  impl_->lastBlock_ = -1;
+}
+
+void StreamMatrixAlgo::setWindowSize(int blocks)
+{
+  Guard g(impl_->lock_.get());
+  impl_->windowSize_ = std::max(1, blocks);
+  impl_->evict();
+}
+
+int StreamMatrixAlgo::cacheMisses() const
+{
+  Guard g(impl_->lock_.get());
+  return impl_->misses_;
+}
+
+void StreamMatrixAlgo::waitForPrefetch()
+{
+  impl_->waitForPrefetch();
+}
+
+DenseMatrixHandle StreamMatrixAlgo::getColumns(const std::vector<int>& indices)
+{
+  const int rows = impl_->rows_;
+  int blockSize;
+  {
+    Guard g(impl_->lock_.get());
+    blockSize = impl_->blockSize_;
+  }
+  DenseMatrixHandle output(boost::make_shared<DenseMatrix>(rows, static_cast<int>(indices.size())));
+
+  int previous = -1;
+  BlockHandle data;
+  for (size_t k = 0; k < indices.size(); ++k)
+  {
+    const int index = indices[k];
+    if (index < 0 || index >= impl_->cols_)
+      THROW_ALGORITHM_INPUT_ERROR_SIMPLE("StreamMatrix: column index out of range");
+
+    const int block = index / blockSize;
+    if (block != previous)
+    {
+      data = impl_->acquire(block, blockSize);
+      previous = block;
+    }
+    const double* column = &data->values[static_cast<size_t>(index - block * blockSize) * rows];
+    for (int r = 0; r < rows; ++r)
+      (*output)(r, k) = column[r];
+  }
+
+  if (!indices.empty())
+    impl_->prefetch(indices.back() / blockSize, blockSize);
+  return output;
+}
+
+DenseMatrixHandle StreamMatrixAlgo::getRows(const std::vector<int>& indices)
+{
+  for (int index : indices)
+  {
+    if (index < 0 || index >= impl_->rows_)
+      THROW_ALGORITHM_INPUT_ERROR_SIMPLE("StreamMatrix: row index out of range");
+  }
+
+  // Rows cut through every column, stream over the whole file without
+  // disturbing the cached window.
+  const int rows = impl_->rows_;
+  const int cols = impl_->cols_;
+  DenseMatrixHandle output(boost::make_shared<DenseMatrix>(static_cast<int>(indices.size()), cols));
+  int blockSize;
+  {
+    Guard g(impl_->lock_.get());
+    blockSize = impl_->blockSize_;
+  }
+  std::vector<double> values;
+  for (int first = 0; first < cols; first += blockSize)
+  {
+    const int count = std::min(blockSize, cols - first);
+    if (!impl_->readColumns(impl_->foreground_, first, count, values))
+      THROW_ALGORITHM_INPUT_ERROR_SIMPLE("StreamMatrix: could not read from " + impl_->dataFile_);
+    for (int c = 0; c < count; ++c)
+      for (size_t k = 0; k < indices.size(); ++k)
+        (*output)(k, first + c) = values[static_cast<size_t>(c) * rows + indices[k]];
+  }
+  return output;
+}
+
+DenseMatrixHandle StreamMatrixAlgo::getWeightedColumns(const SparseRowMatrix& weights)
+{
+  if (weights.cols() != impl_->cols_)
+    THROW_ALGORITHM_INPUT_ERROR_SIMPLE("StreamMatrix: number of weights does not match the number of columns");
+
+  std::vector<int> indices;
+  for (int k = 0; k < weights.outerSize(); ++k)
+    for (SparseRowMatrix::InnerIterator it(weights, k); it; ++it)
+      indices.push_back(static_cast<int>(it.col()));
+  std::sort(indices.begin(), indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+  DenseMatrixHandle columns = getColumns(indices);
+  DenseMatrixHandle output(boost::make_shared<DenseMatrix>(DenseMatrix::Zero(impl_->rows_, weights.rows())));
+  for (int k = 0; k < weights.outerSize(); ++k)
+  {
+    for (SparseRowMatrix::InnerIterator it(weights, k); it; ++it)
+    {
+      const int j = static_cast<int>(std::lower_bound(indices.begin(), indices.end(), static_cast<int>(it.col())) - indices.begin());
+      output->col(k) += it.value() * columns->col(j);
+    }
+  }
+  return output;
+}
+
+DenseMatrixHandle StreamMatrixAlgo::getWeightedRows(const SparseRowMatrix& weights)
+{
+  if (weights.cols() != impl_->rows_)
+    THROW_ALGORITHM_INPUT_ERROR_SIMPLE("StreamMatrix: number of weights does not match the number of rows");
+
+  std::vector<int> indices;
+  for (int k = 0; k < weights.outerSize(); ++k)
+    for (SparseRowMatrix::InnerIterator it(weights, k); it; ++it)
+      indices.push_back(static_cast<int>(it.col()));
+  std::sort(indices.begin(), indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+  DenseMatrixHandle rows = getRows(indices);
+  DenseMatrixHandle output(boost::make_shared<DenseMatrix>(DenseMatrix::Zero(weights.rows(), impl_->cols_)));
+  for (int k = 0; k < weights.outerSize(); ++k)
+  {
+    for (SparseRowMatrix::InnerIterator it(weights, k); it; ++it)
+    {
+      const int j = static_cast<int>(std::lower_bound(indices.begin(), indices.end(), static_cast<int>(it.col())) - indices.begin());
+      output->row(k) += it.value() * rows->row(j);
+    }
+  }
+  return output;
+}
@@ -0,0 +1,94 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_DATAIO_STREAMMATRIX_H
+#define ALGORITHMS_DATAIO_STREAMMATRIX_H
+
+#include <string>
+#include <vector>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <Core/Datatypes/MatrixFwd.h>
+#include <Core/Algorithms/DataIO/share.h>
+
+namespace SCIRun {
+namespace Core {
+namespace Algorithms {
+namespace DataIO {
+
+  class StreamMatrixPrivate;
+
+  /// Out of core access to a large two dimensional matrix stored as a raw
+  /// nrrd, e.g. a time series with one column per time step. The first nrrd
+  /// axis runs along the rows, so every column is contiguous on disk.
+  ///
+  /// Columns are read in blocks. A window of recently used blocks is kept in
+  /// memory, and after every request a background thread reads the blocks
+  /// that follow in the direction of playback, so stepping through the
+  /// columns does not wait for the disk.
+  class SCISHARE StreamMatrixAlgo : boost::noncopyable
+  {
+  public:
+    StreamMatrixAlgo();
+    ~StreamMatrixAlgo();
+
+    /// Open a nrrd header (.nhdr) or an attached nrrd with raw encoding.
+    bool open(const std::string& filename);
+    void close();
+
+    int numRows() const;
+    int numCols() const;
+    double rowSpacing() const;
+    double colSpacing() const;
+
+    /// Number of columns per block and number of blocks kept in memory. The
+    /// background thread reads ahead up to half the window.
+    void setBlockSize(int columns);
+    void setWindowSize(int blocks);
+
+    /// Number of blocks that were neither in memory nor being read ahead
+    /// when requested, so they were read on the calling thread.
+    int cacheMisses() const;
+    /// Wait until the background thread has read all blocks it was asked for.
+    void waitForPrefetch();
+
+    Datatypes::DenseMatrixHandle getColumns(const std::vector<int>& indices);
+    Datatypes::DenseMatrixHandle getRows(const std::vector<int>& indices);
+
+    /// Every row of the weights gives one output column (or row) as a
+    /// weighted sum of the columns (or rows) of the file.
+    Datatypes::DenseMatrixHandle getWeightedColumns(const Datatypes::SparseRowMatrix& weights);
+    Datatypes::DenseMatrixHandle getWeightedRows(const Datatypes::SparseRowMatrix& weights);
+
+  private:
+    boost::shared_ptr<StreamMatrixPrivate> impl_;
+  };
+
+}}}}
+
+#endif
@@ -0,0 +1,332 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <Testing/Utils/SCIRunUnitTests.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Datatypes/MatrixTypeConversions.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/GeometryPrimitives/Tensor.h>
+#include <Core/Persistent/PersistentSTL.h>
+#include <Core/Persistent/ChunkedPiostream.h>
+#include <Core/Persistent/Pstreams.h>
+#include <boost/filesystem.hpp>
+#include <zlib.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+using namespace SCIRun;
+using namespace SCIRun::TestUtils;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Geometry;
+
+namespace
+{
+  boost::filesystem::path tempFile(const std::string& name)
+  {
+    return boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%-" + name);
+  }
+
+  DenseMatrixHandle rampMatrix(int rows, int cols)
+  {
+    DenseMatrixHandle m(new DenseMatrix(rows, cols));
+    for (int i = 0; i < rows; ++i)
+      for (int j = 0; j < cols; ++j)
+        (*m)(i, j) = 0.25 * i - j;
+    return m;
+  }
+
+  template <class T>
+  void writeObject(const boost::filesystem::path& filename, const std::string& type, boost::shared_ptr<T> object)
+  {
+    PiostreamPtr stream = auto_ostream(filename.string(), type);
+    ASSERT_TRUE(stream != nullptr);
+    Pio(*stream, object);
+    ASSERT_FALSE(stream->error());
+  }
+
+  template <class T>
+  boost::shared_ptr<T> readObject(const boost::filesystem::path& filename)
+  {
+    boost::shared_ptr<T> object;
+    PiostreamPtr stream = auto_istream(filename.string());
+    if (stream)
+      Pio(*stream, object);
+    return object;
+  }
+
+  std::string fileContents(const boost::filesystem::path& filename)
+  {
+    std::ifstream file(filename.string().c_str(), std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  }
+}
+
+TEST(ChunkedPiostreamTests, DenseMatrixRoundTrip)
+{
+  auto filename = tempFile("chunked.mat");
+  MatrixHandle expected = rampMatrix(700, 500);
+  writeObject(filename, "Chunked", expected);
+
+  auto actual = readObject<Matrix>(filename);
+  ASSERT_TRUE(actual != nullptr);
+  EXPECT_EQ(*convertMatrix::toDense(expected), *convertMatrix::toDense(actual));
+  boost::filesystem::remove(filename);
+}
+
+TEST(ChunkedPiostreamTests, FieldRoundTrip)
+{
+  auto filename = tempFile("chunked.fld");
+  FieldHandle expected = CreateEmptyLatVol(40, 30, 20);
+  expected->vfield()->resize_values();
+  for (VMesh::index_type i = 0; i < expected->vfield()->num_values(); ++i)
+    expected->vfield()->set_value(0.5 * i, i);
+  writeObject(filename, "Chunked", expected);
+
+  auto actual = readObject<Field>(filename);
+  ASSERT_TRUE(actual != nullptr);
+  ASSERT_EQ(expected->vfield()->num_values(), actual->vfield()->num_values());
+  EXPECT_EQ(expected->vmesh()->num_nodes(), actual->vmesh()->num_nodes());
+  for (VMesh::index_type i = 0; i < actual->vfield()->num_values(); ++i)
+  {
+    double v;
+    actual->vfield()->get_value(v, i);
+    ASSERT_EQ(0.5 * i, v);
+  }
+  boost::filesystem::remove(filename);
+}
+
+TEST(ChunkedPiostreamTests, CanReadPartOfAnArray)
+{
+  auto filename = tempFile("partial.mat");
+  auto expected = rampMatrix(1000, 400);
+  writeObject<Matrix>(filename, "Chunked", expected);
+
+  ChunkedPiostream stream(filename.string(), Piostream::Read);
+  ASSERT_FALSE(stream.error());
+  ASSERT_EQ(2u, stream.num_arrays());
+  ASSERT_EQ(expected->size() * sizeof(double), stream.array_size(1));
+
+  // A range that straddles a chunk boundary.
+  const size_t first = ChunkedPiostream::CHUNK_SIZE / sizeof(double) - 3;
+  std::vector<double> values(7);
+  ASSERT_TRUE(stream.read_array(1, first * sizeof(double), values.size() * sizeof(double), &values[0]));
+  for (size_t k = 0; k < values.size(); ++k)
+    EXPECT_EQ(expected->data()[first + k], values[k]);
+
+  EXPECT_FALSE(stream.read_array(1, stream.array_size(1), 1, &values[0]));
+  boost::filesystem::remove(filename);
+}
+
+TEST(ChunkedPiostreamTests, CorruptedChunkIsReported)
+{
+  auto filename = tempFile("corrupt.mat");
+  writeObject<Matrix>(filename, "Chunked", rampMatrix(300, 300));
+
+  FILE* fp = fopen(filename.string().c_str(), "r+b");
+  ASSERT_TRUE(fp != nullptr);
+  fseek(fp, 64, SEEK_SET);
+  const int c = fgetc(fp);
+  fseek(fp, 64, SEEK_SET);
+  fputc(c ^ 0xff, fp);
+  fclose(fp);
+
+  MatrixHandle matrix;
+  PiostreamPtr stream = auto_istream(filename.string());
+  ASSERT_TRUE(stream != nullptr);
+  Pio(*stream, matrix);
+  EXPECT_TRUE(stream->error());
+  boost::filesystem::remove(filename);
+}
+
+TEST(ChunkedPiostreamTests, MeshNodesAreStoredAsChunkedArrays)
+{
+  auto filename = tempFile("nodes.fld");
+  FieldInformation fi("PointCloudMesh", LINEARDATA_E, "Vector");
+  FieldHandle expected = CreateField(fi);
+  const int n = 100000;
+  for (int i = 0; i < n; ++i)
+    expected->vmesh()->add_point(Point(i, 0.5 * i, -0.25 * i));
+  expected->vfield()->resize_values();
+  for (VMesh::index_type i = 0; i < n; ++i)
+    expected->vfield()->set_value(Vector(i, 1, -i), i);
+  writeObject(filename, "Chunked", expected);
+
+  {
+    // The structure array, the nodes and the values.
+    ChunkedPiostream stream(filename.string(), Piostream::Read);
+    ASSERT_FALSE(stream.error());
+    ASSERT_EQ(3u, stream.num_arrays());
+    EXPECT_EQ(n * sizeof(Point), stream.array_size(1));
+    EXPECT_EQ(n * sizeof(Vector), stream.array_size(2));
+  }
+
+  auto actual = readObject<Field>(filename);
+  ASSERT_TRUE(actual != nullptr);
+  ASSERT_EQ(n, actual->vmesh()->num_nodes());
+  for (VMesh::index_type i = 0; i < n; ++i)
+  {
+    Point p;
+    actual->vmesh()->get_point(p, VMesh::Node::index_type(i));
+    ASSERT_EQ(Point(i, 0.5 * i, -0.25 * i), p);
+    Vector v;
+    actual->vfield()->get_value(v, i);
+    ASSERT_EQ(Vector(i, 1, -i), v);
+  }
+  boost::filesystem::remove(filename);
+}
+
+TEST(ChunkedPiostreamTests, TensorVectorsKeepTheirDecompositions)
+{
+  auto filename = tempFile("tensors.bin");
+  std::vector<Tensor> expected;
+  for (int i = 0; i < 2000; ++i)
+    expected.push_back(Tensor(i, 0.5, 0, 2, 0, 1));
+  // Deliberately not the decomposition of the components.
+  expected[7].set_outside_eigens(Vector(1, 0, 0), Vector(0, 1, 0), Vector(0, 0, 1), 7, 8, 9);
+  {
+    ChunkedPiostream stream(filename.string(), Piostream::Write);
+    Pio(stream, expected);
+    ASSERT_FALSE(stream.error());
+  }
+
+  std::vector<Tensor> actual;
+  {
+    ChunkedPiostream stream(filename.string(), Piostream::Read);
+    ASSERT_EQ(2u, stream.num_arrays());
+    EXPECT_EQ(expected.size() * 6 * sizeof(double), stream.array_size(1));
+    Pio(stream, actual);
+    ASSERT_FALSE(stream.error());
+  }
+  EXPECT_EQ(expected, actual);
+  double l1, l2, l3;
+  actual[7].get_eigenvalues(l1, l2, l3);
+  EXPECT_EQ(7, l1);
+  EXPECT_EQ(8, l2);
+  EXPECT_EQ(9, l3);
+  boost::filesystem::remove(filename);
+}
+
+TEST(ChunkedPiostreamTests, PointVectorsKeepTheBinaryFormat)
+{
+  std::vector<Point> points;
+  for (int i = 0; i < 1000; ++i)
+    points.push_back(Point(i, -i, 0.5 * i));
+
+  auto blocked = tempFile("blocked.pts");
+  auto elementwise = tempFile("elementwise.pts");
+  {
+    BinaryPiostream stream(blocked.string(), Piostream::Write);
+    Pio(stream, points);
+  }
+  {
+    BinaryPiostream stream(elementwise.string(), Piostream::Write);
+    SCIRun::Pio<Point>(stream, points);
+  }
+  EXPECT_EQ(fileContents(elementwise), fileContents(blocked));
+
+  std::vector<Point> actual;
+  {
+    BinaryPiostream stream(elementwise.string(), Piostream::Read);
+    Pio(stream, actual);
+    ASSERT_FALSE(stream.error());
+  }
+  EXPECT_EQ(points, actual);
+  boost::filesystem::remove(blocked);
+  boost::filesystem::remove(elementwise);
+}
+
+// Compares writing and reading a large field with the plain binary format,
+// the binary format piped through single stream gzip, and the chunked format.
+TEST(ChunkedPiostreamTests, DISABLED_BenchmarkAgainstBinaryAndGzip)
+{
+  typedef std::chrono::steady_clock Clock;
+  auto seconds = [](Clock::time_point start) { return std::chrono::duration<double>(Clock::now() - start).count(); };
+
+  FieldHandle field = CreateEmptyLatVol(200, 200, 200);
+  field->vfield()->resize_values();
+  for (VMesh::index_type i = 0; i < field->vfield()->num_values(); ++i)
+    field->vfield()->set_value(std::sin(0.001 * i), i);
+
+  auto binary = tempFile("bench_binary.fld");
+  auto gzipped = tempFile("bench_binary.fld.gz");
+  auto chunked = tempFile("bench_chunked.fld");
+
+  auto start = Clock::now();
+  writeObject(binary, "Binary", field);
+  std::cout << "Binary write:  " << seconds(start) << " s, " << boost::filesystem::file_size(binary) << " bytes" << std::endl;
+
+  start = Clock::now();
+  {
+    std::vector<char> buffer(1 << 20);
+    FILE* in = fopen(binary.string().c_str(), "rb");
+    gzFile out = gzopen(gzipped.string().c_str(), "wb");
+    size_t n;
+    while ((n = fread(&buffer[0], 1, buffer.size(), in)) > 0)
+      gzwrite(out, &buffer[0], static_cast<unsigned>(n));
+    gzclose(out);
+    fclose(in);
+  }
+  std::cout << "Gzip write:    " << seconds(start) << " s (on top of binary), " << boost::filesystem::file_size(gzipped) << " bytes" << std::endl;
+
+  start = Clock::now();
+  writeObject(chunked, "Chunked", field);
+  std::cout << "Chunked write: " << seconds(start) << " s, " << boost::filesystem::file_size(chunked) << " bytes" << std::endl;
+
+  start = Clock::now();
+  EXPECT_TRUE(readObject<Field>(binary) != nullptr);
+  std::cout << "Binary read:   " << seconds(start) << " s" << std::endl;
+
+  start = Clock::now();
+  {
+    std::vector<char> buffer(1 << 20);
+    gzFile in = gzopen(gzipped.string().c_str(), "rb");
+    size_t total = 0;
+    int n;
+    while ((n = gzread(in, &buffer[0], static_cast<unsigned>(buffer.size()))) > 0)
+      total += n;
+    gzclose(in);
+    EXPECT_EQ(boost::filesystem::file_size(binary), total);
+  }
+  std::cout << "Gzip inflate:  " << seconds(start) << " s (before parsing)" << std::endl;
+
+  start = Clock::now();
+  EXPECT_TRUE(readObject<Field>(chunked) != nullptr);
+  std::cout << "Chunked read:  " << seconds(start) << " s" << std::endl;
+
+  boost::filesystem::remove(binary);
+  boost::filesystem::remove(gzipped);
+  boost::filesystem::remove(chunked);
+}
@@ -0,0 +1,214 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Core/Algorithms/DataIO/ReadHDF5Dataset.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Datatypes/Legacy/Nrrd/NrrdData.h>
+#include <boost/filesystem.hpp>
+#include <hdf5.h>
+
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::DataIO;
+
+namespace
+{
+  const hsize_t STEPS = 10;
+  const hsize_t ROWS = 4;
+  const hsize_t COLS = 3;
+
+  double value(size_t step, size_t index)
+  {
+    return 100.0 * step + index - 5;
+  }
+
+  /// Write a time series of short values in chunks of three time steps, and
+  /// the same values as an unchunked float dataset.
+  boost::filesystem::path writeFile()
+  {
+    auto dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("hdf5-%%%%-%%%%");
+    boost::filesystem::create_directories(dir);
+    auto filename = dir / "series.h5";
+
+    std::vector<short> shorts;
+    std::vector<float> floats;
+    for (size_t s = 0; s < STEPS; ++s)
+    {
+      for (size_t i = 0; i < ROWS * COLS; ++i)
+      {
+        shorts.push_back(static_cast<short>(value(s, i)));
+        floats.push_back(static_cast<float>(value(s, i)));
+      }
+    }
+
+    const hsize_t dims[] = { STEPS, ROWS, COLS };
+    const hsize_t chunk[] = { 3, ROWS, COLS };
+    hid_t file = H5Fcreate(filename.string().c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    hid_t group = H5Gcreate2(file, "/series", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    hid_t space = H5Screate_simple(3, dims, nullptr);
+
+    hid_t plist = H5Pcreate(H5P_DATASET_CREATE);
+    H5Pset_chunk(plist, 3, chunk);
+    H5Pset_deflate(plist, 6);
+    hid_t chunked = H5Dcreate2(group, "chunked", H5T_STD_I16BE, space, H5P_DEFAULT, plist, H5P_DEFAULT);
+    H5Dwrite(chunked, H5T_NATIVE_SHORT, H5S_ALL, H5S_ALL, H5P_DEFAULT, &shorts[0]);
+    hid_t contiguous = H5Dcreate2(group, "contiguous", H5T_IEEE_F32LE, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    H5Dwrite(contiguous, H5T_NATIVE_FLOAT, H5S_ALL, H5S_ALL, H5P_DEFAULT, &floats[0]);
+
+    H5Dclose(contiguous);
+    H5Dclose(chunked);
+    H5Pclose(plist);
+    H5Sclose(space);
+    H5Gclose(group);
+    H5Fclose(file);
+    return filename;
+  }
+}
+
+TEST(ReadHDF5DatasetTests, ReadsChunkedDatasetSliceBySlice)
+{
+  auto filename = writeFile();
+  ReadHDF5DatasetAlgo reader;
+  ASSERT_TRUE(reader.open(filename.string(), "/series/chunked"));
+  ASSERT_EQ(3u, reader.dimensions().size());
+  EXPECT_EQ(STEPS, reader.numSlices());
+  EXPECT_EQ(ROWS * COLS, reader.sliceSize());
+  EXPECT_EQ(3u, reader.blockSlices());
+
+  std::vector<size_t> slices;
+  reader.readSlices(0, STEPS, [&](size_t slice, const double* values)
+  {
+    slices.push_back(slice);
+    for (size_t i = 0; i < ROWS * COLS; ++i)
+      ASSERT_EQ(value(slice, i), values[i]);
+  });
+  ASSERT_EQ(STEPS, slices.size());
+  for (size_t s = 0; s < STEPS; ++s)
+    EXPECT_EQ(s, slices[s]);
+  reader.close();
+  boost::filesystem::remove_all(filename.parent_path());
+}
+
+TEST(ReadHDF5DatasetTests, ReadsRangesThatDoNotStartAtAChunk)
+{
+  auto filename = writeFile();
+  ReadHDF5DatasetAlgo reader;
+  ASSERT_TRUE(reader.open(filename.string(), "/series/chunked"));
+
+  std::vector<size_t> slices;
+  reader.readSlices(2, 6, [&](size_t slice, const double* values)
+  {
+    slices.push_back(slice);
+    EXPECT_EQ(value(slice, 0), values[0]);
+    EXPECT_EQ(value(slice, ROWS * COLS - 1), values[ROWS * COLS - 1]);
+  });
+  ASSERT_EQ(6u, slices.size());
+  EXPECT_EQ(2u, slices.front());
+  EXPECT_EQ(7u, slices.back());
+
+  EXPECT_THROW(reader.readSlices(8, 3, [](size_t, const double*) {}), AlgorithmInputException);
+  reader.close();
+  boost::filesystem::remove_all(filename.parent_path());
+}
+
+TEST(ReadHDF5DatasetTests, ReadsContiguousDatasetAsMatrix)
+{
+  auto filename = writeFile();
+  ReadHDF5DatasetAlgo reader;
+  ASSERT_TRUE(reader.open(filename.string(), "/series/contiguous"));
+  EXPECT_EQ(STEPS, reader.blockSlices());
+
+  auto matrix = reader.readMatrix();
+  ASSERT_EQ(STEPS, matrix->nrows());
+  ASSERT_EQ(ROWS * COLS, matrix->ncols());
+  for (size_t s = 0; s < STEPS; ++s)
+    for (size_t i = 0; i < ROWS * COLS; ++i)
+      EXPECT_EQ(value(s, i), (*matrix)(s, i));
+  reader.close();
+  boost::filesystem::remove_all(filename.parent_path());
+}
+
+TEST(ReadHDF5DatasetTests, ReadsSliceRangeAsNrrd)
+{
+  auto filename = writeFile();
+  ReadHDF5DatasetAlgo reader;
+  ASSERT_TRUE(reader.open(filename.string(), "/series/chunked"));
+
+  auto nrrd = reader.readNrrd(4, 5);
+  ASSERT_TRUE(nrrd != nullptr);
+  const Nrrd* n = nrrd->getNrrd();
+  ASSERT_EQ(3u, n->dim);
+  EXPECT_EQ(COLS, n->axis[0].size);
+  EXPECT_EQ(ROWS, n->axis[1].size);
+  EXPECT_EQ(5u, n->axis[2].size);
+  ASSERT_EQ(nrrdTypeDouble, n->type);
+  const double* values = static_cast<const double*>(n->data);
+  for (size_t s = 0; s < 5; ++s)
+    for (size_t i = 0; i < ROWS * COLS; ++i)
+      EXPECT_EQ(value(s + 4, i), values[s * ROWS * COLS + i]);
+
+  EXPECT_THROW(reader.readNrrd(6, 5), AlgorithmInputException);
+  reader.close();
+  boost::filesystem::remove_all(filename.parent_path());
+}
+
+TEST(ReadHDF5DatasetTests, StopsReadingWhenTheHandlerThrows)
+{
+  auto filename = writeFile();
+  ReadHDF5DatasetAlgo reader;
+  ASSERT_TRUE(reader.open(filename.string(), "/series/chunked"));
+
+  size_t handled = 0;
+  EXPECT_THROW(reader.readSlices(0, STEPS, [&](size_t slice, const double*)
+  {
+    ++handled;
+    if (slice == 4)
+      throw std::runtime_error("stop");
+  }), std::runtime_error);
+  EXPECT_EQ(5u, handled);
+
+  // The reader is usable afterwards.
+  auto matrix = reader.readMatrix();
+  EXPECT_EQ(value(STEPS - 1, 0), (*matrix)(STEPS - 1, 0));
+  reader.close();
+  boost::filesystem::remove_all(filename.parent_path());
+}
+
+TEST(ReadHDF5DatasetTests, FailsForMissingFileOrDataset)
+{
+  auto filename = writeFile();
+  ReadHDF5DatasetAlgo reader;
+  EXPECT_FALSE(reader.open((filename.parent_path() / "missing.h5").string(), "/series/chunked"));
+  EXPECT_FALSE(reader.open(filename.string(), "/series/missing"));
+  EXPECT_EQ(0u, reader.numSlices());
+  EXPECT_THROW(reader.readMatrix(), AlgorithmInputException);
+  reader.close();
+  boost::filesystem::remove_all(filename.parent_path());
+}
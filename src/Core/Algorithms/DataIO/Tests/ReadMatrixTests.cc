@@ -336,3 +336,24 @@ TEST(ReadMatrixAlgorithmTest, CallLegacyPioSparse)
 {
   CallLegacyPio(TestResources::rootDir() / "Matrices" / "eye3x3sparse_bin.mat");
 }
+
+TEST(ReadMatrixAlgorithmTest, BinaryPioRoundTrip)
+{
+  auto filename = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%-binary.mat");
+
+  DenseMatrix expected(50, 40);
+  for (int i = 0; i < expected.rows(); ++i)
+    for (int j = 0; j < expected.cols(); ++j)
+      expected(i, j) = i * 0.5 - j;
+
+  {
+    PiostreamPtr stream = auto_ostream(filename.string(), "Binary");
+    ASSERT_TRUE(stream != nullptr);
+    MatrixHandle matrix(new DenseMatrix(expected));
+    Pio(*stream, matrix);
+    ASSERT_FALSE(stream->error());
+  }
+
+  CallLegacyPio(filename, expected);
+  boost::filesystem::remove(filename);
+}
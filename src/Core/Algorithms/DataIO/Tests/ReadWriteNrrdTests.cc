@@ -30,16 +30,38 @@
 #include <Core/IEPlugin/NrrdField_Plugin.h>
 #include <Core/Datatypes/Legacy/Field/Field.h>
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Nrrd/NrrdData.h>
+#include <Core/Algorithms/Legacy/Converter/ConverterAlgo.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
+#include <chrono>
 
 using namespace SCIRun;
 using namespace SCIRun::Core;
 using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Geometry;
 using namespace SCIRun::TestUtils;
 
 namespace
 {
   boost::filesystem::path testNrrd = TestResources::rootDir() / "ToolKits" / "FwdInvToolbox" / "pot_based_FEM_forward" / "Segmentation.nrrd";
   boost::filesystem::path testNrrdHeader = TestResources::rootDir() / "Fields" / "nrrd" / "fieldOut.nhdr";
+
+  FieldHandle rampLatVol(int size, data_info_type type)
+  {
+    FieldHandle field = CreateEmptyLatVol(size, size + 1, size + 2, type);
+    VField* vfield = field->vfield();
+    vfield->resize_values();
+    for (VMesh::index_type i = 0; i < vfield->num_values(); ++i)
+    {
+      if (type == VECTOR_E)
+        vfield->set_value(Vector(i, -i, 0.5 * i), i);
+      else
+        vfield->set_value(static_cast<double>(i % 100), i);
+    }
+    return field;
+  }
 }
 
 TEST(ReadNrrdTests, CanReadFullNrrdFile)
@@ -126,4 +148,84 @@ TEST(WriteNrrdTests, CanWriteNrrdFileHeader)
 
   boost::filesystem::path out(TestResources::rootDir() / "TransientOutput" / "fieldOutUnitHeader.nhdr");
   ASSERT_TRUE(FieldToNrrd_writer(nullptr, field, out.string().c_str()));
-}
\ No newline at end of file
+}
+TEST(ConvertNrrdTests, ScalarFieldRoundTripWithCopiedAndSharedData)
+{
+  ConverterAlgo algo(nullptr);
+  FieldHandle field = rampLatVol(10, FLOAT_E);
+
+  for (bool share : { false, true })
+  {
+    NrrdDataHandle nrrd;
+    ASSERT_TRUE(algo.fieldToNrrd(field, nrrd, share));
+    ASSERT_EQ(nrrdTypeFloat, nrrd->getNrrd()->type);
+    EXPECT_EQ(share, nrrd->getNrrd()->data == field->vfield()->get_values_pointer());
+
+    FieldHandle back;
+    ASSERT_TRUE(algo.nrrdToField(nrrd, back));
+    ASSERT_EQ(field->vfield()->num_values(), back->vfield()->num_values());
+    std::vector<float> expected, actual;
+    field->vfield()->get_values(expected);
+    back->vfield()->get_values(actual);
+    EXPECT_EQ(expected, actual);
+  }
+}
+
+TEST(ConvertNrrdTests, SharedNrrdKeepsFieldAlive)
+{
+  ConverterAlgo algo(nullptr);
+  NrrdDataHandle nrrd;
+  {
+    FieldHandle field = rampLatVol(4, DOUBLE_E);
+    ASSERT_TRUE(algo.fieldToNrrd(field, nrrd, true));
+  }
+  const double* data = static_cast<const double*>(nrrd->getNrrd()->data);
+  ASSERT_TRUE(data != nullptr);
+  EXPECT_EQ(99.0, data[99]);
+}
+
+TEST(ConvertNrrdTests, VectorFieldRoundTrip)
+{
+  ConverterAlgo algo(nullptr);
+  FieldHandle field = rampLatVol(6, VECTOR_E);
+
+  NrrdDataHandle nrrd;
+  ASSERT_TRUE(algo.fieldToNrrd(field, nrrd));
+  const double* data = static_cast<const double*>(nrrd->getNrrd()->data);
+  EXPECT_EQ(7.0, data[21]);
+  EXPECT_EQ(-7.0, data[22]);
+
+  FieldHandle back;
+  ASSERT_TRUE(algo.nrrdToField(nrrd, back));
+  ASSERT_EQ(field->vfield()->num_values(), back->vfield()->num_values());
+  for (VMesh::index_type i = 0; i < back->vfield()->num_values(); ++i)
+  {
+    Vector v;
+    back->vfield()->get_value(v, i);
+    EXPECT_EQ(Vector(i, -i, 0.5 * i), v);
+  }
+}
+
+TEST(ConvertNrrdTests, DISABLED_LargeVolumeConversionTiming)
+{
+  typedef std::chrono::steady_clock Clock;
+  auto seconds = [](Clock::time_point start) { return std::chrono::duration<double>(Clock::now() - start).count(); };
+
+  ConverterAlgo algo(nullptr);
+  FieldHandle field = rampLatVol(510, DOUBLE_E);
+
+  auto start = Clock::now();
+  NrrdDataHandle nrrd;
+  ASSERT_TRUE(algo.fieldToNrrd(field, nrrd));
+  std::cout << "FieldToNrrd copy:   " << seconds(start) << " s" << std::endl;
+
+  start = Clock::now();
+  NrrdDataHandle shared;
+  ASSERT_TRUE(algo.fieldToNrrd(field, shared, true));
+  std::cout << "FieldToNrrd shared: " << seconds(start) << " s" << std::endl;
+
+  start = Clock::now();
+  FieldHandle back;
+  ASSERT_TRUE(algo.nrrdToField(nrrd, back));
+  std::cout << "NrrdToField:        " << seconds(start) << " s" << std::endl;
+}
@@ -0,0 +1,204 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Core/Algorithms/DataIO/StreamMatrix.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Datatypes/SparseRowMatrix.h>
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <fstream>
+
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::DataIO;
+
+namespace
+{
+  const int ROWS = 7;
+  const int COLS = 250;
+
+  double value(int r, int c)
+  {
+    return 1000.0 * c + r;
+  }
+
+  /// Write a float matrix with one contiguous column after another.
+  boost::filesystem::path writeNrrd(bool bigEndian, bool attached)
+  {
+    auto dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("stream-%%%%-%%%%");
+    boost::filesystem::create_directories(dir);
+    auto header = dir / (attached ? "matrix.nrrd" : "matrix.nhdr");
+
+    std::ofstream out(header.string().c_str(), std::ios::binary);
+    out << "NRRD0004\n# test data\ntype: float\ndimension: 2\nsizes: " << ROWS << " " << COLS
+        << "\nspacings: 1 0.5\nendian: " << (bigEndian ? "big" : "little") << "\nencoding: raw\n";
+    if (!attached)
+    {
+      out << "data file: matrix.raw\n";
+      out.close();
+      out.open((dir / "matrix.raw").string().c_str(), std::ios::binary);
+    }
+    else
+      out << "\n";
+
+    for (int c = 0; c < COLS; ++c)
+    {
+      for (int r = 0; r < ROWS; ++r)
+      {
+        float v = static_cast<float>(value(r, c));
+        char bytes[sizeof(float)];
+        memcpy(bytes, &v, sizeof(float));
+        const unsigned short one = 1;
+        const bool little = *reinterpret_cast<const unsigned char*>(&one) == 1;
+        if (little == bigEndian)
+          std::reverse(bytes, bytes + sizeof(float));
+        out.write(bytes, sizeof(float));
+      }
+    }
+    return header;
+  }
+}
+
+TEST(StreamMatrixTests, PlaysColumnsForwardAndBackward)
+{
+  auto filename = writeNrrd(false, false);
+  StreamMatrixAlgo stream;
+  ASSERT_TRUE(stream.open(filename.string()));
+  EXPECT_EQ(ROWS, stream.numRows());
+  EXPECT_EQ(COLS, stream.numCols());
+  EXPECT_EQ(0.5, stream.colSpacing());
+
+  stream.setBlockSize(8);
+  stream.setWindowSize(4);
+
+  for (int c = 0; c < COLS; ++c)
+  {
+    auto column = stream.getColumns(std::vector<int>(1, c));
+    ASSERT_EQ(ROWS, column->rows());
+    ASSERT_EQ(1, column->cols());
+    for (int r = 0; r < ROWS; ++r)
+      ASSERT_EQ(value(r, c), (*column)(r, 0));
+  }
+  for (int c = COLS - 1; c >= 0; c -= 3)
+  {
+    auto columns = stream.getColumns({ c, c / 2 });
+    ASSERT_EQ(value(3, c), (*columns)(3, 0));
+    ASSERT_EQ(value(3, c / 2), (*columns)(3, 1));
+  }
+
+  EXPECT_THROW(stream.getColumns(std::vector<int>(1, COLS)), AlgorithmInputException);
+  stream.close();
+  boost::filesystem::remove_all(filename.parent_path());
+}
+
+TEST(StreamMatrixTests, ServesReadAheadBlocksFromMemoryPastTheWindow)
+{
+  auto filename = writeNrrd(false, false);
+  StreamMatrixAlgo stream;
+  ASSERT_TRUE(stream.open(filename.string()));
+  stream.setBlockSize(8);
+  stream.setWindowSize(4);
+
+  // Play many more blocks than the window holds, one column per block
+  for (int c = 0; c < COLS; c += 8)
+  {
+    auto column = stream.getColumns(std::vector<int>(1, c));
+    ASSERT_EQ(value(0, c), (*column)(0, 0));
+    stream.waitForPrefetch();
+    // Only the very first block is read on this thread
+    ASSERT_EQ(1, stream.cacheMisses()) << "column " << c;
+  }
+  stream.close();
+  boost::filesystem::remove_all(filename.parent_path());
+}
+
+TEST(StreamMatrixTests, ChangesBlockSizeWhileReadingAhead)
+{
+  auto filename = writeNrrd(false, true);
+  StreamMatrixAlgo stream;
+  ASSERT_TRUE(stream.open(filename.string()));
+
+  const int sizes[] = { 8, 5, 13, 1, 64 };
+  for (int pass = 0; pass < 5; ++pass)
+  {
+    for (int c = 0; c < COLS; c += 2)
+    {
+      // Resize in the middle of playback, read ahead requests are still queued
+      if (c == 40)
+        stream.setBlockSize(sizes[pass]);
+      const int index = pass % 2 ? COLS - 1 - c : c;
+      auto column = stream.getColumns(std::vector<int>(1, index));
+      for (int r = 0; r < ROWS; ++r)
+        ASSERT_EQ(value(r, index), (*column)(r, 0));
+    }
+  }
+  stream.close();
+  boost::filesystem::remove_all(filename.parent_path());
+}
+
+TEST(StreamMatrixTests, ReadsRowsAndWeightedColumnsFromBigEndianAttachedData)
+{
+  auto filename = writeNrrd(true, true);
+  StreamMatrixAlgo stream;
+  ASSERT_TRUE(stream.open(filename.string()));
+  stream.setBlockSize(16);
+
+  auto rows = stream.getRows({ 6, 0 });
+  ASSERT_EQ(2, rows->rows());
+  ASSERT_EQ(COLS, rows->cols());
+  for (int c = 0; c < COLS; ++c)
+  {
+    ASSERT_EQ(value(6, c), (*rows)(0, c));
+    ASSERT_EQ(value(0, c), (*rows)(1, c));
+  }
+
+  // Interpolate half way between two neighboring columns
+  SparseRowMatrix weights(1, COLS);
+  weights.insert(0, 10) = 0.5;
+  weights.insert(0, 11) = 0.5;
+  weights.makeCompressed();
+  auto interpolated = stream.getWeightedColumns(weights);
+  ASSERT_EQ(1, interpolated->cols());
+  EXPECT_DOUBLE_EQ(0.5 * (value(2, 10) + value(2, 11)), (*interpolated)(2, 0));
+
+  stream.close();
+  boost::filesystem::remove_all(filename.parent_path());
+}
+
+TEST(StreamMatrixTests, RejectsMissingOrTruncatedData)
+{
+  auto filename = writeNrrd(false, false);
+  StreamMatrixAlgo stream;
+  EXPECT_FALSE(stream.open((filename.parent_path() / "nothing.nhdr").string()));
+
+  boost::filesystem::resize_file(filename.parent_path() / "matrix.raw", 100);
+  EXPECT_FALSE(stream.open(filename.string()));
+  boost::filesystem::remove_all(filename.parent_path());
+}
@@ -0,0 +1,230 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Core/Algorithms/DataIO/TextNumberParser.h>
+#include <Core/Algorithms/DataIO/EigenMatrixFromScirunAsciiFormatConverter.h>
+#include <Core/Algorithms/DataIO/ReadMatrix.h>
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Datatypes/MatrixIO.h>
+#include <Core/Datatypes/MatrixTypeConversions.h>
+#include <Core/Utils/Exception.h>
+#include <boost/filesystem.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Algorithms::DataIO;
+using namespace SCIRun::Core::Algorithms::DataIO::internal;
+
+namespace
+{
+  boost::filesystem::path tempFile(const std::string& name)
+  {
+    return boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%-" + name);
+  }
+
+  double parse(const std::string& str)
+  {
+    const char* p = str.c_str();
+    double value = 0;
+    EXPECT_TRUE(parseNumber(p, p + str.size(), value)) << str;
+    return value;
+  }
+
+  /// Write the same matrix as a plain text matrix and as a SCIRun ASCII matrix.
+  void writeMatrixFiles(int rows, int cols, const boost::filesystem::path& txt, const boost::filesystem::path& mat)
+  {
+    std::ofstream text(txt.string().c_str());
+    std::ofstream ascii(mat.string().c_str());
+    text.precision(17);
+    ascii.precision(17);
+    ascii << "SCI\nASC\n2\n{DenseMatrix 3 {Matrix 3 {PropertyManager 2 0 }\n}\n" << rows << " " << cols << " {0 ";
+    for (int i = 0; i < rows; ++i)
+    {
+      for (int j = 0; j < cols; ++j)
+      {
+        const double v = std::sin(0.001 * (i * cols + j)) * 1e3;
+        text << v << ' ';
+        ascii << v << ' ';
+      }
+      text << '\n';
+    }
+    ascii << "}}\n";
+  }
+}
+
+TEST(TextNumberParserTests, ParsesDoublesLikeStrtod)
+{
+  const char* numbers[] =
+  {
+    "0", "-0", "1", "+17", "-3.25", "0.1", ".5", "5.", "1e3", "1E-3", "-2.5e+10",
+    "3.141592653589793", "2.2250738585072014e-308", "1.7976931348623157e308",
+    "0.000000000000000000000000000001", "123456789012345678901234567890",
+    "9007199254740993", "4.9e-324", "1e23"
+  };
+  for (const char* str : numbers)
+    EXPECT_EQ(strtod(str, 0), parse(str)) << str;
+}
+
+TEST(TextNumberParserTests, ParsesNaNAndInfinity)
+{
+  EXPECT_TRUE(std::isnan(parse("NaN")));
+  EXPECT_TRUE(std::isnan(parse("nan")));
+  EXPECT_EQ(std::numeric_limits<double>::infinity(), parse("inf"));
+  EXPECT_EQ(-std::numeric_limits<double>::infinity(), parse("-inf"));
+}
+
+TEST(TextNumberParserTests, StopsAtFirstNonNumber)
+{
+  const std::string str = "  1 2.5\t-3\n4e1 five 6";
+  std::vector<double> values;
+  const char* stop = parseNumbers(str.c_str(), str.c_str() + str.size(), values);
+  ASSERT_EQ(4u, values.size());
+  EXPECT_EQ(40.0, values[3]);
+  EXPECT_EQ('f', *stop);
+
+  std::vector<int> ints;
+  const std::string intStr = "1 -2 2147483647 2147483648";
+  stop = parseNumbers(intStr.c_str(), intStr.c_str() + intStr.size(), ints);
+  ASSERT_EQ(3u, ints.size());
+  EXPECT_EQ(2147483647, ints[2]);
+  EXPECT_EQ('2', *stop);
+}
+
+TEST(TextNumberParserTests, ParallelParsingKeepsFileOrder)
+{
+  std::string str;
+  for (int i = 0; i < 500000; ++i)
+    str += std::to_string(i) + (i % 10 == 9 ? "\n" : " ");
+
+  std::vector<int> values;
+  ASSERT_TRUE(parseNumbersInParallel(str.c_str(), str.c_str() + str.size(), values));
+  ASSERT_EQ(500000u, values.size());
+  for (int i = 0; i < 500000; ++i)
+    ASSERT_EQ(i, values[i]);
+
+  str += "x";
+  values.clear();
+  EXPECT_FALSE(parseNumbersInParallel(str.c_str(), str.c_str() + str.size(), values));
+}
+
+TEST(TextNumberParserTests, ParsesTextMatrix)
+{
+  const std::string str = "# comment\n0 1 2\n3 4 5 % trailing\n\n6 7 NaN";
+  std::vector<double> values;
+  size_t rows = 0, cols = 0;
+  auto allocate = [&](size_t r, size_t c)
+  {
+    rows = r;
+    cols = c;
+    values.resize(r * c);
+    return values.data();
+  };
+  parseTextMatrix(str.c_str(), str.c_str() + str.size(), allocate);
+  EXPECT_EQ(3u, rows);
+  EXPECT_EQ(3u, cols);
+  ASSERT_EQ(9u, values.size());
+  EXPECT_EQ(5.0, values[5]);
+  EXPECT_TRUE(std::isnan(values[8]));
+
+  const std::string ragged = "0 1 2\n3 4\n";
+  EXPECT_THROW(parseTextMatrix(ragged.c_str(), ragged.c_str() + ragged.size(), allocate), SCIRun::Core::InvalidArgumentException);
+}
+
+// The text is large enough to be cut into several pieces on a multi-core
+// machine, so the parallel stitching is compared as well.
+TEST(TextNumberParserTests, StreamingParsersMatchTheOldReaders)
+{
+  auto txt = tempFile("matrix.txt");
+  auto mat = tempFile("matrix.mat");
+  writeMatrixFiles(300, 400, txt, mat);
+
+  DenseMatrix old;
+  {
+    std::ifstream reader(txt.string().c_str());
+    reader >> old;
+  }
+  ReadMatrixAlgorithm algo;
+  auto streamed = castMatrix::toDense(algo.run(txt.string()));
+  ASSERT_TRUE(streamed != nullptr);
+  EXPECT_EQ(old, *streamed);
+
+  EigenMatrixFromScirunAsciiFormatConverter conv;
+  auto raw = conv.convertRaw(conv.parseDenseMatrixString(conv.getMatrixContentsLine(conv.readFile(mat.string())).get()).get());
+  auto dense = conv.makeDense(mat.string());
+  ASSERT_TRUE(dense != nullptr);
+  ASSERT_EQ(raw.get<2>().size(), static_cast<size_t>(dense->size()));
+  EXPECT_TRUE(std::equal(raw.get<2>().begin(), raw.get<2>().end(), dense->data()));
+  EXPECT_EQ(*streamed, *dense);
+
+  boost::filesystem::remove(txt);
+  boost::filesystem::remove(mat);
+}
+
+// Compares the throughput of the streaming parser with the istream reader for
+// text matrices and the regular expression parser for SCIRun ASCII matrices.
+TEST(TextNumberParserTests, DISABLED_BenchmarkTextMatrixThroughput)
+{
+  typedef std::chrono::steady_clock Clock;
+  auto seconds = [](Clock::time_point start) { return std::chrono::duration<double>(Clock::now() - start).count(); };
+
+  auto txt = tempFile("bench_matrix.txt");
+  auto mat = tempFile("bench_matrix.mat");
+  writeMatrixFiles(2000, 1000, txt, mat);
+  const double txtMB = boost::filesystem::file_size(txt) / 1048576.0;
+  const double matMB = boost::filesystem::file_size(mat) / 1048576.0;
+
+  auto start = Clock::now();
+  DenseMatrix old;
+  {
+    std::ifstream reader(txt.string().c_str());
+    reader >> old;
+  }
+  std::cout << "istream .txt:   " << txtMB / seconds(start) << " MB/s" << std::endl;
+
+  start = Clock::now();
+  ReadMatrixAlgorithm algo;
+  auto streamed = algo.run(txt.string());
+  std::cout << "streaming .txt: " << txtMB / seconds(start) << " MB/s" << std::endl;
+
+  EigenMatrixFromScirunAsciiFormatConverter conv;
+  start = Clock::now();
+  auto raw = conv.convertRaw(conv.parseDenseMatrixString(conv.getMatrixContentsLine(conv.readFile(mat.string())).get()).get());
+  std::cout << "regex .mat:     " << matMB / seconds(start) << " MB/s" << std::endl;
+
+  start = Clock::now();
+  auto dense = conv.makeDense(mat.string());
+  std::cout << "streaming .mat: " << matMB / seconds(start) << " MB/s" << std::endl;
+
+  boost::filesystem::remove(txt);
+  boost::filesystem::remove(mat);
+}
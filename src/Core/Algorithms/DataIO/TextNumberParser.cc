@@ -0,0 +1,387 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Core/Algorithms/DataIO/TextNumberParser.h>
+#include <Core/Thread/Parallel.h>
+#include <Core/Utils/Exception.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <boost/cstdint.hpp>
+
+using namespace SCIRun::Core::Thread;
+using namespace SCIRun::Core::Algorithms::DataIO::internal;
+
+namespace
+{
+  /// Pieces smaller than this are not worth a thread.
+  const size_t MIN_PIECE_SIZE = 1 << 20;
+
+  /// Powers of ten that are exactly representable as a double.
+  const double POWERS_OF_TEN[] =
+  {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+
+  inline bool isSpace(char c)
+  {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+  }
+
+  inline bool isDigit(char c)
+  {
+    return c >= '0' && c <= '9';
+  }
+
+  inline const char* skipSpace(const char* p, const char* end)
+  {
+    while (p != end && isSpace(*p))
+      ++p;
+    return p;
+  }
+
+  /// Accumulate up to 19 significant digits, the remaining digits only shift
+  /// the exponent. Dropping a non-zero digit makes the result inexact.
+  inline void addDigit(int digit, bool fraction, boost::uint64_t& mantissa, int& digits, int& exponent, bool& exact)
+  {
+    if (digits < 19)
+    {
+      mantissa = mantissa * 10 + digit;
+      if (mantissa != 0)
+        ++digits;
+      if (fraction)
+        --exponent;
+    }
+    else
+    {
+      if (digit != 0)
+        exact = false;
+      if (!fraction)
+        ++exponent;
+    }
+  }
+
+  /// Cut [begin, end) into at most np pieces, every cut is placed right after
+  /// the next occurence of a separator so no token is split.
+  template <class IsSeparator>
+  std::vector<const char*> cutIntoPieces(const char* begin, const char* end, IsSeparator isSeparator)
+  {
+    const size_t size = end - begin;
+    size_t np = std::max<size_t>(1, Parallel::NumCores());
+    np = std::max<size_t>(1, std::min(np, size / MIN_PIECE_SIZE));
+
+    std::vector<const char*> cuts(1, begin);
+    for (size_t i = 1; i < np; ++i)
+    {
+      const char* cut = std::max(begin + size * i / np, cuts.back());
+      while (cut != end && !isSeparator(*cut))
+        ++cut;
+      if (cut != end)
+        ++cut;
+      if (cut != cuts.back() && cut != end)
+        cuts.push_back(cut);
+    }
+    cuts.push_back(end);
+    return cuts;
+  }
+
+  /// Concatenate the pieces in order, every piece is copied by its own thread.
+  template <class T>
+  void stitch(const std::vector<std::vector<T> >& pieces, std::vector<T>& values)
+  {
+    std::vector<size_t> offsets(pieces.size() + 1, values.size());
+    for (size_t i = 0; i < pieces.size(); ++i)
+      offsets[i + 1] = offsets[i] + pieces[i].size();
+    values.resize(offsets.back());
+
+    Parallel::RunTasks([&](int i)
+    {
+      std::copy(pieces[i].begin(), pieces[i].end(), values.begin() + offsets[i]);
+    }, static_cast<int>(pieces.size()));
+  }
+
+  template <class T>
+  const char* parseAll(const char* begin, const char* end, std::vector<T>& values)
+  {
+    const char* p = begin;
+    T value;
+    for (;;)
+    {
+      const char* q = p;
+      if (!parseNumber(q, end, value))
+        break;
+      values.push_back(value);
+      p = q;
+    }
+    return skipSpace(p, end);
+  }
+
+  template <class T>
+  bool parseAllInParallel(const char* begin, const char* end, std::vector<T>& values)
+  {
+    const std::vector<const char*> cuts = cutIntoPieces(begin, end, isSpace);
+    const int np = static_cast<int>(cuts.size()) - 1;
+    if (np == 1)
+      return parseAll(begin, end, values) == end;
+
+    std::vector<std::vector<T> > pieces(np);
+    std::vector<char> complete(np);
+    Parallel::RunTasks([&](int i)
+    {
+      complete[i] = parseAll(cuts[i], cuts[i + 1], pieces[i]) == cuts[i + 1];
+    }, np);
+
+    if (std::find(complete.begin(), complete.end(), 0) != complete.end())
+      return false;
+
+    stitch(pieces, values);
+    return true;
+  }
+
+  struct MatrixPiece
+  {
+    MatrixPiece() : rows(0), cols(0), consistent(true) {}
+    std::vector<double> values;
+    size_t rows;
+    size_t cols;
+    bool consistent;
+  };
+
+  void parseLines(const char* begin, const char* end, MatrixPiece& piece)
+  {
+    const char* line = begin;
+    while (line != end)
+    {
+      const char* lineEnd = static_cast<const char*>(memchr(line, '\n', end - line));
+      if (!lineEnd)
+        lineEnd = end;
+
+      const size_t before = piece.values.size();
+      parseAll(line, lineEnd, piece.values);
+      const size_t count = piece.values.size() - before;
+      if (count > 0)
+      {
+        if (piece.rows == 0)
+          piece.cols = count;
+        else if (count != piece.cols)
+          piece.consistent = false;
+        ++piece.rows;
+      }
+      line = lineEnd == end ? end : lineEnd + 1;
+    }
+  }
+}
+
+namespace SCIRun {
+namespace Core {
+namespace Algorithms {
+namespace DataIO {
+namespace internal
+{
+
+bool readTextFile(const std::string& filename, std::vector<char>& buffer)
+{
+  std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!file)
+    return false;
+
+  file.seekg(0, std::ios::end);
+  const std::streamoff size = file.tellg();
+  if (size < 0)
+    return false;
+  file.seekg(0, std::ios::beg);
+
+  buffer.resize(static_cast<size_t>(size) + 1);
+  if (size > 0 && !file.read(&buffer[0], size))
+    return false;
+  buffer[static_cast<size_t>(size)] = '\0';
+  return true;
+}
+
+bool parseNumber(const char*& p, const char* end, double& value)
+{
+  const char* s = skipSpace(p, end);
+  const char* start = s;
+  if (s == end)
+    return false;
+
+  bool negative = false;
+  if (*s == '-' || *s == '+')
+  {
+    negative = *s == '-';
+    ++s;
+  }
+
+  boost::uint64_t mantissa = 0;
+  int digits = 0;
+  int exponent = 0;
+  bool exact = true;
+  bool any = false;
+
+  for (; s != end && isDigit(*s); ++s)
+  {
+    addDigit(*s - '0', false, mantissa, digits, exponent, exact);
+    any = true;
+  }
+  if (s != end && *s == '.')
+  {
+    for (++s; s != end && isDigit(*s); ++s)
+    {
+      addDigit(*s - '0', true, mantissa, digits, exponent, exact);
+      any = true;
+    }
+  }
+  if (any && s != end && (*s == 'e' || *s == 'E'))
+  {
+    const char* e = s + 1;
+    bool negativeExponent = false;
+    if (e != end && (*e == '-' || *e == '+'))
+    {
+      negativeExponent = *e == '-';
+      ++e;
+    }
+    if (e != end && isDigit(*e))
+    {
+      int value10 = 0;
+      for (; e != end && isDigit(*e); ++e)
+      {
+        if (value10 < 100000)
+          value10 = value10 * 10 + (*e - '0');
+      }
+      exponent += negativeExponent ? -value10 : value10;
+      s = e;
+    }
+  }
+
+  // Clinger's fast path: an exact mantissa times an exact power of ten is
+  // correctly rounded by a single floating point operation.
+  if (any && exact && mantissa <= (boost::uint64_t(1) << 53) && exponent >= -22 && exponent <= 22)
+  {
+    double result = static_cast<double>(mantissa);
+    if (exponent < 0)
+      result /= POWERS_OF_TEN[-exponent];
+    else
+      result *= POWERS_OF_TEN[exponent];
+    value = negative ? -result : result;
+    p = s;
+    return true;
+  }
+
+  // Long mantissas, extreme exponents, NaN and infinity.
+  char* stop = 0;
+  const double result = strtod(start, &stop);
+  if (stop == start || stop > end)
+    return false;
+  value = result;
+  p = stop;
+  return true;
+}
+
+bool parseNumber(const char*& p, const char* end, int& value)
+{
+  const char* s = skipSpace(p, end);
+  if (s == end)
+    return false;
+
+  bool negative = false;
+  if (*s == '-' || *s == '+')
+  {
+    negative = *s == '-';
+    ++s;
+  }
+  if (s == end || !isDigit(*s))
+    return false;
+
+  const boost::int64_t limit = static_cast<boost::int64_t>(std::numeric_limits<int>::max()) + (negative ? 1 : 0);
+  boost::int64_t result = 0;
+  for (; s != end && isDigit(*s); ++s)
+  {
+    result = result * 10 + (*s - '0');
+    if (result > limit)
+      return false;
+  }
+  value = static_cast<int>(negative ? -result : result);
+  p = s;
+  return true;
+}
+
+const char* parseNumbers(const char* begin, const char* end, std::vector<double>& values)
+{
+  return parseAll(begin, end, values);
+}
+
+const char* parseNumbers(const char* begin, const char* end, std::vector<int>& values)
+{
+  return parseAll(begin, end, values);
+}
+
+bool parseNumbersInParallel(const char* begin, const char* end, std::vector<double>& values)
+{
+  return parseAllInParallel(begin, end, values);
+}
+
+bool parseNumbersInParallel(const char* begin, const char* end, std::vector<int>& values)
+{
+  return parseAllInParallel(begin, end, values);
+}
+
+void parseTextMatrix(const char* begin, const char* end, const std::function<double*(size_t rows, size_t cols)>& allocate)
+{
+  const std::vector<const char*> cuts = cutIntoPieces(begin, end, [](char c) { return c == '\n'; });
+  const int np = static_cast<int>(cuts.size()) - 1;
+
+  std::vector<MatrixPiece> pieces(np);
+  Parallel::RunTasks([&](int i) { parseLines(cuts[i], cuts[i + 1], pieces[i]); }, np);
+
+  size_t rows = 0;
+  size_t cols = 0;
+  std::vector<size_t> offsets(np + 1, 0);
+  for (int i = 0; i < np; ++i)
+  {
+    const MatrixPiece& piece = pieces[i];
+    offsets[i + 1] = offsets[i] + piece.values.size();
+    if (piece.rows == 0)
+      continue;
+    if (!piece.consistent || (rows > 0 && piece.cols != cols))
+      THROW_INVALID_ARGUMENT("Improper format of matrix text stream: not every line contains the same amount of numbers.");
+    cols = piece.cols;
+    rows += piece.rows;
+  }
+
+  double* data = allocate(rows, cols);
+  Parallel::RunTasks([&](int i)
+  {
+    std::copy(pieces[i].values.begin(), pieces[i].values.end(), data + offsets[i]);
+    std::vector<double>().swap(pieces[i].values);
+  }, np);
+}
+
+}}}}}
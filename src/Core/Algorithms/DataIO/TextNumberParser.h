@@ -0,0 +1,77 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef ALGORITHMS_DATAIO_TEXTNUMBERPARSER_H
+#define ALGORITHMS_DATAIO_TEXTNUMBERPARSER_H
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <Core/Algorithms/DataIO/share.h>
+
+namespace SCIRun {
+namespace Core {
+namespace Algorithms {
+namespace DataIO {
+namespace internal
+{
+  /// Allocation free number parsing for large text files. The file is read
+  /// into one buffer, which is cut at white space into one piece per core.
+  /// Every piece is parsed into its own array and the pieces are stitched
+  /// together in file order.
+
+  /// Read a whole file, the buffer is terminated by an extra '\0'.
+  SCISHARE bool readTextFile(const std::string& filename, std::vector<char>& buffer);
+
+  /// Parse a single number at p, leading white space is skipped. On success p
+  /// points past the number. The text has to be followed by a '\0' or any
+  /// other character that cannot continue a number.
+  SCISHARE bool parseNumber(const char*& p, const char* end, double& value);
+  SCISHARE bool parseNumber(const char*& p, const char* end, int& value);
+
+  /// Parse white space separated numbers until end or the first character that
+  /// does not belong to a number, the position of which is returned.
+  SCISHARE const char* parseNumbers(const char* begin, const char* end, std::vector<double>& values);
+  SCISHARE const char* parseNumbers(const char* begin, const char* end, std::vector<int>& values);
+
+  /// Parse a range that only contains numbers and white space in parallel.
+  /// Returns false if the range contains anything else.
+  SCISHARE bool parseNumbersInParallel(const char* begin, const char* end, std::vector<double>& values);
+  SCISHARE bool parseNumbersInParallel(const char* begin, const char* end, std::vector<int>& values);
+
+  /// Parse a matrix with one row per line. Lines that do not start with a
+  /// number are skipped and a row ends at the first entry that is not a
+  /// number. Throws if the rows do not have the same length. Once all lines
+  /// are parsed, allocate is called with the matrix size and has to return row
+  /// major storage for it, every piece is then copied to its row offset.
+  /// [begin, end) is not accessed after allocate is called.
+  SCISHARE void parseTextMatrix(const char* begin, const char* end, const std::function<double*(size_t rows, size_t cols)>& allocate);
+
+}}}}}
+
+#endif
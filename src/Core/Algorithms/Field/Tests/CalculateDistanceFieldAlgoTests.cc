@@ -0,0 +1,225 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Core/Algorithms/Legacy/Fields/DistanceField/CalculateDistanceField.h>
+#include <Core/Algorithms/Legacy/Fields/DistanceField/CalculateSignedDistanceField.h>
+#include <Core/Algorithms/Legacy/Fields/DistanceField/RegularGridDistanceTransform.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
+#include <algorithm>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::TestUtils;
+
+namespace
+{
+  // Grid nodes deliberately do not line up with the faces of the unit cube [0,1]x[0,1]x[-1,0]
+  FieldHandle grid()
+  {
+    return CreateEmptyLatVol(23, 21, 25, DOUBLE_E, Point(-0.73, -0.61, -1.52), Point(1.47, 1.39, 0.61));
+  }
+
+  const double maxSpacing = 2.2/22.0;
+
+  /// Append a latitude/longitude triangulated sphere to a TriSurf field
+  void addSphere(FieldHandle field, int nlat, int nlon, double radius, const Point& center)
+  {
+    auto mesh = field->vmesh();
+    const VMesh::index_type first = mesh->num_nodes();
+    auto node = [=](int a, int b) { return first + 1 + (a-1)*nlon + (b % nlon); };
+    const VMesh::index_type south = first + 1 + (nlat-1)*nlon;
+
+    mesh->add_point(center + Vector(0, 0, radius));
+    for (int a = 1; a < nlat; a++)
+      for (int b = 0; b < nlon; b++)
+      {
+        const double theta = M_PI*a/nlat, phi = 2.0*M_PI*b/nlon;
+        mesh->add_point(center + radius*Vector(sin(theta)*cos(phi), sin(theta)*sin(phi), cos(theta)));
+      }
+    mesh->add_point(center - Vector(0, 0, radius));
+
+    VMesh::Node::array_type nodes(3);
+    for (int b = 0; b < nlon; b++)
+    {
+      nodes[0] = first; nodes[1] = node(1, b); nodes[2] = node(1, b+1);
+      mesh->add_elem(nodes);
+      nodes[0] = south; nodes[1] = node(nlat-1, b+1); nodes[2] = node(nlat-1, b);
+      mesh->add_elem(nodes);
+    }
+    for (int a = 1; a < nlat-1; a++)
+      for (int b = 0; b < nlon; b++)
+      {
+        nodes[0] = node(a, b); nodes[1] = node(a+1, b); nodes[2] = node(a+1, b+1);
+        mesh->add_elem(nodes);
+        nodes[0] = node(a, b); nodes[1] = node(a+1, b+1); nodes[2] = node(a, b+1);
+        mesh->add_elem(nodes);
+      }
+    field->vfield()->resize_values();
+  }
+
+  FieldHandle emptyTriSurf()
+  {
+    FieldInformation fi("TriSurfMesh", LINEARDATA_E, "double");
+    return CreateField(fi);
+  }
+
+  void compareWithClosestElementSearch(FieldHandle object, FieldHandle input, double tolerance)
+  {
+    CalculateDistanceFieldAlgo algo;
+    FieldHandle exact, fast;
+    ASSERT_TRUE(algo.runImpl(input, object, exact));
+
+    algo.set(Parameters::UseDistanceTransform, true);
+    ASSERT_TRUE(algo.runImpl(input, object, fast));
+
+    ASSERT_EQ(exact->vfield()->num_values(), fast->vfield()->num_values());
+    double maxError = 0.0;
+    for (VMesh::index_type idx = 0; idx < exact->vfield()->num_values(); ++idx)
+    {
+      double e, f;
+      exact->vfield()->get_value(e, idx);
+      fast->vfield()->get_value(f, idx);
+      // Every value is a distance to some element, it can never be too small
+      EXPECT_GE(f, e - 1e-10);
+      maxError = std::max(maxError, f - e);
+    }
+    // The transform is an approximation, this is the bound it is held to
+    EXPECT_LE(maxError, tolerance);
+  }
+}
+
+TEST(CalculateDistanceFieldAlgoTests, DistanceTransformMatchesClosestElementSearch)
+{
+  compareWithClosestElementSearch(CubeTriSurfLinearBasis(DOUBLE_E), grid(), 1e-10);
+}
+
+TEST(CalculateDistanceFieldAlgoTests, DistanceTransformIsExactForSphere)
+{
+  auto object = emptyTriSurf();
+  addSphere(object, 12, 24, 0.8, Point(0.1, 0.2, -0.3));
+  compareWithClosestElementSearch(object, grid(), 1e-10);
+}
+
+TEST(CalculateDistanceFieldAlgoTests, DistanceTransformForSeparateSurfaces)
+{
+  // Samples between the spheres are almost equally far from two of them
+  auto object = emptyTriSurf();
+  addSphere(object, 10, 20, 0.4, Point(-0.3, -0.2, -0.9));
+  addSphere(object, 14, 17, 0.5, Point(0.6, 0.5, -0.1));
+  addSphere(object, 5, 7, 0.2, Point(0.9, -0.5, -1.2));
+  compareWithClosestElementSearch(object, grid(), 1e-3*maxSpacing);
+}
+
+TEST(CalculateDistanceFieldAlgoTests, DistanceTransformForNestedSpheres)
+{
+  // Every sample between the spheres is close to their medial surface
+  auto object = emptyTriSurf();
+  addSphere(object, 16, 32, 1.0, Point(0.35, 0.4, -0.45));
+  addSphere(object, 8, 11, 0.3, Point(0.5, 0.3, -0.6));
+  compareWithClosestElementSearch(object, grid(), 1e-3*maxSpacing);
+}
+
+TEST(CalculateDistanceFieldAlgoTests, DistanceTransformErrorForDisconnectedTriangles)
+{
+  // Walking over shared nodes cannot reach a closer triangle here, this is
+  // where the transform is furthest from the closest element search
+  for (unsigned int seed = 1; seed <= 3; seed++)
+  {
+    unsigned int state = seed;
+    auto random = [&state](double lo, double hi)
+    {
+      state = state*1664525u + 1013904223u;
+      return lo + (hi - lo)*(state/4294967296.0);
+    };
+
+    auto object = emptyTriSurf();
+    VMesh::Node::array_type nodes(3);
+    for (int t = 0; t < 400; t++)
+    {
+      const Point c(random(-0.5, 1.2), random(-0.5, 1.2), random(-1.5, 0.2));
+      for (int r = 0; r < 3; r++)
+        nodes[r] = object->vmesh()->add_point(c + Vector(random(-0.15, 0.15), random(-0.15, 0.15), random(-0.15, 0.15)));
+      object->vmesh()->add_elem(nodes);
+    }
+    object->vfield()->resize_values();
+    compareWithClosestElementSearch(object, grid(), 0.5*maxSpacing);
+  }
+}
+
+TEST(CalculateDistanceFieldAlgoTests, DistanceTransformHonorsTruncation)
+{
+  auto object = CubeTriSurfLinearBasis(DOUBLE_E);
+  auto input = grid();
+
+  CalculateDistanceFieldAlgo algo;
+  algo.set(Parameters::UseDistanceTransform, true);
+  algo.set(Parameters::Truncate, true);
+  algo.set(Parameters::TruncateDistance, 0.2);
+  FieldHandle fast;
+  ASSERT_TRUE(algo.runImpl(input, object, fast));
+
+  double max;
+  fast->vfield()->max(max);
+  EXPECT_DOUBLE_EQ(0.2, max);
+}
+
+TEST(CalculateDistanceFieldAlgoTests, DistanceTransformSignFromScanConversion)
+{
+  auto object = CubeTriSurfLinearBasis(DOUBLE_E);
+  auto input = grid();
+
+  CalculateSignedDistanceFieldAlgo algo;
+  algo.set(Parameters::UseDistanceTransform, true);
+  FieldHandle fast;
+  ASSERT_TRUE(algo.run(input, object, fast));
+
+  auto mesh = input->vmesh();
+  for (VMesh::Node::index_type idx = 0; idx < mesh->num_nodes(); ++idx)
+  {
+    Point p;
+    mesh->get_center(p, idx);
+    const bool inside = p.x() > 0 && p.x() < 1 && p.y() > 0 && p.y() < 1 && p.z() > -1 && p.z() < 0;
+    double d;
+    fast->vfield()->get_value(d, idx);
+    EXPECT_EQ(inside, d < 0) << p;
+  }
+}
+
+TEST(CalculateDistanceFieldAlgoTests, DistanceTransformNeedsLatVol)
+{
+  auto object = CubeTriSurfLinearBasis(DOUBLE_E);
+  auto input = TetrahedronTetVolLinearBasis(DOUBLE_E);
+
+  RegularGridDistanceTransform edt(input->vmesh(), object->vmesh(), 1, nullptr);
+  EXPECT_FALSE(edt.is_supported());
+}
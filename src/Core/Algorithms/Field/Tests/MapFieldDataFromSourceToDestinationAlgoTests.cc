@@ -36,6 +36,7 @@
 #include <Core/Datatypes/DenseMatrix.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Testing/Utils/MatrixTestUtilities.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
 #include <Core/Datatypes/DenseMatrix.h>
 
 using namespace SCIRun;
@@ -53,3 +54,53 @@ TEST(MapFieldDataFromSourceToDestinationAlgoTests, ThrowsOnNullInput)
   AlgorithmInput empty;
   EXPECT_THROW(algo.run(empty), AlgorithmProcessingException);
 }
+
+namespace
+{
+  FieldHandle LinearLatVol(size_type size, const Point& minb, const Point& maxb)
+  {
+    auto field = CreateEmptyLatVol(size, size, size, DOUBLE_E, minb, maxb);
+    VMesh* mesh = field->vmesh();
+    VField* vfield = field->vfield();
+    vfield->resize_values();
+    for (VMesh::Node::index_type idx = 0; idx < mesh->num_nodes(); ++idx)
+    {
+      Point p;
+      mesh->get_center(p, idx);
+      vfield->set_value(p.x() + 2*p.y() - p.z(), idx);
+    }
+    return field;
+  }
+}
+
+TEST(MapFieldDataFromSourceToDestinationAlgoTests, ReusedMappingMatrixMatchesDirectInterpolation)
+{
+  auto source = LinearLatVol(6, Point(-1, -1, -1), Point(1, 1, 1));
+  auto destination = LinearLatVol(5, Point(-0.6, -0.5, -0.4), Point(0.7, 0.5, 0.3));
+
+  MapFieldDataFromSourceToDestinationAlgo direct;
+  FieldHandle expected;
+  ASSERT_TRUE(direct.runImpl(source, destination, expected));
+
+  MapFieldDataFromSourceToDestinationAlgo reuse;
+  reuse.set(Parameters::ReuseMappingMatrix, true);
+  FieldHandle first, second;
+  MatrixHandle firstMapping, secondMapping;
+  ASSERT_TRUE(reuse.runImpl(source, destination, first, firstMapping));
+  ASSERT_TRUE(firstMapping != nullptr);
+  EXPECT_EQ(destination->vfield()->num_values(), firstMapping->nrows());
+  EXPECT_EQ(source->vfield()->num_values(), firstMapping->ncols());
+
+  ASSERT_TRUE(reuse.runImpl(source, destination, second, secondMapping));
+  EXPECT_EQ(firstMapping, secondMapping);
+
+  for (VMesh::index_type idx = 0; idx < expected->vfield()->num_values(); ++idx)
+  {
+    double e, a, b;
+    expected->vfield()->get_value(e, idx);
+    first->vfield()->get_value(a, idx);
+    second->vfield()->get_value(b, idx);
+    EXPECT_NEAR(e, a, 1e-10);
+    EXPECT_NEAR(e, b, 1e-10);
+  }
+}
@@ -0,0 +1,165 @@
+
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   License for the specific language governing rights and limitations under
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Algorithms/Legacy/Fields/Mapping/MapFieldDataOntoNodesRadialbasis.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <random>
+#include <functional>
+#include <cmath>
+#include <chrono>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Fields;
+
+namespace
+{
+  double smooth(const Point& p)
+  {
+    return std::sin(2 * p.x()) + p.y() * p.z();
+  }
+
+  // Scattered samples of a smooth function in the unit cube.
+  FieldHandle ScatteredSamples(int count)
+  {
+    FieldInformation fi(POINTCLOUDMESH_E, LINEARDATA_E, DOUBLE_E);
+    FieldHandle samples = CreateField(fi);
+    VMesh* vmesh = samples->vmesh();
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<double> uniform(0, 1);
+    for (int i = 0; i < count; i++)
+    {
+      Point p(uniform(rng), uniform(rng), uniform(rng));
+      vmesh->add_point(p);
+    }
+    VField* vfield = samples->vfield();
+    vfield->resize_values();
+    for (VMesh::Node::index_type i = 0; i < vmesh->num_nodes(); i++)
+    {
+      Point p;
+      vmesh->get_center(p, i);
+      vfield->set_value(smooth(p), i);
+    }
+    return samples;
+  }
+
+  FieldHandle Lattice(int n, const Point& min, const Point& max)
+  {
+    FieldInformation fi(LATVOLMESH_E, LINEARDATA_E, DOUBLE_E);
+    return CreateField(fi, CreateMesh(fi, n, n, n, min, max));
+  }
+
+  double MaxErrorAgainst(FieldHandle field, std::function<double(const Point&)> expected)
+  {
+    double error = 0;
+    for (VMesh::Node::index_type i = 0; i < field->vmesh()->num_nodes(); i++)
+    {
+      Point p;
+      double value;
+      field->vmesh()->get_center(p, i);
+      field->vfield()->get_value(value, i);
+      error = std::max(error, std::abs(value - expected(p)));
+    }
+    return error;
+  }
+}
+
+TEST(MapFieldDataOntoNodesRadialbasisAlgoTests, ThinPlateSplineReproducesSourceData)
+{
+  MapFieldDataOntoNodesRadialbasisAlgo algo;
+  FieldHandle samples = ScatteredSamples(300);
+  FieldHandle output;
+  ASSERT_TRUE(algo.runImpl(samples, samples, output));
+  EXPECT_LT(MaxErrorAgainst(output, smooth), 1e-6);
+}
+
+TEST(MapFieldDataOntoNodesRadialbasisAlgoTests, WendlandReproducesSourceDataAndInterpolatesBetween)
+{
+  MapFieldDataOntoNodesRadialbasisAlgo algo;
+  algo.setOption(Parameters::RadialBasisFunction, "wendland");
+  FieldHandle samples = ScatteredSamples(2000);
+
+  FieldHandle output;
+  ASSERT_TRUE(algo.runImpl(samples, samples, output));
+  EXPECT_LT(MaxErrorAgainst(output, smooth), 1e-6);
+
+  algo.set(Parameters::SupportRadius, 0.4);
+  ASSERT_TRUE(algo.runImpl(samples, Lattice(12, Point(0.2, 0.2, 0.2), Point(0.8, 0.8, 0.8)), output));
+  EXPECT_LT(MaxErrorAgainst(output, smooth), 0.05);
+}
+
+TEST(MapFieldDataOntoNodesRadialbasisAlgoTests, NodesAwayFromTheSourceGetOutsideValue)
+{
+  MapFieldDataOntoNodesRadialbasisAlgo algo;
+  algo.setOption(Parameters::RadialBasisFunction, "wendland");
+  algo.set(Parameters::SupportRadius, 0.3);
+  algo.set(Parameters::OutsideValue, -7.0);
+  FieldHandle samples = ScatteredSamples(1000);
+  FieldHandle output;
+
+  ASSERT_TRUE(algo.runImpl(samples, Lattice(3, Point(3, 3, 3), Point(4, 4, 4)), output));
+  EXPECT_EQ(0, MaxErrorAgainst(output, [](const Point&) { return -7.0; }));
+
+  algo.set(Parameters::MaxDistance, 1e-4);
+  ASSERT_TRUE(algo.runImpl(samples, Lattice(3, Point(0.4, 0.4, 0.4), Point(0.6, 0.6, 0.6)), output));
+  EXPECT_EQ(0, MaxErrorAgainst(output, [](const Point&) { return -7.0; }));
+}
+
+TEST(MapFieldDataOntoNodesRadialbasisAlgoTests, RejectsNegativeSupportRadius)
+{
+  MapFieldDataOntoNodesRadialbasisAlgo algo;
+  algo.setOption(Parameters::RadialBasisFunction, "wendland");
+  algo.set(Parameters::SupportRadius, -1.0);
+  FieldHandle samples = ScatteredSamples(10);
+  FieldHandle output;
+  EXPECT_FALSE(algo.runImpl(samples, samples, output));
+}
+
+TEST(MapFieldDataOntoNodesRadialbasisAlgoTests, DISABLED_WendlandTiming)
+{
+  for (int count : { 1000, 10000, 100000 })
+  {
+    FieldHandle samples = ScatteredSamples(count);
+    FieldHandle lattice = Lattice(50, Point(0, 0, 0), Point(1, 1, 1));
+    MapFieldDataOntoNodesRadialbasisAlgo algo;
+    algo.setOption(Parameters::RadialBasisFunction, "wendland");
+    FieldHandle output;
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(algo.runImpl(samples, lattice, output));
+    auto end = std::chrono::steady_clock::now();
+    std::cout << count << " samples onto " << lattice->vmesh()->num_nodes() << " nodes: "
+      << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms" << std::endl;
+  }
+}
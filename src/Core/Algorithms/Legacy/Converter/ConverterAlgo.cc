@@ -632,10 +632,10 @@ bool ConverterAlgo::nrrdToField(NrrdDataHandle input, FieldHandle& output, const
   return(algo.nrrdToField(pr_, input, output, datalocation, fieldtype, convertparity));
 }
 
-bool ConverterAlgo::fieldToNrrd(FieldHandle input, NrrdDataHandle& output)
+bool ConverterAlgo::fieldToNrrd(FieldHandle input, NrrdDataHandle& output, bool shareData)
 {
   FieldToNrrdAlgo algo;
-  return(algo.fieldToNrrd(pr_, input, output));
+  return(algo.fieldToNrrd(pr_, input, output, shareData));
 }
 
 #ifdef SCIRUN4_CODE_TO_BE_CONVERTED_LATER
@@ -87,7 +87,8 @@ class SCISHARE ConverterAlgo : public AlgorithmBase
       const std::string& fieldtype = "Auto",
       const std::string& convertparity = "Make Right Hand Sided");
 
-    bool fieldToNrrd(FieldHandle input, NrrdDataHandle& output);
+    // With shareData the nrrd points into the field values instead of a copy
+    bool fieldToNrrd(FieldHandle input, NrrdDataHandle& output, bool shareData = false);
 
     #ifdef SCIRUN4_CODE_TO_BE_CONVERTED_LATER
     bool NrrdToMatrix(NrrdDataHandle input, Datatypes::MatrixHandle& output);
@@ -42,6 +42,7 @@ using namespace SCIRun;
 using namespace Core::Logging;
 using namespace Core::Algorithms;
 using namespace Core::Geometry;
+using namespace Core::Datatypes;
 
 namespace detail 
 {
@@ -50,18 +51,57 @@ class FieldToNrrdAlgoT
 public:
   // Converters for node centered data
   template<class T>
-  bool scalarFieldToNrrd(LoggerHandle pr, FieldHandle input, NrrdDataHandle& output, int datatype);
-  bool vectorFieldToNrrd(LoggerHandle pr, FieldHandle input, NrrdDataHandle& output);
+  bool scalarFieldToNrrd(LoggerHandle pr, FieldHandle input, NrrdDataHandle& output, int datatype, bool shareData);
+  bool vectorFieldToNrrd(LoggerHandle pr, FieldHandle input, NrrdDataHandle& output, bool shareData);
   bool tensorFieldToNrrd(LoggerHandle pr, FieldHandle input, NrrdDataHandle& output);
+
+private:
+  template<class T>
+  void setNrrdData(Nrrd* nrrd, VField* field, int datatype, unsigned int nrrddim, const size_t* dim, VMesh::size_type size, bool shareData);
+  void copyTensors(VField* field, double* data);
 };
 
+// Field values are stored in the same order as the nrrd samples. Either wrap
+// the values, the NrrdData keeps the field alive, or copy them in one call.
+template<class T>
+void FieldToNrrdAlgoT::setNrrdData(Nrrd* nrrd, VField* field, int datatype, unsigned int nrrddim, const size_t* dim, VMesh::size_type size, bool shareData)
+{
+  if (shareData)
+  {
+    nrrdWrap_nva(nrrd,field->get_values_pointer(),datatype,nrrddim,dim);
+    return;
+  }
+
+  nrrdAlloc_nva(nrrd,datatype,nrrddim,dim);
+  if (nrrd->data)
+    field->get_values(reinterpret_cast<T*>(nrrd->data),size);
+}
+
+// Tensors carry an eigen value cache, hence the six unique components are
+// copied out of the field array one by one.
+void FieldToNrrdAlgoT::copyTensors(VField* field, double* data)
+{
+  const Tensor* values = static_cast<const Tensor*>(field->get_values_pointer());
+  const size_t size = static_cast<size_t>(field->num_values());
+  for (size_t k = 0; k < size; k++, data += 6)
+  {
+    const Tensor& t = values[k];
+    data[0] = t.xx();
+    data[1] = t.xy();
+    data[2] = t.xz();
+    data[3] = t.yy();
+    data[4] = t.yz();
+    data[5] = t.zz();
+  }
+}
+
 
 // Templated converter for Scalar data so we can use every type supported by the Teem library
 
 template<class T>
-bool FieldToNrrdAlgoT::scalarFieldToNrrd(LoggerHandle pr,FieldHandle input, NrrdDataHandle& output,int datatype)
+bool FieldToNrrdAlgoT::scalarFieldToNrrd(LoggerHandle pr,FieldHandle input, NrrdDataHandle& output,int datatype,bool shareData)
 {
-  output.reset(new NrrdData());
+  output.reset(shareData ? new NrrdData(input) : new NrrdData());
 
   Nrrd* nrrd = output->getNrrd();
 
@@ -91,7 +131,7 @@ bool FieldToNrrdAlgoT::scalarFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
     dim[0] = static_cast<size_t>(sz[0]);
     dim[1] = static_cast<size_t>(sz[1]);
     dim[2] = static_cast<size_t>(sz[2]);
-    nrrdAlloc_nva(nrrd,datatype,nrrddim,dim);
+    setNrrdData<T>(nrrd,field,datatype,nrrddim,dim,mesh->num_nodes(),shareData);
 
     if (nrrd->data == 0)
     {
@@ -99,8 +139,6 @@ bool FieldToNrrdAlgoT::scalarFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    field->get_values(reinterpret_cast<T*>(nrrd->data),mesh->num_nodes());
-
     nrrdcenter = nrrdCenterNode;
     tf = mesh->get_transform();
   }
@@ -118,7 +156,7 @@ bool FieldToNrrdAlgoT::scalarFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
     dim[0] = static_cast<size_t>(sz[0]);
     dim[1] = static_cast<size_t>(sz[1]);
     dim[2] = static_cast<size_t>(sz[2]);
-    nrrdAlloc_nva(nrrd,datatype,nrrddim,dim);
+    setNrrdData<T>(nrrd,field,datatype,nrrddim,dim,mesh->num_elems(),shareData);
 
     if (nrrd->data == 0)
     {
@@ -126,8 +164,6 @@ bool FieldToNrrdAlgoT::scalarFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    field->get_values(reinterpret_cast<T*>(nrrd->data),mesh->num_elems());
-
     nrrdcenter = nrrdCenterCell;
     tf = mesh->get_transform();
   }
@@ -143,7 +179,7 @@ bool FieldToNrrdAlgoT::scalarFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
     nrrddim = 2;
     dim[0] = static_cast<size_t>(sz[0]);
     dim[1] = static_cast<size_t>(sz[1]);
-    nrrdAlloc_nva(nrrd,datatype,nrrddim,dim);
+    setNrrdData<T>(nrrd,field,datatype,nrrddim,dim,mesh->num_nodes(),shareData);
 
     if (nrrd->data == 0)
     {
@@ -151,8 +187,6 @@ bool FieldToNrrdAlgoT::scalarFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    field->get_values(reinterpret_cast<T*>(nrrd->data),mesh->num_nodes());
-
     nrrdcenter = nrrdCenterNode;
     tf = mesh->get_transform();
   }
@@ -168,7 +202,7 @@ bool FieldToNrrdAlgoT::scalarFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
     nrrddim = 2;
     dim[0] = static_cast<size_t>(sz[0]);
     dim[1] = static_cast<size_t>(sz[1]);
-    nrrdAlloc_nva(nrrd,datatype,nrrddim,dim);
+    setNrrdData<T>(nrrd,field,datatype,nrrddim,dim,mesh->num_elems(),shareData);
 
     if (nrrd->data == 0)
     {
@@ -176,8 +210,6 @@ bool FieldToNrrdAlgoT::scalarFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    field->get_values(reinterpret_cast<T*>(nrrd->data),mesh->num_elems());
-
     nrrdcenter = nrrdCenterCell;
     tf = mesh->get_transform();
   }
@@ -192,7 +224,7 @@ bool FieldToNrrdAlgoT::scalarFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
 
     nrrddim = 1;
     dim[0] = static_cast<size_t>(sz[0]);
-    nrrdAlloc_nva(nrrd,datatype,nrrddim,dim);
+    setNrrdData<T>(nrrd,field,datatype,nrrddim,dim,mesh->num_nodes(),shareData);
 
     if (nrrd->data == 0)
     {
@@ -200,8 +232,6 @@ bool FieldToNrrdAlgoT::scalarFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    field->get_values(reinterpret_cast<T*>(nrrd->data),mesh->num_nodes());
-
     nrrdcenter = nrrdCenterNode;
     tf = mesh->get_transform();
   }
@@ -217,7 +247,7 @@ bool FieldToNrrdAlgoT::scalarFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
 
     nrrddim = 1;
     dim[0] = static_cast<size_t>(sz[0]);
-    nrrdAlloc_nva(nrrd,datatype,nrrddim,dim);
+    setNrrdData<T>(nrrd,field,datatype,nrrddim,dim,mesh->num_elems(),shareData);
 
     if (nrrd->data == 0)
     {
@@ -225,8 +255,6 @@ bool FieldToNrrdAlgoT::scalarFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    field->get_values(reinterpret_cast<T*>(nrrd->data),mesh->num_elems());
-
     nrrdcenter = nrrdCenterCell;
     tf = mesh->get_transform();
   }
@@ -275,9 +303,10 @@ bool FieldToNrrdAlgoT::scalarFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
   return (false);
 }
 
-bool FieldToNrrdAlgoT::vectorFieldToNrrd(LoggerHandle pr,FieldHandle input, NrrdDataHandle& output)
+bool FieldToNrrdAlgoT::vectorFieldToNrrd(LoggerHandle pr,FieldHandle input, NrrdDataHandle& output,bool shareData)
 {
-  output.reset(new NrrdData());
+  static_assert(sizeof(Vector) == 3*sizeof(double), "Vector values are copied as three doubles");
+  output.reset(shareData ? new NrrdData(input) : new NrrdData());
 
   Nrrd* nrrd = output->getNrrd();
 
@@ -307,7 +336,7 @@ bool FieldToNrrdAlgoT::vectorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
     dim[1] = static_cast<size_t>(sz[0]);
     dim[2] = static_cast<size_t>(sz[1]);
     dim[3] = static_cast<size_t>(sz[2]);
-    nrrdAlloc_nva(nrrd,nrrdTypeDouble,nrrddim,dim);
+    setNrrdData<Vector>(nrrd,field,nrrdTypeDouble,nrrddim,dim,field->num_values(),shareData);
 
     if (nrrd->data == 0)
     {
@@ -315,22 +344,6 @@ bool FieldToNrrdAlgoT::vectorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Node::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
-    size_t k = 0;
-
-    double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
-    {
-      Vector v;
-      field->get_value(v,*it);
-      data[k] = v.x(); k++;
-      data[k] = v.y(); k++;
-      data[k] = v.z(); k++;
-      ++it;
-    }
-
     nrrdcenter = nrrdCenterNode;
     tf = mesh->get_transform();
   }
@@ -348,7 +361,7 @@ bool FieldToNrrdAlgoT::vectorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
     dim[1] = static_cast<size_t>(sz[0]);
     dim[2] = static_cast<size_t>(sz[1]);
     dim[3] = static_cast<size_t>(sz[2]);
-    nrrdAlloc_nva(nrrd,nrrdTypeDouble,nrrddim,dim);
+    setNrrdData<Vector>(nrrd,field,nrrdTypeDouble,nrrddim,dim,field->num_values(),shareData);
 
     if (nrrd->data == 0)
     {
@@ -356,22 +369,6 @@ bool FieldToNrrdAlgoT::vectorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Elem::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
-    size_t k = 0;
-
-    double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
-    {
-      Vector v;
-      field->get_value(v,*it);
-      data[k] = v.x(); k++;
-      data[k] = v.y(); k++;
-      data[k] = v.z(); k++;
-      ++it;
-    }
-
     nrrdcenter = nrrdCenterCell;
     tf = mesh->get_transform();
   }
@@ -388,7 +385,7 @@ bool FieldToNrrdAlgoT::vectorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
     nrrddim = 3; dim[0] = 3;
     dim[1] = static_cast<size_t>(sz[0]);
     dim[2] = static_cast<size_t>(sz[1]);
-    nrrdAlloc_nva(nrrd,nrrdTypeDouble,nrrddim,dim);
+    setNrrdData<Vector>(nrrd,field,nrrdTypeDouble,nrrddim,dim,field->num_values(),shareData);
 
     if (nrrd->data == 0)
     {
@@ -396,22 +393,6 @@ bool FieldToNrrdAlgoT::vectorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Node::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
-    size_t k = 0;
-
-    double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
-    {
-      Vector v;
-      field->get_value(v,*it);
-      data[k] = v.x(); k++;
-      data[k] = v.y(); k++;
-      data[k] = v.z(); k++;
-      ++it;
-    }
-
     nrrdcenter = nrrdCenterNode;
     tf = mesh->get_transform();
   }
@@ -428,7 +409,7 @@ bool FieldToNrrdAlgoT::vectorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
     nrrddim = 3; dim[0] = 3;
     dim[1] = static_cast<size_t>(sz[0]);
     dim[2] = static_cast<size_t>(sz[1]);
-    nrrdAlloc_nva(nrrd,nrrdTypeDouble,nrrddim,dim);
+    setNrrdData<Vector>(nrrd,field,nrrdTypeDouble,nrrddim,dim,field->num_values(),shareData);
 
     if (nrrd->data == 0)
     {
@@ -436,22 +417,6 @@ bool FieldToNrrdAlgoT::vectorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Elem::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
-    size_t k = 0;
-
-    double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
-    {
-      Vector v;
-      field->get_value(v,*it);
-      data[k] = v.x(); k++;
-      data[k] = v.y(); k++;
-      data[k] = v.z(); k++;
-      ++it;
-    }
-
     nrrdcenter = nrrdCenterCell;
     tf = mesh->get_transform();
   }
@@ -467,7 +432,7 @@ bool FieldToNrrdAlgoT::vectorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
 
     nrrddim = 2; dim[0] = 3;
     dim[1] = static_cast<size_t>(sz[0]);
-    nrrdAlloc_nva(nrrd,nrrdTypeDouble,nrrddim,dim);
+    setNrrdData<Vector>(nrrd,field,nrrdTypeDouble,nrrddim,dim,field->num_values(),shareData);
 
     if (nrrd->data == 0)
     {
@@ -475,22 +440,6 @@ bool FieldToNrrdAlgoT::vectorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Node::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
-    size_t k = 0;
-
-    double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
-    {
-      Vector v;
-      field->get_value(v,*it);
-      data[k] = v.x(); k++;
-      data[k] = v.y(); k++;
-      data[k] = v.z(); k++;
-      ++it;
-    }
-
     nrrdcenter = nrrdCenterNode;
     tf = mesh->get_transform();
   }
@@ -506,7 +455,7 @@ bool FieldToNrrdAlgoT::vectorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
 
     nrrddim = 2; dim[0] = 3;
     dim[1] = static_cast<size_t>(sz[0]);
-    nrrdAlloc_nva(nrrd,nrrdTypeDouble,nrrddim,dim);
+    setNrrdData<Vector>(nrrd,field,nrrdTypeDouble,nrrddim,dim,field->num_values(),shareData);
 
     if (nrrd->data == 0)
     {
@@ -514,22 +463,6 @@ bool FieldToNrrdAlgoT::vectorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Elem::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
-    size_t k = 0;
-
-    double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
-    {
-      Vector v;
-      field->get_value(v,*it);
-      data[k] = v.x(); k++;
-      data[k] = v.y(); k++;
-      data[k] = v.z(); k++;
-      ++it;
-    }
-
     nrrdcenter = nrrdCenterCell;
     tf = mesh->get_transform();
   }
@@ -623,24 +556,7 @@ bool FieldToNrrdAlgoT::tensorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Node::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
-    size_t k = 0;
-
-    double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
-    {
-      Tensor t;
-      field->get_value(t,*it);
-      data[k] = t.val(0,0); k++;
-      data[k] = t.val(0,1); k++;
-      data[k] = t.val(0,2); k++;
-      data[k] = t.val(1,1); k++;
-      data[k] = t.val(1,2); k++;
-      data[k] = t.val(2,2); k++;
-      ++it;
-    }
+    copyTensors(field,reinterpret_cast<double*>(nrrd->data));
 
     nrrdcenter = nrrdCenterNode;
     tf = mesh->get_transform();
@@ -667,24 +583,7 @@ bool FieldToNrrdAlgoT::tensorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Elem::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
-    size_t k = 0;
-
-    double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
-    {
-      Tensor t;
-      field->get_value(t,*it);
-      data[k] = t.val(0, 0); k++;
-      data[k] = t.val(0, 1); k++;
-      data[k] = t.val(0, 2); k++;
-      data[k] = t.val(1, 1); k++;
-      data[k] = t.val(1, 2); k++;
-      data[k] = t.val(2, 2); k++;
-      ++it;
-    }
+    copyTensors(field,reinterpret_cast<double*>(nrrd->data));
 
     nrrdcenter = nrrdCenterCell;
     tf = mesh->get_transform();
@@ -711,24 +610,7 @@ bool FieldToNrrdAlgoT::tensorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Node::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
-    size_t k = 0;
-
-    double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
-    {
-      Tensor t;
-      field->get_value(t,*it);
-      data[k] = t.val(0, 0); k++;
-      data[k] = t.val(0, 1); k++;
-      data[k] = t.val(0, 2); k++;
-      data[k] = t.val(1, 1); k++;
-      data[k] = t.val(1, 2); k++;
-      data[k] = t.val(2, 2); k++;
-      ++it;
-    }
+    copyTensors(field,reinterpret_cast<double*>(nrrd->data));
 
     nrrdcenter = nrrdCenterNode;
     tf = mesh->get_transform();
@@ -754,24 +636,7 @@ bool FieldToNrrdAlgoT::tensorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Elem::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
-    size_t k = 0;
-
-    double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
-    {
-      Tensor t;
-      field->get_value(t,*it);
-      data[k] = t.val(0, 0); k++;
-      data[k] = t.val(0, 1); k++;
-      data[k] = t.val(0, 2); k++;
-      data[k] = t.val(1, 1); k++;
-      data[k] = t.val(1, 2); k++;
-      data[k] = t.val(2, 2); k++;
-      ++it;
-    }
+    copyTensors(field,reinterpret_cast<double*>(nrrd->data));
 
     nrrdcenter = nrrdCenterCell;
     tf = mesh->get_transform();
@@ -797,24 +662,7 @@ bool FieldToNrrdAlgoT::tensorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Node::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
-    size_t k = 0;
-
-    double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
-    {
-      Tensor t;
-      field->get_value(t,*it);
-      data[k] = t.val(0, 0); k++;
-      data[k] = t.val(0, 1); k++;
-      data[k] = t.val(0, 2); k++;
-      data[k] = t.val(1, 1); k++;
-      data[k] = t.val(1, 2); k++;
-      data[k] = t.val(2, 2); k++;
-      ++it;
-    }
+    copyTensors(field,reinterpret_cast<double*>(nrrd->data));
 
     nrrdcenter = nrrdCenterNode;
     tf = mesh->get_transform();
@@ -839,24 +687,7 @@ bool FieldToNrrdAlgoT::tensorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
       return (false);
     }
 
-    VMesh::Elem::iterator it, it_end;
-    mesh->begin(it);
-    mesh->end(it_end);
-    size_t k = 0;
-
-    double* data = reinterpret_cast<double*>(nrrd->data);
-    while (it != it_end)
-    {
-      Tensor t;
-      field->get_value(t,*it);
-      data[k] = t.val(0, 0); k++;
-      data[k] = t.val(0, 1); k++;
-      data[k] = t.val(0, 2); k++;
-      data[k] = t.val(1, 1); k++;
-      data[k] = t.val(1, 2); k++;
-      data[k] = t.val(2, 2); k++;
-      ++it;
-    }
+    copyTensors(field,reinterpret_cast<double*>(nrrd->data));
 
     nrrdcenter = nrrdCenterCell;
     tf = mesh->get_transform();
@@ -912,7 +743,7 @@ bool FieldToNrrdAlgoT::tensorFieldToNrrd(LoggerHandle pr,FieldHandle input, Nrrd
 }
 }
 
-bool FieldToNrrdAlgo::fieldToNrrd(LoggerHandle pr, FieldHandle input, NrrdDataHandle& output)
+bool FieldToNrrdAlgo::fieldToNrrd(LoggerHandle pr, FieldHandle input, NrrdDataHandle& output, bool shareData)
 {
   if (!input)
   {
@@ -950,23 +781,23 @@ bool FieldToNrrdAlgo::fieldToNrrd(LoggerHandle pr, FieldHandle input, NrrdDataHa
 
   if (fi.is_scalar())
   {
-    if (fi.is_double())               return(algo.scalarFieldToNrrd<double>(pr,input,output,nrrdTypeDouble));
-    if (fi.is_float())                return(algo.scalarFieldToNrrd<float>(pr,input,output,nrrdTypeFloat));
-    if (fi.is_char())                 return(algo.scalarFieldToNrrd<char>(pr,input,output,nrrdTypeChar));
-    if (fi.is_unsigned_char())        return(algo.scalarFieldToNrrd<unsigned char>(pr,input,output,nrrdTypeUChar));
-    if (fi.is_short())                return(algo.scalarFieldToNrrd<short>(pr,input,output,nrrdTypeShort));
-    if (fi.is_unsigned_short())       return(algo.scalarFieldToNrrd<unsigned short>(pr,input,output,nrrdTypeUShort));
-    if (fi.is_int())                  return(algo.scalarFieldToNrrd<int>(pr,input,output,nrrdTypeInt));
-    if (fi.is_unsigned_int())         return(algo.scalarFieldToNrrd<unsigned int>(pr,input,output,nrrdTypeUInt));
-    if (fi.is_longlong())             return(algo.scalarFieldToNrrd<long long>(pr,input,output,nrrdTypeLLong));
-    if (fi.is_unsigned_longlong())    return(algo.scalarFieldToNrrd<unsigned long long>(pr,input,output,nrrdTypeULLong));
+    if (fi.is_double())               return(algo.scalarFieldToNrrd<double>(pr,input,output,nrrdTypeDouble,shareData));
+    if (fi.is_float())                return(algo.scalarFieldToNrrd<float>(pr,input,output,nrrdTypeFloat,shareData));
+    if (fi.is_char())                 return(algo.scalarFieldToNrrd<char>(pr,input,output,nrrdTypeChar,shareData));
+    if (fi.is_unsigned_char())        return(algo.scalarFieldToNrrd<unsigned char>(pr,input,output,nrrdTypeUChar,shareData));
+    if (fi.is_short())                return(algo.scalarFieldToNrrd<short>(pr,input,output,nrrdTypeShort,shareData));
+    if (fi.is_unsigned_short())       return(algo.scalarFieldToNrrd<unsigned short>(pr,input,output,nrrdTypeUShort,shareData));
+    if (fi.is_int())                  return(algo.scalarFieldToNrrd<int>(pr,input,output,nrrdTypeInt,shareData));
+    if (fi.is_unsigned_int())         return(algo.scalarFieldToNrrd<unsigned int>(pr,input,output,nrrdTypeUInt,shareData));
+    if (fi.is_longlong())             return(algo.scalarFieldToNrrd<long long>(pr,input,output,nrrdTypeLLong,shareData));
+    if (fi.is_unsigned_longlong())    return(algo.scalarFieldToNrrd<unsigned long long>(pr,input,output,nrrdTypeULLong,shareData));
     pr->error("FieldToNrrd: The field type is not supported by nrrd format, hence we cannot convert it");
     return (false);
   }
 
   if (fi.is_vector())
   {
-    return(algo.vectorFieldToNrrd(pr,input,output));
+    return(algo.vectorFieldToNrrd(pr,input,output,shareData));
   }
 
   if (fi.is_tensor())
@@ -44,7 +44,9 @@ namespace SCIRun
       class SCISHARE FieldToNrrdAlgo
       {
       public:
-        bool fieldToNrrd(Core::Logging::LoggerHandle pr, FieldHandle input, NrrdDataHandle& output);
+        /// With shareData the nrrd wraps the field values instead of copying
+        /// them, this is only possible for scalar and vector data.
+        bool fieldToNrrd(Core::Logging::LoggerHandle pr, FieldHandle input, NrrdDataHandle& output, bool shareData = false);
       };
 
 }}}
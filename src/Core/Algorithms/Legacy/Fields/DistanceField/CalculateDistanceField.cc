@@ -55,6 +55,7 @@ CalculateDistanceFieldAlgo::CalculateDistanceFieldAlgo()
   addParameter(Truncate, false);
   addParameter(TruncateDistance, 1.0);
   addParameter(OutputValueField, false);
+  addParameter(UseDistanceTransform, false);
   addOption(BasisType, "same as input","same as input|constant|linear");
   addOption(OutputFieldDatatype, "double","char|unsigned char|short|unsigned short|int|unsigned int|float|double");
 }
@@ -396,6 +397,25 @@ CalculateDistanceFieldAlgo::runImpl(FieldHandle input, FieldHandle object, Field
     return (true);
   }
 
+  if (get(Parameters::UseDistanceTransform).toBool())
+  {
+    RegularGridDistanceTransform edt(imesh,objmesh,ofield->basis_order(),this);
+    if (edt.is_supported())
+    {
+      double max = DBL_MAX;
+      if (get(Parameters::Truncate).toBool())
+      {
+        max = get(Parameters::TruncateDistance).toDouble();
+      }
+
+      std::vector<double> values;
+      edt.compute_distance(values,max);
+      ofield->set_values(values);
+      return (true);
+    }
+    remark("Distance transform needs an axis aligned LatVol field with constant or linear data and a point, curve or surface object, using closest element search instead.");
+  }
+
   objmesh->synchronize(Mesh::FIND_CLOSEST_ELEM_E);
 
   if (ofield->basis_order() > 2)
@@ -27,6 +27,7 @@
 */
 
 #include <Core/Algorithms/Legacy/Fields/DistanceField/CalculateSignedDistanceField.h>
+#include <Core/Algorithms/Legacy/Fields/DistanceField/RegularGridDistanceTransform.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
@@ -661,6 +662,7 @@ class CalculateSignedDistanceFieldP : public Interruptible
 CalculateSignedDistanceFieldAlgo::CalculateSignedDistanceFieldAlgo()
 {
   addParameter(OutputValueField, false);
+  addParameter(Parameters::UseDistanceTransform, false);
 }
 
 bool
@@ -718,6 +720,20 @@ CalculateSignedDistanceFieldAlgo::run(FieldHandle input, FieldHandle object, Fie
     return (true);
   }
 
+  if (get(Parameters::UseDistanceTransform).toBool())
+  {
+    RegularGridDistanceTransform edt(imesh, objmesh, ofield->basis_order(), this);
+    if (edt.is_sign_supported())
+    {
+      std::vector<double> values;
+      edt.compute_distance(values, DBL_MAX);
+      edt.apply_sign(values);
+      ofield->set_values(values);
+      return (true);
+    }
+    remark("Distance transform needs an axis aligned LatVol field with constant or linear data and a linear surface object, using closest element search instead.");
+  }
+
   objmesh->synchronize(Mesh::FIND_CLOSEST_ELEM_E|Mesh::EDGES_E);
   CalculateSignedDistanceFieldP palgo(imesh, objmesh, ofield, this);
   const int numThreads = Parallel::NumCores();
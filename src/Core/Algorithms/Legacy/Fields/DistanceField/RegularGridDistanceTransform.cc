@@ -0,0 +1,565 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Core/Algorithms/Legacy/Fields/DistanceField/RegularGridDistanceTransform.h>
+#include <Core/GeometryPrimitives/CompGeom.h>
+#include <Core/GeometryPrimitives/Point.h>
+#include <Core/Thread/Parallel.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Thread;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Fields;
+
+ALGORITHM_PARAMETER_DEF(Fields, UseDistanceTransform);
+
+namespace
+{
+  const double infinity = std::numeric_limits<double>::infinity();
+
+  void closest_point_on_segment(Point& result, const Point& p, const Point& a, const Point& b)
+  {
+    const Vector ab = b - a;
+    const double len2 = ab.length2();
+    double t = (len2 > 0.0) ? Dot(p - a, ab)/len2 : 0.0;
+    t = std::max(0.0, std::min(1.0, t));
+    result = a + t*ab;
+  }
+
+  // Closest point on a point, edge, triangle or quadrilateral element
+  double closest_point_on_elem(Point& result, const Point& p, const Point* pts, size_t num_pts)
+  {
+    switch (num_pts)
+    {
+      case 1:
+        result = pts[0];
+        break;
+      case 2:
+        closest_point_on_segment(result, p, pts[0], pts[1]);
+        break;
+      case 3:
+        closest_point_on_tri(result, p, pts[0], pts[1], pts[2]);
+        break;
+      case 4:
+      {
+        Point r;
+        closest_point_on_tri(result, p, pts[0], pts[1], pts[2]);
+        closest_point_on_tri(r, p, pts[0], pts[2], pts[3]);
+        if ((p - r).length2() < (p - result).length2()) result = r;
+        break;
+      }
+      default:
+        return (infinity);
+    }
+    return ((p - result).length2());
+  }
+
+  struct Candidate
+  {
+    double a;   // position of the feature along the line
+    double h;   // squared distance of the feature to the line
+    VMesh::index_type q;
+    bool operator<(const Candidate& c) const { return (a < c.a || (a == c.a && h < c.h)); }
+  };
+}
+
+RegularGridDistanceTransform::RegularGridDistanceTransform(VMesh* grid, VMesh* object, int basis_order, const AlgorithmBase* algo) :
+  grid_(grid), object_(object), algo_(algo), offset_(0.0), supported_(false), nodes_per_elem_(0)
+{
+  dim_[0] = dim_[1] = dim_[2] = 0;
+  spacing_[0] = spacing_[1] = spacing_[2] = 0.0;
+
+  if (!grid_->is_latvolmesh()) return;
+  if (!object_->is_linearmesh() || object_->is_volume()) return;
+  if (object_->num_nodes_per_elem() > 4) return;
+
+  if (basis_order == 1)
+  {
+    dim_[0] = grid_->get_ni(); dim_[1] = grid_->get_nj(); dim_[2] = grid_->get_nk();
+  }
+  else if (basis_order == 0)
+  {
+    // Cell centered data lives on the dual grid
+    dim_[0] = grid_->get_ni()-1; dim_[1] = grid_->get_nj()-1; dim_[2] = grid_->get_nk()-1;
+    offset_ = 0.5;
+  }
+  else
+  {
+    return;
+  }
+
+  if (dim_[0] < 1 || dim_[1] < 1 || dim_[2] < 1) return;
+
+  // The separable transform needs the grid axes to align with the world axes
+  transform_ = grid_->get_transform();
+  for (int r = 0; r < 3; r++)
+  {
+    spacing_[r] = std::fabs(transform_.get_mat_val(r, r));
+    if (spacing_[r] == 0.0) return;
+  }
+
+  for (int r = 0; r < 3; r++)
+  {
+    for (int c = 0; c < 3; c++)
+    {
+      if (r != c && std::fabs(transform_.get_mat_val(r, c)) > 1e-12*spacing_[c]) return;
+    }
+  }
+
+  // Compute the inverse up front, it is used concurrently later on
+  transform_.compute_imat();
+
+  // Element corners are looked up for every candidate, fetch them once.
+  // The elements around each node let the final pass walk over the surface.
+  nodes_per_elem_ = object_->num_nodes_per_elem();
+  const VMesh::size_type num_elems = object_->num_elems();
+  const VMesh::size_type num_nodes = object_->num_nodes();
+  elem_points_.resize(num_elems*nodes_per_elem_);
+  elem_nodes_.resize(num_elems*nodes_per_elem_);
+  node_elems_start_.assign(num_nodes+1, 0);
+  VMesh::Node::array_type nodes;
+  for (VMesh::Elem::index_type idx = 0; idx < num_elems; idx++)
+  {
+    object_->get_nodes(nodes, idx);
+    if (static_cast<VMesh::size_type>(nodes.size()) != nodes_per_elem_) return;
+    for (size_t r = 0; r < nodes.size(); r++)
+    {
+      object_->get_center(elem_points_[idx*nodes_per_elem_ + r], nodes[r]);
+      elem_nodes_[idx*nodes_per_elem_ + r] = nodes[r];
+      node_elems_start_[nodes[r]+1]++;
+    }
+  }
+  for (VMesh::size_type n = 0; n < num_nodes; n++)
+    node_elems_start_[n+1] += node_elems_start_[n];
+  node_elems_.resize(elem_nodes_.size());
+  std::vector<VMesh::index_type> fill(node_elems_start_.begin(), node_elems_start_.end()-1);
+  for (size_t r = 0; r < elem_nodes_.size(); r++)
+    node_elems_[fill[elem_nodes_[r]]++] = r/nodes_per_elem_;
+
+  supported_ = true;
+}
+
+bool
+RegularGridDistanceTransform::is_supported() const
+{
+  return (supported_);
+}
+
+bool
+RegularGridDistanceTransform::is_sign_supported() const
+{
+  return (supported_ && object_->is_surface());
+}
+
+void
+RegularGridDistanceTransform::index_point(Point& p, const Point& world) const
+{
+  transform_.unproject(world, p);
+  p -= Vector(offset_, offset_, offset_);
+}
+
+void
+RegularGridDistanceTransform::world_point(Point& p, VMesh::index_type i, VMesh::index_type j, VMesh::index_type k) const
+{
+  p = transform_.project(Point(i+offset_, j+offset_, k+offset_));
+}
+
+void
+RegularGridDistanceTransform::slab_range(int proc, int nproc, VMesh::index_type& start, VMesh::index_type& end, VMesh::size_type size) const
+{
+  VMesh::size_type m = size/nproc;
+  start = proc*m;
+  end = (proc+1)*m;
+  if (proc == nproc-1) end = size;
+}
+
+void
+RegularGridDistanceTransform::rasterize(std::vector<Feature>& features, std::vector<double>& dist2, int proc, int nproc) const
+{
+  // Every thread owns a slab of k-planes and visits all the elements,
+  // so no two threads write the same sample.
+  VMesh::index_type kstart, kend;
+  slab_range(proc, nproc, kstart, kend, dim_[2]);
+  if (kstart >= kend) return;
+
+  const VMesh::size_type nx = dim_[0];
+  const VMesh::size_type ny = dim_[1];
+  const VMesh::size_type num_elems = object_->num_elems();
+
+  Point ip, p, c;
+
+  for (VMesh::Elem::index_type idx = 0; idx < num_elems; idx++)
+  {
+    const Point* pts = &elem_points_[idx*nodes_per_elem_];
+
+    double lo[3] = { infinity, infinity, infinity };
+    double hi[3] = { -infinity, -infinity, -infinity };
+    for (VMesh::size_type r = 0; r < nodes_per_elem_; r++)
+    {
+      index_point(ip, pts[r]);
+      for (int d = 0; d < 3; d++)
+      {
+        lo[d] = std::min(lo[d], ip[d]);
+        hi[d] = std::max(hi[d], ip[d]);
+      }
+    }
+
+    // All samples within one cell of the element
+    VMesh::index_type bmin[3], bmax[3];
+    bool empty = false;
+    for (int d = 0; d < 3; d++)
+    {
+      bmin[d] = std::max(static_cast<VMesh::index_type>(std::ceil(lo[d] - 1.0)), VMesh::index_type(0));
+      bmax[d] = std::min(static_cast<VMesh::index_type>(std::floor(hi[d] + 1.0)), dim_[d]-1);
+      if (bmin[d] > bmax[d]) empty = true;
+    }
+    bmin[2] = std::max(bmin[2], kstart);
+    bmax[2] = std::min(bmax[2], kend-1);
+    if (empty || bmin[2] > bmax[2]) continue;
+
+    for (VMesh::index_type k = bmin[2]; k <= bmax[2]; k++)
+      for (VMesh::index_type j = bmin[1]; j <= bmax[1]; j++)
+        for (VMesh::index_type i = bmin[0]; i <= bmax[0]; i++)
+        {
+          world_point(p, i, j, k);
+          const double d2 = closest_point_on_elem(c, p, pts, nodes_per_elem_);
+          const VMesh::index_type r = i + nx*(j + ny*k);
+          if (d2 < dist2[r])
+          {
+            dist2[r] = d2;
+            index_point(features[r].point, c);
+            features[r].elem = idx;
+          }
+        }
+  }
+}
+
+void
+RegularGridDistanceTransform::transform_lines(std::vector<Feature>& features, int axis, int proc, int nproc) const
+{
+  const VMesh::size_type nx = dim_[0];
+  const VMesh::size_type ny = dim_[1];
+  const VMesh::size_type n = dim_[axis];
+  const VMesh::size_type stride = (axis == 0) ? 1 : ((axis == 1) ? nx : nx*ny);
+  const VMesh::size_type num_lines = (nx*ny*dim_[2])/n;
+  const double s2 = spacing_[axis]*spacing_[axis];
+
+  VMesh::index_type start, end;
+  slab_range(proc, nproc, start, end, num_lines);
+
+  std::vector<Feature> line(n);
+  std::vector<Candidate> cand;
+  std::vector<size_t> v(n+1);
+  std::vector<double> z(n+1);
+
+  for (VMesh::index_type l = start; l < end; l++)
+  {
+    VMesh::index_type base;
+    if (axis == 0) base = l*nx;
+    else if (axis == 1) base = (l % nx) + (l / nx)*nx*ny;
+    else base = l;
+    const double pos[3] = { static_cast<double>(base % nx), static_cast<double>((base / nx) % ny), static_cast<double>(base / (nx*ny)) };
+
+    // Every feature on the line is a parabola s2*(q-a)^2 + h along it, where
+    // h is its squared distance to the line. Keep the lower envelope.
+    cand.clear();
+    for (VMesh::index_type q = 0; q < n; q++)
+    {
+      const Feature& f = features[base + q*stride];
+      line[q] = f;
+      if (f.elem < 0) continue;
+      Candidate c;
+      c.a = f.point[axis];
+      c.h = 0.0;
+      for (int d = 0; d < 3; d++)
+      {
+        if (d == axis) continue;
+        const double dd = spacing_[d]*(pos[d] - f.point[d]);
+        c.h += dd*dd;
+      }
+      c.q = q;
+      cand.push_back(c);
+    }
+    if (cand.empty()) continue;
+    std::sort(cand.begin(), cand.end());
+    if (v.size() < cand.size()+1)
+    {
+      v.resize(cand.size()+1);
+      z.resize(cand.size()+1);
+    }
+
+    long k = -1;
+    for (size_t r = 0; r < cand.size(); r++)
+    {
+      // Of the features at the same position only the nearest counts
+      if (k >= 0 && cand[r].a == cand[v[k]].a) continue;
+
+      double s = -infinity;
+      while (k >= 0)
+      {
+        const Candidate& w = cand[v[k]];
+        s = ((cand[r].h - w.h)/s2 + cand[r].a*cand[r].a - w.a*w.a)/(2.0*(cand[r].a - w.a));
+        if (s > z[k]) break;
+        k--;
+      }
+
+      k++;
+      v[k] = r;
+      z[k] = (k == 0) ? -infinity : s;
+      z[k+1] = infinity;
+    }
+
+    k = 0;
+    for (VMesh::index_type q = 0; q < n; q++)
+    {
+      while (z[k+1] < q) k++;
+      features[base + q*stride] = line[cand[v[k]].q];
+    }
+  }
+}
+
+void
+RegularGridDistanceTransform::closest_elements(const std::vector<Feature>& features, std::vector<Feature>& closest, std::vector<double>& distance, int proc, int nproc) const
+{
+  VMesh::index_type kstart, kend;
+  slab_range(proc, nproc, kstart, kend, dim_[2]);
+
+  const VMesh::size_type nx = dim_[0];
+  const VMesh::size_type ny = dim_[1];
+  const VMesh::index_type offsets[6] = { -1, 1, -nx, nx, -nx*ny, nx*ny };
+
+  Point p, c;
+  for (VMesh::index_type k = kstart; k < kend; k++)
+    for (VMesh::index_type j = 0; j < ny; j++)
+      for (VMesh::index_type i = 0; i < nx; i++)
+      {
+        const VMesh::index_type r = i + nx*(j + ny*k);
+        const bool inside[6] = { i > 0, i < nx-1, j > 0, j < ny-1, k > 0, k < dim_[2]-1 };
+        world_point(p, i, j, k);
+
+        VMesh::index_type elems[7];
+        int num = 0;
+        elems[num++] = features[r].elem;
+        for (int n = 0; n < 6; n++)
+        {
+          if (!inside[n]) continue;
+          const VMesh::index_type e = features[r + offsets[n]].elem;
+          if (std::find(elems, elems + num, e) == elems + num) elems[num++] = e;
+        }
+
+        double d2 = infinity;
+        VMesh::index_type best = -1;
+        for (int n = 0; n < num; n++)
+        {
+          if (elems[n] < 0) continue;
+          const double e2 = closest_point_on_elem(c, p, &elem_points_[elems[n]*nodes_per_elem_], nodes_per_elem_);
+          if (e2 < d2)
+          {
+            d2 = e2;
+            best = elems[n];
+          }
+        }
+
+        // Walk over the surface to the closest element around it
+        VMesh::index_type current = -1;
+        while (best >= 0 && best != current)
+        {
+          current = best;
+          for (VMesh::size_type m = 0; m < nodes_per_elem_; m++)
+          {
+            const VMesh::index_type node = elem_nodes_[current*nodes_per_elem_ + m];
+            for (VMesh::index_type q = node_elems_start_[node]; q < node_elems_start_[node+1]; q++)
+            {
+              const VMesh::index_type e = node_elems_[q];
+              const double e2 = closest_point_on_elem(c, p, &elem_points_[e*nodes_per_elem_], nodes_per_elem_);
+              if (e2 < d2)
+              {
+                d2 = e2;
+                best = e;
+              }
+            }
+          }
+        }
+        distance[r] = d2;
+        closest[r].elem = best;
+        if (best >= 0)
+        {
+          closest_point_on_elem(c, p, &elem_points_[best*nodes_per_elem_], nodes_per_elem_);
+          index_point(closest[r].point, c);
+        }
+      }
+}
+
+bool
+RegularGridDistanceTransform::compute_distance(std::vector<double>& distance, double maxdist) const
+{
+  if (!supported_) return (false);
+
+  // The second round starts from the closest points found by the first one,
+  // which settles the samples where the first round picked a farther element.
+  const int num_rounds = 2;
+  const int num_steps = 2 + 4*num_rounds;
+
+  const int nproc = Parallel::NumCores();
+  const size_t size = dim_[0]*dim_[1]*dim_[2];
+  Feature none;
+  none.elem = -1;
+  std::vector<Feature> features(size, none);
+  distance.assign(size, infinity);
+
+  auto raster_task = [this, &features, &distance, nproc](int i) { rasterize(features, distance, i, nproc); };
+  Parallel::RunTasks(raster_task, nproc);
+  int step = 1;
+  if (algo_) algo_->update_progress_max(step, num_steps);
+
+  std::vector<Feature> closest(size, none);
+  for (int round = 0; round < num_rounds; round++)
+  {
+    for (int axis = 0; axis < 3; axis++)
+    {
+      auto line_task = [this, &features, axis, nproc](int i) { transform_lines(features, axis, i, nproc); };
+      Parallel::RunTasks(line_task, nproc);
+      if (algo_) algo_->update_progress_max(++step, num_steps);
+    }
+
+    auto closest_task = [this, &features, &closest, &distance, nproc](int i) { closest_elements(features, closest, distance, i, nproc); };
+    Parallel::RunTasks(closest_task, nproc);
+    features.swap(closest);
+    if (algo_) algo_->update_progress_max(++step, num_steps);
+  }
+
+  for (size_t r = 0; r < distance.size(); r++)
+  {
+    const double d = std::sqrt(distance[r]);
+    distance[r] = (d < maxdist) ? d : maxdist;
+  }
+  if (algo_) algo_->update_progress_max(num_steps, num_steps);
+
+  return (true);
+}
+
+void
+RegularGridDistanceTransform::scan_convert(std::vector<double>& distance, int proc, int nproc) const
+{
+  VMesh::index_type kstart, kend;
+  slab_range(proc, nproc, kstart, kend, dim_[2]);
+  if (kstart >= kend) return;
+
+  const VMesh::size_type nx = dim_[0];
+  const VMesh::size_type ny = dim_[1];
+  const VMesh::size_type num_elems = object_->num_elems();
+
+  // Grid lines are shifted by a tiny irrational amount so they do not
+  // pass exactly through the edges and corners of grid aligned surfaces.
+  const double dy = 1e-7*std::sqrt(2.0);
+  const double dz = 1e-7*std::sqrt(3.0);
+
+  std::vector<std::vector<double> > crossings(ny*(kend-kstart));
+
+  VMesh::Node::array_type nodes;
+  Point pts[4], c;
+
+  for (VMesh::Elem::index_type idx = 0; idx < num_elems; idx++)
+  {
+    object_->get_nodes(nodes, idx);
+    for (size_t r = 0; r < nodes.size(); r++)
+    {
+      object_->get_center(c, nodes[r]);
+      index_point(pts[r], c);
+    }
+
+    const size_t num_tris = nodes.size() - 2;
+    for (size_t t = 0; t < num_tris; t++)
+    {
+      const Point& a = pts[0];
+      const Point& b = pts[t+1];
+      const Point& e = pts[t+2];
+
+      const double denom = (b.y()-a.y())*(e.z()-a.z()) - (e.y()-a.y())*(b.z()-a.z());
+      if (denom == 0.0) continue;
+
+      const double ymin = std::min(a.y(), std::min(b.y(), e.y()));
+      const double ymax = std::max(a.y(), std::max(b.y(), e.y()));
+      const double zmin = std::min(a.z(), std::min(b.z(), e.z()));
+      const double zmax = std::max(a.z(), std::max(b.z(), e.z()));
+
+      const VMesh::index_type j0 = std::max(static_cast<VMesh::index_type>(std::ceil(ymin - dy)), VMesh::index_type(0));
+      const VMesh::index_type j1 = std::min(static_cast<VMesh::index_type>(std::floor(ymax - dy)), ny-1);
+      const VMesh::index_type k0 = std::max(static_cast<VMesh::index_type>(std::ceil(zmin - dz)), kstart);
+      const VMesh::index_type k1 = std::min(static_cast<VMesh::index_type>(std::floor(zmax - dz)), kend-1);
+
+      for (VMesh::index_type k = k0; k <= k1; k++)
+        for (VMesh::index_type j = j0; j <= j1; j++)
+        {
+          const double y = j + dy;
+          const double z = k + dz;
+          const double l1 = ((y-a.y())*(e.z()-a.z()) - (e.y()-a.y())*(z-a.z()))/denom;
+          const double l2 = ((b.y()-a.y())*(z-a.z()) - (y-a.y())*(b.z()-a.z()))/denom;
+          const double l0 = 1.0 - l1 - l2;
+          if (l0 < 0.0 || l1 < 0.0 || l2 < 0.0) continue;
+          crossings[j + ny*(k-kstart)].push_back(l0*a.x() + l1*b.x() + l2*e.x());
+        }
+    }
+  }
+
+  for (VMesh::index_type k = kstart; k < kend; k++)
+    for (VMesh::index_type j = 0; j < ny; j++)
+    {
+      std::vector<double>& x = crossings[j + ny*(k-kstart)];
+      if (x.empty()) continue;
+      std::sort(x.begin(), x.end());
+
+      size_t p = 0;
+      for (VMesh::index_type i = 0; i < nx; i++)
+      {
+        while (p < x.size() && x[p] < i) p++;
+        if (p & 1)
+        {
+          double& d = distance[i + nx*(j + ny*k)];
+          d = -d;
+        }
+      }
+    }
+}
+
+bool
+RegularGridDistanceTransform::apply_sign(std::vector<double>& distance) const
+{
+  if (!is_sign_supported()) return (false);
+  if (distance.size() != static_cast<size_t>(dim_[0]*dim_[1]*dim_[2])) return (false);
+
+  const int nproc = Parallel::NumCores();
+  auto scan_task = [this, &distance, nproc](int i) { scan_convert(distance, i, nproc); };
+  Parallel::RunTasks(scan_task, nproc);
+
+  return (true);
+}
@@ -0,0 +1,130 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef CORE_ALGORITHMS_FIELDS_DISTANCEFIELD_REGULARGRIDDISTANCETRANSFORM_H
+#define CORE_ALGORITHMS_FIELDS_DISTANCEFIELD_REGULARGRIDDISTANCETRANSFORM_H 1
+
+#include <vector>
+#include <Core/Algorithms/Base/AlgorithmBase.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/GeometryPrimitives/Point.h>
+#include <Core/GeometryPrimitives/Transform.h>
+#include <Core/Algorithms/Legacy/Fields/share.h>
+
+namespace SCIRun {
+  namespace Core {
+    namespace Algorithms {
+      namespace Fields {
+
+        ALGORITHM_PARAMETER_DECL(UseDistanceTransform);
+
+        /// @class RegularGridDistanceTransform
+        /// @brief Distance map of an object mesh sampled on an axis aligned LatVolMesh.
+        ///
+        /// Instead of a closest element search per destination value, the object
+        /// is rasterized into the grid: every grid sample within one cell of an
+        /// object element records the closest point on that element and the
+        /// element itself. These feature points are propagated through the grid
+        /// with a separable feature transform, one pass per axis, in which every
+        /// sample keeps the feature point closest to it among those on its grid
+        /// line. Each sample then takes the closest of its own and its six
+        /// neighbors' elements and walks over the elements sharing a node with
+        /// it until none is closer. A second round of passes starts from these
+        /// closest points.
+        ///
+        /// The result is an approximation of the distance map computed by the
+        /// closest element search. Every value is the exact distance to some
+        /// element of the object, so it is never less than the true distance,
+        /// and samples within one cell of the object are exact. Further away a
+        /// value is larger than the true distance if the closest element is not
+        /// reached by walking from the propagated element, which happens at
+        /// samples almost equally far from two separate parts of the surface.
+        /// There is no proven bound on this error. The tests compare against
+        /// the closest element search: for closed, connected surfaces the
+        /// values match, for hundreds of disconnected triangles a few samples
+        /// are too large by up to a fifth of the grid spacing, and the tests
+        /// fail above half of it.
+        ///
+        /// The sign for signed distance maps is found by scan conversion: grid
+        /// lines along the first axis are intersected with the surface and the
+        /// samples with an odd number of crossings in front of them are inside.
+        /// This requires a closed surface.
+
+        class SCISHARE RegularGridDistanceTransform
+        {
+        public:
+          RegularGridDistanceTransform(VMesh* grid, VMesh* object, int basis_order, const AlgorithmBase* algo);
+
+          /// Check whether the grid and object allow for the fast path.
+          bool is_supported() const;
+          bool is_sign_supported() const;
+
+          /// Compute unsigned distances for all values of the grid field,
+          /// values further away than maxdist are set to maxdist.
+          bool compute_distance(std::vector<double>& distance, double maxdist) const;
+
+          /// Negate the distances of all samples inside the closed object surface.
+          bool apply_sign(std::vector<double>& distance) const;
+
+        private:
+          void index_point(Geometry::Point& p, const Geometry::Point& world) const;
+          void world_point(Geometry::Point& p, VMesh::index_type i, VMesh::index_type j, VMesh::index_type k) const;
+
+          /// Closest point, in index space, and the element it lies on
+          struct Feature
+          {
+            Geometry::Point point;
+            VMesh::index_type elem;
+          };
+
+          void rasterize(std::vector<Feature>& features, std::vector<double>& dist2, int proc, int nproc) const;
+          void transform_lines(std::vector<Feature>& features, int axis, int proc, int nproc) const;
+          void closest_elements(const std::vector<Feature>& features, std::vector<Feature>& closest, std::vector<double>& distance, int proc, int nproc) const;
+          void scan_convert(std::vector<double>& distance, int proc, int nproc) const;
+
+          void slab_range(int proc, int nproc, VMesh::index_type& start, VMesh::index_type& end, VMesh::size_type size) const;
+
+          VMesh* grid_;
+          VMesh* object_;
+          const AlgorithmBase* algo_;
+
+          Geometry::Transform transform_;
+          VMesh::size_type dim_[3];
+          double spacing_[3];
+          double offset_;
+          bool supported_;
+          std::vector<Geometry::Point> elem_points_;
+          std::vector<VMesh::index_type> elem_nodes_;
+          std::vector<VMesh::index_type> node_elems_start_;
+          std::vector<VMesh::index_type> node_elems_;
+          VMesh::size_type nodes_per_elem_;
+        };
+
+      }}}}
+
+#endif
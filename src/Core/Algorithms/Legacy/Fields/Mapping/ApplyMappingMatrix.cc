@@ -42,6 +42,7 @@
 #include <Core/GeometryPrimitives/Point.h>
 #include <Core/GeometryPrimitives/Tensor.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Thread/Parallel.h>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -53,6 +54,7 @@ using namespace SCIRun::Core::Datatypes;
 using namespace SCIRun::Core::Algorithms::Fields;
 using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Thread;
 
 /// Internal function to this algorithm: no need for this function to be
 /// public. It is called from the algorithm class only.
@@ -64,28 +66,38 @@ ApplyMappingMatrixT(const ApplyMappingMatrixAlgo* algo,
                     SparseRowMatrixHandle mapping);
 
 /// This is the basic algorithm behind the mapping algorithm
+/// Every row only writes its own output value, hence the rows can be
+/// split over the threads without any locking.
 template <class DATA> 
 bool
 ApplyMappingMatrixT(const ApplyMappingMatrixAlgo* algo,
                     const VField* input, VField* output,
                     SparseRowMatrixHandle mapping)
 {
-  double* vals = mapping->valuePtr();
+  const double* vals = mapping->valuePtr();
   const index_type* rows = mapping->get_rows();
   const index_type* columns = mapping->get_cols();
   const size_type m = mapping->nrows();
 
- index_type cnt=0;
- for (index_type idx=0; idx<m; idx++)
- {
-  DATA val(0);
-  index_type rr = rows[idx];
-  size_type  ss = rows[idx+1]-rows[idx];
-  input->get_weighted_value(val,&(columns[rr]),&(vals[rr]),ss);
-
-  output->set_value(val,idx);
-  cnt++; if (cnt==400) {algo->update_progress((double)idx/m); cnt=0;}  
- }
+  const int np = Parallel::NumCores();
+  auto task_i = [&](int proc)
+  {
+    const index_type start = (m*proc)/np;
+    const index_type end = (m*(proc+1))/np;
+    index_type cnt=0;
+    for (index_type idx=start; idx<end; idx++)
+    {
+      index_type rr = rows[idx];
+      size_type  ss = rows[idx+1]-rows[idx];
+      if (ss == 0) continue;
+
+      DATA val(0);
+      input->get_weighted_value(val,&(columns[rr]),&(vals[rr]),ss);
+      output->set_value(val,idx);
+      if (proc == 0) { cnt++; if (cnt==400) {algo->update_progress_max(idx,end); cnt=0;} }
+    }
+  };
+  Parallel::RunTasks(task_i, np);
 
   return true;
 }
@@ -176,6 +188,12 @@ FieldHandle ApplyMappingMatrixAlgo::run(FieldHandle& isrc, FieldHandle& idst, Ma
     THROW_ALGORITHM_INPUT_ERROR("Could not create output field");
   } 
   
+  apply(ifsrc,ofield,matrix);
+  return output;
+}
+
+bool ApplyMappingMatrixAlgo::apply(VField* ifsrc, VField* ofield, SparseRowMatrixHandle matrix) const
+{
   /// Simple table to deal with the various data type formats
   /// Note that not every data type is handled, all char, shorts etc,
   /// are automatically handled by the int, and unsigned int case, by
@@ -183,44 +201,32 @@ FieldHandle ApplyMappingMatrixAlgo::run(FieldHandle& isrc, FieldHandle& idst, Ma
   /// used datatypes and hence have no specific algorithm in place).
   /// Similarly floats are casted to doubles.
 
-  if (isrc->vfield()->is_char()) 
-    if (ApplyMappingMatrixT<char>(this,ifsrc,ofield,matrix))
-       return output;
-  if (isrc->vfield()->is_unsigned_char()) 
-    if (ApplyMappingMatrixT<unsigned char>(this,ifsrc,ofield,matrix))
-        return output;
-  if (isrc->vfield()->is_short()) 
-    if (ApplyMappingMatrixT<short>(this,ifsrc,ofield,matrix))
-        return output;  
-  if (isrc->vfield()->is_unsigned_short()) 
-    if (ApplyMappingMatrixT<unsigned short>(this,ifsrc,ofield,matrix))
-       return output;
-  if (isrc->vfield()->is_int()) 
-    if (ApplyMappingMatrixT<int>(this,ifsrc,ofield,matrix))
-       return output;
-  if (isrc->vfield()->is_unsigned_int()) 
-    if (ApplyMappingMatrixT<unsigned int>(this,ifsrc,ofield,matrix))
-       return output;
-  if (isrc->vfield()->is_longlong()) 
-    if (ApplyMappingMatrixT<long long>(this,ifsrc,ofield,matrix))
-       return output;
-  if (isrc->vfield()->is_unsigned_longlong()) 
-    if (ApplyMappingMatrixT<unsigned long long>(this,ifsrc,ofield,matrix))
-       return output;
-  if (isrc->vfield()->is_float()) 
-    if (ApplyMappingMatrixT<float>(this,ifsrc,ofield,matrix))
-       return output; 
-  if (isrc->vfield()->is_double()) 
-    if (ApplyMappingMatrixT<double>(this,ifsrc,ofield,matrix))
-       return output;  
-  if (isrc->vfield()->is_vector()) 
-    if (ApplyMappingMatrixT<Vector>(this,ifsrc,ofield,matrix))
-       return output;    
-  if (isrc->vfield()->is_tensor()) 
-    if (ApplyMappingMatrixT<Tensor>(this,ifsrc,ofield,matrix))
-       return output;
-
-  return output;
+  if (ifsrc->is_char()) 
+    return ApplyMappingMatrixT<char>(this,ifsrc,ofield,matrix);
+  if (ifsrc->is_unsigned_char()) 
+    return ApplyMappingMatrixT<unsigned char>(this,ifsrc,ofield,matrix);
+  if (ifsrc->is_short()) 
+    return ApplyMappingMatrixT<short>(this,ifsrc,ofield,matrix);
+  if (ifsrc->is_unsigned_short()) 
+    return ApplyMappingMatrixT<unsigned short>(this,ifsrc,ofield,matrix);
+  if (ifsrc->is_int()) 
+    return ApplyMappingMatrixT<int>(this,ifsrc,ofield,matrix);
+  if (ifsrc->is_unsigned_int()) 
+    return ApplyMappingMatrixT<unsigned int>(this,ifsrc,ofield,matrix);
+  if (ifsrc->is_longlong()) 
+    return ApplyMappingMatrixT<long long>(this,ifsrc,ofield,matrix);
+  if (ifsrc->is_unsigned_longlong()) 
+    return ApplyMappingMatrixT<unsigned long long>(this,ifsrc,ofield,matrix);
+  if (ifsrc->is_float()) 
+    return ApplyMappingMatrixT<float>(this,ifsrc,ofield,matrix);
+  if (ifsrc->is_double()) 
+    return ApplyMappingMatrixT<double>(this,ifsrc,ofield,matrix);
+  if (ifsrc->is_vector()) 
+    return ApplyMappingMatrixT<Vector>(this,ifsrc,ofield,matrix);
+  if (ifsrc->is_tensor()) 
+    return ApplyMappingMatrixT<Tensor>(this,ifsrc,ofield,matrix);
+
+  return false;
 }
 
 
@@ -37,6 +37,7 @@
 /// Datatypes used
 #include <Core/Datatypes/Legacy/Field/Field.h>
 #include <Core/Datatypes/Legacy/Field/Mesh.h>
+#include <Core/Datatypes/MatrixFwd.h>
 #include <Core/Math/MiscMath.h>
 /// Base for algorithm
 #include <Core/Algorithms/Base/AlgorithmBase.h>
@@ -62,6 +63,11 @@ class SCISHARE ApplyMappingMatrixAlgo : public AlgorithmBase
     /// Algorithm Functions
     FieldHandle run(FieldHandle& isrc, FieldHandle& idst, Datatypes::MatrixHandle& mapping) const;
     virtual AlgorithmOutput run(const AlgorithmInput &) const;
+
+    /// Multiply the source values with the mapping matrix and store them in
+    /// output. Rows without entries leave the output value untouched. The
+    /// rows are distributed over all cores.
+    bool apply(VField* input, VField* output, Datatypes::SparseRowMatrixHandle mapping) const;
 };
 
 } /// namespace SCIRunAlgo
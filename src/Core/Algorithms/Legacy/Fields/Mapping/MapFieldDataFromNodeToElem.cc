@@ -80,7 +80,35 @@ MapFieldDataFromNodeToElemT(const MapFieldDataFromNodeToElemAlgo* algo,
   mesh->size(sz);
   index_type cnt = 0, c = 0;
 
-  if ((method == "Average") || (method == "Interpolation"))
+  /// When values and connectivity are stored explicitly, work directly on
+  /// the arrays instead of going through the virtual interface per value.
+  FieldArrayView<DATA> ivalues = ifield->template view<DATA>();
+  FieldArrayView<DATA> ovalues = ofield->template view<DATA>();
+  FieldArrayView<VMesh::index_type> elemnodes = mesh->elem_nodes_view();
+
+  if (ivalues && ovalues && elemnodes && ovalues.size() == elemnodes.size() &&
+      ((method == "Average") || (method == "Interpolation") || (method == "Sum")))
+  {
+    const VMesh::size_type nsize = elemnodes.stride();
+    const bool average = (method != "Sum");
+    const double scale = 1.0 / static_cast<double>(nsize);
+    for (VMesh::index_type e = 0; e < elemnodes.size(); e++)
+    {
+      if (cnt == 0) Interruptible::checkForInterruption();
+      const VMesh::index_type* enodes = elemnodes.record(e);
+      DATA val(0);
+      for (VMesh::size_type p = 0; p < nsize; p++) val += ivalues[enodes[p]];
+      if (average) val = static_cast<DATA>(val * scale);
+      ovalues[e] = val;
+      cnt++;
+      if (cnt == 1000)
+      {
+        cnt = 0; c += 1000;
+        algo->update_progress_max(c, sz);
+      }
+    }
+  }
+  else if ((method == "Average") || (method == "Interpolation"))
   {
     DATA tval(0);
     while (it != eit)
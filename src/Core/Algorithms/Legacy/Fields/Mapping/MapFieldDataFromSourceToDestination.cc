@@ -27,6 +27,8 @@
 */
 
 #include <Core/Algorithms/Legacy/Fields/Mapping/MapFieldDataFromSourceToDestination.h>
+#include <Core/Algorithms/Legacy/Fields/Mapping/BuildMappingMatrixAlgo.h>
+#include <Core/Algorithms/Legacy/Fields/Mapping/ApplyMappingMatrix.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Thread/Parallel.h>
@@ -37,6 +39,7 @@
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
 #include <Core/Datatypes/Matrix.h>
 #include <Core/Datatypes/SparseRowMatrix.h>
+#include <Core/Datatypes/MatrixTypeConversions.h>
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 
 #include <boost/scoped_ptr.hpp>
@@ -52,15 +55,30 @@ using namespace SCIRun;
 
 ALGORITHM_PARAMETER_DEF(Fields, DefaultValue);
 ALGORITHM_PARAMETER_DEF(Fields, MappingMethod);
+ALGORITHM_PARAMETER_DEF(Fields, ReuseMappingMatrix);
 
 const AlgorithmOutputName MapFieldDataFromSourceToDestinationAlgo::Remapped_Destination("Remapped_Destination");
+const AlgorithmOutputName MapFieldDataFromSourceToDestinationAlgo::Mapping("Mapping");
 
-MapFieldDataFromSourceToDestinationAlgo::MapFieldDataFromSourceToDestinationAlgo()
+MapFieldDataFromSourceToDestinationAlgo::MapFieldDataFromSourceToDestinationAlgo() : cacheLock_("MapFieldDataFromSourceToDestination cache")
 {
   using namespace Parameters;
   addParameter(DefaultValue, 0.0);
   addParameter(MaxDistance, -1.0);
   addOption(MappingMethod, "interpolateddata", "interpolateddata|closestdata|singledestination");
+  addParameter(ReuseMappingMatrix, false);
+}
+
+MapFieldDataFromSourceToDestinationAlgo::MappingKey::MappingKey() :
+  source_mesh_(-1), destination_mesh_(-1), source_basis_(-1), destination_basis_(-1), maxdist_(0.0)
+{
+}
+
+bool MapFieldDataFromSourceToDestinationAlgo::MappingKey::operator==(const MappingKey& other) const
+{
+  return source_mesh_ == other.source_mesh_ && destination_mesh_ == other.destination_mesh_ &&
+    source_basis_ == other.source_basis_ && destination_basis_ == other.destination_basis_ &&
+    method_ == other.method_ && maxdist_ == other.maxdist_;
 }
 
 namespace detail
@@ -457,6 +475,74 @@ MapFieldDataFromSourceToDestinationInterpolatedDataPAlgo::parallel(int proc)
 
 bool
 MapFieldDataFromSourceToDestinationAlgo::runImpl(FieldHandle source, FieldHandle destination, FieldHandle& output) const
+{
+  MatrixHandle mapping;
+  return runImpl(source, destination, output, mapping);
+}
+
+bool
+MapFieldDataFromSourceToDestinationAlgo::runMapping(FieldHandle source, FieldHandle output, MatrixHandle& mapping) const
+{
+  using namespace Parameters;
+
+  MappingKey key;
+  key.source_mesh_ = source->mesh()->id();
+  key.destination_mesh_ = output->mesh()->id();
+  key.source_basis_ = source->vfield()->basis_order();
+  key.destination_basis_ = output->vfield()->basis_order();
+  key.method_ = getOption(MappingMethod);
+  key.maxdist_ = get(MaxDistance).toDouble();
+
+  SparseRowMatrixHandle matrix;
+  {
+    Guard g(cacheLock_.get());
+    if (cachedMapping_ && cachedKey_ == key)
+      matrix = cachedMapping_;
+  }
+
+  if (!matrix)
+  {
+    BuildMappingMatrixAlgo builder;
+    builder.setUpdaterFunc(getUpdaterFunc());
+    builder.set(MaxDistance, key.maxdist_);
+    builder.setOption(MappingMethod, key.method_);
+
+    MatrixHandle built;
+    if (!builder.runImpl(source, output, built))
+    {
+      error("Could not build the mapping matrix");
+      return (false);
+    }
+    matrix = castMatrix::toSparse(built);
+    if (!matrix)
+    {
+      error("Mapping matrix needs to be sparse");
+      return (false);
+    }
+
+    Guard g(cacheLock_.get());
+    cachedKey_ = key;
+    cachedMapping_ = matrix;
+  }
+  else
+  {
+    remark("Reusing mapping matrix");
+  }
+
+  ApplyMappingMatrixAlgo applier;
+  applier.setUpdaterFunc(getUpdaterFunc());
+  if (!applier.apply(source->vfield(), output->vfield(), matrix))
+  {
+    error("Could not apply the mapping matrix");
+    return (false);
+  }
+
+  mapping = matrix;
+  return (true);
+}
+
+bool
+MapFieldDataFromSourceToDestinationAlgo::runImpl(FieldHandle source, FieldHandle destination, FieldHandle& output, MatrixHandle& mapping) const
 {
   ScopedAlgorithmStatusReporter asr(this, "MapFieldDataFromSourceToDestination");
   using namespace Parameters;
@@ -514,6 +600,15 @@ MapFieldDataFromSourceToDestinationAlgo::runImpl(FieldHandle source, FieldHandle
     return (false);
   }
 
+  if (get(ReuseMappingMatrix).toBool())
+  {
+    if (!runMapping(source, output, mapping))
+      return (false);
+
+    CopyProperties(*destination, *output);
+    return (true);
+  }
+
   if (method == "closestdata")
   {
     if (sbasis_order == 0) smesh->synchronize(Mesh::FIND_CLOSEST_ELEM_E);
@@ -580,11 +675,13 @@ AlgorithmOutput MapFieldDataFromSourceToDestinationAlgo::run(const AlgorithmInpu
   auto destination = input.get<Field>(Variables::Destination);
 
   FieldHandle output_field;
-  if (!runImpl(source, destination, output_field))
+  MatrixHandle mapping;
+  if (!runImpl(source, destination, output_field, mapping))
     THROW_ALGORITHM_PROCESSING_ERROR("False returned from legacy run call");
 
   AlgorithmOutput output;
   output[Remapped_Destination] = output_field;
+  output[Mapping] = mapping;
 
   return output;
 }
@@ -33,6 +33,9 @@
 #include <Core/Algorithms/Base/AlgorithmBase.h>
 #include <Core/Algorithms/Legacy/Fields/Mapping/MapFieldDataOntoNodes.h>
 #include <Core/Thread/Interruptible.h>
+#include <Core/Datatypes/MatrixFwd.h>
+#include <Core/Datatypes/Datatype.h>
+#include <Core/Thread/Mutex.h>
 #include <Core/Algorithms/Legacy/Fields/share.h>
 
 namespace SCIRun {
@@ -42,6 +45,7 @@ namespace SCIRun {
 
         ALGORITHM_PARAMETER_DECL(DefaultValue);
         ALGORITHM_PARAMETER_DECL(MappingMethod);
+        ALGORITHM_PARAMETER_DECL(ReuseMappingMatrix);
 
         class SCISHARE MapFieldDataFromSourceToDestinationAlgo : public AlgorithmBase, public Thread::Interruptible
         {
@@ -49,10 +53,36 @@ namespace SCIRun {
           MapFieldDataFromSourceToDestinationAlgo();
 
           bool runImpl(FieldHandle source, FieldHandle destination, FieldHandle& output) const;
+          /// When ReuseMappingMatrix is set the interpolation weights are stored in a
+          /// sparse matrix, which is returned in mapping and reused as long as the
+          /// source and destination meshes and the mapping settings do not change.
+          bool runImpl(FieldHandle source, FieldHandle destination, FieldHandle& output, Datatypes::MatrixHandle& mapping) const;
 
           virtual AlgorithmOutput run(const AlgorithmInput& input) const override;
 
           static const Core::Algorithms::AlgorithmOutputName Remapped_Destination;
+          static const Core::Algorithms::AlgorithmOutputName Mapping;
+
+        private:
+          /// Meshes are identified by their unique id, a mesh that is modified in
+          /// place keeps its id and will not invalidate the cached matrix.
+          struct MappingKey
+          {
+            MappingKey();
+            bool operator==(const MappingKey& other) const;
+            Datatypes::Datatype::id_type source_mesh_;
+            Datatypes::Datatype::id_type destination_mesh_;
+            int source_basis_;
+            int destination_basis_;
+            std::string method_;
+            double maxdist_;
+          };
+
+          bool runMapping(FieldHandle source, FieldHandle output, Datatypes::MatrixHandle& mapping) const;
+
+          mutable Thread::Mutex cacheLock_;
+          mutable MappingKey cachedKey_;
+          mutable Datatypes::SparseRowMatrixHandle cachedMapping_;
         };
 
       }
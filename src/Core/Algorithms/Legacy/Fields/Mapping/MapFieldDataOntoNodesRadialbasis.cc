@@ -0,0 +1,355 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Core/Algorithms/Legacy/Fields/Mapping/MapFieldDataOntoNodesRadialbasis.h>
+#include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
+#include <Core/Thread/Parallel.h>
+
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Datatypes/SparseRowMatrix.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/GeometryPrimitives/BBox.h>
+
+#include <Eigen/SVD>
+#include <Eigen/IterativeLinearSolvers>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Thread;
+using namespace SCIRun;
+
+ALGORITHM_PARAMETER_DEF(Fields, RadialBasisFunction);
+ALGORITHM_PARAMETER_DEF(Fields, SupportRadius);
+
+MapFieldDataOntoNodesRadialbasisAlgo::MapFieldDataOntoNodesRadialbasisAlgo()
+{
+  using namespace Parameters;
+  addOption(RadialBasisFunction, "thin-plate-spline", "thin-plate-spline|wendland");
+  addParameter(SupportRadius, 0.0);
+  addParameter(OutsideValue, 0.0);
+  addParameter(MaxDistance, std::numeric_limits<double>::max());
+}
+
+namespace
+{
+  double thin_plate_spline(double r)
+  {
+    return r > 0 ? r * r * std::log(r) : 0.0;
+  }
+
+  /// Wendland's C2 function (1-q)^4 (4q+1), q = r/radius: positive definite in 3D and zero beyond radius
+  double wendland(double r, double radius)
+  {
+    const double q = r / radius;
+    if (q >= 1.0)
+      return 0.0;
+    const double s = (1.0 - q) * (1.0 - q);
+    return s * s * (4.0 * q + 1.0);
+  }
+
+  int number_of_tasks(size_t size)
+  {
+    return std::max(1, std::min(static_cast<int>(Parallel::NumCores()), static_cast<int>(size / 1000)));
+  }
+
+  /// Six times the mean distance from a source node to its closest neighbor, estimated from up to 1000 nodes.
+  /// The search starts at the spacing the nodes would have if they filled their bounding box and is doubled
+  /// until a neighbor shows up, which also covers nodes on a surface or a line.
+  double automatic_support_radius(VMesh* smesh, const std::vector<Point>& points)
+  {
+    const size_t n = points.size();
+    const Vector diagonal = smesh->get_bounding_box().diagonal();
+    const double search = std::max(std::cbrt(diagonal.x() * diagonal.y() * diagonal.z() / n), diagonal.length() / n);
+    if (!(search > 0))
+      return 1.0;
+
+    const size_t stride = std::max<size_t>(1, n / 1000);
+    double sum = 0;
+    size_t count = 0;
+    std::vector<VMesh::Node::index_type> neighbors;
+    for (size_t i = 0; i < n; i += stride)
+    {
+      double closest = std::numeric_limits<double>::max();
+      for (double r = search; closest == std::numeric_limits<double>::max() && r <= 2 * diagonal.length(); r *= 2)
+      {
+        smesh->find_closest_nodes(neighbors, points[i], r);
+        for (auto j : neighbors)
+          if (static_cast<size_t>(j) != i)
+            closest = std::min(closest, (points[j] - points[i]).length());
+      }
+      if (closest < std::numeric_limits<double>::max())
+      {
+        sum += closest;
+        count++;
+      }
+    }
+    return sum > 0 ? 6.0 * sum / count : 1.0;
+  }
+
+  /// The dense thin plate spline system, solved in the least squares sense like the original module did.
+  std::vector<double> solve_thin_plate_spline(const std::vector<Point>& points, const std::vector<double>& values)
+  {
+    const size_t n = points.size();
+    DenseMatrix sigma(n, n);
+    const int np = number_of_tasks(n);
+    Parallel::RunTasks([&](int proc)
+    {
+      for (size_t i = n * proc / np; i < n * (proc + 1) / np; i++)
+        for (size_t j = 0; j < n; j++)
+          sigma(i, j) = thin_plate_spline((points[i] - points[j]).length());
+    }, np);
+
+    Eigen::Map<const Eigen::VectorXd> rhs(values.data(), n);
+    Eigen::BDCSVD<DenseMatrix::EigenBase> svd(sigma, Eigen::ComputeThinU | Eigen::ComputeThinV);
+    Eigen::VectorXd coefficients = svd.solve(rhs);
+    return std::vector<double>(coefficients.data(), coefficients.data() + n);
+  }
+
+  /// Assembles the sparse Wendland system straight into compressed row storage: every thread collects the
+  /// neighbors of a contiguous range of source nodes, which are then copied behind each other.
+  bool solve_wendland(VMesh* smesh, const std::vector<Point>& points, const std::vector<double>& values, double radius,
+    std::vector<double>& coefficients, int& iterations)
+  {
+    typedef SparseRowMatrix::StorageIndex StorageIndex;
+    const size_t n = points.size();
+    const int np = number_of_tasks(n);
+    std::vector<std::vector<StorageIndex>> columns(np);
+    std::vector<std::vector<double>> entries(np);
+    std::vector<StorageIndex> row_counts(n);
+
+    Parallel::RunTasks([&](int proc)
+    {
+      std::vector<VMesh::Node::index_type> neighbors;
+      for (size_t i = n * proc / np; i < n * (proc + 1) / np; i++)
+      {
+        smesh->find_closest_nodes(neighbors, points[i], radius);
+        std::sort(neighbors.begin(), neighbors.end());
+        for (auto j : neighbors)
+        {
+          columns[proc].push_back(static_cast<StorageIndex>(j));
+          entries[proc].push_back(wendland((points[i] - points[j]).length(), radius));
+        }
+        row_counts[i] = static_cast<StorageIndex>(neighbors.size());
+      }
+    }, np);
+
+    SparseRowMatrix sigma(static_cast<int>(n), static_cast<int>(n));
+    StorageIndex* rows = sigma.outerIndexPtr();
+    rows[0] = 0;
+    for (size_t i = 0; i < n; i++)
+      rows[i + 1] = rows[i] + row_counts[i];
+    sigma.resizeNonZeros(rows[n]);
+    for (int proc = 0; proc < np; proc++)
+    {
+      const StorageIndex offset = rows[n * proc / np];
+      std::copy(columns[proc].begin(), columns[proc].end(), sigma.innerIndexPtr() + offset);
+      std::copy(entries[proc].begin(), entries[proc].end(), sigma.valuePtr() + offset);
+    }
+    columns.clear();
+    entries.clear();
+
+    /// the system gets ill-conditioned as the support radius grows relative to the node spacing, incomplete
+    /// Cholesky keeps the number of iterations in the tens to hundreds where plain CG needs thousands
+    Eigen::ConjugateGradient<SparseRowMatrix::EigenBase, Eigen::Lower | Eigen::Upper,
+      Eigen::IncompleteCholesky<double, Eigen::Lower, Eigen::AMDOrdering<StorageIndex> > > cg;
+    cg.setTolerance(1e-10);
+    cg.compute(sigma);
+    Eigen::Map<const Eigen::VectorXd> rhs(values.data(), n);
+    Eigen::VectorXd solution = cg.solve(rhs);
+    iterations = static_cast<int>(cg.iterations());
+    if (cg.info() != Eigen::Success)
+      return false;
+    coefficients.assign(solution.data(), solution.data() + n);
+    return true;
+  }
+}
+
+bool
+MapFieldDataOntoNodesRadialbasisAlgo::runImpl(FieldHandle source, FieldHandle destination, FieldHandle& output) const
+{
+  ScopedAlgorithmStatusReporter asr(this, "MapFieldDataOntoNodesRadialbasis");
+  using namespace Parameters;
+
+  if (!source)
+  {
+    error("No source field");
+    return (false);
+  }
+
+  if (!destination)
+  {
+    error("No destination field");
+    return (false);
+  }
+
+  VField* sfield = source->vfield();
+  VMesh* smesh = source->vmesh();
+
+  /// the elements of a point cloud are its nodes, so its constant data lives on the nodes as well
+  const bool nodedata = sfield->basis_order() == 1 || (sfield->basis_order() == 0 && smesh->is_pointcloudmesh());
+  if (!sfield->is_scalar() || !nodedata)
+  {
+    error("Source field needs scalar data on the nodes");
+    return (false);
+  }
+
+  const VMesh::size_type num_sources = smesh->num_nodes();
+  if (num_sources == 0)
+  {
+    error("Source field does not have any nodes");
+    return (false);
+  }
+
+  double radius = get(SupportRadius).toDouble();
+  if (radius < 0)
+  {
+    error("Support radius needs to be positive, or 0 to derive it from the spacing of the source nodes");
+    return (false);
+  }
+
+  FieldInformation fis(source);
+  FieldInformation fid(destination);
+  fid.set_data_type(fis.get_data_type());
+  fid.make_lineardata();
+  output = CreateField(fid, destination->mesh());
+
+  if (!output)
+  {
+    error("Could not allocate output field");
+    return (false);
+  }
+
+  VMesh* dmesh = output->vmesh();
+  VField* ofield = output->vfield();
+  ofield->resize_values();
+
+  std::vector<Point> points(num_sources);
+  std::vector<double> values(num_sources);
+  for (VMesh::Node::index_type i = 0; i < num_sources; i++)
+  {
+    smesh->get_center(points[i], i);
+    sfield->get_value(values[i], i);
+  }
+  smesh->synchronize(Mesh::NODE_LOCATE_E);
+
+  const bool compact = getOption(RadialBasisFunction) == "wendland";
+  std::vector<double> coefficients;
+  if (compact)
+  {
+    if (radius == 0)
+      radius = automatic_support_radius(smesh, points);
+
+    int iterations = 0;
+    if (!solve_wendland(smesh, points, values, radius, coefficients, iterations))
+    {
+      error("Conjugate gradients did not converge for the Wendland system, try a smaller support radius");
+      return (false);
+    }
+    remark("Solved the Wendland system with support radius " + std::to_string(radius) + " in " + std::to_string(iterations) + " iterations");
+  }
+  else
+  {
+    if (num_sources > 5000)
+      remark("Thin plate splines need a dense system, use the wendland radial basis function for large source fields");
+    coefficients = solve_thin_plate_spline(points, values);
+  }
+
+  const double maxdist = get(MaxDistance).toDouble();
+  const double outsidevalue = get(OutsideValue).toDouble();
+  const VMesh::size_type num_destinations = dmesh->num_nodes();
+  const int np = number_of_tasks(num_destinations);
+
+  Parallel::RunTasks([&](int proc)
+  {
+    std::vector<VMesh::Node::index_type> neighbors;
+    const VMesh::Node::index_type begin = static_cast<VMesh::Node::index_type>(static_cast<long long>(num_destinations) * proc / np);
+    const VMesh::Node::index_type end = static_cast<VMesh::Node::index_type>(static_cast<long long>(num_destinations) * (proc + 1) / np);
+    for (VMesh::Node::index_type idx = begin; idx < end; idx++)
+    {
+      Point p;
+      dmesh->get_center(p, idx);
+
+      double value = outsidevalue;
+      bool inside = true;
+      if (maxdist < std::numeric_limits<double>::max())
+      {
+        double dist;
+        Point r;
+        VMesh::Node::index_type closest = 0;
+        inside = smesh->find_closest_node(dist, r, closest, p, maxdist);
+      }
+
+      if (inside && compact)
+      {
+        smesh->find_closest_nodes(neighbors, p, radius);
+        if (!neighbors.empty())
+        {
+          value = 0.0;
+          for (auto j : neighbors)
+            value += coefficients[j] * wendland((p - points[j]).length(), radius);
+        }
+      }
+      else if (inside)
+      {
+        value = 0.0;
+        for (size_t j = 0; j < points.size(); j++)
+          value += coefficients[j] * thin_plate_spline((p - points[j]).length());
+      }
+      ofield->set_value(value, idx);
+    }
+  }, np);
+
+  CopyProperties(*destination, *output);
+
+  return (true);
+}
+
+AlgorithmOutput MapFieldDataOntoNodesRadialbasisAlgo::run(const AlgorithmInput& input) const
+{
+  auto source = input.get<Field>(Variables::Source);
+  auto destination = input.get<Field>(Variables::Destination);
+
+  FieldHandle output_field;
+  if (!runImpl(source, destination, output_field))
+    THROW_ALGORITHM_PROCESSING_ERROR("False returned from legacy run call");
+
+  AlgorithmOutput output;
+  output[Variables::OutputField] = output_field;
+
+  return output;
+}
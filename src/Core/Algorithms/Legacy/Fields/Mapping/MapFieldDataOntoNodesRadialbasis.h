@@ -0,0 +1,67 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef CORE_ALGORITHMS_FIELDS_MAPPING_MAPFIELDDATAONTONODESRADIALBASIS_H
+#define CORE_ALGORITHMS_FIELDS_MAPPING_MAPFIELDDATAONTONODESRADIALBASIS_H 1
+
+#include <Core/Algorithms/Base/AlgorithmBase.h>
+#include <Core/Algorithms/Legacy/Fields/Mapping/MapFieldDataOntoNodes.h>
+#include <Core/Algorithms/Legacy/Fields/share.h>
+
+namespace SCIRun {
+  namespace Core {
+    namespace Algorithms {
+      namespace Fields {
+
+        ALGORITHM_PARAMETER_DECL(RadialBasisFunction);
+        ALGORITHM_PARAMETER_DECL(SupportRadius);
+
+        /// Interpolates scalar data on the nodes of a source field, typically scattered measurements in a point
+        /// cloud, onto the nodes of a destination mesh with radial basis functions.
+        ///
+        /// The thin plate spline couples every pair of source nodes and is solved densely with an SVD, which
+        /// limits it to a few thousand nodes. The compactly supported Wendland C2 function only couples nodes
+        /// closer than SupportRadius: its system is sparse and positive definite, it is solved with conjugate
+        /// gradients and evaluated from the source mesh's node locate grid, so 100k source nodes are feasible.
+        /// A SupportRadius of 0 picks six times the mean distance between neighboring source nodes; a larger
+        /// radius interpolates more accurately between the nodes at the cost of a denser system.
+        ///
+        /// Destination nodes farther than MaxDistance from the closest source node, or outside the support of every
+        /// Wendland function, are set to OutsideValue.
+        class SCISHARE MapFieldDataOntoNodesRadialbasisAlgo : public AlgorithmBase
+        {
+        public:
+          MapFieldDataOntoNodesRadialbasisAlgo();
+
+          bool runImpl(FieldHandle source, FieldHandle destination, FieldHandle& output) const;
+          virtual AlgorithmOutput run(const AlgorithmInput& input) const override;
+        };
+
+}}}}
+
+#endif
@@ -193,7 +193,6 @@ FEMBuilder<T>::build_matrix(FieldHandle input,
       auto data = mat->data();
       size_type m = mat->nrows();
       size_type n = mat->ncols();
-      Tensor tensor;
 
       // Case the table has isotropic conductivities
       if (mat->ncols() == 1)
@@ -201,16 +200,7 @@ FEMBuilder<T>::build_matrix(FieldHandle input,
         for (size_type p=0; p<m;p++)
         {
           // Set the diagonals to the proper version.
-          tensor.val(0,0) = data[p*n+0];
-          tensor.val(1,0) = 0.0;
-          tensor.val(2,0) = 0.0;
-          tensor.val(0,1) = 0.0;
-          tensor.val(1,1) = data[p*n+0];
-          tensor.val(2,1) = 0.0;
-          tensor.val(0,2) = 0.0;
-          tensor.val(1,2) = 0.0;
-          tensor.val(2,2) = data[p*n+0];
-          tensors_.push_back(std::make_pair("",tensor));
+          tensors_.push_back(std::make_pair("",Tensor(data[p*n+0])));
         }
       }
 
@@ -219,16 +209,7 @@ FEMBuilder<T>::build_matrix(FieldHandle input,
       {
         for (size_type p=0; p<m;p++)
         {
-          tensor.val(0,0) = data[0+p*n];
-          tensor.val(1,0) = data[1+p*n];
-          tensor.val(2,0) = data[2+p*n];
-          tensor.val(0,1) = data[1+p*n];
-          tensor.val(1,1) = data[3+p*n];
-          tensor.val(2,1) = data[4+p*n];
-          tensor.val(0,2) = data[2+p*n];
-          tensor.val(1,2) = data[4+p*n];
-          tensor.val(2,2) = data[5+p*n];
-          tensors_.push_back(std::make_pair("",tensor));
+          tensors_.push_back(std::make_pair("",Tensor(&data[p*n])));
         }
       }
 
@@ -237,16 +218,7 @@ FEMBuilder<T>::build_matrix(FieldHandle input,
       {
         for (size_type p=0; p<m;p++)
         {
-          tensor.val(0,0) = data[0+p*n];
-          tensor.val(1,0) = data[1+p*n];
-          tensor.val(2,0) = data[2+p*n];
-          tensor.val(0,1) = data[1+p*n];
-          tensor.val(1,1) = data[4+p*n];
-          tensor.val(2,1) = data[5+p*n];
-          tensor.val(0,2) = data[2+p*n];
-          tensor.val(1,2) = data[5+p*n];
-          tensor.val(2,2) = data[8+p*n];
-          tensors_.push_back(std::make_pair("",tensor));
+          tensors_.push_back(std::make_pair("",symmetricTensorFromNineElementArray(&data[p*n])));
         }
       }
     }
@@ -334,12 +306,13 @@ FEMBuilder<T>::build_local_matrix(VMesh::Elem::index_type c_ind,
     tensor = tensors_[tensor_index].second;
   }
 
-  auto Ca = tensor.val(0,0);
-  auto Cb = tensor.val(0,1);
-  auto Cc = tensor.val(0,2);
-  auto Cd = tensor.val(1,1);
-  auto Ce = tensor.val(1,2);
-  auto Cf = tensor.val(2,2);
+  // The six unique components of the symmetric conductivity tensor
+  auto Ca = tensor.xx();
+  auto Cb = tensor.xy();
+  auto Cc = tensor.xz();
+  auto Cd = tensor.yy();
+  auto Ce = tensor.yz();
+  auto Cf = tensor.zz();
 
   if ( (Ca==0) && (Cb==0) && (Cc==0) && (Cd==0) && (Ce==0) && (Cf==0) )
   {
@@ -450,12 +423,13 @@ FEMBuilder<T>::build_local_matrix_regular(VMesh::Elem::index_type c_ind,
     tensor = tensors_[tensor_index].second;
   }
 
-  auto Ca = tensor.val(0,0);
-  auto Cb = tensor.val(0,1);
-  auto Cc = tensor.val(0,2);
-  auto Cd = tensor.val(1,1);
-  auto Ce = tensor.val(1,2);
-  auto Cf = tensor.val(2,2);
+  // The six unique components of the symmetric conductivity tensor
+  auto Ca = tensor.xx();
+  auto Cb = tensor.xy();
+  auto Cc = tensor.xz();
+  auto Cd = tensor.yy();
+  auto Ce = tensor.yz();
+  auto Cf = tensor.zz();
 
   if ( (Ca==0) && (Cb==0) && (Cc==0) && (Cd==0) && (Ce==0) && (Cf==0) )
   {
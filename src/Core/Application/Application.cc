@@ -244,6 +244,10 @@ NetworkEditorControllerHandle Application::controller()
     auto eventCmdFactory(makeNetworkEventCommandFactory());
     private_->controller_.reset(new NetworkEditorController(moduleFactory, sf, exe, algoFactory, reexFactory, private_->cmdFactory_, eventCmdFactory));
 
+    auto prefetchBudget = parameters()->developerParameters()->prefetchBudgetMegabytes();
+    if (prefetchBudget)
+      private_->controller_->setPrefetchMemoryBudget(static_cast<size_t>(*prefetchBudget) * 1024 * 1024);
+
     /// @todo: sloppy way to initialize this but similar to v4, oh well
     IEPluginManager::Initialize();
   }
@@ -341,12 +345,12 @@ bool Application::get_user_name( std::string& user_name ) const
 std::string SaveFileCommandHelper::saveImpl(const std::string& filename)
 {
   auto fileNameWithExtension = filename;
-  if (!boost::algorithm::ends_with(fileNameWithExtension, ".srn5"))
+  if (!boost::algorithm::ends_with(fileNameWithExtension, ".srn5") && !boost::algorithm::ends_with(fileNameWithExtension, BinaryNetworkFileExtension))
     fileNameWithExtension += ".srn5";
 
   auto file = Application::Instance().controller()->saveNetwork();
 
-  if (!XMLSerializer::save_xml(*file, fileNameWithExtension, "networkFile"))
+  if (!saveNetworkFile(*file, fileNameWithExtension))
     return "";
 
   return fileNameWithExtension;
@@ -68,6 +68,7 @@ public:
       ("frameInitLimit", po::value<int>(), "ViewScene frame init limit--increase if renderer fails")
       ("guiExpandFactor", po::value<double>(), "Expansion factor for high resolution displays")
       ("max-cores", po::value<unsigned int>(), "Limit the number of cores used by multithreaded algorithms")
+      ("prefetch-budget", po::value<unsigned int>(), "Megabytes of reader module files to load in the background when a network is loaded")
       ("list-modules", "print list of available modules")
       ;
 
@@ -117,9 +118,10 @@ public:
     const boost::optional<int>& frameInitLimit,
     const boost::optional<int>& regressionTimeout,
     const boost::optional<unsigned int>& maxCores,
-    const boost::optional<double>& guiExpandFactor
+    const boost::optional<double>& guiExpandFactor,
+    const boost::optional<unsigned int>& prefetchBudget
     ) : threadMode_(threadMode), reexecuteMode_(reexecuteMode), frameInitLimit_(frameInitLimit), 
-    regressionTimeout_(regressionTimeout), maxCores_(maxCores), guiExpandFactor_(guiExpandFactor)
+    regressionTimeout_(regressionTimeout), maxCores_(maxCores), prefetchBudget_(prefetchBudget), guiExpandFactor_(guiExpandFactor)
   {}
   boost::optional<int> regressionTimeoutSeconds() const override
   {
@@ -145,10 +147,14 @@ public:
   {
     return guiExpandFactor_;
   }
+  boost::optional<unsigned int> prefetchBudgetMegabytes() const override
+  {
+    return prefetchBudget_;
+  }
 private:
   boost::optional<std::string> threadMode_, reexecuteMode_;
   boost::optional<int> frameInitLimit_, regressionTimeout_;
-  boost::optional<unsigned int> maxCores_;
+  boost::optional<unsigned int> maxCores_, prefetchBudget_;
   boost::optional<double> guiExpandFactor_;
 };
 
@@ -342,7 +348,8 @@ ApplicationParametersHandle CommandLineParser::parse(int argc, const char* argv[
         parseOptionalArg<int>(parsed, "frameInitLimit"),
         parseOptionalArg<int>(parsed, "regression"),
         parseOptionalArg<unsigned int>(parsed, "max-cores"),
-        parseOptionalArg<double>(parsed, "guiExpandFactor")
+        parseOptionalArg<double>(parsed, "guiExpandFactor"),
+        parseOptionalArg<unsigned int>(parsed, "prefetch-budget")
       ),
       ApplicationParametersImpl::Flags(
         parsed.count("help") != 0,
@@ -62,6 +62,8 @@ TEST(ScirunCommandLineSpecTest, CanReadBasicOptions)
     "  --guiExpandFactor arg   Expansion factor for high resolution displays\n"
     "  --max-cores arg         Limit the number of cores used by multithreaded \n"
     "                          algorithms\n"
+    "  --prefetch-budget arg   Megabytes of reader module files to load in the \n"
+    "                          background when a network is loaded\n"
     "  --list-modules          print list of available modules\n";
 
   EXPECT_EQ(expectedHelp, parser.describe());
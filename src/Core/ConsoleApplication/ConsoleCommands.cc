@@ -83,7 +83,7 @@ bool LoadFileCommandConsole::execute()
   }
   try
   {
-    auto openedFile = XMLSerializer::load_xml<NetworkFile>(filename);
+    auto openedFile = loadNetworkFile(filename);
 
     if (openedFile)
     {
@@ -46,7 +46,34 @@ ColorMap::ColorMap(ColorMapStrategyHandle color, const std::string& name, const
   : color_(color), nameInfo_(name), resolution_(resolution), shift_(shift),
   invert_(invert), rescale_scale_(rescale_scale), rescale_shift_(rescale_shift)
 {
+  buildColorLookup();
+}
+
+namespace
+{
+  // Largest resolution whose colors are tabulated; finer maps are evaluated per value.
+  const size_t maxColorLookupSize = 1 << 16;
+
+  // Values are mapped in blocks, computing all indices of a block before looking them up.
+  const size_t colorBlockSize = 256;
+}
 
+void ColorMap::buildColorLookup()
+{
+  if (!color_ || resolution_ >= maxColorLookupSize)
+    return;
+
+  // A value quantizes to one of resolution_ + 1 indices, see getColorIndex.
+  colorLookup_.resize(resolution_ + 1);
+  rgbaLookup_.resize(4 * colorLookup_.size());
+  for (size_t i = 0; i < colorLookup_.size(); ++i)
+  {
+    colorLookup_[i] = color_->getColorMapVal(getIndexedValue(i));
+    rgbaLookup_[4 * i] = static_cast<float>(colorLookup_[i].r());
+    rgbaLookup_[4 * i + 1] = static_cast<float>(colorLookup_[i].g());
+    rgbaLookup_[4 * i + 2] = static_cast<float>(colorLookup_[i].b());
+    rgbaLookup_[4 * i + 3] = static_cast<float>(colorLookup_[i].a());
+  }
 }
 
 ColorMap* ColorMap::clone() const
@@ -155,17 +182,40 @@ double ColorMap::getTransformedValue(double f) const
   }
   /////////////////////////////////////////////////
 
+  return getIndexedValue(getColorIndex(f));
+}
+
+/**
+ * @name getColorIndex
+ * @brief Rescales a raw data value and quantizes it to the resolution of the map.
+ * @param v The input value from raw data.
+ * @return Index in [0, resolution] that determines the color.
+ */
+size_t ColorMap::getColorIndex(double f) const
+{
   const double rescaled01 = static_cast<double>((f + rescale_shift_) * rescale_scale_);
 
   double v = std::min(std::max(0., rescaled01), 1.);
-  double shift = shift_;
   if (invert_) {
     v = 1.f - v;
-    shift *= -1.;
   }
   //apply the resolution
-  v = static_cast<double>((static_cast<int>(v *
-    static_cast<double>(resolution_)))) /
+  return static_cast<size_t>(static_cast<int>(v * static_cast<double>(resolution_)));
+}
+
+/**
+ * @name getIndexedValue
+ * @brief Applies the gamma shift to a quantized value.
+ * @param index A value quantized by getColorIndex.
+ * @return The value in [0,1] that is looked up in the named map.
+ */
+double ColorMap::getIndexedValue(size_t index) const
+{
+  double shift = shift_;
+  if (invert_) {
+    shift *= -1.;
+  }
+  double v = static_cast<double>(static_cast<int>(index)) /
     static_cast<double>(resolution_ - 1);
   // the shift is a gamma.
   double denom = std::tan(M_PI_2 * (0.5 - std::min(std::max(shift, -0.99), 0.99) * 0.5));
@@ -187,6 +237,9 @@ double ColorMap::getTransformedValue(double f) const
  */
 ColorRGB ColorMap::getColorMapVal(double v) const
 {
+  if (!colorLookup_.empty())
+    return colorLookup_[getColorIndex(v)];
+
   double f = getTransformedValue(v);
   //now grab the RGB
   auto colorWithoutAlpha = color_->getColorMapVal(f);
@@ -241,6 +294,65 @@ ColorRGB ColorMap::valueToColor(const Vector &vector) const {
   return getColorMapVal(vector.length());
 }
 
+/**
+ * @name valuesToColors
+ * @brief Maps an array of scalars at once, using the precomputed color table.
+ * @param values The raw data values.
+ * @param count Number of values.
+ * @param rgba Receives four floats per value.
+ * @param stride Distance in floats between the colors of consecutive values.
+ */
+void ColorMap::valuesToColors(const double* values, size_t count, float* rgba, size_t stride) const
+{
+  if (colorLookup_.empty())
+  {
+    for (size_t i = 0; i < count; ++i, rgba += stride)
+    {
+      auto color = getColorMapVal(values[i]);
+      rgba[0] = static_cast<float>(color.r());
+      rgba[1] = static_cast<float>(color.g());
+      rgba[2] = static_cast<float>(color.b());
+      rgba[3] = static_cast<float>(color.a());
+    }
+    return;
+  }
+
+  // Same arithmetic as getColorIndex. The index loops are kept free of branches and
+  // function calls so the compiler can vectorize them.
+  const double resolution = static_cast<double>(resolution_);
+  int indices[colorBlockSize];
+  for (size_t begin = 0; begin < count; begin += colorBlockSize)
+  {
+    const size_t blockSize = std::min(colorBlockSize, count - begin);
+    const double* block = values + begin;
+    if (invert_)
+    {
+      for (size_t i = 0; i < blockSize; ++i)
+      {
+        double v = 1. - std::min(std::max(0., (block[i] + rescale_shift_) * rescale_scale_), 1.);
+        indices[i] = static_cast<int>(v * resolution);
+      }
+    }
+    else
+    {
+      for (size_t i = 0; i < blockSize; ++i)
+      {
+        double v = std::min(std::max(0., (block[i] + rescale_shift_) * rescale_scale_), 1.);
+        indices[i] = static_cast<int>(v * resolution);
+      }
+    }
+
+    for (size_t i = 0; i < blockSize; ++i, rgba += stride)
+    {
+      const float* color = &rgbaLookup_[4 * indices[i]];
+      rgba[0] = color[0];
+      rgba[1] = color[1];
+      rgba[2] = color[2];
+      rgba[3] = color[3];
+    }
+  }
+}
+
 // This Rainbow takes into account scientific visualization recommendations.
 // It tones down the yellow/cyan values so they don't appear to
 // be "brighter" than the other colors. All colors "appear" to be the
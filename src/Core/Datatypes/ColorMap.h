@@ -67,12 +67,19 @@ namespace Datatypes {
     ColorRGB valueToColor(const Core::Geometry::Tensor &tensor) const;
     ColorRGB valueToColor(const Core::Geometry::Vector &vector) const;
 
+    /// Maps count scalars to RGBA floats. The colors are written stride floats apart, so they
+    /// can go straight into an interleaved vertex buffer. Same colors as valueToColor.
+    void valuesToColors(const double* values, size_t count, float* rgba, size_t stride = 4) const;
+
     virtual std::string dynamic_type_name() const override { return "ColorMap"; }
 
   private:
     ///<< Internal functions.
     Core::Datatypes::ColorRGB getColorMapVal(double v) const;
     double getTransformedValue(double v) const;
+    size_t getColorIndex(double v) const;
+    double getIndexedValue(size_t index) const;
+    void buildColorLookup();
 
     ColorMapStrategyHandle color_;
     ///<< The colormap's name.
@@ -89,6 +96,10 @@ namespace Datatypes {
     double rescale_shift_;
 
     std::vector<double> alphaLookup_;
+    ///<< Color of every quantized value, indexed by getColorIndex. Empty for resolutions too
+    ///<< large to tabulate.
+    std::vector<ColorRGB> colorLookup_;
+    std::vector<float> rgbaLookup_;
   };
 
   class SCISHARE ColorMapStrategy
@@ -0,0 +1,84 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef CORE_DATATYPES_FIELDARRAYVIEW_H
+#define CORE_DATATYPES_FIELDARRAYVIEW_H 1
+
+#include <Core/Datatypes/Legacy/Base/Types.h>
+
+namespace SCIRun {
+
+/// Typed view onto the contiguous storage of a field or mesh.
+/// A view does not own the memory it points to, it is only valid as long as
+/// the field or mesh it was obtained from is alive and is not resized.
+/// Records are stride() entries long, e.g. the connectivity of a tetrahedral
+/// mesh has a stride of four and the nodes of element e are record(e)[0..3].
+/// An invalid view (the storage is not contiguous or has a different type)
+/// converts to false, in that case callers should fall back to the virtual
+/// get_value()/get_nodes() interface.
+
+template<class T>
+class FieldArrayView
+{
+  public:
+    typedef T value_type;
+
+    FieldArrayView() :
+      data_(0), size_(0), stride_(1) {}
+
+    FieldArrayView(T* data, size_type size, size_type stride = 1) :
+      data_(data), size_(data ? size : 0), stride_(stride) {}
+
+    /// Number of records
+    inline size_type size() const { return (size_); }
+    /// Number of entries per record
+    inline size_type stride() const { return (stride_); }
+    /// Total number of entries
+    inline size_type num_entries() const { return (size_*stride_); }
+
+    inline bool valid() const { return (data_ != 0); }
+    inline explicit operator bool() const { return (valid()); }
+
+    inline T* data() const { return (data_); }
+    inline T* begin() const { return (data_); }
+    inline T* end() const { return (data_ + size_*stride_); }
+
+    /// Flat access to the entries
+    inline T& operator[](index_type idx) const { return (data_[idx]); }
+    /// Access to the first entry of a record
+    inline T* record(index_type idx) const { return (data_ + idx*stride_); }
+
+  private:
+    T*        data_;
+    size_type size_;
+    size_type stride_;
+};
+
+} // end namespace SCIRun
+
+#endif
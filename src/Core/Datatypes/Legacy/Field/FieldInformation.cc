@@ -63,6 +63,8 @@ FieldTypeInformation::insert_field_type_information(Field* field)
   temp = mesh_basis_td->get_name(); 
   mesh_basis_type = temp.substr(0,temp.find("<"));
   point_type = point_td->get_name();
+  mesh_storage_type = "";
+  if (mesh_sub_td->size() > 1) mesh_storage_type = (*mesh_sub_td)[1]->get_name();
   
   // Analyze the basis type
   
@@ -501,6 +503,18 @@ FieldInformation::get_point_type() const
   return(point_type);
 }
 
+std::string
+FieldInformation::get_mesh_storage_type() const
+{
+  return(mesh_storage_type);
+}
+
+void
+FieldInformation::set_mesh_storage_type(const std::string& type)
+{
+  mesh_storage_type = type;
+}
+
 void
 FieldInformation::set_point_type(const std::string& type)
 {
@@ -665,9 +679,12 @@ FieldInformation::get_field_type_id() const
   std::string meshptr = "";
   if ((container_type.find("2d") != std::string::npos)||(container_type.find("3d") != std::string::npos)) 
     meshptr = "," + mesh_type + "<" + mesh_basis_type + "<" + point_type + ">" + ">";
+
+  std::string storage = "";
+  if (is_compactmesh()) storage = "," + mesh_storage_type;
     
   std::string field_template = field_type + "<" + mesh_type + "<" + 
-    mesh_basis_type + "<" + point_type + ">" + ">" + "," +
+    mesh_basis_type + "<" + point_type + ">" + storage + ">" + "," +
     basis_type + "<" + data_type + ">" + "," + container_type + "<" +
     data_type + meshptr + ">" + ">";
   
@@ -680,7 +697,10 @@ FieldInformation::get_field_type_id() const
 std::string
 FieldInformation::get_mesh_type_id() const
 {
-  std::string mesh_template =  mesh_type + "<" + mesh_basis_type + "<" + point_type + ">" + ">";
+  std::string storage = "";
+  if (is_compactmesh()) storage = "," + mesh_storage_type;
+
+  std::string mesh_template =  mesh_type + "<" + mesh_basis_type + "<" + point_type + ">" + storage + ">";
   
   for (std::string::size_type r=0; r< mesh_template.size(); r++) if (mesh_template[r] == ' ') mesh_template[r] = '_';  
         
@@ -938,6 +958,15 @@ FieldTypeInformation::is_unstructuredmesh() const
   return(!is_structuredmesh());
 }
 
+bool
+FieldTypeInformation::is_compactmesh() const
+{
+  // The storage type is ignored for meshes that do not have a compact
+  // variant, so changing the mesh type never yields an unknown field type
+  return((!mesh_storage_type.empty())&&(mesh_storage_type != "long_long")&&
+         is_tetvolmesh()&&(mesh_basis_type == "TetLinearLgn"));
+}
+
 bool
 FieldTypeInformation::is_pnt_element() const
 {
@@ -1120,7 +1149,7 @@ FieldInformation::operator==(const FieldInformation& fi) const
 {
   if ( (field_type == fi.field_type) && (mesh_type == fi.mesh_type) && (mesh_basis_type == fi.mesh_basis_type) &&
        (point_type == fi.point_type) && (basis_type == fi.basis_type) && (data_type == fi.data_type) &&
-       (container_type == fi.container_type) ) return (true);
+       (container_type == fi.container_type) && (is_compactmesh() == fi.is_compactmesh()) ) return (true);
   return (false);
 }
 
@@ -1130,7 +1159,7 @@ FieldInformation::operator!=(const FieldInformation& fi) const
 {
   if ( (field_type != fi.field_type) || (mesh_type != fi.mesh_type) || (mesh_basis_type != fi.mesh_basis_type) ||
        (point_type != fi.point_type) || (basis_type != fi.basis_type) || (data_type != fi.data_type) ||
-       (container_type != fi.container_type) ) return (true);
+       (container_type != fi.container_type) || (is_compactmesh() != fi.is_compactmesh()) ) return (true);
   return (false);
 }
 
@@ -1263,6 +1292,22 @@ FieldInformation::make_unstructuredmesh()
 }
 
 
+bool
+FieldInformation::make_compactmesh()
+{
+  set_mesh_storage_type("int");
+  if (is_compactmesh()) return (true);
+  set_mesh_storage_type("");
+  return (false);
+}
+
+bool
+FieldInformation::make_standardmesh()
+{
+  set_mesh_storage_type("");
+  return (true);
+}
+
 bool
 FieldInformation::make_irregularmesh()
 {
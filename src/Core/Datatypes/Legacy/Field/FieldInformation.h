@@ -87,6 +87,10 @@ class SCISHARE FieldTypeInformation
     bool        is_irregularmesh() const;
     bool        is_structuredmesh() const;
     bool        is_unstructuredmesh() const;
+
+    // Compact meshes store their connectivity as 32-bit integers
+    // (currently linear TetVolMesh only)
+    bool        is_compactmesh() const;
     
     // These should go...
     inline bool is_pointcloud() const { return(is_pointcloudmesh()); }
@@ -140,6 +144,7 @@ class SCISHARE FieldTypeInformation
     std::string mesh_type;
     std::string mesh_basis_type;
     std::string point_type;
+    std::string mesh_storage_type;
     std::string basis_type;
     std::string data_type;
     std::string container_type;
@@ -182,6 +187,9 @@ class SCISHARE FieldInformation : public FieldTypeInformation {
     std::string get_point_type() const;
     void        set_point_type(const std::string&);
 
+    std::string get_mesh_storage_type() const;
+    void        set_mesh_storage_type(const std::string&);
+
     std::string get_basis_type() const;
     void        set_basis_type(const std::string&);
     void        set_basis_type(int);
@@ -244,6 +252,11 @@ class SCISHARE FieldInformation : public FieldTypeInformation {
 
     bool        make_unstructuredmesh();
     bool        make_irregularmesh();
+
+    // Select 32-bit connectivity storage, only supported by linear
+    // TetVolMesh, returns false for other meshes
+    bool        make_compactmesh();
+    bool        make_standardmesh();
     
     bool        operator==(const FieldInformation&) const;
     bool        operator!=(const FieldInformation&) const;
@@ -0,0 +1,185 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Core/Datatypes/Legacy/Field/LazyField.h>
+#include <Core/Persistent/Persistent.h>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/filesystem.hpp>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Logging;
+
+LazyField::LazyField(FieldHandle prototype, Loader loader) :
+  prototype_(prototype),
+  loader_(loader),
+  loaded_(false)
+{
+}
+
+bool
+LazyField::is_loaded() const
+{
+  return loaded_.load(std::memory_order_acquire);
+}
+
+FieldHandle
+LazyField::loaded_field() const
+{
+  loaded();
+  return field_;
+}
+
+Field*
+LazyField::loaded() const
+{
+  // field_ is only written once, before loaded_ is set.
+  if (loaded_.load(std::memory_order_acquire))
+    return field_.get();
+
+  boost::lock_guard<boost::mutex> lock(lock_);
+  if (!field_)
+  {
+    FieldHandle field = loader_();
+    if (!field)
+      BOOST_THROW_EXCEPTION(LazyFieldLoadFailed() << Core::ErrorMessage("Could not read field of type " + prototype_->dynamic_type_name()));
+    // The file may have been replaced since its type was read.
+    if (field->dynamic_type_name() != prototype_->dynamic_type_name())
+      BOOST_THROW_EXCEPTION(LazyFieldLoadFailed() << Core::ErrorMessage("Field type changed from " + prototype_->dynamic_type_name() + " to " + field->dynamic_type_name()));
+    field_ = field;
+    // Release whatever the loader holds on to, it is not needed anymore.
+    loader_ = Loader();
+    loaded_.store(true, std::memory_order_release);
+  }
+  return field_.get();
+}
+
+Field*
+LazyField::clone() const
+{
+  return loaded()->clone();
+}
+
+Field*
+LazyField::deep_clone() const
+{
+  return loaded()->deep_clone();
+}
+
+MeshHandle
+LazyField::mesh() const
+{
+  return loaded()->mesh();
+}
+
+VMesh*
+LazyField::vmesh() const
+{
+  return loaded()->vmesh();
+}
+
+VField*
+LazyField::vfield() const
+{
+  return loaded()->vfield();
+}
+
+int
+LazyField::basis_order() const
+{
+  return prototype_->basis_order();
+}
+
+const TypeDescription*
+LazyField::get_type_description(td_info_e td) const
+{
+  return prototype_->get_type_description(td);
+}
+
+void
+LazyField::io(Piostream& stream)
+{
+  // Only used for writing, LazyField is not registered as a persistent type.
+  loaded()->io(stream);
+}
+
+std::string
+LazyField::type_name() const
+{
+  return prototype_->type_name();
+}
+
+std::string
+LazyField::dynamic_type_name() const
+{
+  return prototype_->dynamic_type_name();
+}
+
+FieldHandle
+SCIRun::CreateLazyField(const std::string& filename, LoggerHandle pr)
+{
+  boost::system::error_code ec;
+  const auto size = boost::filesystem::file_size(filename, ec);
+  if (ec)
+    return FieldHandle();
+  const auto modified = boost::filesystem::last_write_time(filename, ec);
+  if (ec)
+    return FieldHandle();
+
+  std::string type;
+  {
+    PiostreamPtr stream = auto_istream(filename, pr);
+    if (!stream)
+      return FieldHandle();
+    type = stream->peek_object_class();
+  }
+
+  FieldHandle prototype = CreateField(type);
+  if (!prototype)
+    return FieldHandle();
+
+  auto loader = [filename, pr, size, modified]()
+  {
+    // The type was read from this exact file, do not read a different one in its place.
+    boost::system::error_code ec;
+    if (boost::filesystem::file_size(filename, ec) != size || ec
+      || boost::filesystem::last_write_time(filename, ec) != modified || ec)
+      BOOST_THROW_EXCEPTION(LazyFieldLoadFailed() << Core::ErrorMessage("File " + filename + " changed since it was opened"));
+
+    FieldHandle field;
+    PiostreamPtr stream = auto_istream(filename, pr);
+    if (stream)
+    {
+      Pio(*stream, field);
+      if (stream->error())
+        field.reset();
+    }
+    return field;
+  };
+  return boost::make_shared<LazyField>(prototype, loader);
+}
@@ -0,0 +1,92 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef CORE_DATATYPES_LEGACY_LAZYFIELD_H
+#define CORE_DATATYPES_LEGACY_LAZYFIELD_H 1
+
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Logging/LoggerFwd.h>
+#include <Core/Utils/Exception.h>
+#include <boost/function.hpp>
+#include <boost/thread/mutex.hpp>
+#include <atomic>
+#include <Core/Datatypes/Legacy/Field/share.h>
+
+namespace SCIRun {
+
+/// A field whose type is known up front, but whose mesh and data are only
+/// read when they are first accessed. Type queries are answered by an empty
+/// field of the same type, everything else loads the field and forwards to it.
+class SCISHARE LazyField : public Field
+{
+  public:
+    typedef boost::function<FieldHandle()> Loader;
+
+    LazyField(FieldHandle prototype, Loader loader);
+
+    virtual Field* clone() const override;
+    virtual Field* deep_clone() const override;
+
+    virtual MeshHandle mesh() const override;
+    virtual VMesh* vmesh() const override;
+    virtual VField* vfield() const override;
+
+    virtual int basis_order() const override;
+    virtual const TypeDescription* get_type_description(td_info_e td = FULL_TD_E) const override;
+
+    virtual void io(Piostream& stream) override;
+    virtual std::string type_name() const override;
+    virtual std::string dynamic_type_name() const override;
+
+    bool is_loaded() const;
+    /// Load the field if needed; throws LazyFieldLoadFailed if the loader returns nothing.
+    FieldHandle loaded_field() const;
+
+  private:
+    /// Loads on the first call. Once loaded, no lock is taken.
+    Field* loaded() const;
+
+    FieldHandle prototype_;
+    mutable Loader loader_;
+    mutable FieldHandle field_;
+    mutable std::atomic<bool> loaded_;
+    mutable boost::mutex lock_;
+};
+
+struct SCISHARE LazyFieldLoadFailed : virtual Core::ExceptionBase {};
+
+/// Read the type of the field stored in a SCIRun field file and return a
+/// LazyField that reads the mesh and data on first access. Returns a null
+/// handle if the file cannot be opened or its field type is not registered.
+/// The size and modification time of the file are recorded here; loading
+/// throws LazyFieldLoadFailed if either has changed by then.
+SCISHARE FieldHandle CreateLazyField(const std::string& filename, Core::Logging::LoggerHandle pr);
+
+}
+
+#endif
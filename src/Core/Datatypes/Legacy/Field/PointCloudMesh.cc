@@ -135,6 +135,13 @@ public:
                                  const Point &point,
                                  double maxdist) const;
 
+  virtual bool find_closest_nodes(std::vector<VMesh::Node::index_type>& nodes,
+                                  const Point& point, double maxdist) const;
+
+  virtual bool find_closest_nodes(std::vector<double>& distances,
+                                  std::vector<VMesh::Node::index_type>& nodes,
+                                  const Point& point, double maxdist) const;
+
   virtual bool find_closest_elem(double& pdist, Point& result,
                                  VMesh::coords_type& coords,
                                  VMesh::Elem::index_type &i,
@@ -524,6 +531,25 @@ VPointCloudMesh<MESH>::find_closest_node(double& pdist, Point& result,
 }
 
 
+template <class MESH>
+bool
+VPointCloudMesh<MESH>::find_closest_nodes(std::vector<VMesh::Node::index_type>& nodes,
+                      const Point& point, double maxdist) const
+{
+  return(this->mesh_->find_closest_nodes(nodes,point,maxdist));
+}
+
+
+template <class MESH>
+bool
+VPointCloudMesh<MESH>::find_closest_nodes(std::vector<double>& distances,
+                      std::vector<VMesh::Node::index_type>& nodes,
+                      const Point& point, double maxdist) const
+{
+  return(this->mesh_->find_closest_nodes(distances,nodes,point,maxdist));
+}
+
+
 template <class MESH>
 bool
 VPointCloudMesh<MESH>::find_closest_elem(double& pdist, Point& result,
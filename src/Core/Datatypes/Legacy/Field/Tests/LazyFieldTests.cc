@@ -0,0 +1,169 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <Core/Datatypes/Legacy/Field/LazyField.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Persistent/Persistent.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+using namespace SCIRun;
+using namespace SCIRun::TestUtils;
+
+namespace
+{
+  boost::filesystem::path tempFile(const std::string& name)
+  {
+    return boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%-" + name);
+  }
+
+  FieldHandle rampLatVol()
+  {
+    FieldHandle field = CreateEmptyLatVol(4, 5, 6, DOUBLE_E);
+    VField* vfield = field->vfield();
+    vfield->resize_values();
+    for (VMesh::index_type i = 0; i < vfield->num_values(); ++i)
+      vfield->set_value(0.5 * i, i);
+    return field;
+  }
+
+  void writeField(const boost::filesystem::path& filename, const std::string& type, FieldHandle field)
+  {
+    PiostreamPtr stream = auto_ostream(filename.string(), type);
+    ASSERT_TRUE(stream != nullptr);
+    Pio(*stream, field);
+    ASSERT_FALSE(stream->error());
+  }
+
+  FieldHandle readField(const boost::filesystem::path& filename)
+  {
+    FieldHandle field;
+    PiostreamPtr stream = auto_istream(filename.string());
+    if (stream)
+      Pio(*stream, field);
+    return field;
+  }
+}
+
+TEST(LazyFieldTests, TypeIsKnownWithoutReadingData)
+{
+  for (const std::string type : { "Binary", "Text", "Chunked" })
+  {
+    auto filename = tempFile("lazy.fld");
+    writeField(filename, type, rampLatVol());
+
+    FieldHandle field = CreateLazyField(filename.string(), nullptr);
+    ASSERT_TRUE(field != nullptr);
+    auto lazy = boost::dynamic_pointer_cast<LazyField>(field);
+    ASSERT_TRUE(lazy != nullptr);
+
+    FieldInformation info(field);
+    EXPECT_TRUE(info.is_latvolmesh());
+    EXPECT_TRUE(info.is_double());
+    EXPECT_EQ(1, field->basis_order());
+    EXPECT_EQ(rampLatVol()->dynamic_type_name(), field->dynamic_type_name());
+    EXPECT_FALSE(lazy->is_loaded());
+
+    boost::filesystem::remove(filename);
+  }
+}
+
+TEST(LazyFieldTests, MeshAndDataAreReadOnFirstAccess)
+{
+  auto filename = tempFile("lazy.fld");
+  writeField(filename, "Binary", rampLatVol());
+
+  FieldHandle field = CreateLazyField(filename.string(), nullptr);
+  ASSERT_TRUE(field != nullptr);
+  EXPECT_EQ(120, field->vmesh()->num_nodes());
+  EXPECT_TRUE(boost::dynamic_pointer_cast<LazyField>(field)->is_loaded());
+
+  std::vector<double> values;
+  field->vfield()->get_values(values);
+  ASSERT_EQ(120, values.size());
+  EXPECT_EQ(59.5, values[119]);
+
+  boost::filesystem::remove(filename);
+}
+
+TEST(LazyFieldTests, WritingLoadsTheField)
+{
+  auto filename = tempFile("lazy.fld");
+  auto copy = tempFile("copy.fld");
+  writeField(filename, "Binary", rampLatVol());
+
+  writeField(copy, "Binary", CreateLazyField(filename.string(), nullptr));
+  FieldHandle field = readField(copy);
+  ASSERT_TRUE(field != nullptr);
+  std::vector<double> values;
+  field->vfield()->get_values(values);
+  ASSERT_EQ(120, values.size());
+  EXPECT_EQ(59.5, values[119]);
+
+  boost::filesystem::remove(filename);
+  boost::filesystem::remove(copy);
+}
+
+TEST(LazyFieldTests, ReturnsNullForMissingFile)
+{
+  EXPECT_TRUE(CreateLazyField(tempFile("missing.fld").string(), nullptr) == nullptr);
+}
+
+TEST(LazyFieldTests, ThrowsWhenFileChangesBeforeLoading)
+{
+  auto filename = tempFile("lazy.fld");
+  writeField(filename, "Binary", rampLatVol());
+
+  FieldHandle field = CreateLazyField(filename.string(), nullptr);
+  ASSERT_TRUE(field != nullptr);
+  writeField(filename, "Binary", CreateEmptyLatVol(2, 2, 2, FLOAT_E));
+
+  EXPECT_THROW(field->vmesh(), LazyFieldLoadFailed);
+
+  boost::filesystem::remove(filename);
+}
+
+TEST(LazyFieldTests, ThrowsWhenFileIsRewrittenWithSameSize)
+{
+  auto filename = tempFile("lazy.fld");
+  writeField(filename, "Binary", rampLatVol());
+
+  FieldHandle field = CreateLazyField(filename.string(), nullptr);
+  ASSERT_TRUE(field != nullptr);
+  writeField(filename, "Binary", rampLatVol());
+  boost::filesystem::last_write_time(filename, boost::filesystem::last_write_time(filename) + 10);
+
+  EXPECT_THROW(field->vfield(), LazyFieldLoadFailed);
+
+  boost::filesystem::remove(filename);
+}
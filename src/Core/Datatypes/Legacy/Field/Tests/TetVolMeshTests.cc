@@ -70,3 +70,47 @@ TEST(TetVolMeshTest, CheckMeshIteratorTetVolMesh)
 }
 
 
+
+TEST(TetVolMeshTest, CompactTetVolMeshFromFieldInformation)
+{
+  FieldInformation fi("TetVolMesh", LINEARDATA_E, "float");
+  EXPECT_FALSE(fi.is_compactmesh());
+  ASSERT_TRUE(fi.make_compactmesh());
+  EXPECT_TRUE(fi.is_compactmesh());
+  EXPECT_EQ("TetVolMesh<TetLinearLgn<Point>,int>", fi.get_mesh_type_id());
+
+  FieldHandle field = CreateField(fi);
+  ASSERT_TRUE(field != nullptr);
+
+  VMesh* mesh = field->vmesh();
+  mesh->add_point(Point(0,0,0));
+  mesh->add_point(Point(1,0,0));
+  mesh->add_point(Point(0,1,0));
+  mesh->add_point(Point(0,0,1));
+  mesh->add_point(Point(1,1,1));
+
+  VMesh::Node::array_type nodes(4);
+  nodes[0] = 0; nodes[1] = 1; nodes[2] = 2; nodes[3] = 3;
+  mesh->add_elem(nodes);
+  nodes[0] = 1; nodes[1] = 2; nodes[2] = 3; nodes[3] = 4;
+  mesh->add_elem(nodes);
+  field->vfield()->resize_values();
+
+  ASSERT_EQ(2, mesh->num_elems());
+  mesh->get_nodes(nodes, VMesh::Elem::index_type(1));
+  EXPECT_EQ(1, nodes[0]);
+  EXPECT_EQ(4, nodes[3]);
+
+  // The connectivity is not stored as VMesh::index_type
+  EXPECT_FALSE(mesh->elem_nodes_view().valid());
+
+  FieldInformation fo(field);
+  EXPECT_TRUE(fo.is_compactmesh());
+  EXPECT_TRUE(fo.is_float());
+  EXPECT_TRUE(fi == fo);
+
+  FieldInformation fs(fo);
+  fs.make_trisurfmesh();
+  EXPECT_FALSE(fs.is_compactmesh());
+  EXPECT_EQ("TriSurfMesh<TriLinearLgn<Point>>", fs.get_mesh_type_id());
+}
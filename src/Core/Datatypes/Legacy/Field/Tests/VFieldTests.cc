@@ -192,3 +192,64 @@ TEST(VFieldTest, TetVolMeshSetFieldValueTest2)
 }
 
 
+
+TEST(VFieldTest, TypedViewMatchesVirtualAccess)
+{
+  FieldHandle field = TetrahedronTetVolLinearBasis(DOUBLE_E);
+  VField *vfield = field->vfield();
+  vfield->resize_values();
+
+  std::vector<double> values = { 1.0, 2.0, 3.0, 4.0 };
+  vfield->set_values(values);
+
+  auto view = vfield->view<double>();
+  ASSERT_TRUE(view.valid());
+  ASSERT_EQ(4, view.size());
+  for (VMesh::index_type i = 0; i < view.size(); ++i)
+  {
+    double tmp;
+    vfield->get_value(tmp, i);
+    EXPECT_EQ(tmp, view[i]);
+  }
+
+  view[2] = 10.0;
+  double tmp;
+  vfield->get_value(tmp, 2);
+  EXPECT_EQ(10.0, tmp);
+
+  EXPECT_FALSE(vfield->view<float>().valid());
+  EXPECT_FALSE(vfield->view<SCIRun::Core::Geometry::Vector>().valid());
+}
+
+TEST(VFieldTest, MeshViewsMatchVirtualAccess)
+{
+  FieldHandle field = TetrahedronTetVolLinearBasis(DOUBLE_E);
+  VMesh *vmesh = field->vmesh();
+
+  auto points = vmesh->node_points_view();
+  ASSERT_TRUE(points.valid());
+  ASSERT_EQ(vmesh->num_nodes(), points.size());
+  for (VMesh::Node::index_type i = 0; i < vmesh->num_nodes(); ++i)
+  {
+    SCIRun::Core::Geometry::Point p;
+    vmesh->get_point(p, i);
+    EXPECT_EQ(p, points[i]);
+  }
+
+  auto elems = vmesh->elem_nodes_view();
+  ASSERT_TRUE(elems.valid());
+  ASSERT_EQ(vmesh->num_elems(), elems.size());
+  ASSERT_EQ(4, elems.stride());
+  VMesh::Node::array_type nodes;
+  vmesh->get_nodes(nodes, VMesh::Elem::index_type(0));
+  for (size_t i = 0; i < nodes.size(); ++i)
+    EXPECT_EQ(nodes[i], elems.record(0)[i]);
+}
+
+TEST(VFieldTest, RegularMeshHasNoPointView)
+{
+  FieldHandle field = CreateEmptyLatVol();
+  EXPECT_FALSE(field->vmesh()->node_points_view().valid());
+  EXPECT_FALSE(field->vmesh()->elem_nodes_view().valid());
+  EXPECT_TRUE(field->vfield()->view<double>().valid());
+}
@@ -169,6 +169,19 @@ VMesh* CreateVTetVolMesh(TetVolMesh<TetLinearLgn<Point> >* mesh)
 /// Register class maker, so we can instantiate it
 static MeshTypeID TetVolMesh_MeshID1(TetVolMesh<TetLinearLgn<Point> >::type_name(-1),
                   TetVolMesh<TetLinearLgn<Point> >::mesh_maker);
+
+/// Add the LINEAR virtual interface for the compact mesh, which stores its
+/// connectivity as 32-bit integers
+
+/// Create virtual interface 
+VMesh* CreateVTetVolMesh(TetVolMesh<TetLinearLgn<Point>, int>* mesh)
+{
+  return new VTetVolMesh<TetVolMesh<TetLinearLgn<Point>, int> >(mesh);
+}
+
+/// Register class maker, so we can instantiate it
+static MeshTypeID TetVolMesh_MeshID1c(TetVolMesh<TetLinearLgn<Point>, int>::type_name(-1),
+                  TetVolMesh<TetLinearLgn<Point>, int>::mesh_maker);
                   
                   
 /// Add the QUADRATIC virtual interface and the meshid for creating it                  
@@ -500,13 +513,26 @@ VTetVolMesh<MESH>::get_delems(VMesh::DElem::array_type &delems,
   delems.resize(1); delems[0] = static_cast<VMesh::DElem::index_type>(idx);
 }
 
+/// Direct access is only possible if the connectivity is stored using
+/// VMesh::index_type, compact meshes return no pointer
+template <class T>
+inline VMesh::index_type* tetvol_elems_pointer(std::vector<T>&)
+{
+  return (0);
+}
+
+inline VMesh::index_type* tetvol_elems_pointer(std::vector<VMesh::index_type>& cells)
+{
+  if (cells.size() == 0) return (0);
+  return (&(cells[0]));
+}
+
 template <class MESH>
 VMesh::index_type*
 VTetVolMesh<MESH>::
 get_elems_pointer() const
 {
-  if (this->mesh_->cells_.size() == 0) return (0);
-   return (&(this->mesh_->cells_[0]));
+  return (tetvol_elems_pointer(this->mesh_->cells_));
 }
 
 
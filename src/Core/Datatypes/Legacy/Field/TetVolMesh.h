@@ -60,6 +60,7 @@
 
 #include <boost/thread.hpp>
 #include <boost/unordered_map.hpp>
+#include <boost/type_traits/is_same.hpp>
 #include <Core/Thread/Mutex.h>
 #include <Core/Thread/ConditionVariable.h>
 
@@ -74,7 +75,7 @@ namespace SCIRun {
 
 /// Functions for creating the virtual interface
 /// Declare the functions that instantiate the virtual interface
-template <class Basis> class TetVolMesh;
+template <class Basis, class CellStorage = SCIRun::index_type> class TetVolMesh;
 
 /// make sure any other mesh other than the preinstantiate ones
 /// returns no virtual interface. Altering this behavior will allow
@@ -90,6 +91,8 @@ VMesh* CreateVTetVolMesh(MESH*) { return nullptr; }
 #if (SCIRUN_TETVOL_SUPPORT > 0)
 
 SCISHARE VMesh* CreateVTetVolMesh(TetVolMesh<Core::Basis::TetLinearLgn<Core::Geometry::Point> >* mesh);
+/// Compact variant with 32-bit connectivity
+SCISHARE VMesh* CreateVTetVolMesh(TetVolMesh<Core::Basis::TetLinearLgn<Core::Geometry::Point>, int>* mesh);
 #if (SCIRUN_QUADRATIC_SUPPORT > 0)
 SCISHARE VMesh* CreateVTetVolMesh(TetVolMesh<Core::Basis::TetQuadraticLgn<Core::Geometry::Point> >* mesh);
 #endif
@@ -132,7 +135,7 @@ TetVolFaceTable[4][3] = { {0,2,1},{1,2,3},{0,1,3},{0,3,2}};
 /////////////////////////////////////////////////////
 // Declarations for TetVolMesh class
 
-template <class Basis>
+template <class Basis, class CellStorage>
 class TetVolMesh : public Mesh
 {
   /// Make sure the virtual interface has access
@@ -147,7 +150,14 @@ public:
   typedef SCIRun::size_type                 size_type;
   typedef SCIRun::mask_type                 mask_type;
 
-  typedef boost::shared_ptr<TetVolMesh<Basis> > handle_type;
+  /// Type used to store the connectivity in cells_. The default stores
+  /// full index_type entries; a compact mesh stores 32-bit node indices,
+  /// which halves the memory footprint of the connectivity table.
+  typedef CellStorage                       cell_storage_type;
+  static const bool is_compact_storage =
+    !boost::is_same<CellStorage, SCIRun::index_type>::value;
+
+  typedef boost::shared_ptr<TetVolMesh<Basis, CellStorage> > handle_type;
   typedef Basis                             basis_type;
 
   /// Index and Iterator types required for Mesh Concept.
@@ -194,9 +204,9 @@ public:
   class ElemData
   {
   public:
-    typedef typename TetVolMesh<Basis>::index_type  index_type;
+    typedef typename TetVolMesh<Basis, CellStorage>::index_type  index_type;
 
-    ElemData(const TetVolMesh<Basis>& msh, const index_type ind) :
+    ElemData(const TetVolMesh<Basis, CellStorage>& msh, const index_type ind) :
       mesh_(msh),
       index_(ind)
     {
@@ -284,7 +294,7 @@ public:
 
   private:
     /// reference to the mesh
-    const TetVolMesh<Basis>          &mesh_;
+    const TetVolMesh<Basis, CellStorage>          &mesh_;
     /// copy of element index
     const index_type                 index_;
     /// need edges for quadratic meshes
@@ -296,7 +306,7 @@ public:
   class Synchronize //: public Runnable
   {
     public:
-      Synchronize(TetVolMesh<Basis>* mesh, mask_type sync) :
+      Synchronize(TetVolMesh<Basis, CellStorage>* mesh, mask_type sync) :
         mesh_(mesh), sync_(sync) {}
 
       void operator()()
@@ -345,7 +355,7 @@ public:
       }
 
     private:
-      TetVolMesh<Basis>* mesh_;
+      TetVolMesh<Basis, CellStorage>* mesh_;
       mask_type  sync_;
   };
 
@@ -2330,7 +2340,7 @@ protected:
   std::vector<Core::Geometry::Point>         points_;
 
   /// each 4 indicies make up a tet
-  std::vector<under_type>    cells_;
+  std::vector<cell_storage_type>    cells_;
 
   /// Face information.
   class PFaceCell {
@@ -2646,9 +2656,9 @@ public:
 
 }; // end class TetVolMesh
 
-template <class Basis>
+template <class Basis, class CellStorage>
 int
-TetVolMesh<Basis>::compute_checksum()
+TetVolMesh<Basis, CellStorage>::compute_checksum()
 {
   int sum = 0;
   sum += SCIRun::compute_checksum(&points_[0],points_.size());
@@ -2656,8 +2666,8 @@ TetVolMesh<Basis>::compute_checksum()
   return (sum);
 }
 
-template <class Basis>
-TetVolMesh<Basis>::TetVolMesh() :
+template <class Basis, class CellStorage>
+TetVolMesh<Basis, CellStorage>::TetVolMesh() :
   points_(0),
   cells_(0),
   faces_(0),
@@ -2677,8 +2687,8 @@ TetVolMesh<Basis>::TetVolMesh() :
   vmesh_.reset(CreateVTetVolMesh(this));
 }
 
-template <class Basis>
-TetVolMesh<Basis>::TetVolMesh(const TetVolMesh &copy) :
+template <class Basis, class CellStorage>
+TetVolMesh<Basis, CellStorage>::TetVolMesh(const TetVolMesh &copy) :
   Mesh(copy),
   points_(0),
   cells_(0),
@@ -2719,16 +2729,16 @@ TetVolMesh<Basis>::TetVolMesh(const TetVolMesh &copy) :
   vmesh_.reset(CreateVTetVolMesh(this));
 }
 
-template <class Basis>
-TetVolMesh<Basis>::~TetVolMesh()
+template <class Basis, class CellStorage>
+TetVolMesh<Basis, CellStorage>::~TetVolMesh()
 {
   DEBUG_DESTRUCTOR("TetVolMesh")
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 template <class Iter, class Functor>
 void
-TetVolMesh<Basis>::fill_points(Iter begin, Iter end, Functor fill_ftor)
+TetVolMesh<Basis, CellStorage>::fill_points(Iter begin, Iter end, Functor fill_ftor)
 {
   synchronize_lock_.lock();
   Iter iter = begin;
@@ -2742,15 +2752,15 @@ TetVolMesh<Basis>::fill_points(Iter begin, Iter end, Functor fill_ftor)
   synchronize_lock_.unlock();
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 template <class Iter, class Functor>
 void
-TetVolMesh<Basis>::fill_cells(Iter begin, Iter end, Functor fill_ftor)
+TetVolMesh<Basis, CellStorage>::fill_cells(Iter begin, Iter end, Functor fill_ftor)
 {
   synchronize_lock_.lock();
   Iter iter = begin;
   cells_.resize((end - begin) * 4); // resize to the new size
-  std::vector<under_type>::iterator citer = cells_.begin();
+  typename std::vector<cell_storage_type>::iterator citer = cells_.begin();
   while (iter != end)
   {
     index_type *nodes = fill_ftor(*iter); // returns an array of length 4
@@ -2766,19 +2776,23 @@ TetVolMesh<Basis>::fill_cells(Iter begin, Iter end, Functor fill_ftor)
   synchronize_lock_.unlock();
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 PersistentTypeID
-TetVolMesh<Basis>::tetvolmesh_typeid(TetVolMesh<Basis>::type_name(-1), "Mesh",
-				     TetVolMesh<Basis>::maker);
+TetVolMesh<Basis, CellStorage>::tetvolmesh_typeid(TetVolMesh<Basis, CellStorage>::type_name(-1), "Mesh",
+				     TetVolMesh<Basis, CellStorage>::maker);
 
-template <class Basis>
+template <class Basis, class CellStorage>
 const std::string
-TetVolMesh<Basis>::type_name(int n)
+TetVolMesh<Basis, CellStorage>::type_name(int n)
 {
-  ASSERT((n >= -1) && n <= 1);
+  ASSERT((n >= -1) && n <= 2);
   if (n == -1)
   {
-    static const std::string name = TypeNameGenerator::make_template_id(type_name(0), type_name(1));
+    /// The default storage keeps its original name, so existing files and
+    /// type ids remain valid; compact meshes add the storage type.
+    static const std::string name = is_compact_storage ?
+      TypeNameGenerator::make_template_id(type_name(0), type_name(1), type_name(2)) :
+      TypeNameGenerator::make_template_id(type_name(0), type_name(1));
     return name;
   }
   else if (n == 0)
@@ -2786,18 +2800,22 @@ TetVolMesh<Basis>::type_name(int n)
     static const std::string nm("TetVolMesh");
     return nm;
   }
-  else
+  else if (n == 1)
   {
     return find_type_name((Basis *)0);
   }
+  else
+  {
+    return find_type_name((CellStorage *)0);
+  }
 }
 
 /* To generate a random point inside of a tetrahedron, we generate random
    barrycentric coordinates (independent random variables between 0 and
    1 that sum to 1) for the point. */
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::get_random_point(Core::Geometry::Point &p,
+TetVolMesh<Basis, CellStorage>::get_random_point(Core::Geometry::Point &p,
 				    typename Elem::index_type ei,
                                     FieldRNG &rng) const
 {
@@ -2837,9 +2855,9 @@ TetVolMesh<Basis>::get_random_point(Core::Geometry::Point &p,
   p = Core::Geometry::Point(p0*a + p1*t + p2*u + p3*v);
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 Core::Geometry::BBox
-TetVolMesh<Basis>::get_bounding_box() const
+TetVolMesh<Basis, CellStorage>::get_bounding_box() const
 {
   Core::Geometry::BBox result;
   typename Node::iterator ni, nie;
@@ -2853,9 +2871,9 @@ TetVolMesh<Basis>::get_bounding_box() const
   return (result);
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::get_canonical_transform(Core::Geometry::Transform &t) const
+TetVolMesh<Basis, CellStorage>::get_canonical_transform(Core::Geometry::Transform &t) const
 {
   t.load_identity();
   Core::Geometry::BBox bbox = get_bounding_box();
@@ -2863,9 +2881,9 @@ TetVolMesh<Basis>::get_canonical_transform(Core::Geometry::Transform &t) const
   t.pre_translate(Core::Geometry::Vector(bbox.get_min()));
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::transform(const Core::Geometry::Transform &t)
+TetVolMesh<Basis, CellStorage>::transform(const Core::Geometry::Transform &t)
 {
   synchronize_lock_.lock();
 
@@ -2905,9 +2923,9 @@ TetVolMesh<Basis>::transform(const Core::Geometry::Transform &t)
   synchronize_lock_.unlock();
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::remove_face(typename Node::index_type n1,
+TetVolMesh<Basis, CellStorage>::remove_face(typename Node::index_type n1,
 			       typename Node::index_type n2,
 			       typename Node::index_type n3,
 			       typename Cell::index_type ci,
@@ -2949,9 +2967,9 @@ TetVolMesh<Basis>::remove_face(typename Node::index_type n1,
   }
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::hash_face(typename Node::index_type n1,
+TetVolMesh<Basis, CellStorage>::hash_face(typename Node::index_type n1,
                              typename Node::index_type n2,
                              typename Node::index_type n3,
                              index_type combined_index,
@@ -2989,9 +3007,9 @@ TetVolMesh<Basis>::hash_face(typename Node::index_type n1,
   }
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::compute_faces()
+TetVolMesh<Basis, CellStorage>::compute_faces()
 {
   typename Cell::iterator ci, cie;
   begin(ci); end(cie);
@@ -3044,9 +3062,9 @@ TetVolMesh<Basis>::compute_faces()
 }
 
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::add_face(typename Node::index_type n1,
+TetVolMesh<Basis, CellStorage>::add_face(typename Node::index_type n1,
                             typename Node::index_type n2,
                             typename Node::index_type n3,
                             index_type combined_index)
@@ -3078,9 +3096,9 @@ TetVolMesh<Basis>::add_face(typename Node::index_type n1,
   }
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::hash_edge(typename Node::index_type n1,
+TetVolMesh<Basis, CellStorage>::hash_edge(typename Node::index_type n1,
                              typename Node::index_type n2,
                              index_type combined_index,
                              edge_ht& table)
@@ -3103,9 +3121,9 @@ TetVolMesh<Basis>::hash_edge(typename Node::index_type n1,
   }
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::compute_edges()
+TetVolMesh<Basis, CellStorage>::compute_edges()
 {
   typename Cell::iterator ci, cie;
   begin(ci); end(cie);
@@ -3144,9 +3162,9 @@ TetVolMesh<Basis>::compute_edges()
   synchronize_lock_.unlock();
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::add_edge(typename Node::index_type n1,
+TetVolMesh<Basis, CellStorage>::add_edge(typename Node::index_type n1,
                             typename Node::index_type n2, index_type combined_index)
 {
   PEdgeNode e(n1,n2);
@@ -3165,9 +3183,9 @@ TetVolMesh<Basis>::add_edge(typename Node::index_type n1,
   }
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 bool
-TetVolMesh<Basis>::synchronize(mask_type sync)
+TetVolMesh<Basis, CellStorage>::synchronize(mask_type sync)
 {
   // Conversion table
   if (sync & (Mesh::ELEM_NEIGHBORS_E|Mesh::DELEMS_E))
@@ -3284,16 +3302,16 @@ TetVolMesh<Basis>::synchronize(mask_type sync)
   return (true);
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 bool
-TetVolMesh<Basis>::unsynchronize(mask_type /*sync*/)
+TetVolMesh<Basis, CellStorage>::unsynchronize(mask_type /*sync*/)
 {
   return (true);
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 bool
-TetVolMesh<Basis>::clear_synchronization()
+TetVolMesh<Basis, CellStorage>::clear_synchronization()
 {
   // Undo marking the synchronization
   synchronize_lock_.lock();
@@ -3317,117 +3335,117 @@ TetVolMesh<Basis>::clear_synchronization()
   return (true);
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::begin(typename TetVolMesh::Node::iterator &itr) const
+TetVolMesh<Basis, CellStorage>::begin(typename TetVolMesh::Node::iterator &itr) const
 {
   ASSERTMSG(synchronized_ & Mesh::NODES_E,
             "Must call synchronize NODES_E on TetVolMesh first");
   itr = 0;
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::end(typename TetVolMesh::Node::iterator &itr) const
+TetVolMesh<Basis, CellStorage>::end(typename TetVolMesh::Node::iterator &itr) const
 {
   ASSERTMSG(synchronized_ & Mesh::NODES_E,
             "Must call synchronize NODES_E on TetVolMesh first");
   itr = static_cast<typename Node::iterator>(points_.size());
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::size(typename TetVolMesh::Node::size_type &s) const
+TetVolMesh<Basis, CellStorage>::size(typename TetVolMesh::Node::size_type &s) const
 {
   ASSERTMSG(synchronized_ & Mesh::NODES_E,
             "Must call synchronize NODES_E on TetVolMesh first");
   s = points_.size();
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::begin(typename TetVolMesh::Edge::iterator &itr) const
+TetVolMesh<Basis, CellStorage>::begin(typename TetVolMesh::Edge::iterator &itr) const
 {
   ASSERTMSG(synchronized_ & Mesh::EDGES_E,
             "Must call synchronize EDGES_E on TetVolMesh first");
   itr = 0;
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::end(typename TetVolMesh::Edge::iterator &itr) const
+TetVolMesh<Basis, CellStorage>::end(typename TetVolMesh::Edge::iterator &itr) const
 {
   ASSERTMSG(synchronized_ & Mesh::EDGES_E,
             "Must call synchronize EDGES_E on TetVolMesh first");
   itr = static_cast<index_type>(edges_.size());
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::size(typename TetVolMesh::Edge::size_type &s) const
+TetVolMesh<Basis, CellStorage>::size(typename TetVolMesh::Edge::size_type &s) const
 {
   ASSERTMSG(synchronized_ & Mesh::EDGES_E,
             "Must call synchronize EDGES_E on TetVolMesh first");
   s = static_cast<index_type>(edges_.size());
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::begin(typename TetVolMesh::Face::iterator &itr) const
+TetVolMesh<Basis, CellStorage>::begin(typename TetVolMesh::Face::iterator &itr) const
 {
   ASSERTMSG(synchronized_ & Mesh::FACES_E,
             "Must call synchronize FACES_E on TetVolMesh first");
   itr = 0;
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::end(typename TetVolMesh::Face::iterator &itr) const
+TetVolMesh<Basis, CellStorage>::end(typename TetVolMesh::Face::iterator &itr) const
 {
   ASSERTMSG(synchronized_ & Mesh::FACES_E,
             "Must call synchronize FACES_E on TetVolMesh first");
   itr = static_cast<index_type>(faces_.size());
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::size(typename TetVolMesh::Face::size_type &s) const
+TetVolMesh<Basis, CellStorage>::size(typename TetVolMesh::Face::size_type &s) const
 {
   ASSERTMSG(synchronized_ & Mesh::FACES_E,
             "Must call synchronize FACES_E on TetVolMesh first");
   s = static_cast<index_type>(faces_.size());
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::begin(typename TetVolMesh::Cell::iterator &itr) const
+TetVolMesh<Basis, CellStorage>::begin(typename TetVolMesh::Cell::iterator &itr) const
 {
   ASSERTMSG(synchronized_ & CELLS_E,
             "Must call synchronize CELLS_E on TetVolMesh first");
   itr = 0;
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::end(typename TetVolMesh::Cell::iterator &itr) const
+TetVolMesh<Basis, CellStorage>::end(typename TetVolMesh::Cell::iterator &itr) const
 {
   ASSERTMSG(synchronized_ & CELLS_E,
             "Must call synchronize CELLS_E on TetVolMesh first");
   itr = cells_.size() >> 2;
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::size(typename TetVolMesh::Cell::size_type &s) const
+TetVolMesh<Basis, CellStorage>::size(typename TetVolMesh::Cell::size_type &s) const
 {
   ASSERTMSG(synchronized_ & CELLS_E,
             "Must call synchronize CELLS_E on TetVolMesh first");
   s = static_cast<size_type>(cells_.size() >> 2);
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::create_cell_edges(typename Cell::index_type c)
+TetVolMesh<Basis, CellStorage>::create_cell_edges(typename Cell::index_type c)
 {
   typename Node::array_type arr;
   get_nodes(arr, c);
@@ -3440,9 +3458,9 @@ TetVolMesh<Basis>::create_cell_edges(typename Cell::index_type c)
   add_edge(arr[3], arr[2], cell_index+5);
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::remove_edge(typename Node::index_type n1,
+TetVolMesh<Basis, CellStorage>::remove_edge(typename Node::index_type n1,
 			       typename Node::index_type n2,
 			       typename Cell::index_type ci,
              bool table_only)
@@ -3489,9 +3507,9 @@ TetVolMesh<Basis>::remove_edge(typename Node::index_type n1,
   }
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::delete_cell_edges(typename Cell::index_type c,
+TetVolMesh<Basis, CellStorage>::delete_cell_edges(typename Cell::index_type c,
                                      bool table_only)
 {
   typename Node::array_type arr;
@@ -3504,9 +3522,9 @@ TetVolMesh<Basis>::delete_cell_edges(typename Cell::index_type c,
   remove_edge(arr[3], arr[2], c, table_only);
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::create_cell_faces(typename Cell::index_type c)
+TetVolMesh<Basis, CellStorage>::create_cell_faces(typename Cell::index_type c)
 {
   typename Node::array_type arr;
   get_nodes(arr, c);
@@ -3518,9 +3536,9 @@ TetVolMesh<Basis>::create_cell_faces(typename Cell::index_type c)
 }
 
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::delete_cell_faces(typename Cell::index_type c,
+TetVolMesh<Basis, CellStorage>::delete_cell_faces(typename Cell::index_type c,
                                      bool table_only)
 {
   typename Node::array_type arr;
@@ -3532,9 +3550,9 @@ TetVolMesh<Basis>::delete_cell_faces(typename Cell::index_type c,
 }
 
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::create_cell_node_neighbors(typename Cell::index_type c)
+TetVolMesh<Basis, CellStorage>::create_cell_node_neighbors(typename Cell::index_type c)
 {
   for (index_type i = c*4; i < c*4+4; ++i)
   {
@@ -3543,9 +3561,9 @@ TetVolMesh<Basis>::create_cell_node_neighbors(typename Cell::index_type c)
 }
 
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::delete_cell_node_neighbors(typename Cell::index_type c)
+TetVolMesh<Basis, CellStorage>::delete_cell_node_neighbors(typename Cell::index_type c)
 {
   for (index_type i = c*4; i < c*4+4; ++i)
   {
@@ -3563,9 +3581,9 @@ TetVolMesh<Basis>::delete_cell_node_neighbors(typename Cell::index_type c)
   }
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::create_cell_syncinfo(typename Cell::index_type ci)
+TetVolMesh<Basis, CellStorage>::create_cell_syncinfo(typename Cell::index_type ci)
 {
   synchronize_lock_.lock();
   if (synchronized_ & Mesh::NODE_NEIGHBORS_E)
@@ -3579,9 +3597,9 @@ TetVolMesh<Basis>::create_cell_syncinfo(typename Cell::index_type ci)
   synchronize_lock_.unlock();
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::delete_cell_syncinfo(typename Cell::index_type ci)
+TetVolMesh<Basis, CellStorage>::delete_cell_syncinfo(typename Cell::index_type ci)
 {
   synchronize_lock_.lock();
   if (synchronized_ & Mesh::NODE_NEIGHBORS_E)
@@ -3595,9 +3613,9 @@ TetVolMesh<Basis>::delete_cell_syncinfo(typename Cell::index_type ci)
   synchronize_lock_.unlock();
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::create_cell_syncinfo_special(typename Cell::index_type ci)
+TetVolMesh<Basis, CellStorage>::create_cell_syncinfo_special(typename Cell::index_type ci)
 {
   synchronize_lock_.lock();
   if (synchronized_ & Mesh::NODE_NEIGHBORS_E)
@@ -3631,9 +3649,9 @@ TetVolMesh<Basis>::create_cell_syncinfo_special(typename Cell::index_type ci)
   synchronize_lock_.unlock();
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::delete_cell_syncinfo_special(typename Cell::index_type ci)
+TetVolMesh<Basis, CellStorage>::delete_cell_syncinfo_special(typename Cell::index_type ci)
 {
   synchronize_lock_.lock();
   if (synchronized_ & Mesh::NODE_NEIGHBORS_E)
@@ -3648,9 +3666,9 @@ TetVolMesh<Basis>::delete_cell_syncinfo_special(typename Cell::index_type ci)
 }
 
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::set_nodes(typename Node::array_type &array,
+TetVolMesh<Basis, CellStorage>::set_nodes(typename Node::array_type &array,
                              typename Cell::index_type idx)
 {
   ASSERT(array.size() == 4);
@@ -3663,9 +3681,9 @@ TetVolMesh<Basis>::set_nodes(typename Node::array_type &array,
   create_cell_syncinfo(idx);
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::compute_node_neighbors()
+TetVolMesh<Basis, CellStorage>::compute_node_neighbors()
 {
   node_neighbors_.clear();
   node_neighbors_.resize(points_.size());
@@ -3680,9 +3698,9 @@ TetVolMesh<Basis>::compute_node_neighbors()
   synchronize_lock_.unlock();
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 int
-TetVolMesh<Basis>::get_weights(const Core::Geometry::Point &p, typename Cell::array_type &l,
+TetVolMesh<Basis, CellStorage>::get_weights(const Core::Geometry::Point &p, typename Cell::array_type &l,
                                double *w)
 {
   typename Cell::index_type idx;
@@ -3696,9 +3714,9 @@ TetVolMesh<Basis>::get_weights(const Core::Geometry::Point &p, typename Cell::ar
   return 0;
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 int
-TetVolMesh<Basis>::get_weights(const Core::Geometry::Point &p, typename Node::array_type &l,
+TetVolMesh<Basis, CellStorage>::get_weights(const Core::Geometry::Point &p, typename Node::array_type &l,
                                double *w)
 {
   typename Cell::index_type idx;
@@ -3715,9 +3733,9 @@ TetVolMesh<Basis>::get_weights(const Core::Geometry::Point &p, typename Node::ar
   return 0;
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::insert_elem_into_grid(typename Cell::index_type ci)
+TetVolMesh<Basis, CellStorage>::insert_elem_into_grid(typename Cell::index_type ci)
 {
   /// @todo:  This can crash if you insert a new cell outside of the grid.
   // Need to recompute grid at that point.
@@ -3733,9 +3751,9 @@ TetVolMesh<Basis>::insert_elem_into_grid(typename Cell::index_type ci)
 }
 
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::remove_elem_from_grid(typename Cell::index_type ci)
+TetVolMesh<Basis, CellStorage>::remove_elem_from_grid(typename Cell::index_type ci)
 {
   const index_type idx = ci*4;
   Core::Geometry::BBox box;
@@ -3747,25 +3765,25 @@ TetVolMesh<Basis>::remove_elem_from_grid(typename Cell::index_type ci)
   elem_grid_->remove(ci, box);
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::insert_node_into_grid(typename Node::index_type ni)
+TetVolMesh<Basis, CellStorage>::insert_node_into_grid(typename Node::index_type ni)
 {
   /// @todo:  This can crash if you insert a new cell outside of the grid.
   // Need to recompute grid at that point.
   node_grid_->insert(ni,points_[ni]);
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::remove_node_from_grid(typename Node::index_type ni)
+TetVolMesh<Basis, CellStorage>::remove_node_from_grid(typename Node::index_type ni)
 {
   node_grid_->remove(ni,points_[ni]);
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::compute_elem_grid()
+TetVolMesh<Basis, CellStorage>::compute_elem_grid()
 {
   if (bbox_.valid())
   {
@@ -3799,9 +3817,9 @@ TetVolMesh<Basis>::compute_elem_grid()
   synchronize_lock_.unlock();
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::compute_node_grid()
+TetVolMesh<Basis, CellStorage>::compute_node_grid()
 {
   ASSERTMSG(bbox_.valid(),"TetVolMesh BBox not valid");
   if (bbox_.valid())
@@ -3836,9 +3854,9 @@ TetVolMesh<Basis>::compute_node_grid()
   synchronize_lock_.unlock();
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::compute_bounding_box()
+TetVolMesh<Basis, CellStorage>::compute_bounding_box()
 {
   bbox_.reset();
 
@@ -3870,9 +3888,9 @@ TetVolMesh<Basis>::compute_bounding_box()
   synchronize_lock_.unlock();
 }
 
-template <class Basis>
-typename TetVolMesh<Basis>::Node::index_type
-TetVolMesh<Basis>::add_find_point(const Core::Geometry::Point &p, double /*err*/)
+template <class Basis, class CellStorage>
+typename TetVolMesh<Basis, CellStorage>::Node::index_type
+TetVolMesh<Basis, CellStorage>::add_find_point(const Core::Geometry::Point &p, double /*err*/)
 {
   typename Node::index_type i;
   if (locate(i, p) && (points_[i] - p).length2() < epsilon2_)
@@ -3892,9 +3910,9 @@ TetVolMesh<Basis>::add_find_point(const Core::Geometry::Point &p, double /*err*/
   }
 }
 
-template <class Basis>
-typename TetVolMesh<Basis>::Elem::index_type
-TetVolMesh<Basis>::add_tet(typename Node::index_type a,
+template <class Basis, class CellStorage>
+typename TetVolMesh<Basis, CellStorage>::Elem::index_type
+TetVolMesh<Basis, CellStorage>::add_tet(typename Node::index_type a,
 			   typename Node::index_type b,
 			   typename Node::index_type c,
 			   typename Node::index_type d)
@@ -3907,27 +3925,27 @@ TetVolMesh<Basis>::add_tet(typename Node::index_type a,
   return tet;
 }
 
-template <class Basis>
-typename TetVolMesh<Basis>::Node::index_type
-TetVolMesh<Basis>::add_point(const Core::Geometry::Point &p)
+template <class Basis, class CellStorage>
+typename TetVolMesh<Basis, CellStorage>::Node::index_type
+TetVolMesh<Basis, CellStorage>::add_point(const Core::Geometry::Point &p)
 {
   points_.push_back(p);
   return static_cast<typename Node::index_type>(points_.size() - 1);
 }
 
 
-template <class Basis>
-typename TetVolMesh<Basis>::Elem::index_type
-TetVolMesh<Basis>::add_tet(const Core::Geometry::Point &p0, const Core::Geometry::Point &p1,
+template <class Basis, class CellStorage>
+typename TetVolMesh<Basis, CellStorage>::Elem::index_type
+TetVolMesh<Basis, CellStorage>::add_tet(const Core::Geometry::Point &p0, const Core::Geometry::Point &p1,
 			   const Core::Geometry::Point &p2, const Core::Geometry::Point &p3)
 {
   return add_tet(add_find_point(p0), add_find_point(p1),
                  add_find_point(p2), add_find_point(p3));
 }
 
-template <class Basis>
-typename TetVolMesh<Basis>::Elem::index_type
-TetVolMesh<Basis>::add_tet_pos(typename Node::index_type a,
+template <class Basis, class CellStorage>
+typename TetVolMesh<Basis, CellStorage>::Elem::index_type
+TetVolMesh<Basis, CellStorage>::add_tet_pos(typename Node::index_type a,
                                typename Node::index_type b,
                                typename Node::index_type c,
                                typename Node::index_type d)
@@ -3953,9 +3971,9 @@ TetVolMesh<Basis>::add_tet_pos(typename Node::index_type a,
   return tet;
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::mod_tet_pos(typename TetVolMesh<Basis>::Elem::index_type ci,
+TetVolMesh<Basis, CellStorage>::mod_tet_pos(typename TetVolMesh<Basis, CellStorage>::Elem::index_type ci,
                                typename Node::index_type a,
                                typename Node::index_type b,
                                typename Node::index_type c,
@@ -3980,19 +3998,19 @@ TetVolMesh<Basis>::mod_tet_pos(typename TetVolMesh<Basis>::Elem::index_type ci,
   cells_[ci*4+3] = d;
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::delete_cells(std::set<index_type> &to_delete)
+TetVolMesh<Basis, CellStorage>::delete_cells(std::set<index_type> &to_delete)
 {
   synchronize_lock_.lock();
   std::set<index_type>::reverse_iterator iter = to_delete.rbegin();
   while (iter != to_delete.rend())
   {
     // erase the correct cell
-    typename TetVolMesh<Basis>::Cell::index_type ci = *iter++;
+    typename TetVolMesh<Basis, CellStorage>::Cell::index_type ci = *iter++;
     index_type ind = ci * 4;
-    std::vector<index_type>::iterator cb = cells_.begin() + ind;
-    std::vector<index_type>::iterator ce = cb;
+    typename std::vector<cell_storage_type>::iterator cb = cells_.begin() + ind;
+    typename std::vector<cell_storage_type>::iterator ce = cb;
     ce+=4;
     cells_.erase(cb, ce);
   }
@@ -4012,9 +4030,9 @@ TetVolMesh<Basis>::delete_cells(std::set<index_type> &to_delete)
   synchronize_lock_.unlock();
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::delete_nodes(std::set<index_type> &to_delete)
+TetVolMesh<Basis, CellStorage>::delete_nodes(std::set<index_type> &to_delete)
 {
   synchronize_lock_.lock();
   std::set<index_type>::reverse_iterator iter = to_delete.rbegin();
@@ -4039,9 +4057,9 @@ TetVolMesh<Basis>::delete_nodes(std::set<index_type> &to_delete)
   synchronize_lock_.unlock();
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 bool
-TetVolMesh<Basis>::insert_node_in_cell(typename Cell::array_type &tets,
+TetVolMesh<Basis, CellStorage>::insert_node_in_cell(typename Cell::array_type &tets,
                                        typename Cell::index_type ci,
                                        typename Node::index_type &pi,
                                        const Core::Geometry::Point &p)
@@ -4068,9 +4086,9 @@ TetVolMesh<Basis>::insert_node_in_cell(typename Cell::array_type &tets,
   return true;
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::insert_node_in_face(typename Cell::array_type &tets,
+TetVolMesh<Basis, CellStorage>::insert_node_in_face(typename Cell::array_type &tets,
                                        typename Node::index_type pi,
                                        typename Cell::index_type ci,
                                        const PFaceNode &f)
@@ -4121,9 +4139,9 @@ TetVolMesh<Basis>::insert_node_in_face(typename Cell::array_type &tets,
 
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::insert_node_in_edge(typename Cell::array_type &tets,
+TetVolMesh<Basis, CellStorage>::insert_node_in_edge(typename Cell::array_type &tets,
                                        typename Node::index_type pi,
                                        typename Cell::index_type ci,
                                        const PEdgeNode &e)
@@ -4189,9 +4207,9 @@ TetVolMesh<Basis>::insert_node_in_edge(typename Cell::array_type &tets,
   create_cell_syncinfo_special(tets[tets.size()-1]);
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 bool
-TetVolMesh<Basis>::insert_node_in_elem(typename Elem::array_type &tets,
+TetVolMesh<Basis, CellStorage>::insert_node_in_elem(typename Elem::array_type &tets,
                                        typename Node::index_type &pi,
                                        typename Elem::index_type ci,
                                        const Core::Geometry::Point &p)
@@ -4350,9 +4368,9 @@ TetVolMesh<Basis>::insert_node_in_elem(typename Elem::array_type &tets,
   return true;
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::orient(typename Cell::index_type ci)
+TetVolMesh<Basis, CellStorage>::orient(typename Cell::index_type ci)
 {
   const Core::Geometry::Point &p0 = point(cells_[ci*4+0]);
   const Core::Geometry::Point &p1 = point(cells_[ci*4+1]);
@@ -4371,9 +4389,9 @@ TetVolMesh<Basis>::orient(typename Cell::index_type ci)
 
 #define TETVOLMESH_VERSION 4
 
-template <class Basis>
+template <class Basis, class CellStorage>
 void
-TetVolMesh<Basis>::io(Piostream &stream)
+TetVolMesh<Basis, CellStorage>::io(Piostream &stream)
 {
   const int version = stream.begin_class(type_name(-1),
 					 TETVOLMESH_VERSION);
@@ -4402,15 +4420,17 @@ TetVolMesh<Basis>::io(Piostream &stream)
   }
 }
 
-template <class Basis>
-const TypeDescription* get_type_description(TetVolMesh<Basis> *)
+template <class Basis, class CellStorage>
+const TypeDescription* get_type_description(TetVolMesh<Basis, CellStorage> *)
 {
   static TypeDescription *td = 0;
   if (!td)
   {
     const TypeDescription *sub = get_type_description((Basis*)0);
-    TypeDescription::td_vec *subs = new TypeDescription::td_vec(1);
+    const bool compact = TetVolMesh<Basis, CellStorage>::is_compact_storage;
+    TypeDescription::td_vec *subs = new TypeDescription::td_vec(compact ? 2 : 1);
     (*subs)[0] = sub;
+    if (compact) (*subs)[1] = get_type_description((CellStorage*)0);
     td = new TypeDescription("TetVolMesh", subs,
                                 std::string(__FILE__),
                                 "SCIRun",
@@ -4419,22 +4439,22 @@ const TypeDescription* get_type_description(TetVolMesh<Basis> *)
   return td;
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 const TypeDescription*
-TetVolMesh<Basis>::get_type_description() const
+TetVolMesh<Basis, CellStorage>::get_type_description() const
 {
-  return SCIRun::get_type_description((TetVolMesh<Basis> *)0);
+  return SCIRun::get_type_description((TetVolMesh<Basis, CellStorage> *)0);
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 const TypeDescription*
-TetVolMesh<Basis>::node_type_description()
+TetVolMesh<Basis, CellStorage>::node_type_description()
 {
   static TypeDescription *td = 0;
   if (!td)
   {
     const TypeDescription *me =
-      SCIRun::get_type_description((TetVolMesh<Basis> *)0);
+      SCIRun::get_type_description((TetVolMesh<Basis, CellStorage> *)0);
     td = new TypeDescription(me->get_name() + "::Node",
                                 std::string(__FILE__),
                                 "SCIRun",
@@ -4443,15 +4463,15 @@ TetVolMesh<Basis>::node_type_description()
   return td;
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 const TypeDescription*
-TetVolMesh<Basis>::edge_type_description()
+TetVolMesh<Basis, CellStorage>::edge_type_description()
 {
   static TypeDescription *td = 0;
   if (!td)
   {
     const TypeDescription *me =
-      SCIRun::get_type_description((TetVolMesh<Basis> *)0);
+      SCIRun::get_type_description((TetVolMesh<Basis, CellStorage> *)0);
     td = new TypeDescription(me->get_name() + "::Edge",
                                 std::string(__FILE__),
                                 "SCIRun",
@@ -4460,15 +4480,15 @@ TetVolMesh<Basis>::edge_type_description()
   return td;
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 const TypeDescription*
-TetVolMesh<Basis>::face_type_description()
+TetVolMesh<Basis, CellStorage>::face_type_description()
 {
   static TypeDescription *td = 0;
   if (!td)
   {
     const TypeDescription *me =
-      SCIRun::get_type_description((TetVolMesh<Basis> *)0);
+      SCIRun::get_type_description((TetVolMesh<Basis, CellStorage> *)0);
     td = new TypeDescription(me->get_name() + "::Face",
                                 std::string(__FILE__),
                                 "SCIRun",
@@ -4477,15 +4497,15 @@ TetVolMesh<Basis>::face_type_description()
   return td;
 }
 
-template <class Basis>
+template <class Basis, class CellStorage>
 const TypeDescription*
-TetVolMesh<Basis>::cell_type_description()
+TetVolMesh<Basis, CellStorage>::cell_type_description()
 {
   static TypeDescription *td = 0;
   if (!td)
   {
     const TypeDescription *me =
-      SCIRun::get_type_description((TetVolMesh<Basis> *)0);
+      SCIRun::get_type_description((TetVolMesh<Basis, CellStorage> *)0);
     td = new TypeDescription(me->get_name() + "::Cell",
                                 std::string(__FILE__),
                                 "SCIRun",
@@ -605,6 +605,23 @@ public:
   inline void* fdata_pointer()   { return (vfdata_->fdata_pointer()); }
   inline void* efdata_pointer()   { return (vfdata_->efdata_pointer()); }
 
+  /// Typed views onto the data storage, these are the safe version of the
+  /// pointers above. The view is invalid unless T is exactly the type the
+  /// data is stored in, e.g. view<double>() on a float field is invalid.
+  /// Values are stored contiguously for all mesh types, so when the view
+  /// is valid view[idx] is the same value as get_value(val,idx).
+  template<class T> inline FieldArrayView<T> view()
+  {
+    if (basis_order_ < 0 || !is_type(static_cast<T*>(0))) return (FieldArrayView<T>());
+    return (FieldArrayView<T>(static_cast<T*>(vfdata_->fdata_pointer()),vfdata_->fdata_size()));
+  }
+
+  template<class T> inline FieldArrayView<T> eview()
+  {
+    if (basis_order_ < 2 || !is_type(static_cast<T*>(0))) return (FieldArrayView<T>());
+    return (FieldArrayView<T>(static_cast<T*>(vfdata_->efdata_pointer()),vfdata_->efdata_size()));
+  }
+
   inline bool is_nodata()        { return (basis_order_ == -1); }
   inline bool is_constantdata()  { return (basis_order_ == 0); }
   inline bool is_lineardata()    { return (basis_order_ == 1); }
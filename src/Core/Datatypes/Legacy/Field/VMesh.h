@@ -36,6 +36,7 @@
 #include <Core/Datatypes/Legacy/Field/Mesh.h>
 #include <Core/Datatypes/Legacy/Field/FieldVIndex.h>
 #include <Core/Datatypes/Legacy/Field/FieldVIterator.h>
+#include <Core/Datatypes/Legacy/Field/FieldArrayView.h>
 
 #include <Core/GeometryPrimitives/SearchGridT.h>
 
@@ -774,6 +775,23 @@ public:
   // Only for unstructured data
   virtual VMesh::index_type* get_elems_pointer() const;
 
+  /// Typed views onto the same memory as above, they carry their own size
+  /// and are invalid when the mesh does not store the array explicitly.
+  /// Node points are stored for irregular meshes only, the connectivity
+  /// has num_nodes_per_elem() entries per element and is stored for
+  /// unstructured meshes only.
+  inline FieldArrayView<Core::Geometry::Point> node_points_view() const
+  {
+    if (is_regular_) return (FieldArrayView<Core::Geometry::Point>());
+    return (FieldArrayView<Core::Geometry::Point>(get_points_pointer(),num_nodes()));
+  }
+
+  inline FieldArrayView<VMesh::index_type> elem_nodes_view() const
+  {
+    if (is_structured_ || basis_order_ != 1) return (FieldArrayView<VMesh::index_type>());
+    return (FieldArrayView<VMesh::index_type>(get_elems_pointer(),num_elems(),num_nodes_per_elem_));
+  }
+
   /// Copy nodes from one mesh to another mesh
   /// Note: currently only for irregular meshes
   /// @todo: Add regular meshes to the mix
@@ -800,6 +818,18 @@ public:
   {
     VMesh::index_type* ielem = imesh->get_elems_pointer();
     VMesh::index_type* oelem  = get_elems_pointer();
+    if (ielem == 0 || oelem == 0)
+    {
+      // Compact meshes do not expose their connectivity, copy per element
+      Node::array_type nodes;
+      for (index_type j=0; j<size; j++,i++,o++)
+      {
+        imesh->get_nodes(nodes,i);
+        for (size_t k=0; k<nodes.size(); k++) nodes[k] += offset;
+        set_nodes(nodes,o);
+      }
+      return;
+    }
     index_type ii = i*num_nodes_per_elem_;
     index_type oo = o*num_nodes_per_elem_;
     size_type  ss = size*num_nodes_per_elem_;
@@ -810,6 +840,11 @@ public:
   {
     VMesh::index_type* ielem = imesh->get_elems_pointer();
     VMesh::index_type* oelem  = get_elems_pointer();
+    if (ielem == 0 || oelem == 0)
+    {
+      copy_elems(imesh,0,0,num_elems(),0);
+      return;
+    }
     size_type  ss = num_elems()*num_nodes_per_elem_;
     for (index_type j=0; j <ss; j++) oelem[j] = ielem[j];
   }
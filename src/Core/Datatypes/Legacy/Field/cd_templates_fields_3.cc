@@ -216,6 +216,33 @@ typedef TetQuadraticLgn<unsigned short>        TQFDushortBasis;
 typedef TetQuadraticLgn<unsigned char>         TQFDucharBasis;
 typedef TetQuadraticLgn<unsigned long>         TQFDulongBasis;
 
+/// Compact TetVolMesh storing its connectivity as 32-bit integers, only the
+/// data types commonly used for large simulation meshes are instantiated
+typedef TetVolMesh<TetLinearLgn<Point>, int> CTVMesh;
+
+namespace SCIRun {
+
+template class TetVolMesh<TetLinearLgn<Point>, int>;
+
+//NoData
+template class GenericField<CTVMesh, NDBasis, std::vector<double> >;
+
+//Constant
+template class GenericField<CTVMesh, CFDTensorBasis, std::vector<Tensor> >;
+template class GenericField<CTVMesh, CFDVectorBasis, std::vector<Vector> >;
+template class GenericField<CTVMesh, CFDdoubleBasis, std::vector<double> >;
+template class GenericField<CTVMesh, CFDfloatBasis,  std::vector<float> >;
+template class GenericField<CTVMesh, CFDintBasis,    std::vector<int> >;
+
+//Linear
+template class GenericField<CTVMesh, TFDTensorBasis, std::vector<Tensor> >;
+template class GenericField<CTVMesh, TFDVectorBasis, std::vector<Vector> >;
+template class GenericField<CTVMesh, TFDdoubleBasis, std::vector<double> >;
+template class GenericField<CTVMesh, TFDfloatBasis,  std::vector<float> >;
+template class GenericField<CTVMesh, TFDintBasis,    std::vector<int> >;
+
+}
+
 typedef TetVolMesh<TetQuadraticLgn<Point> > QTVMesh;
 
 namespace SCIRun {
@@ -54,6 +54,9 @@ public:
   NrrdData();
   explicit NrrdData(Nrrd* nrrd);
   explicit NrrdData(const NrrdData&);
+  /// Wrap data that belongs to another object. The nrrd data pointer has to be
+  /// set with nrrdWrap, the owner is kept alive as long as this object exists.
+  explicit NrrdData(Core::Datatypes::DatatypeHandle data_owner);
   virtual ~NrrdData();
 
   virtual NrrdData* clone() const override;
@@ -85,6 +88,7 @@ private:
   Nrrd *nrrd_;
   bool    write_nrrd_;
   bool    embed_object_;
+  Core::Datatypes::DatatypeHandle data_owner_;
 
   bool in_name_set(const std::string &s) const;
 
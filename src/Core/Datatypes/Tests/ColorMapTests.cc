@@ -0,0 +1,162 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2016 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   License for the specific language governing rights and limitations under
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Core/Math/MiscMath.h>
+#include <Core/Datatypes/ColorMap.h>
+#include <chrono>
+#include <limits>
+
+using namespace SCIRun::Core::Datatypes;
+
+namespace
+{
+  // The color of a value computed step by step, without the lookup table.
+  ColorRGB expectedColor(const ColorMap& map, double f)
+  {
+    double v = std::min(std::max(0., (f + map.getColorMapRescaleShift()) * map.getColorMapRescaleScale()), 1.);
+    double shift = map.getColorMapShift();
+    if (map.getColorMapInvert())
+    {
+      v = 1. - v;
+      shift *= -1.;
+    }
+    const double resolution = static_cast<double>(map.getColorMapResolution());
+    v = static_cast<double>(static_cast<int>(v * resolution)) / (resolution - 1.);
+    double denom = std::tan(M_PI_2 * (0.5 - std::min(std::max(shift, -0.99), 0.99) * 0.5));
+    if (std::isnan(denom)) denom = 0.;
+    denom = std::max(denom, 0.001);
+    v = std::min(std::max(0., std::pow(v, 1. / denom)), 1.);
+    return map.getColorStrategy()->getColorMapVal(v);
+  }
+
+  std::vector<double> sampleValues()
+  {
+    std::vector<double> values;
+    for (int i = -300; i <= 300; ++i)
+      values.push_back(i / 200.0);
+    values.push_back(-1e10);
+    values.push_back(1e10);
+    values.push_back(std::numeric_limits<double>::quiet_NaN());
+    return values;
+  }
+}
+
+TEST(ColorMapTests, LookupMatchesDirectEvaluation)
+{
+  auto values = sampleValues();
+  for (const auto& name : StandardColorMapFactory::getList())
+  {
+    for (size_t resolution : { 2, 17, 256 })
+    {
+      for (double shift : { -0.5, 0.0, 0.3 })
+      {
+        for (bool invert : { false, true })
+        {
+          auto map = StandardColorMapFactory::create(name, resolution, shift, invert);
+          std::vector<float> rgba(4 * values.size());
+          map->valuesToColors(&values[0], values.size(), &rgba[0]);
+          for (size_t i = 0; i < values.size(); ++i)
+          {
+            auto expected = expectedColor(*map, values[i]);
+            auto color = map->valueToColor(values[i]);
+            ASSERT_EQ(expected.r(), color.r()) << name << " " << values[i];
+            ASSERT_EQ(expected.g(), color.g()) << name << " " << values[i];
+            ASSERT_EQ(expected.b(), color.b()) << name << " " << values[i];
+            ASSERT_EQ(static_cast<float>(expected.r()), rgba[4 * i]);
+            ASSERT_EQ(static_cast<float>(expected.g()), rgba[4 * i + 1]);
+            ASSERT_EQ(static_cast<float>(expected.b()), rgba[4 * i + 2]);
+            ASSERT_EQ(static_cast<float>(expected.a()), rgba[4 * i + 3]);
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(ColorMapTests, BulkMappingHonorsStride)
+{
+  auto map = StandardColorMapFactory::create("Blackbody", 64, 0.0, false, 0.25, 2.0);
+  auto values = sampleValues();
+  const size_t stride = 10;
+  std::vector<float> interleaved(stride * values.size(), -1.0f);
+  map->valuesToColors(&values[0], values.size(), &interleaved[3], stride);
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    auto expected = map->valueToColor(values[i]);
+    const float* vertex = &interleaved[stride * i];
+    EXPECT_EQ(-1.0f, vertex[2]);
+    EXPECT_EQ(static_cast<float>(expected.r()), vertex[3]);
+    EXPECT_EQ(static_cast<float>(expected.g()), vertex[4]);
+    EXPECT_EQ(static_cast<float>(expected.b()), vertex[5]);
+    EXPECT_EQ(static_cast<float>(expected.a()), vertex[6]);
+    EXPECT_EQ(-1.0f, vertex[7]);
+  }
+}
+
+TEST(ColorMapTests, FineResolutionFallsBackToDirectEvaluation)
+{
+  auto map = StandardColorMapFactory::create("Rainbow", 1 << 20, 0.2, true);
+  auto values = sampleValues();
+  std::vector<float> rgba(4 * values.size());
+  map->valuesToColors(&values[0], values.size(), &rgba[0]);
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    auto expected = expectedColor(*map, values[i]);
+    EXPECT_EQ(expected.r(), map->valueToColor(values[i]).r());
+    EXPECT_EQ(static_cast<float>(expected.g()), rgba[4 * i + 1]);
+  }
+}
+
+TEST(ColorMapTests, DISABLED_BulkMappingTiming)
+{
+  auto map = StandardColorMapFactory::create("Rainbow", 256, 0.1, false);
+  std::vector<double> values(1 << 22);
+  for (size_t i = 0; i < values.size(); ++i)
+    values[i] = std::sin(0.001 * i);
+  std::vector<float> rgba(4 * values.size());
+
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    auto color = map->valueToColor(values[i]);
+    rgba[4 * i] = static_cast<float>(color.r());
+    rgba[4 * i + 1] = static_cast<float>(color.g());
+    rgba[4 * i + 2] = static_cast<float>(color.b());
+    rgba[4 * i + 3] = static_cast<float>(color.a());
+  }
+  auto perValue = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  map->valuesToColors(&values[0], values.size(), &rgba[0]);
+  auto bulk = std::chrono::steady_clock::now() - start;
+
+  std::cout << values.size() << " values: per value "
+    << std::chrono::duration_cast<std::chrono::milliseconds>(perValue).count() << " ms, bulk "
+    << std::chrono::duration_cast<std::chrono::milliseconds>(bulk).count() << " ms" << std::endl;
+}
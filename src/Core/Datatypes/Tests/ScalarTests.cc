@@ -82,11 +82,8 @@ TEST(BasicDatatypeIOTests, AssertSizesOfFieldDatatypesAreConsistent)
   ASSERT_EQ(3 * sizeof(double), sizeof(Vector));
   ASSERT_EQ(3 * sizeof(double), sizeof(Point));
   ASSERT_EQ(
-    3 * 3 * sizeof(double) +  // matrix data
-    3 * sizeof(Vector) +      // eigenvectors
-    3 * sizeof(double) +      // eigenvalues
-    sizeof(int) +             // eigens computed flag (must stay int, not bool)
-    4,                        // to get to 8-byte packing
+    6 * sizeof(double) +      // upper triangle of the symmetric matrix
+    sizeof(void*),            // lazily allocated eigen decomposition
     sizeof(Tensor));
 }
 
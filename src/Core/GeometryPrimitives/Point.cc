@@ -26,7 +26,7 @@
    DEALINGS IN THE SOFTWARE.
 */
 
-#include <Core/Persistent/Persistent.h>
+#include <Core/Persistent/PersistentSTL.h>
 #include <Core/GeometryPrimitives/Point.h>
 #include <iostream>
 #include <sstream>
@@ -160,6 +160,12 @@ SCIRun::Core::Geometry::Pio(Piostream& stream, Point& p)
   stream.end_cheap_delim();
 }
 
+void
+SCIRun::Core::Geometry::Pio(Piostream& stream, std::vector<Point>& data)
+{
+  Pio_double_records<Point, 3>(stream, data);
+}
+
 
 const std::string& 
 SCIRun::Point_get_h_file_path() 
@@ -177,6 +177,7 @@ SCISHARE Point AffineCombination(const Point&, double, const Point&, double,
 SCISHARE Point AffineCombination(const Point&, double, const Point&, double);
 
 SCISHARE void Pio( Piostream&, Point& );
+SCISHARE void Pio( Piostream&, std::vector<Point>& );
 
 inline 
 Point operator*(double d, const Point &p) {
@@ -45,145 +45,105 @@
 
 #include <iostream>
 
-#include <Core/Persistent/Persistent.h>
+#include <Core/Persistent/PersistentSTL.h>
 
 #include <teem/ten.h>
 
 using namespace SCIRun;
 using namespace Core::Geometry;
 
-Tensor::Tensor() : l1_(0), l2_(0), l3_(0), have_eigens_(false)
+Tensor::Tensor()
 {
-  mat_[0][0] = 0.0;
-  mat_[0][1] = 0.0;
-  mat_[0][2] = 0.0;
-  mat_[1][0] = 0.0;
-  mat_[1][1] = 0.0;
-  mat_[1][2] = 0.0;
-  mat_[2][0] = 0.0;
-  mat_[2][1] = 0.0;
-  mat_[2][2] = 0.0;
+  for (int i=0; i<6; i++) mat_[i] = 0.0;
 }
 
 Tensor::Tensor(const Tensor& copy)
 {
-  for(int i=0; i<3; i++)
-    for(int j=0; j<3; j++)
-      mat_[i][j]=copy.mat_[i][j];
-  have_eigens_=copy.have_eigens_;
-  if (have_eigens_) {
-    e1_=copy.e1_; e2_=copy.e2_; e3_=copy.e3_;
-    l1_=copy.l1_; l2_=copy.l2_; l3_=copy.l3_;
-  }
+  for (int i=0; i<6; i++) mat_[i] = copy.mat_[i];
+  if (copy.eigens_) eigens_.reset(new Eigens(*copy.eigens_));
 }
 
-Tensor::Tensor(const Array1<double> &t) : l1_(0), l2_(0), l3_(0)
+Tensor::Tensor(const Array1<double> &t)
 {
-  mat_[0][0]=t[0];
-  mat_[0][1]=mat_[1][0]=t[1];
-  mat_[0][2]=mat_[2][0]=t[2];
-  mat_[1][1]=t[3];
-  mat_[1][2]=mat_[2][1]=t[4];
-  mat_[2][2]=t[5];
-
-  have_eigens_=0;
+  for (int i=0; i<6; i++) mat_[i] = t[i];
 }
 
-Tensor::Tensor(const std::vector<double> &t) : l1_(0), l2_(0), l3_(0)
+Tensor::Tensor(const std::vector<double> &t)
 {
   ASSERT(t.size() > 5);
-
-  mat_[0][0]=t[0];
-  mat_[0][1]=mat_[1][0]=t[1];
-  mat_[0][2]=mat_[2][0]=t[2];
-  mat_[1][1]=t[3];
-  mat_[1][2]=mat_[2][1]=t[4];
-  mat_[2][2]=t[5];
-
-  have_eigens_=0;
+  for (int i=0; i<6; i++) mat_[i] = t[i];
 }
 
-Tensor::Tensor(const double *t) : l1_(0), l2_(0), l3_(0)
+Tensor::Tensor(const double *t)
 {
-  mat_[0][0]=t[0];
-  mat_[0][1]=mat_[1][0]=t[1];
-  mat_[0][2]=mat_[2][0]=t[2];
-  mat_[1][1]=t[3];
-  mat_[1][2]=mat_[2][1]=t[4];
-  mat_[2][2]=t[5];
-
-  have_eigens_=0;
+  for (int i=0; i<6; i++) mat_[i] = t[i];
 }
 
 /// Initialize the diagonal to this value
-Tensor::Tensor(double v) : l1_(0), l2_(0), l3_(0)
+Tensor::Tensor(double v)
 {
-  have_eigens_=0;
-  for (int i=0; i<3; i++) 
-    for (int j=0; j<3; j++)
-      if (i==j) mat_[i][j]=v;
-      else mat_[i][j]=0;
+  mat_[0] = v; mat_[1] = 0.0; mat_[2] = 0.0;
+  mat_[3] = v; mat_[4] = 0.0;
+  mat_[5] = v;
 }
 
-Tensor::Tensor(double v1, double v2, double v3, double v4, double v5, double v6) : l1_(0), l2_(0), l3_(0)
+Tensor::Tensor(double v1, double v2, double v3, double v4, double v5, double v6)
 {
-  have_eigens_=0;
-  mat_[0][0] = v1;
-  mat_[0][1] = v2;
-  mat_[0][2] = v3;
-  mat_[1][0] = v2;
-  mat_[1][1] = v4;
-  mat_[1][2] = v5;
-  mat_[2][0] = v3;
-  mat_[2][1] = v5;
-  mat_[2][2] = v6;
+  mat_[0] = v1;
+  mat_[1] = v2;
+  mat_[2] = v3;
+  mat_[3] = v4;
+  mat_[4] = v5;
+  mat_[5] = v6;
 }
 
 /// Initialize the diagonal to this value
-Tensor::Tensor(int v) : l1_(0), l2_(0), l3_(0)
+Tensor::Tensor(int v)
 {
-  have_eigens_=0;
-  for (int i=0; i<3; i++) 
-    for (int j=0; j<3; j++)
-      if (i==j) mat_[i][j]=v;
-      else mat_[i][j]=0;
+  mat_[0] = v; mat_[1] = 0.0; mat_[2] = 0.0;
+  mat_[3] = v; mat_[4] = 0.0;
+  mat_[5] = v;
 }
 
-Tensor::Tensor(const Vector &e1, const Vector &e2, const Vector &e3) :
-  e1_(e1), e2_(e2), e3_(e3), 
-  l1_(e1.length()), l2_(e2.length()), l3_(e3.length())
+Tensor::Tensor(const Vector &e1, const Vector &e2, const Vector &e3)
 {
-  build_mat_from_eigens();
-  have_eigens_=1;
+  set_eigens(e1, e2, e3);
+}
+
+/// Only the upper triangle of the matrix is used
+Tensor::Tensor(const double **cmat)
+{
+  for (size_t i=0; i<3; i++)
+    for (size_t j=i; j<3; j++)
+      mat_[index(i,j)]=cmat[i][j];
 }
 
-Tensor::Tensor(const double **cmat) : l1_(0), l2_(0), l3_(0)
+Tensor::Eigens& Tensor::eigens()
 {
-  for (int i=0; i<3; i++)
-    for (int j=0; j<3; j++)
-      mat_[i][j]=cmat[i][j];
-  have_eigens_=0;
+  if (!eigens_) eigens_.reset(new Eigens());
+  return *eigens_;
 }
 
 void Tensor::build_mat_from_eigens() {
-  if (!have_eigens_) return;
+  if (!eigens_) return;
+  const Eigens& eg = *eigens_;
   double E[3][3];
   double S[3][3];
   double SE[3][3];
-  Vector e1n(e1_);
-  Vector e2n(e2_);
-  Vector e3n(e3_);
-  if (l1_ != 0) e1n.normalize();
-  if (l2_ != 0) e2n.normalize();
-  if (l3_ != 0) e3n.normalize();
+  Vector e1n(eg.e1_);
+  Vector e2n(eg.e2_);
+  Vector e3n(eg.e3_);
+  if (eg.l1_ != 0) e1n.normalize();
+  if (eg.l2_ != 0) e2n.normalize();
+  if (eg.l3_ != 0) e3n.normalize();
 
   E[0][0] = e1n.x(); E[0][1] = e1n.y(); E[0][2] = e1n.z();
   E[1][0] = e2n.x(); E[1][1] = e2n.y(); E[1][2] = e2n.z();
   E[2][0] = e3n.x(); E[2][1] = e3n.y(); E[2][2] = e3n.z();
-  S[0][0] = l1_; S[0][1] = 0;   S[0][2] = 0;
-  S[1][0] = 0;   S[1][1] = l2_; S[1][2] = 0;
-  S[2][0] = 0;   S[2][1] = 0;   S[2][2] = l3_;
-  int i,j,k;
+  S[0][0] = eg.l1_; S[0][1] = 0;      S[0][2] = 0;
+  S[1][0] = 0;      S[1][1] = eg.l2_; S[1][2] = 0;
+  S[2][0] = 0;      S[2][1] = 0;      S[2][2] = eg.l3_;
+  size_t i,j,k;
   for (i=0; i<3; i++)
     for (j=0; j<3; j++) {
       SE[i][j]=0;
@@ -191,52 +151,47 @@ void Tensor::build_mat_from_eigens() {
         SE[i][j] += S[i][k] * E[j][k];  // S x E-transpose
     }
     for (i=0; i<3; i++)
-      for (j=0; j<3; j++) {
-        mat_[i][j]=0;
+      for (j=i; j<3; j++) {
+        double m = 0.0;
         for (k=0; k<3; k++)
-          mat_[i][j] += E[i][k] * SE[k][j];
+          m += E[i][k] * SE[k][j];
+        mat_[index(i,j)] = m;
       }
 }
 
 bool Tensor::operator==(const Tensor& t) const
 {
-  for(int i=0;i<3;i++)
-    for(int j=0;j<3;j++)
-      if( mat_[i][j]!=t.mat_[i][j])
-        return false;
+  for(int i=0;i<6;i++)
+    if( mat_[i]!=t.mat_[i])
+      return false;
 
   return true;
 }
 
 bool Tensor::operator!=(const Tensor& t) const
 {
-  for(int i=0;i<3;i++)
-    for(int j=0;j<3;j++)
-      if( mat_[i][j]!=t.mat_[i][j])
-        return true;
+  for(int i=0;i<6;i++)
+    if( mat_[i]!=t.mat_[i])
+      return true;
 
   return false;
 }
 
 Tensor& Tensor::operator=(const Tensor& copy)
 {
-  for(int i=0;i<3;i++)
-    for(int j=0;j<3;j++)
-      mat_[i][j]=copy.mat_[i][j];
-  have_eigens_=copy.have_eigens_;
-  if (have_eigens_) {
-    e1_=copy.e1_; e2_=copy.e2_; e3_=copy.e3_;
-    l1_=copy.l1_; l2_=copy.l2_; l3_=copy.l3_;
-  }
+  if (this == &copy) return *this;
+  for(int i=0;i<6;i++)
+    mat_[i]=copy.mat_[i];
+  if (copy.eigens_) eigens() = *copy.eigens_;
+  else eigens_.reset();
   return *this;
 }
 
 Tensor& Tensor::operator=(const double& d)
 {
-  for(int i=0;i<3;i++)
-    for(int j=0;j<3;j++)
-      mat_[i][j]=d;
-  have_eigens_=0;
+  for(int i=0;i<6;i++)
+    mat_[i]=d;
+  eigens_.reset();
   return *this;
 }
 
@@ -245,10 +200,10 @@ double Tensor::norm() const
 {
   double a = 0.0;
   double sum;
-  for (int i=0;i<3;i++)
+  for (size_t i=0;i<3;i++)
   {
     sum = 0.0;
-    for (int j=0;j<3;j++) sum += fabs(mat_[i][j]);
+    for (size_t j=0;j<3;j++) sum += fabs(mat_[index(i,j)]);
     if (sum > a) a = sum;
   }
   return (a);
@@ -261,144 +216,210 @@ std::string Tensor::type_name(int) {
 
 Tensor Tensor::operator-(const Tensor& t) const
 {
-  Tensor t1(*this);
-  t1.have_eigens_=0;
-  for (int i=0; i<3; i++)
-    for (int j=0; j<3; j++)
-      t1.mat_[i][j]-=t.mat_[i][j];
+  Tensor t1;
+  for (int i=0; i<6; i++)
+    t1.mat_[i]=mat_[i]-t.mat_[i];
   return t1;
 }
 
 Tensor& Tensor::operator-=(const Tensor& t)
 {
-  have_eigens_=0;
-  for (int i=0; i<3; i++)
-    for (int j=0; j<3; j++)
-      mat_[i][j]-=t.mat_[i][j];
+  eigens_.reset();
+  for (int i=0; i<6; i++)
+    mat_[i]-=t.mat_[i];
   return *this;
 }
 
 Tensor Tensor::operator+(const Tensor& t) const
 {
-  Tensor t1(*this);
-  t1.have_eigens_=0;
-  for (int i=0; i<3; i++)
-    for (int j=0; j<3; j++)
-      t1.mat_[i][j]+=t.mat_[i][j];
+  Tensor t1;
+  for (int i=0; i<6; i++)
+    t1.mat_[i]=mat_[i]+t.mat_[i];
   return t1;
 }
 
 Tensor& Tensor::operator+=(const Tensor& t)
 {
-  have_eigens_=0;
-  for (int i=0; i<3; i++)
-    for (int j=0; j<3; j++)
-      mat_[i][j]+=t.mat_[i][j];
+  eigens_.reset();
+  for (int i=0; i<6; i++)
+    mat_[i]+=t.mat_[i];
   return *this;
 }
 
 Tensor Tensor::operator*(const double s) const
 {
   Tensor t1(*this);
-  for (int i=0; i<3; i++)
-    for (int j=0; j<3; j++)
-      t1.mat_[i][j]*=s;
-  if (t1.have_eigens_) {
-    t1.e1_*=s; t1.e2_*=s; t1.e3_*=s;
-    t1.l1_*=s; t1.l2_*=s; t1.l3_*=s;
+  for (int i=0; i<6; i++)
+    t1.mat_[i]*=s;
+  if (t1.eigens_) {
+    Eigens& eg = *t1.eigens_;
+    eg.e1_*=s; eg.e2_*=s; eg.e3_*=s;
+    eg.l1_*=s; eg.l2_*=s; eg.l3_*=s;
   }
   return t1;
 }
 
 Vector Tensor::operator*(const Vector& v) const
 {
-  return Vector(v.x()*mat_[0][0]+v.y()*mat_[0][1]+v.z()*mat_[0][2],
-		v.x()*mat_[1][0]+v.y()*mat_[1][1]+v.z()*mat_[1][2],
-		v.x()*mat_[2][0]+v.y()*mat_[2][1]+v.z()*mat_[2][2]);
+  return Vector(v.x()*mat_[0]+v.y()*mat_[1]+v.z()*mat_[2],
+		v.x()*mat_[1]+v.y()*mat_[3]+v.z()*mat_[4],
+		v.x()*mat_[2]+v.y()*mat_[4]+v.z()*mat_[5]);
 }
 
 void Tensor::build_eigens_from_mat()
 {
-  if (have_eigens_) return;
+  if (eigens_) return;
   float ten[7];
   ten[0] = 1.0;
-  ten[1] = mat_[0][0];
-  ten[2] = mat_[0][1];
-  ten[3] = mat_[0][2];
-  ten[4] = mat_[1][1];
-  ten[5] = mat_[1][2];
-  ten[6] = mat_[2][2];
+  ten[1] = mat_[0];
+  ten[2] = mat_[1];
+  ten[3] = mat_[2];
+  ten[4] = mat_[3];
+  ten[5] = mat_[4];
+  ten[6] = mat_[5];
   float eval[3];
   float evec[9];
 
   tenEigensolve_f(eval, evec, ten);
 
-  e1_ = Vector(evec[0], evec[1], evec[2]);
-  e2_ = Vector(evec[3], evec[4], evec[5]);
-  e3_ = Vector(evec[6], evec[7], evec[8]);
-  l1_ = eval[0];
-  l2_ = eval[1];
-  l3_ = eval[2];
-  have_eigens_ = 1;
+  Eigens& eg = eigens();
+  eg.e1_ = Vector(evec[0], evec[1], evec[2]);
+  eg.e2_ = Vector(evec[3], evec[4], evec[5]);
+  eg.e3_ = Vector(evec[6], evec[7], evec[8]);
+  eg.l1_ = eval[0];
+  eg.l2_ = eval[1];
+  eg.l3_ = eval[2];
 }
 
 void Tensor::get_eigenvectors(Vector &e1, Vector &e2, Vector &e3)
 {
-  if (!have_eigens_) build_eigens_from_mat();
-  e1=e1_; e2=e2_; e3=e3_;
+  if (!eigens_) build_eigens_from_mat();
+  e1=eigens_->e1_; e2=eigens_->e2_; e3=eigens_->e3_;
 }
 
 void Tensor::get_eigenvalues(double &l1, double &l2, double &l3)
 {
-  if (!have_eigens_) build_eigens_from_mat();
-  l1=l1_; l2=l2_; l3=l3_;
+  if (!eigens_) build_eigens_from_mat();
+  l1=eigens_->l1_; l2=eigens_->l2_; l3=eigens_->l3_;
 }
 
 void Tensor::set_eigens(const Vector &e1, const Vector &e2, const Vector &e3) {
-  e1_ = e1; e2_ = e2; e3_ = e3;
-  l1_ = e1.length(); l2_ = e2.length(); l3_ = e3.length();
+  Eigens& eg = eigens();
+  eg.e1_ = e1; eg.e2_ = e2; eg.e3_ = e3;
+  eg.l1_ = e1.length(); eg.l2_ = e2.length(); eg.l3_ = e3.length();
   build_mat_from_eigens();
-  have_eigens_ = 1;
 }
 
 void Tensor::set_outside_eigens(const Vector &e1, const Vector &e2,
 				const Vector &e3,
 				double v1, double v2, double v3)
 {
-  e1_ = e1; e2_ = e2; e3_ = e3;
-  l1_ = v1; l2_ = v2; l3_ = v3;
-  have_eigens_ = 1;
+  Eigens& eg = eigens();
+  eg.e1_ = e1; eg.e2_ = e2; eg.e3_ = e3;
+  eg.l1_ = v1; eg.l2_ = v2; eg.l3_ = v3;
 }
 
 void Core::Geometry::Pio(Piostream& stream, Tensor& t)
 {
   stream.begin_cheap_delim();
  
-  Pio(stream, t.mat_[0][0]);
-  Pio(stream, t.mat_[0][1]);
-  Pio(stream, t.mat_[0][2]);
-  Pio(stream, t.mat_[1][1]);
-  Pio(stream, t.mat_[1][2]);
-  Pio(stream, t.mat_[2][2]);
-
-  t.mat_[1][0]=t.mat_[0][1];
-  t.mat_[2][0]=t.mat_[0][2];
-  t.mat_[2][1]=t.mat_[1][2];
-
-  Pio(stream, t.have_eigens_);
-  if (t.have_eigens_) 
+  for (int i=0; i<6; i++)
+    Pio(stream, t.mat_[i]);
+
+  //do NOT change to bool, it will break Pio system
+  int have_eigens = t.eigens_ ? 1 : 0;
+  Pio(stream, have_eigens);
+  if (have_eigens) 
   {
-    Pio(stream, t.e1_);
-    Pio(stream, t.e2_);
-    Pio(stream, t.e3_);
-    Pio(stream, t.l1_);
-    Pio(stream, t.l2_);
-    Pio(stream, t.l3_);
+    Tensor::Eigens& eg = t.eigens();
+    Pio(stream, eg.e1_);
+    Pio(stream, eg.e2_);
+    Pio(stream, eg.e3_);
+    Pio(stream, eg.l1_);
+    Pio(stream, eg.l2_);
+    Pio(stream, eg.l3_);
+  }
+  else if (stream.reading())
+  {
+    t.eigens_.reset();
   }
 
   stream.end_cheap_delim();
 }
 
+void Core::Geometry::Pio(Piostream& stream, std::vector<Tensor>& data)
+{
+  if (!stream.supports_split_records())
+  {
+    SCIRun::Pio<Tensor>(stream, data);
+    return;
+  }
+
+  // Tensors only carry a decomposition if it was requested, the components,
+  // the flags and the decompositions are stored as three arrays instead, so
+  // the components go through block_io like any other field data.
+  stream.begin_class("STLVector", STLVECTOR_VERSION);
+  int size = static_cast<int>(data.size());
+  stream.io(size);
+
+  std::vector<double> components(6 * static_cast<size_t>(size));
+  std::vector<char> have_eigens(size);
+  std::vector<double> eigens;
+  if (stream.reading())
+  {
+    data.resize(size);
+  }
+  else
+  {
+    for (int i = 0; i < size; i++)
+    {
+      const Tensor& t = data[i];
+      std::copy(t.mat_, t.mat_ + 6, &components[6 * i]);
+      have_eigens[i] = t.eigens_ ? 1 : 0;
+      if (t.eigens_)
+      {
+        const Tensor::Eigens& eg = *t.eigens_;
+        const double e[12] = { eg.e1_.x(), eg.e1_.y(), eg.e1_.z(), eg.e2_.x(), eg.e2_.y(), eg.e2_.z(),
+          eg.e3_.x(), eg.e3_.y(), eg.e3_.z(), eg.l1_, eg.l2_, eg.l3_ };
+        eigens.insert(eigens.end(), e, e + 12);
+      }
+    }
+  }
+
+  Pio(stream, components);
+  Pio(stream, have_eigens);
+  Pio(stream, eigens);
+
+  if (stream.reading() && !stream.error() && components.size() == 6 * static_cast<size_t>(size) &&
+    have_eigens.size() == static_cast<size_t>(size))
+  {
+    size_t e = 0;
+    for (int i = 0; i < size; i++)
+    {
+      Tensor& t = data[i];
+      std::copy(&components[6 * i], &components[6 * i] + 6, t.mat_);
+      if (have_eigens[i] && e + 12 <= eigens.size())
+      {
+        Tensor::Eigens& eg = t.eigens();
+        const double* v = &eigens[e];
+        eg.e1_ = Vector(v[0], v[1], v[2]);
+        eg.e2_ = Vector(v[3], v[4], v[5]);
+        eg.e3_ = Vector(v[6], v[7], v[8]);
+        eg.l1_ = v[9];
+        eg.l2_ = v[10];
+        eg.l3_ = v[11];
+        e += 12;
+      }
+      else
+      {
+        t.eigens_.reset();
+      }
+    }
+  }
+
+  stream.end_class();
+}
+
 const std::string& 
 Tensor::get_h_file_path() {
   static const std::string path(TypeDescription::cc_to_h(__FILE__));
@@ -419,20 +440,25 @@ const TypeDescription* Core::Geometry::get_type_description(Tensor*)
 
 std::ostream& Core::Geometry::operator<<( std::ostream& os, const Tensor& t )
 {
-  os << '[' << t.mat_[0][0] << ' ' << t.mat_[0][1] << ' ' << t.mat_[0][2]
-     << ' ' << t.mat_[1][0] << ' ' << t.mat_[1][1] << ' ' << t.mat_[1][2]
-     << ' ' << t.mat_[2][0] << ' ' << t.mat_[2][1] << ' ' << t.mat_[2][2]
+  os << '[' << t.val(0,0) << ' ' << t.val(0,1) << ' ' << t.val(0,2)
+     << ' ' << t.val(1,0) << ' ' << t.val(1,1) << ' ' << t.val(1,2)
+     << ' ' << t.val(2,0) << ' ' << t.val(2,1) << ' ' << t.val(2,2)
      << ']';
 
   return os;
 }
 
+/// Nine values are read, only the upper triangle is used
 std::istream& Core::Geometry::operator>>(std::istream& is, Tensor& t)
 {
   t = Tensor();
-  is >> t.mat_[0][0] >> t.mat_[0][1] >> t.mat_[0][2]
-     >> t.mat_[1][0] >> t.mat_[1][1] >> t.mat_[1][2]
-     >> t.mat_[2][0] >> t.mat_[2][1] >> t.mat_[2][2];
+  double m[3][3];
+  is >> m[0][0] >> m[0][1] >> m[0][2]
+     >> m[1][0] >> m[1][1] >> m[1][2]
+     >> m[2][0] >> m[2][1] >> m[2][2];
+  for (size_t i=0; i<3; i++)
+    for (size_t j=i; j<3; j++)
+      t.mat_[Tensor::index(i,j)] = m[i][j];
      
   return is;
 }
@@ -48,6 +48,7 @@
 #include <Core/GeometryPrimitives/share.h>
 
 #include <iosfwd>
+#include <memory>
 #include <vector>
 
 
@@ -91,9 +92,9 @@ public:
   void build_mat_from_eigens();
   void build_eigens_from_mat(); 
   void get_eigenvectors(Vector &e1, Vector &e2, Vector &e3);
-  const Vector &get_eigenvector1() const { ASSERT(have_eigens_); return e1_; }
-  const Vector &get_eigenvector2() const { ASSERT(have_eigens_); return e2_; }
-  const Vector &get_eigenvector3() const { ASSERT(have_eigens_); return e3_; }
+  const Vector &get_eigenvector1() const { ASSERT(eigens_); return eigens_->e1_; }
+  const Vector &get_eigenvector2() const { ASSERT(eigens_); return eigens_->e2_; }
+  const Vector &get_eigenvector3() const { ASSERT(eigens_); return eigens_->e3_; }
   void get_eigenvalues(double &l1, double &l2, double &l3);
 
   double norm() const;
@@ -111,25 +112,44 @@ public:
   static const std::string& get_h_file_path();
 
   friend SCISHARE void Pio(Piostream&, Tensor&);
+SCISHARE void Pio(Piostream&, std::vector<Tensor>&);
+  friend SCISHARE void Pio(Piostream&, std::vector<Tensor>&);
 
-  double xx() const { return mat_[0][0]; }
-  double xy() const { return mat_[1][0]; }
-  double xz() const { return mat_[2][0]; }
-  double yy() const { return mat_[1][1]; }
-  double yz() const { return mat_[2][1]; }
-  double zz() const { return mat_[2][2]; }
+  double xx() const { return mat_[0]; }
+  double xy() const { return mat_[1]; }
+  double xz() const { return mat_[2]; }
+  double yy() const { return mat_[3]; }
+  double yz() const { return mat_[4]; }
+  double zz() const { return mat_[5]; }
 
   SCISHARE friend std::ostream& operator<<(std::ostream& os, const Tensor& t);
   SCISHARE friend std::istream& operator>>(std::istream& os, Tensor& t);
 
-  double val(size_t i, size_t j) const { return mat_[i][j]; }
-  double& val(size_t i, size_t j) { return mat_[i][j]; }
+  /// (i,j) and (j,i) refer to the same entry.
+  double val(size_t i, size_t j) const { return mat_[index(i,j)]; }
+  /// Sets both (i,j) and (j,i) and drops the cached eigen decomposition.
+  void set(size_t i, size_t j, double v) { eigens_.reset(); mat_[index(i,j)] = v; }
 
 private:
-  double mat_[3][3];
-  Vector e1_, e2_, e3_;  // these are already scaled by the eigenvalues
-  double l1_, l2_, l3_;
-  int have_eigens_; //do NOT change to bool, it will break Pio system
+  static size_t index(size_t i, size_t j)
+  {
+    static const size_t idx[3][3] = {{0,1,2},{1,3,4},{2,4,5}};
+    return idx[i][j];
+  }
+
+  struct Eigens
+  {
+    Vector e1_, e2_, e3_;  // these are already scaled by the eigenvalues
+    double l1_, l2_, l3_;
+  };
+
+  Eigens& eigens();
+
+  /// Only the upper triangle is stored (xx, xy, xz, yy, yz, zz), the eigen
+  /// decomposition is allocated when it is first requested, so a field of
+  /// tensors does not carry the cache for every value.
+  double mat_[6];
+  std::unique_ptr<Eigens> eigens_;
 };
 
 SCISHARE void Pio(Piostream&, Tensor&);
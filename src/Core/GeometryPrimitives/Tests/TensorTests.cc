@@ -0,0 +1,109 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+
+#include <Core/GeometryPrimitives/Tensor.h>
+#include <sstream>
+
+using namespace SCIRun::Core::Geometry;
+
+TEST(TensorTests, StoresSymmetricEntriesOnce)
+{
+  Tensor t(1, 2, 3, 4, 5, 6);
+  EXPECT_EQ(t.val(0,1), t.val(1,0));
+  EXPECT_EQ(t.val(0,2), t.val(2,0));
+  EXPECT_EQ(t.val(1,2), t.val(2,1));
+  EXPECT_EQ(4, t.yy());
+
+  t.set(2,1,7);
+  EXPECT_EQ(7, t.yz());
+  EXPECT_EQ(7, t.val(1,2));
+}
+
+TEST(TensorTests, CanMultiplyVector)
+{
+  Tensor t(1, 2, 3, 4, 5, 6);
+  EXPECT_EQ(Vector(6, 11, 14), t * Vector(1, 1, 1));
+}
+
+TEST(TensorTests, EigenDecompositionIsComputedOnRequest)
+{
+  Tensor t(Vector(2,0,0), Vector(0,3,0), Vector(0,0,4));
+  EXPECT_DOUBLE_EQ(2, t.xx());
+  EXPECT_DOUBLE_EQ(3, t.yy());
+  EXPECT_DOUBLE_EQ(4, t.zz());
+  EXPECT_DOUBLE_EQ(0, t.xy());
+
+  Tensor copy(t);
+  double l1, l2, l3;
+  copy.get_eigenvalues(l1, l2, l3);
+  EXPECT_DOUBLE_EQ(2, l1);
+  EXPECT_DOUBLE_EQ(3, l2);
+  EXPECT_DOUBLE_EQ(4, l3);
+
+  Tensor scaled = copy * 2.0;
+  EXPECT_EQ(Vector(4,0,0), scaled.get_eigenvector1());
+  EXPECT_DOUBLE_EQ(8, scaled.zz());
+}
+
+TEST(TensorTests, ArithmeticKeepsSymmetry)
+{
+  Tensor a(1, 2, 3, 4, 5, 6);
+  Tensor b(1.0);
+  Tensor c = a + b;
+  EXPECT_EQ(Tensor(2, 2, 3, 5, 5, 7), c);
+  c -= b;
+  EXPECT_EQ(a, c);
+  EXPECT_DOUBLE_EQ(14, a.norm());
+}
+
+TEST(TensorTests, ReadingEntriesKeepsOutsideEigens)
+{
+  Tensor t(1, 0, 0, 1, 0, 1);
+  t.set_outside_eigens(Vector(5,0,0), Vector(0,6,0), Vector(0,0,7), 5, 6, 7);
+  Tensor& ref = t;
+  EXPECT_EQ(1, ref.val(0,0));
+  double l1, l2, l3;
+  t.get_eigenvalues(l1, l2, l3);
+  EXPECT_EQ(5, l1);
+  EXPECT_EQ(7, l3);
+
+  t.set(0,0,2);
+  t.get_eigenvalues(l1, l2, l3);
+  EXPECT_NEAR(4, l1 + l2 + l3, 1e-12);
+}
+
+TEST(TensorTests, StreamInputUsesUpperTriangle)
+{
+  std::istringstream in("1 2 3 20 4 5 30 50 6");
+  Tensor t;
+  in >> t;
+  EXPECT_EQ(Tensor(1, 2, 3, 4, 5, 6), t);
+  EXPECT_EQ(t, symmetricTensorFromNineElementArray(std::vector<double>{ 1, 2, 3, 20, 4, 5, 30, 50, 6 }));
+}
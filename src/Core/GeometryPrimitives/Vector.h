@@ -37,6 +37,7 @@
 
 #include <cmath>
 #include <algorithm>
+#include <vector>
 #include <Core/Persistent/PersistentFwd.h>
 #include <Core/Utils/Legacy/TypeDescription.h>
 #include <Core/GeometryPrimitives/share.h>
@@ -233,6 +234,7 @@ inline Vector Max(const Vector &v1, const Vector &v2)
 }
 
 SCISHARE void Pio( Piostream&, Vector& );
+SCISHARE void Pio( Piostream&, std::vector<Vector>& );
 
 inline
   double Vector::safe_normalize()
@@ -62,7 +62,8 @@ SCIRun::FieldToNrrd_writer(LoggerHandle pr, FieldHandle fh, const char *filename
   DataIOAlgo dalgo(pr);
   ConverterAlgo calgo(pr);
 
-  if (calgo.fieldToNrrd(fh,nrrd))
+  // The nrrd only lives until it is written, so it can share the field values
+  if (calgo.fieldToNrrd(fh,nrrd,true))
   {
     std::string fn(filename);
     return dalgo.writeNrrd(fn,nrrd);
@@ -76,13 +76,13 @@ std::string SCIRun::defaultImportTypeForFile(const GenericIEPluginManager<NrrdDa
 template <>
 std::string SCIRun::defaultExportTypeForFile(const GenericIEPluginManager<Field>*)
 {
-  return "SCIRun Field Binary (*.fld);;SCIRun Field ASCII (*.fld)";
+  return "SCIRun Field Binary (*.fld);;SCIRun Field ASCII (*.fld);;SCIRun Field Chunked (*.fld)";
 }
 
 template <>
 std::string SCIRun::defaultExportTypeForFile(const GenericIEPluginManager<Matrix>*)
 {
-  return "SCIRun Matrix Binary (*.mat);;SCIRun Matrix ASCII (*.mat)";
+  return "SCIRun Matrix Binary (*.mat);;SCIRun Matrix ASCII (*.mat);;SCIRun Matrix Chunked (*.mat)";
 }
 
 #ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
@@ -0,0 +1,208 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Core/Matlab/matlabconverter.h>
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Datatypes/SparseRowMatrix.h>
+#include <Core/Datatypes/MatrixTypeConversions.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/GeometryPrimitives/Vector.h>
+#include <Testing/Utils/SCIRunFieldSamples.h>
+#include <chrono>
+
+using namespace SCIRun;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::MatlabIO;
+using namespace SCIRun::TestUtils;
+
+namespace
+{
+  DenseMatrixHandle rampDense(int rows, int cols)
+  {
+    DenseMatrixHandle m(new DenseMatrix(rows, cols));
+    for (int r = 0; r < rows; ++r)
+      for (int c = 0; c < cols; ++c)
+        (*m)(r, c) = 1000 * r + c;
+    return m;
+  }
+
+  SparseRowMatrixHandle bandedSparse(int rows, int cols)
+  {
+    std::vector<SparseRowMatrix::Triplet> triplets;
+    for (int r = 0; r < rows; ++r)
+      for (int c = r - 1; c <= r + 1; ++c)
+        if (c >= 0 && c < cols)
+          triplets.push_back(SparseRowMatrix::Triplet(r, c, r + 0.5 * c));
+    SparseRowMatrixHandle m(new SparseRowMatrix(rows, cols));
+    m->setFromTriplets(triplets.begin(), triplets.end());
+    return m;
+  }
+
+  matlabconverter numericConverter()
+  {
+    matlabconverter converter;
+    converter.converttonumericmatrix();
+    return converter;
+  }
+}
+
+TEST(MatlabConverterTests, DenseMatrixIsStoredColumnMajor)
+{
+  matlabconverter converter = numericConverter();
+  DenseMatrixHandle dense = rampDense(3, 4);
+
+  matlabarray ml;
+  converter.sciMatrixTOmlArray(dense, ml);
+  ASSERT_EQ(3, ml.getm());
+  ASSERT_EQ(4, ml.getn());
+
+  std::vector<double> values;
+  ml.getnumericarray(values);
+  ASSERT_EQ(12, values.size());
+  EXPECT_EQ(0, values[0]);
+  EXPECT_EQ(1000, values[1]);
+  EXPECT_EQ(2000, values[2]);
+  EXPECT_EQ(1, values[3]);
+  EXPECT_EQ(2003, values[11]);
+}
+
+TEST(MatlabConverterTests, DenseMatrixRoundTrip)
+{
+  matlabconverter converter = numericConverter();
+  for (auto dims : { std::make_pair(1, 1), std::make_pair(5, 70), std::make_pair(67, 33) })
+  {
+    DenseMatrixHandle dense = rampDense(dims.first, dims.second);
+
+    matlabarray ml;
+    converter.sciMatrixTOmlArray(dense, ml);
+    MatrixHandle back;
+    converter.mlArrayTOsciMatrix(ml, back);
+
+    auto backDense = castMatrix::toDense(back);
+    ASSERT_TRUE(backDense != nullptr);
+    EXPECT_EQ(*dense, *backDense);
+  }
+}
+
+TEST(MatlabConverterTests, ConvertsIntegerDataOnTheFly)
+{
+  matlabconverter converter;
+  matlabarray ml;
+  ml.createdensearray(2, 3, matlabarray::miINT16);
+  std::vector<short> values = { 1, 2, 3, 4, 5, -6 };
+  ml.setnumericarray(values);
+
+  MatrixHandle mat;
+  converter.mlArrayTOsciMatrix(ml, mat);
+  auto dense = castMatrix::toDense(mat);
+  ASSERT_TRUE(dense != nullptr);
+  EXPECT_EQ(1, (*dense)(0, 0));
+  EXPECT_EQ(2, (*dense)(1, 0));
+  EXPECT_EQ(3, (*dense)(0, 1));
+  EXPECT_EQ(-6, (*dense)(1, 2));
+}
+
+TEST(MatlabConverterTests, SparseMatrixRoundTrip)
+{
+  matlabconverter converter = numericConverter();
+  SparseRowMatrixHandle sparse = bandedSparse(40, 25);
+
+  matlabarray ml;
+  converter.sciMatrixTOmlArray(sparse, ml);
+  ASSERT_EQ(matlabarray::mlSPARSE, ml.getclass());
+  ASSERT_EQ(sparse->nonZeros(), ml.getnnz());
+
+  MatrixHandle back;
+  converter.mlArrayTOsciMatrix(ml, back);
+  auto backSparse = castMatrix::toSparse(back);
+  ASSERT_TRUE(backSparse != nullptr);
+  ASSERT_EQ(sparse->nrows(), backSparse->nrows());
+  ASSERT_EQ(sparse->ncols(), backSparse->ncols());
+  EXPECT_EQ(sparse->nonZeros(), backSparse->nonZeros());
+  for (int r = 0; r < sparse->nrows(); ++r)
+    for (int c = 0; c < sparse->ncols(); ++c)
+      EXPECT_EQ(sparse->coeff(r, c), backSparse->coeff(r, c));
+}
+
+TEST(MatlabConverterTests, VectorFieldRoundTrip)
+{
+  matlabconverter converter;
+  FieldHandle field = CreateEmptyLatVol(4, 5, 6, VECTOR_E);
+  VField* vfield = field->vfield();
+  vfield->resize_values();
+  for (VMesh::index_type i = 0; i < vfield->num_values(); ++i)
+    vfield->set_value(Vector(i, -i, 0.5 * i), i);
+
+  matlabarray ml;
+  converter.sciFieldTOmlArray(field, ml);
+  FieldHandle back;
+  converter.mlArrayTOsciField(ml, back);
+
+  ASSERT_TRUE(back != nullptr);
+  ASSERT_EQ(vfield->num_values(), back->vfield()->num_values());
+  for (VMesh::index_type i = 0; i < vfield->num_values(); ++i)
+  {
+    Vector v;
+    back->vfield()->get_value(v, i);
+    EXPECT_EQ(Vector(i, -i, 0.5 * i), v);
+  }
+}
+
+TEST(MatlabConverterTests, DISABLED_LargeMatrixConversionTiming)
+{
+  typedef std::chrono::steady_clock Clock;
+  auto seconds = [](Clock::time_point start) { return std::chrono::duration<double>(Clock::now() - start).count(); };
+
+  matlabconverter converter = numericConverter();
+  DenseMatrixHandle dense = rampDense(4000, 5000);
+  const double megabytes = 8.0 * dense->nrows() * dense->ncols() / (1024 * 1024);
+
+  auto start = Clock::now();
+  matlabarray ml;
+  converter.sciMatrixTOmlArray(dense, ml);
+  std::cout << "Dense export: " << megabytes / seconds(start) << " MB/s" << std::endl;
+
+  start = Clock::now();
+  MatrixHandle back;
+  converter.mlArrayTOsciMatrix(ml, back);
+  std::cout << "Dense import: " << megabytes / seconds(start) << " MB/s" << std::endl;
+
+  SparseRowMatrixHandle sparse = bandedSparse(2000000, 2000000);
+  start = Clock::now();
+  matlabarray mlsparse;
+  converter.sciMatrixTOmlArray(sparse, mlsparse);
+  std::cout << "Sparse export: " << seconds(start) << " s for " << sparse->nonZeros() << " nonzeros" << std::endl;
+
+  start = Clock::now();
+  converter.mlArrayTOsciMatrix(mlsparse, back);
+  std::cout << "Sparse import: " << seconds(start) << " s" << std::endl;
+}
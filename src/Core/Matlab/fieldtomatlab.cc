@@ -854,17 +854,10 @@ FieldToMatlabAlgo::mladdfielddata(VField* field, VMesh* /*mesh*/, matlabarray& m
   {
     mlfield.createdensearray(3,static_cast<int>(size),matlabarray::miDOUBLE);
                 
-    int p,q;
-    std::vector<double> data(size*3);
-    for (p = 0, q = 0; p < static_cast<int>(size); p++) 
-    {
-      Vector v;
-      field->get_value(v,VMesh::index_type(p));
-      data[q++] = v.x();
-      data[q++] = v.y();
-      data[q++] = v.z();
-    }
-    mlfield.setnumericarray(data);          
+    // Vectors are three packed doubles, so the field array is already laid out as a 3 x size matrix
+    static_assert(sizeof(Vector) == 3*sizeof(double), "Vector values are copied as three doubles");
+    const Vector* values = static_cast<const Vector*>(field->get_values_pointer());
+    mlfield.setnumericarray(reinterpret_cast<const double*>(values),3*static_cast<int>(size));          
     mlarray.setfield(0,"field",mlfield);
     return(true);
   }
@@ -875,10 +868,10 @@ FieldToMatlabAlgo::mladdfielddata(VField* field, VMesh* /*mesh*/, matlabarray& m
                 
     int p,q;
     std::vector<double> data(size*9);
+    const Tensor* values = static_cast<const Tensor*>(field->get_values_pointer());
     for (p = 0, q = 0; p < static_cast<int>(size); p++) 
     {
-      Tensor v;
-      field->get_value(v,VMesh::index_type(p));
+      const Tensor& v = values[p];
       data[q++] = v.val(0,0);
       data[q++] = v.val(0,1);
       data[q++] = v.val(0,2);
@@ -79,6 +79,8 @@ DEALINGS IN THE SOFTWARE.
 */
 
 #include <vector>
+#include <algorithm>
+#include <cstring>
 #include <boost/shared_ptr.hpp>
 #include <Core/Matlab/matfilebase.h>
 #include <Core/Matlab/share.h>
@@ -178,6 +180,12 @@ namespace SCIRun
       template<class T> void putandcast(const T **dataptr,int dim1, int dim2, mitype type);
       template<class T> void putandcast(const T ***dataptr,int dim1, int dim2, int dim3, mitype type);
 
+      // copy and cast between the column major order of the data in the
+      // matfilebuffer and a row major dim1 x dim2 block, as used by SCIRun's
+      // dense matrices. The data is reordered in tiles that stay in cache.
+      template<class T> void getandcastrowmajor(T *dataptr,int dim1, int dim2) const;
+      template<class T> void putandcastrowmajor(const T *dataptr,int dim1, int dim2, mitype type);
+
 
       // For smaller arrays use the STL and put the data in a vector. These
       // vectors are copied and hence are less efficient. However using STL
@@ -225,6 +233,38 @@ namespace SCIRun
 
     };
 
+    // Bulk copy with a cast per element. When both sides have the same type,
+    // which is the common case of double data, this reduces to a memcpy.
+    template<class S, class T> inline void copyandcast(const S *src,T *dst,int size)
+    {
+      for(int p=0;p<size;p++) { dst[p] = static_cast<T>(src[p]); }
+    }
+
+    template<class T> inline void copyandcast(const T *src,T *dst,int size)
+    {
+      std::memcpy(dst,src,static_cast<size_t>(size)*sizeof(T));
+    }
+
+    // Reorder a column major dim1 x dim2 block into row major order while
+    // casting. Swapping dim1 and dim2 gives the reverse reordering.
+    template<class S, class T> void transposeandcast(const S *src,T *dst,int dim1, int dim2)
+    {
+      const int tile = 32;
+      const size_t rows = static_cast<size_t>(dim1);
+      const size_t cols = static_cast<size_t>(dim2);
+      for (size_t ib=0;ib<rows;ib+=tile)
+      {
+        const size_t ie = std::min(ib+tile,rows);
+        for (size_t jb=0;jb<cols;jb+=tile)
+        {
+          const size_t je = std::min(jb+tile,cols);
+          for (size_t i=ib;i<ie;i++)
+            for (size_t j=jb;j<je;j++)
+              dst[i*cols+j] = static_cast<T>(src[j*rows+i]);
+        }
+      }
+    }
+
     template<class T> void matfiledata::getandcast(T *dataptr,int dsize) const
     {
       // This function copies and casts the data in the matfilebuffer into
@@ -241,49 +281,119 @@ namespace SCIRun
       {
       case miINT8:
         { signed char *ptr = static_cast<signed char *>(databuffer());
-        for(int p=0;p<dsize;p++) {dataptr[p] = static_cast<T>(ptr[p]); }}
+        copyandcast(ptr,dataptr,dsize);}
         break;
       case miUINT8: case miUTF8:
         { unsigned char *ptr = static_cast<unsigned char *>(databuffer());
-        for(int p=0;p<dsize;p++) {dataptr[p] = static_cast<T>(ptr[p]); }}
+        copyandcast(ptr,dataptr,dsize);}
         break;
       case miINT16:
         { signed short *ptr = static_cast<signed short *>(databuffer());
-        for(int p=0;p<dsize;p++) {dataptr[p] = static_cast<T>(ptr[p]); }}
+        copyandcast(ptr,dataptr,dsize);}
         break;
       case miUINT16: case miUTF16:
         { unsigned short *ptr = static_cast<unsigned short *>(databuffer());
-        for(int p=0;p<dsize;p++) {dataptr[p] = static_cast<T>(ptr[p]); }}
+        copyandcast(ptr,dataptr,dsize);}
         break;
       case miINT32:
         { int32_t *ptr = static_cast<int32_t *>(databuffer());
-        for(int p=0;p<dsize;p++) {dataptr[p] = static_cast<T>(ptr[p]); }}
+        copyandcast(ptr,dataptr,dsize);}
         break;
       case miUINT32: case miUTF32:
         { uint32_t *ptr = static_cast<uint32_t *>(databuffer());
-        for(int p=0;p<dsize;p++) {dataptr[p] = static_cast<T>(ptr[p]); }}
+        copyandcast(ptr,dataptr,dsize);}
         break;
       case miINT64:
         { int64_t *ptr = static_cast<int64_t *>(databuffer());
-        for(int p=0;p<dsize;p++) {dataptr[p] = static_cast<T>(ptr[p]); }}
+        copyandcast(ptr,dataptr,dsize);}
         break;
       case miUINT64:
         { uint64_t *ptr = static_cast<uint64_t *>(databuffer());
-        for(int p=0;p<dsize;p++) {dataptr[p] = static_cast<T>(ptr[p]); }}
+        copyandcast(ptr,dataptr,dsize);}
         break;
       case miSINGLE:
         { float *ptr = static_cast<float *>(databuffer());
-        for(int p=0;p<dsize;p++) {dataptr[p] = static_cast<T>(ptr[p]); }}
+        copyandcast(ptr,dataptr,dsize);}
         break;
       case miDOUBLE:
         { double *ptr = static_cast<double *>(databuffer());
-        for(int p=0;p<dsize;p++) {dataptr[p] = static_cast<T>(ptr[p]); }}
+        copyandcast(ptr,dataptr,dsize);}
         break;
       default:
         throw unknown_type();
       }
     }
 
+    template<class T> void matfiledata::getandcastrowmajor(T *dataptr,int dim1, int dim2) const
+    {
+      if (databuffer() == 0) return;
+      if (dataptr  == 0) return;
+      if (dim1 == 0) return;
+      if (dim2 == 0) return;
+      if ((dim1*dim2) > size()) throw out_of_range();
+
+      switch (type())
+      {
+      case miINT8:
+        transposeandcast(static_cast<signed char *>(databuffer()),dataptr,dim1,dim2); break;
+      case miUINT8: case miUTF8:
+        transposeandcast(static_cast<unsigned char *>(databuffer()),dataptr,dim1,dim2); break;
+      case miINT16:
+        transposeandcast(static_cast<signed short *>(databuffer()),dataptr,dim1,dim2); break;
+      case miUINT16: case miUTF16:
+        transposeandcast(static_cast<unsigned short *>(databuffer()),dataptr,dim1,dim2); break;
+      case miINT32:
+        transposeandcast(static_cast<int32_t *>(databuffer()),dataptr,dim1,dim2); break;
+      case miUINT32: case miUTF32:
+        transposeandcast(static_cast<uint32_t *>(databuffer()),dataptr,dim1,dim2); break;
+      case miINT64:
+        transposeandcast(static_cast<int64_t *>(databuffer()),dataptr,dim1,dim2); break;
+      case miUINT64:
+        transposeandcast(static_cast<uint64_t *>(databuffer()),dataptr,dim1,dim2); break;
+      case miSINGLE:
+        transposeandcast(static_cast<float *>(databuffer()),dataptr,dim1,dim2); break;
+      case miDOUBLE:
+        transposeandcast(static_cast<double *>(databuffer()),dataptr,dim1,dim2); break;
+      default:
+        throw unknown_type();
+      }
+    }
+
+    template<class T> void matfiledata::putandcastrowmajor(const T *dataptr,int dim1, int dim2, mitype dtype)
+    {
+      clear();
+      if (dataptr  == 0) return;
+
+      newdatabuffer(dim1*dim2*elsize(dtype),dtype);
+
+      // The row major block is the column major dim2 x dim1 transpose
+      switch (dtype)
+      {
+      case miINT8:
+        transposeandcast(dataptr,static_cast<signed char *>(databuffer()),dim2,dim1); break;
+      case miUINT8: case miUTF8:
+        transposeandcast(dataptr,static_cast<unsigned char *>(databuffer()),dim2,dim1); break;
+      case miINT16:
+        transposeandcast(dataptr,static_cast<signed short *>(databuffer()),dim2,dim1); break;
+      case miUINT16: case miUTF16:
+        transposeandcast(dataptr,static_cast<unsigned short *>(databuffer()),dim2,dim1); break;
+      case miINT32:
+        transposeandcast(dataptr,static_cast<int32_t *>(databuffer()),dim2,dim1); break;
+      case miUINT32: case miUTF32:
+        transposeandcast(dataptr,static_cast<uint32_t *>(databuffer()),dim2,dim1); break;
+      case miINT64:
+        transposeandcast(dataptr,static_cast<int64_t *>(databuffer()),dim2,dim1); break;
+      case miUINT64:
+        transposeandcast(dataptr,static_cast<uint64_t *>(databuffer()),dim2,dim1); break;
+      case miSINGLE:
+        transposeandcast(dataptr,static_cast<float *>(databuffer()),dim2,dim1); break;
+      case miDOUBLE:
+        transposeandcast(dataptr,static_cast<double *>(databuffer()),dim2,dim1); break;
+      default:
+        throw unknown_type();
+      }
+    }
+
     template<class T> void matfiledata::getandcast(T **dataptr,int dim1, int dim2) const
     {
       // This function copies and casts the data in the matfilebuffer into
@@ -450,43 +560,43 @@ namespace SCIRun
       {
       case miINT8:
         { signed char *ptr = static_cast<signed char *>(databuffer());
-        for(int p=0;p<dsize;p++) {vec[p] = static_cast<T>(ptr[p]); }}
+        copyandcast(ptr,&vec[0],dsize);}
         break;
       case miUINT8: case miUTF8:
         { unsigned char *ptr = static_cast<unsigned char *>(databuffer());
-        for(int p=0;p<dsize;p++) {vec[p] = static_cast<T>(ptr[p]); }}
+        copyandcast(ptr,&vec[0],dsize);}
         break;
       case miINT16:
         { signed short *ptr = static_cast<signed short *>(databuffer());
-        for(int p=0;p<dsize;p++) {vec[p] = static_cast<T>(ptr[p]); }}
+        copyandcast(ptr,&vec[0],dsize);}
         break;
       case miUINT16: case miUTF16:
         { unsigned short *ptr = static_cast<unsigned short *>(databuffer());
-        for(int p=0;p<dsize;p++) {vec[p] = static_cast<T>(ptr[p]); }}
+        copyandcast(ptr,&vec[0],dsize);}
         break;
       case miINT32:
         { int32_t *ptr = static_cast<int32_t *>(databuffer());
-        for(int p=0;p<dsize;p++) {vec[p] = static_cast<T>(ptr[p]); }}
+        copyandcast(ptr,&vec[0],dsize);}
         break;
       case miUINT32: case miUTF32:
         { uint32_t *ptr = static_cast<uint32_t *>(databuffer());
-        for(int p=0;p<dsize;p++) {vec[p] = static_cast<T>(ptr[p]); }}
+        copyandcast(ptr,&vec[0],dsize);}
         break;
       case miINT64:
         { int64_t *ptr = static_cast<int64_t *>(databuffer());
-        for(int p=0;p<dsize;p++) {vec[p] = static_cast<T>(ptr[p]); }}
+        copyandcast(ptr,&vec[0],dsize);}
         break;
       case miUINT64:
         { uint64_t *ptr = static_cast<uint64_t*>(databuffer());
-        for(int p=0;p<dsize;p++) {vec[p] = static_cast<T>(ptr[p]); }}
+        copyandcast(ptr,&vec[0],dsize);}
         break;
       case miSINGLE:
         { float *ptr = static_cast<float *>(databuffer());
-        for(int p=0;p<dsize;p++) {vec[p] = static_cast<T>(ptr[p]); }}
+        copyandcast(ptr,&vec[0],dsize);}
         break;
       case miDOUBLE:
         { double *ptr = static_cast<double *>(databuffer());
-        for(int p=0;p<dsize;p++) {vec[p] = static_cast<T>(ptr[p]); }}
+        copyandcast(ptr,&vec[0],dsize);}
         break;
       default:
         throw unknown_type();
@@ -560,43 +670,43 @@ namespace SCIRun
       {
       case miINT8:
         { signed char *ptr = static_cast<signed char *>(databuffer());
-        for(int p=0;p<dsize;p++) { ptr[p] = static_cast<signed char>(dataptr[p]); }}
+        copyandcast(dataptr,ptr,dsize);}
         break;
       case miUINT8: case miUTF8:
         { unsigned char *ptr = static_cast<unsigned char *>(databuffer());
-        for(int p=0;p<dsize;p++) { ptr[p] = static_cast<unsigned char>(dataptr[p]); }}
+        copyandcast(dataptr,ptr,dsize);}
         break;
       case miINT16:
         { signed short *ptr = static_cast<signed short *>(databuffer());
-        for(int p=0;p<dsize;p++) { ptr[p] = static_cast<signed short>(dataptr[p]); }}
+        copyandcast(dataptr,ptr,dsize);}
         break;
       case miUINT16: case miUTF16:
         { unsigned short *ptr = static_cast<unsigned short *>(databuffer());
-        for(int p=0;p<dsize;p++) { ptr[p] = static_cast<unsigned short>(dataptr[p]); }}
+        copyandcast(dataptr,ptr,dsize);}
         break;
       case miINT32:
         { int32_t *ptr = static_cast<int32_t *>(databuffer());
-        for(int p=0;p<dsize;p++) { ptr[p] = static_cast<int32_t>(dataptr[p]); }}
+        copyandcast(dataptr,ptr,dsize);}
         break;
       case miUINT32: case miUTF32:
         { uint32_t *ptr = static_cast<uint32_t *>(databuffer());
-        for(int p=0;p<dsize;p++) { ptr[p] = static_cast<uint32_t>(dataptr[p]); }}
+        copyandcast(dataptr,ptr,dsize);}
         break;
       case miINT64:
         { int64_t *ptr = static_cast<int64_t *>(databuffer());
-        for(int p=0;p<dsize;p++) { ptr[p] = static_cast<int64_t>(dataptr[p]); }}
+        copyandcast(dataptr,ptr,dsize);}
         break;
       case miUINT64:
         { uint64_t *ptr = static_cast<uint64_t *>(databuffer());
-        for(int p=0;p<dsize;p++) { ptr[p] = static_cast<uint64_t>(dataptr[p]); }}
+        copyandcast(dataptr,ptr,dsize);}
         break;
       case miSINGLE:
         { float *ptr = static_cast<float *>(databuffer());
-        for(int p=0;p<dsize;p++) { ptr[p] = static_cast<float>(dataptr[p]); }}
+        copyandcast(dataptr,ptr,dsize);}
         break;
       case miDOUBLE:
         { double *ptr = static_cast<double *>(databuffer());
-        for(int p=0;p<dsize;p++) { ptr[p] = static_cast<double>(dataptr[p]); }}
+        copyandcast(dataptr,ptr,dsize);}
         break;
       default:
         throw unknown_type();
@@ -741,43 +851,43 @@ namespace SCIRun
       {
       case miINT8:
         { signed char *ptr = static_cast<signed char *>(databuffer());
-        for(int p=0;p<dsize;p++) {ptr[p] = static_cast<signed char>(vec[p]); }}
+        copyandcast(&vec[0],ptr,dsize);}
         break;
       case miUINT8: case miUTF8:
         { unsigned char *ptr = static_cast<unsigned char *>(databuffer());
-        for(int p=0;p<dsize;p++) {ptr[p] = static_cast<unsigned char>(vec[p]); }}
+        copyandcast(&vec[0],ptr,dsize);}
         break;
       case miINT16:
         { signed short *ptr = static_cast<signed short *>(databuffer());
-        for(int p=0;p<dsize;p++) {ptr[p] = static_cast<signed short>(vec[p]); }}
+        copyandcast(&vec[0],ptr,dsize);}
         break;
       case miUINT16: case miUTF16:
         { unsigned short *ptr = static_cast<unsigned short *>(databuffer());
-        for(int p=0;p<dsize;p++) {ptr[p] = static_cast<unsigned short>(vec[p]); }}
+        copyandcast(&vec[0],ptr,dsize);}
         break;
       case miINT32:
         { int32_t *ptr = static_cast<int32_t *>(databuffer());
-        for(int p=0;p<dsize;p++) {ptr[p] = static_cast<int32_t>(vec[p]); }}
+        copyandcast(&vec[0],ptr,dsize);}
         break;
       case miUINT32: case miUTF32:
         { uint32_t *ptr = static_cast<uint32_t *>(databuffer());
-        for(int p=0;p<dsize;p++) {ptr[p] = static_cast<uint32_t>(vec[p]); }}
+        copyandcast(&vec[0],ptr,dsize);}
         break;
       case miINT64:
         { int64_t *ptr = static_cast<int64_t *>(databuffer());
-        for(int p=0;p<dsize;p++) {ptr[p] = static_cast<int64_t>(vec[p]); }}
+        copyandcast(&vec[0],ptr,dsize);}
         break;
       case miUINT64:
         { uint64_t *ptr = static_cast<uint64_t *>(databuffer());
-        for(int p=0;p<dsize;p++) {ptr[p] = static_cast<uint64_t>(vec[p]); }}
+        copyandcast(&vec[0],ptr,dsize);}
         break;
       case miSINGLE:
         { float *ptr = static_cast<float *>(databuffer());
-        for(int p=0;p<dsize;p++) {ptr[p] = static_cast<float>(vec[p]); }}
+        copyandcast(&vec[0],ptr,dsize);}
         break;
       case miDOUBLE:
         { double *ptr = static_cast<double *>(databuffer());
-        for(int p=0;p<dsize;p++) {ptr[p] = static_cast<double>(vec[p]); }}
+        copyandcast(&vec[0],ptr,dsize);}
         break;
       default:
         throw unknown_type();
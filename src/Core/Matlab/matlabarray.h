@@ -394,6 +394,12 @@ public:
   
   template<class T> void getnumericarray(std::vector<T> &vec) const;
   template<class T> void getimagnumericarray(std::vector<T> &vec) const;
+
+  // Bulk access for dense 2D arrays stored row major on the SCIRun side,
+  // e.g. DenseMatrix. The reordering from Matlab's column major layout is
+  // done while copying, so no intermediate transposed copy is needed.
+  template<class T> void getnumericarrayrowmajor(T *data,int dim1, int dim2) const;
+  template<class T> void setnumericarrayrowmajor(const T *data,int dim1, int dim2);
   
   // C-style write access. The data will be copied out of the
   // databuffer and casted to the format of the Matlab file. If a type
@@ -529,6 +535,27 @@ template<class T> inline void matlabarray::getimagnumericarray(std::vector<T> &v
   m_->pimag_.getandcastvector(vec);
 }
 
+template<class T> inline void matlabarray::getnumericarrayrowmajor(T *data,int dim1, int dim2) const
+{
+  if(m_ == 0) throw empty_matlabarray();
+  m_->preal_.getandcastrowmajor(data,dim1,dim2);
+}
+
+template<class T> inline void matlabarray::setnumericarrayrowmajor(const T *data,int dim1, int dim2)
+{
+  if(m_ == 0) 
+  {
+    std::cerr << "internal error in setnumericarrayrowmajor(T*,int,int)\n";
+    throw internal_error();
+  }
+  if((dim1*dim2) != getnumelements())
+  {
+    std::cerr << "internal error in setnumericarrayrowmajor(T*,int,int)\n";
+    throw internal_error();
+  }
+  m_->preal_.putandcastrowmajor(data,dim1,dim2,m_->type_);
+}
+
 
 template<class T> inline void matlabarray::setnumericarray(const T *data,int size,const std::vector<int> &dims)
 {
@@ -608,6 +608,33 @@ void matlabconverter::mlArrayTOsciColorMap(const matlabarray &ma,ColorMapHandle
 }
 #endif
 
+namespace
+{
+  // Convert the compressed arrays of an outer x inner matrix into the compressed
+  // arrays of its transpose with a counting sort on the inner index. This maps
+  // between Matlab's compressed columns and SCIRun's compressed rows in one pass.
+  void transposecompressed(size_type outer, size_type inner, const index_type* start, const index_type* index, const double* values,
+    index_type* tstart, index_type* tindex, double* tvalues)
+  {
+    std::fill(tstart, tstart + inner + 1, 0);
+    for (index_type k = 0; k < start[outer]; k++)
+      tstart[index[k] + 1]++;
+    for (size_type r = 0; r < inner; r++)
+      tstart[r + 1] += tstart[r];
+
+    std::vector<index_type> next(tstart, tstart + inner);
+    for (size_type c = 0; c < outer; c++)
+    {
+      for (index_type k = start[c]; k < start[c + 1]; k++)
+      {
+        const index_type dest = next[index[k]]++;
+        tindex[dest] = c;
+        tvalues[dest] = values[k];
+      }
+    }
+  }
+}
+
 void matlabconverter::mlArrayTOsciMatrix(const matlabarray &ma,MatrixHandle &handle)
 {
   matlabarray::mlclass mclass = ma.getclass();
@@ -632,13 +659,12 @@ void matlabconverter::mlArrayTOsciMatrix(const matlabarray &ma,MatrixHandle &han
         }
         else
         {
-          DenseMatrix dm(n,m);  
-          ma.getnumericarray(dm.data(), dm.size());
-                      
-          // There is no transpose function to operate on the same memory block
-          // Hence, it is a little memory inefficient.
-                      
-          handle = boost::make_shared<DenseMatrix>(dm.transpose()); // SCIRun has a C++-style matrix and Matlab a FORTRAN-style matrix;
+          // SCIRun has a C++-style matrix and Matlab a FORTRAN-style matrix;
+          // the data is reordered while it is copied and cast.
+          DenseMatrixHandle dmptr(new DenseMatrix(m,n));
+          ma.getnumericarrayrowmajor(dmptr->data(), m, n);
+
+          handle = dmptr;
         }
       }
       break;
@@ -656,23 +682,30 @@ void matlabconverter::mlArrayTOsciMatrix(const matlabarray &ma,MatrixHandle &han
         size_type m = static_cast<size_type>(ma.getm());
         size_type n = static_cast<size_type>(ma.getn());
 
-        LegacySparseDataContainer<double> sparseData(n + 1, nnz, nnz);
-
-        // NOTE: this was flipped around in the old code: the arrays rows/cols were passed as cols/rows into the SparseRowMatrix ctor.  Hence the screwy order here, and the transpose call below.
-        // REASON: SCIRun uses Row sparse matrices and Matlab Column sparse matrices.
-        ma.getnumericarray(sparseData.data().get(), nnz);
-        ma.getrowsarray(sparseData.columns().get(), nnz);
-        ma.getcolsarray(sparseData.rows().get(), (n + 1));
-
-        SparseRowMatrixHandle sparse(new SparseRowMatrix(n, m, sparseData.rows().get(), sparseData.columns().get(), sparseData.data().get(), nnz));
+        // SCIRun uses Row sparse matrices and Matlab Column sparse matrices:
+        // the column arrays of the m x n Matlab matrix are the row arrays of its n x m transpose.
+        std::vector<index_type> colstart(n + 1), rowindex(nnz);
+        std::vector<double> values(nnz);
+        ma.getnumericarray(values.data(), static_cast<int>(nnz));
+        ma.getrowsarray(rowindex.data(), static_cast<int>(nnz));
+        ma.getcolsarray(colstart.data(), static_cast<int>(n + 1));
 
         if (disable_transpose_)
         {
+          SparseRowMatrixHandle sparse(new SparseRowMatrix(n, m));
+          sparse->resizeNonZeros(nnz);
+          std::copy(colstart.begin(), colstart.end(), sparse->outerIndexPtr());
+          std::copy(rowindex.begin(), rowindex.end(), sparse->innerIndexPtr());
+          std::copy(values.begin(), values.end(), sparse->valuePtr());
           handle = sparse;
         }
         else
         {
-          handle = boost::make_shared<SparseRowMatrix>(sparse->transpose());
+          SparseRowMatrixHandle sparse(new SparseRowMatrix(m, n));
+          sparse->resizeNonZeros(nnz);
+          transposecompressed(n, m, colstart.data(), rowindex.data(), values.data(),
+            sparse->outerIndexPtr(), sparse->innerIndexPtr(), sparse->valuePtr());
+          handle = sparse;
         }
       }
       break;
@@ -729,13 +762,13 @@ void matlabconverter::sciMatrixTOmlMatrix(MatrixHandle scimat, matlabarray &mlma
         
   if (matrixIs::dense(scimat))
   {
-    DenseMatrix tmatrix = castMatrix::toDense(scimat)->transpose();
+    DenseMatrixHandle dense = castMatrix::toDense(scimat);
               
     std::vector<int> dims(2);
-    dims[1] = tmatrix.nrows();
-    dims[0] = tmatrix.ncols();
+    dims[0] = static_cast<int>(dense->nrows());
+    dims[1] = static_cast<int>(dense->ncols());
     mlmat.createdensearray(dims,dataformat);
-    mlmat.setnumericarray(tmatrix.data(),mlmat.getnumelements());
+    mlmat.setnumericarrayrowmajor(dense->data(),dims[0],dims[1]);
   }
   else if (matrixIs::column(scimat))
   {
@@ -748,15 +781,28 @@ void matlabconverter::sciMatrixTOmlMatrix(MatrixHandle scimat, matlabarray &mlma
   }
   else if (matrixIs::sparse(scimat))
   {
-    SparseRowMatrix tmatrix = castMatrix::toSparse(scimat)->transpose();
-              
+    SparseRowMatrixHandle sparse = castMatrix::toSparse(scimat);
+    if (!sparse->isCompressed())
+    {
+      sparse = boost::make_shared<SparseRowMatrix>(*sparse);
+      sparse->makeCompressed();
+    }
+
+    const size_type m = sparse->nrows();
+    const size_type n = sparse->ncols();
+    const size_type nnz = sparse->nonZeros();
+    std::vector<index_type> colstart(n + 1), rowindex(nnz);
+    std::vector<double> values(nnz);
+    transposecompressed(m, n, sparse->outerIndexPtr(), sparse->innerIndexPtr(), sparse->valuePtr(),
+      colstart.data(), rowindex.data(), values.data());
+
     std::vector<int> dims(2);
-    dims[1] = tmatrix.nrows();
-    dims[0] = tmatrix.ncols();
+    dims[0] = static_cast<int>(m);
+    dims[1] = static_cast<int>(n);
     mlmat.createsparsearray(dims,dataformat);
-    mlmat.setnumericarray(tmatrix.valuePtr(),tmatrix.nonZeros());
-    mlmat.setrowsarray(tmatrix.get_cols(),tmatrix.nonZeros());
-    mlmat.setcolsarray(tmatrix.get_rows(),tmatrix.nrows()+1);
+    mlmat.setnumericarray(values.data(),static_cast<int>(nnz));
+    mlmat.setrowsarray(rowindex.data(),static_cast<int>(nnz));
+    mlmat.setcolsarray(colstart.data(),static_cast<int>(n+1));
   }
 }
 
@@ -39,6 +39,7 @@
 #include <Core/Datatypes/Legacy/Field/FieldInformation.h>
 #include <Core/Logging/LoggerInterface.h>
 #include <Core/Matlab/matlabconverter.h>
+#include <algorithm>
 
 using namespace SCIRun;
 using namespace SCIRun::MatlabIO;
@@ -2789,12 +2790,10 @@ bool MatlabToFieldAlgo::addfield(VField* field)
     VMesh::size_type numdata = static_cast<VMesh::size_type>(fielddata.size());
     if (numdata > (3*field->num_values())) numdata = (3*field->num_values()); // make sure we do not copy more data than there are elements
 
-    VField::index_type p,q;
-    for (p=0,q=0; p < numdata; q++)
-    {
-      Vector v(fielddata[p],fielddata[p+1],fielddata[p+2]); p+=3;
-      field->set_value(v,VMesh::index_type(q));
-    }
+    // Vectors are three packed doubles, so the x,y,z columns map onto the field array directly
+    static_assert(sizeof(Vector) == 3*sizeof(double), "Vector values are copied as three doubles");
+    Vector* values = static_cast<Vector*>(field->get_values_pointer());
+    std::copy(fielddata.begin(), fielddata.begin() + (numdata/3)*3, reinterpret_cast<double*>(values));
 
     return(true);
   }
@@ -2806,26 +2805,27 @@ bool MatlabToFieldAlgo::addfield(VField* field)
     mlfield.getnumericarray(fielddata); // cast and copy the real part of the data
 
     VMesh::size_type numdata = static_cast<VMesh::size_type>(fielddata.size());
+    Tensor* values = static_cast<Tensor*>(field->get_values_pointer());
     Tensor tensor;
 
     if (mlfield.getm() == 6)
     { // Compressed tensor data : xx,yy,zz,xy,xz,yz
       if (numdata > (6*field->num_values())) numdata = (6*field->num_values()); // make sure we do not copy more data than there are elements
       VField::index_type p,q;
-      for (p = 0, q = 0; p < numdata; p +=6, q++)
+      for (p = 0, q = 0; p + 6 <= numdata; p +=6, q++)
       {
         compressedtensor(fielddata,tensor,p);
-        field->set_value(tensor,VMesh::index_type(q));
+        values[q] = tensor;
       }
     }
     else
     {  // UnCompressed tensor data : xx,xy,xz,yx,yy,yz,zx,zy,zz
       if (numdata > (9*field->num_values())) numdata = (9*field->num_values()); // make sure we do not copy more data than there are elements
       VField::index_type p,q;
-      for (p = 0, q = 0; p < numdata; p +=9, q++)
+      for (p = 0, q = 0; p + 9 <= numdata; p +=9, q++)
       {
         uncompressedtensor(fielddata,tensor,p);
-        field->set_value(tensor,VMesh::index_type(q));
+        values[q] = tensor;
       }
     }
   }
@@ -2859,26 +2859,11 @@ void MatlabToFieldAlgo::remark(const std::string& remark) const
 
 void MatlabToFieldAlgo::compressedtensor(std::vector<double> &fielddata,Tensor &tens, unsigned int p)
 {
-  tens.val(0,0) = fielddata[p+0];
-  tens.val(0,1) = fielddata[p+1];
-  tens.val(0,2) = fielddata[p+2];
-  tens.val(1,0) = fielddata[p+1];
-  tens.val(1,1) = fielddata[p+3];
-  tens.val(1,2) = fielddata[p+4];
-  tens.val(2,0) = fielddata[p+2];
-  tens.val(2,1) = fielddata[p+4];
-  tens.val(2,2) = fielddata[p+5];
+  tens = symmetricTensorFromSixElementArray(&fielddata[p]);
 }
 
+/// Only the upper triangle is used, the same as reading a tensor from a stream
 void MatlabToFieldAlgo::uncompressedtensor(std::vector<double> &fielddata,Tensor &tens, unsigned int p)
 {
-  tens.val(0, 0) = fielddata[p];
-  tens.val(0, 1) = fielddata[p + 1];
-  tens.val(0, 2) = fielddata[p + 2];
-  tens.val(1, 0) = fielddata[p + 3];
-  tens.val(1, 1) = fielddata[p + 4];
-  tens.val(1, 2) = fielddata[p + 5];
-  tens.val(2, 0) = fielddata[p + 6];
-  tens.val(2, 1) = fielddata[p + 7];
-  tens.val(2, 2) = fielddata[p + 8];
+  tens = symmetricTensorFromNineElementArray(&fielddata[p]);
 }
@@ -68,6 +68,20 @@ bool get_scalar_fd(ArrayMathProgramCode& pc)
   double* data0_end = data0 + pc.get_size();
   VMesh::index_type idx = pc.get_index();
 
+  // Read straight from the storage for the common types
+  if (auto values = data1->view<double>())
+  {
+    const double* src = values.data() + idx;
+    while (data0 != data0_end) { *data0 = *src; data0++; src++; }
+    return (true);
+  }
+  if (auto values = data1->view<float>())
+  {
+    const float* src = values.data() + idx;
+    while (data0 != data0_end) { *data0 = static_cast<double>(*src); data0++; src++; }
+    return (true);
+  }
+
   double val;
   while(data0 != data0_end) 
   {
@@ -97,6 +111,19 @@ bool get_vector_fd(ArrayMathProgramCode& pc)
   double* data0_end = data0 + 3*(pc.get_size());
   VMesh::index_type idx = pc.get_index();
 
+  if (auto values = data1->view<Vector>())
+  {
+    const Vector* src = values.data() + idx;
+    while (data0 != data0_end)
+    {
+      *data0 = src->x(); data0++;
+      *data0 = src->y(); data0++;
+      *data0 = src->z(); data0++;
+      src++;
+    }
+    return (true);
+  }
+
   Vector val;
   while (data0 != data0_end) 
   {
@@ -127,6 +154,22 @@ bool get_tensor_fd(ArrayMathProgramCode& pc)
   double* data0_end = data0 + 6*(pc.get_size());
   VMesh::index_type idx = pc.get_index();
 
+  if (auto values = data1->view<Tensor>())
+  {
+    const Tensor* src = values.data() + idx;
+    while (data0 != data0_end)
+    {
+      *data0 = src->xx(); data0++;
+      *data0 = src->xy(); data0++;
+      *data0 = src->xz(); data0++;
+      *data0 = src->yy(); data0++;
+      *data0 = src->yz(); data0++;
+      *data0 = src->zz(); data0++;
+      src++;
+    }
+    return (true);
+  }
+
   Tensor val;
   while (data0 != data0_end) 
   {
@@ -157,6 +200,19 @@ bool get_node_location_fm(ArrayMathProgramCode& pc)
   double* data0_end = data0 + 3*pc.get_size();
   VMesh::Node::index_type idx = pc.get_index();
 
+  if (auto points = data1->node_points_view())
+  {
+    const Point* src = points.data() + idx;
+    while (data0 != data0_end)
+    {
+      *data0 = src->x(); data0++;
+      *data0 = src->y(); data0++;
+      *data0 = src->z(); data0++;
+      src++;
+    }
+    return (true);
+  }
+
   Point val;
   while (data0 != data0_end) 
   {
@@ -558,6 +614,13 @@ bool to_fielddata_s(ArrayMathProgramCode& pc)
   double* data1_end = data1 + (pc.get_size());
   index_type idx = pc.get_index();
 
+  if (auto values = data0->view<double>())
+  {
+    double* dst = values.data() + idx;
+    while (data1 != data1_end) { *dst = *data1; dst++; data1++; }
+    return (true);
+  }
+
   while (data1 != data1_end) 
   {
     data0->set_value(*data1,idx); idx++; data1++;
@@ -607,6 +670,17 @@ bool to_fielddata_t(ArrayMathProgramCode& pc)
   double* data1_end = data1 + 6*(pc.get_size());
   index_type idx = pc.get_index();
 
+  if (auto values = data0->view<Tensor>())
+  {
+    // The six components map directly onto the symmetric storage
+    Tensor* dst = values.data() + idx;
+    while (data1 != data1_end)
+    {
+      *dst = Tensor(data1); dst++; data1+=6;
+    }
+    return (true);
+  }
+
   while (data1 != data1_end) 
   {
     Tensor ten(data1[0],data1[1],data1[2],data1[3],data1[4],data1[5]);
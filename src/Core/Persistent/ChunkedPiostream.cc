@@ -0,0 +1,623 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+///
+///@file  ChunkedPiostream.cc
+///@brief Chunked, compressed container for persistent objects
+///
+
+#include <Core/Persistent/ChunkedPiostream.h>
+#include <Core/Logging/LoggerInterface.h>
+#include <Core/Thread/Parallel.h>
+
+#include <zlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+
+using namespace SCIRun::Core::Logging;
+using namespace SCIRun::Core::Thread;
+
+namespace SCIRun {
+
+const size_t ChunkedPiostream::CHUNK_SIZE = 1 << 20;
+const size_t ChunkedPiostream::INLINE_BLOCK_SIZE = 1 << 12;
+
+namespace
+{
+  const char INDEX_MAGIC[8] = { 'C', 'N', 'K', 'I', 'N', 'D', 'E', 'X' };
+
+  int seek_file(FILE* fp, boost::uint64_t offset, int whence)
+  {
+#ifdef _WIN32
+    return _fseeki64(fp, static_cast<__int64>(offset), whence);
+#else
+    return fseeko(fp, static_cast<off_t>(offset), whence);
+#endif
+  }
+
+  boost::uint64_t tell_file(FILE* fp)
+  {
+#ifdef _WIN32
+    return static_cast<boost::uint64_t>(_ftelli64(fp));
+#else
+    return static_cast<boost::uint64_t>(ftello(fp));
+#endif
+  }
+
+  template <class T>
+  bool read_value(FILE* fp, T& value)
+  {
+    return fread(&value, sizeof(T), 1, fp) == 1;
+  }
+
+  template <class T>
+  bool write_value(FILE* fp, const T& value)
+  {
+    return fwrite(&value, sizeof(T), 1, fp) == 1;
+  }
+
+  boost::uint32_t checksum(const char* data, size_t size)
+  {
+    uLong crc = crc32(0L, Z_NULL, 0);
+    return static_cast<boost::uint32_t>(crc32(crc, reinterpret_cast<const Bytef*>(data), static_cast<uInt>(size)));
+  }
+}
+
+ChunkedPiostream::ChunkedPiostream(const std::string& filename, Direction dir,
+                                   LoggerHandle pr)
+  : Piostream(dir, PERSISTENT_VERSION, filename, pr),
+    fp_(0), structure_pos_(0), next_array_(1), write_pos_(0)
+{
+  if (dir == Read)
+  {
+    fp_ = fopen(filename.c_str(), "rb");
+    if (!fp_)
+    {
+      reporter_->error("Error opening file: " + filename + " for reading.");
+      err = true;
+      return;
+    }
+
+    char hdr[16];
+    if (fread(hdr, 1, 16, fp_) != 16 || strncmp(hdr, "SCI\nCNK\n", 8) != 0)
+    {
+      reporter_->error("Header read failed.");
+      err = true;
+      return;
+    }
+    if (strncmp(hdr + 12, "LIT\n", 4) != 0)
+    {
+      reporter_->error("Chunked files can only be read on a machine with the same endianness.");
+      err = true;
+      return;
+    }
+    version_ = atoi(std::string(hdr + 8, 3).c_str());
+
+    if (!read_index())
+    {
+      reporter_->error("Could not read the index of chunked file: " + filename);
+      err = true;
+      return;
+    }
+
+    structure_.resize(array_size(0));
+    if (!structure_.empty() && !read_array(0, 0, structure_.size(), &structure_[0]))
+    {
+      err = true;
+      return;
+    }
+  }
+  else
+  {
+    fp_ = fopen(filename.c_str(), "wb");
+    if (!fp_)
+    {
+      reporter_->error("Error opening file '" + filename + "' for writing.");
+      err = true;
+      return;
+    }
+
+    // write out 16 bytes, but we need 17 for \0
+    char hdr[17];
+    sprintf(hdr, "SCI\nCNK\n%03d\nLIT\n", version_);
+    if (fwrite(hdr, 1, 16, fp_) != 16)
+    {
+      reporter_->error("Header write failed.");
+      err = true;
+      return;
+    }
+    write_pos_ = 16;
+
+    // The structure array is written last, but takes the first slot.
+    arrays_.resize(1);
+  }
+}
+
+
+ChunkedPiostream::~ChunkedPiostream()
+{
+  if (fp_)
+  {
+    if (writing() && !err) write_index();
+    fclose(fp_);
+  }
+}
+
+
+void
+ChunkedPiostream::reset_post_header()
+{
+  if (! reading()) return;
+
+  structure_pos_ = 0;
+  next_array_ = 1;
+}
+
+
+void
+ChunkedPiostream::raw_io(void* data, size_t bytes, const char *iotype)
+{
+  if (err) return;
+  if (dir == Read)
+  {
+    if (structure_pos_ + bytes > structure_.size())
+    {
+      err = true;
+      reporter_->error(std::string("ChunkedPiostream error reading ") +
+                       iotype + ".");
+      return;
+    }
+    if (bytes) memcpy(data, &structure_[structure_pos_], bytes);
+    structure_pos_ += bytes;
+  }
+  else
+  {
+    const char* p = static_cast<const char*>(data);
+    structure_.insert(structure_.end(), p, p + bytes);
+  }
+}
+
+
+template <class T>
+inline void
+ChunkedPiostream::gen_io(T& data, const char *iotype)
+{
+  raw_io(&data, sizeof(data), iotype);
+}
+
+
+void
+ChunkedPiostream::io(char& data)
+{
+  gen_io(data, "char");
+}
+
+
+void
+ChunkedPiostream::io(signed char& data)
+{
+  gen_io(data, "signed char");
+}
+
+
+void
+ChunkedPiostream::io(unsigned char& data)
+{
+  gen_io(data, "unsigned char");
+}
+
+
+void
+ChunkedPiostream::io(short& data)
+{
+  gen_io(data, "short");
+}
+
+
+void
+ChunkedPiostream::io(unsigned short& data)
+{
+  gen_io(data, "unsigned short");
+}
+
+
+void
+ChunkedPiostream::io(int& data)
+{
+  gen_io(data, "int");
+}
+
+
+void
+ChunkedPiostream::io(unsigned int& data)
+{
+  gen_io(data, "unsigned int");
+}
+
+
+void
+ChunkedPiostream::io(long& data)
+{
+  // Store as 64 bits so files move between platforms with different longs.
+  long long tmp = data;
+  gen_io(tmp, "long");
+  data = static_cast<long>(tmp);
+}
+
+
+void
+ChunkedPiostream::io(unsigned long& data)
+{
+  unsigned long long tmp = data;
+  gen_io(tmp, "unsigned long");
+  data = static_cast<unsigned long>(tmp);
+}
+
+
+void
+ChunkedPiostream::io(long long& data)
+{
+  gen_io(data, "long long");
+}
+
+
+void
+ChunkedPiostream::io(unsigned long long& data)
+{
+  gen_io(data, "unsigned long long");
+}
+
+
+void
+ChunkedPiostream::io(double& data)
+{
+  gen_io(data, "double");
+}
+
+
+void
+ChunkedPiostream::io(float& data)
+{
+  gen_io(data, "float");
+}
+
+
+void
+ChunkedPiostream::io(std::string& data)
+{
+  if (err) return;
+  unsigned int chars = static_cast<unsigned int>(data.size());
+  io(chars);
+  if (dir == Read)
+  {
+    if (err || structure_pos_ + chars > structure_.size())
+    {
+      err = true;
+      reporter_->error("ChunkedPiostream error reading string.");
+      return;
+    }
+    data.assign(structure_.data() + structure_pos_, chars);
+    structure_pos_ += chars;
+  }
+  else
+  {
+    raw_io(const_cast<char*>(data.data()), chars, "string");
+  }
+}
+
+
+bool
+ChunkedPiostream::block_io(void *data, size_t s, size_t nmemb)
+{
+  if (err) return true;
+
+  const size_t bytes = s * nmemb;
+  if (bytes < INLINE_BLOCK_SIZE)
+  {
+    raw_io(data, bytes, "block io");
+    return true;
+  }
+
+  if (dir == Read)
+  {
+    if (next_array_ >= arrays_.size() || arrays_[next_array_].size_ != bytes)
+    {
+      err = true;
+      reporter_->error("ChunkedPiostream error reading block io: block size does not match index.");
+      return true;
+    }
+    if (!read_array(next_array_, 0, bytes, data)) err = true;
+    ++next_array_;
+  }
+  else
+  {
+    Array array;
+    if (!write_array(static_cast<const char*>(data), bytes, array))
+    {
+      err = true;
+      reporter_->error("ChunkedPiostream error writing block io.");
+      return true;
+    }
+    arrays_.push_back(array);
+  }
+  return true;
+}
+
+
+bool
+ChunkedPiostream::write_array(const char* data, size_t bytes, Array& array)
+{
+  array.size_ = bytes;
+  const size_t num_chunks = (bytes + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  array.chunks_.resize(num_chunks);
+  if (num_chunks == 0) return true;
+
+  // Compress a batch of chunks in parallel, then append them to the file in
+  // order. Batching bounds the memory needed for the compressed buffers.
+  const size_t np = std::max<size_t>(1, std::min<size_t>(Parallel::NumCores(), num_chunks));
+  const size_t batch = 4 * np;
+  std::vector<std::vector<char> > buffers(batch);
+  std::vector<int> status(batch);
+
+  for (size_t first = 0; first < num_chunks; first += batch)
+  {
+    const size_t last = std::min(first + batch, num_chunks);
+
+    auto task_i = [&](int proc)
+    {
+      for (size_t c = first + proc; c < last; c += np)
+      {
+        const size_t start = c * CHUNK_SIZE;
+        const size_t size = std::min(CHUNK_SIZE, bytes - start);
+        std::vector<char>& buffer = buffers[c - first];
+
+        uLongf compressed_size = compressBound(static_cast<uLong>(size));
+        buffer.resize(compressed_size);
+        // Favor speed: most of the payload is floating point data that does
+        // not compress much better at higher levels.
+        status[c - first] = compress2(reinterpret_cast<Bytef*>(&buffer[0]), &compressed_size,
+          reinterpret_cast<const Bytef*>(data + start), static_cast<uLong>(size), Z_BEST_SPEED);
+        buffer.resize(compressed_size);
+
+        Chunk& chunk = array.chunks_[c];
+        chunk.size_ = size;
+        chunk.compressed_size_ = compressed_size;
+        chunk.crc_ = checksum(data + start, size);
+      }
+    };
+    Parallel::RunTasks(task_i, static_cast<int>(np));
+
+    for (size_t c = first; c < last; c++)
+    {
+      const std::vector<char>& buffer = buffers[c - first];
+      if (status[c - first] != Z_OK ||
+        fwrite(&buffer[0], 1, buffer.size(), fp_) != buffer.size())
+      {
+        return false;
+      }
+      array.chunks_[c].offset_ = write_pos_;
+      write_pos_ += buffer.size();
+    }
+  }
+  return true;
+}
+
+
+bool
+ChunkedPiostream::write_index()
+{
+  if (!write_array(structure_.empty() ? 0 : &structure_[0], structure_.size(), arrays_[0]))
+  {
+    reporter_->error("ChunkedPiostream error writing structure.");
+    err = true;
+    return false;
+  }
+
+  const boost::uint64_t index_offset = write_pos_;
+  bool ok = write_value(fp_, static_cast<boost::uint64_t>(arrays_.size()));
+  for (size_t a = 0; a < arrays_.size() && ok; a++)
+  {
+    const Array& array = arrays_[a];
+    ok = write_value(fp_, array.size_) &&
+      write_value(fp_, static_cast<boost::uint64_t>(array.chunks_.size()));
+    for (size_t c = 0; c < array.chunks_.size() && ok; c++)
+    {
+      const Chunk& chunk = array.chunks_[c];
+      ok = write_value(fp_, chunk.offset_) && write_value(fp_, chunk.compressed_size_) &&
+        write_value(fp_, chunk.size_) && write_value(fp_, chunk.crc_);
+    }
+  }
+  ok = ok && write_value(fp_, index_offset) &&
+    fwrite(INDEX_MAGIC, 1, sizeof(INDEX_MAGIC), fp_) == sizeof(INDEX_MAGIC);
+
+  if (!ok)
+  {
+    reporter_->error("ChunkedPiostream error writing index.");
+    err = true;
+  }
+  return ok;
+}
+
+
+bool
+ChunkedPiostream::read_index()
+{
+  if (seek_file(fp_, 0, SEEK_END) != 0) return false;
+  const boost::uint64_t file_size = tell_file(fp_);
+  if (file_size < 16 + 8 + 16) return false;
+
+  boost::uint64_t index_offset;
+  char magic[sizeof(INDEX_MAGIC)];
+  if (seek_file(fp_, file_size - 16, SEEK_SET) != 0 ||
+    !read_value(fp_, index_offset) ||
+    fread(magic, 1, sizeof(magic), fp_) != sizeof(magic) ||
+    memcmp(magic, INDEX_MAGIC, sizeof(magic)) != 0 ||
+    index_offset < 16 || index_offset > file_size - 16)
+  {
+    return false;
+  }
+
+  boost::uint64_t num_arrays;
+  if (seek_file(fp_, index_offset, SEEK_SET) != 0 || !read_value(fp_, num_arrays) || num_arrays == 0)
+    return false;
+
+  arrays_.clear();
+  for (boost::uint64_t a = 0; a < num_arrays; a++)
+  {
+    Array array;
+    boost::uint64_t num_chunks;
+    if (!read_value(fp_, array.size_) || !read_value(fp_, num_chunks)) return false;
+
+    boost::uint64_t total = 0;
+    for (boost::uint64_t c = 0; c < num_chunks; c++)
+    {
+      Chunk chunk;
+      if (!read_value(fp_, chunk.offset_) || !read_value(fp_, chunk.compressed_size_) ||
+        !read_value(fp_, chunk.size_) || !read_value(fp_, chunk.crc_))
+        return false;
+      if (chunk.offset_ < 16 || chunk.offset_ + chunk.compressed_size_ > index_offset)
+        return false;
+      total += chunk.size_;
+      array.chunks_.push_back(chunk);
+    }
+    if (total != array.size_) return false;
+    arrays_.push_back(array);
+  }
+  return true;
+}
+
+
+size_t
+ChunkedPiostream::array_size(size_t array) const
+{
+  return (array < arrays_.size()) ? static_cast<size_t>(arrays_[array].size_) : 0;
+}
+
+
+bool
+ChunkedPiostream::read_array(size_t array, size_t offset, size_t bytes, void* data)
+{
+  if (!reading() || !fp_ || array >= arrays_.size() || offset + bytes > arrays_[array].size_)
+  {
+    reporter_->error("ChunkedPiostream: requested range is not in the file.");
+    return false;
+  }
+
+  // Select the chunks that overlap the requested range.
+  const std::vector<Chunk>& chunks = arrays_[array].chunks_;
+  std::vector<size_t> selected, starts;
+  size_t start = 0;
+  for (size_t c = 0; c < chunks.size() && start < offset + bytes; c++)
+  {
+    if (start + chunks[c].size_ > offset)
+    {
+      selected.push_back(c);
+      starts.push_back(start);
+    }
+    start += static_cast<size_t>(chunks[c].size_);
+  }
+
+  char* dst = static_cast<char*>(data);
+  const size_t np = std::max<size_t>(1, std::min<size_t>(Parallel::NumCores(), selected.size()));
+  const size_t batch = 4 * np;
+  std::vector<std::vector<char> > compressed(batch);
+  std::vector<std::vector<char> > partial(batch);
+  std::vector<char> ok(batch);
+
+  for (size_t first = 0; first < selected.size(); first += batch)
+  {
+    const size_t last = std::min(first + batch, selected.size());
+
+    // The file is read sequentially, only the decompression runs in parallel.
+    for (size_t s = first; s < last; s++)
+    {
+      const Chunk& chunk = chunks[selected[s]];
+      std::vector<char>& buffer = compressed[s - first];
+      buffer.resize(static_cast<size_t>(chunk.compressed_size_));
+      if (seek_file(fp_, chunk.offset_, SEEK_SET) != 0 ||
+        fread(&buffer[0], 1, buffer.size(), fp_) != buffer.size())
+      {
+        reporter_->error("ChunkedPiostream error reading chunk.");
+        return false;
+      }
+    }
+
+    auto task_i = [&](int proc)
+    {
+      for (size_t s = first + proc; s < last; s += np)
+      {
+        const Chunk& chunk = chunks[selected[s]];
+        const size_t chunk_start = starts[s];
+        const size_t chunk_size = static_cast<size_t>(chunk.size_);
+        const bool inside = chunk_start >= offset && chunk_start + chunk_size <= offset + bytes;
+
+        // Chunks that are completely requested are decompressed in place,
+        // chunk_start may be before offset otherwise.
+        char* out;
+        if (inside)
+        {
+          out = dst + (chunk_start - offset);
+        }
+        else
+        {
+          partial[s - first].resize(chunk_size);
+          out = &partial[s - first][0];
+        }
+
+        uLongf size = static_cast<uLongf>(chunk_size);
+        const std::vector<char>& buffer = compressed[s - first];
+        ok[s - first] = uncompress(reinterpret_cast<Bytef*>(out), &size,
+          reinterpret_cast<const Bytef*>(&buffer[0]), static_cast<uLong>(buffer.size())) == Z_OK &&
+          size == chunk_size && checksum(out, chunk_size) == chunk.crc_;
+
+        if (ok[s - first] && !inside)
+        {
+          const size_t from = std::max(chunk_start, offset);
+          const size_t to = std::min(chunk_start + chunk_size, offset + bytes);
+          memcpy(dst + (from - offset), out + (from - chunk_start), to - from);
+        }
+      }
+    };
+    Parallel::RunTasks(task_i, static_cast<int>(np));
+
+    for (size_t s = first; s < last; s++)
+    {
+      if (!ok[s - first])
+      {
+        reporter_->error("ChunkedPiostream: chunk failed to decompress or has a bad checksum.");
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+} // End namespace SCIRun
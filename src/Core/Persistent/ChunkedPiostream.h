@@ -0,0 +1,127 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+
+///
+///@file  ChunkedPiostream.h
+///@brief Chunked, compressed container for persistent objects
+///
+/// The file starts with the usual 16 byte SCI header (type CNK). Every
+/// array written with block_io is split in chunks that are compressed
+/// independently, and in parallel, with zlib. All other data written to
+/// the stream (class names, versions, sizes and element wise data) is
+/// collected in one structure array that is compressed when the stream is
+/// closed. An index with the offset, size and CRC-32 of every chunk and a
+/// trailer pointing to the index finish the file.
+///
+
+#ifndef CORE_PERSISTENT_CHUNKEDPIOSTREAM_H
+#define CORE_PERSISTENT_CHUNKEDPIOSTREAM_H 1
+
+#include <Core/Persistent/Persistent.h>
+#include <cstdio>
+#include <vector>
+#include <boost/cstdint.hpp>
+
+#include <Core/Persistent/share.h>
+
+namespace SCIRun {
+
+class SCISHARE ChunkedPiostream : public Piostream {
+public:
+  ChunkedPiostream(const std::string& filename, Direction dir,
+                   Core::Logging::LoggerHandle pr = Core::Logging::LoggerHandle());
+  virtual ~ChunkedPiostream();
+
+  virtual void io(char&);
+  virtual void io(signed char&);
+  virtual void io(unsigned char&);
+  virtual void io(short&);
+  virtual void io(unsigned short&);
+  virtual void io(int&);
+  virtual void io(unsigned int&);
+  virtual void io(long&);
+  virtual void io(unsigned long&);
+  virtual void io(long long&);
+  virtual void io(unsigned long long&);
+  virtual void io(double&);
+  virtual void io(float&);
+  virtual void io(std::string& str);
+
+  virtual bool supports_block_io() { return true; }
+  virtual bool block_io(void*, size_t, size_t);
+  virtual bool supports_split_records() { return true; }
+
+  /// Direct access to the arrays in a file opened for reading. Array 0 is
+  /// the structure array, the others are the blocks in the order in which
+  /// they were written. Only the chunks overlapping the requested range are
+  /// read and decompressed.
+  size_t num_arrays() const { return arrays_.size(); }
+  size_t array_size(size_t array) const;
+  bool read_array(size_t array, size_t offset, size_t bytes, void* data);
+
+  /// Uncompressed size of a chunk.
+  static const size_t CHUNK_SIZE;
+  /// Blocks smaller than this are stored in the structure array.
+  static const size_t INLINE_BLOCK_SIZE;
+
+private:
+  struct Chunk
+  {
+    boost::uint64_t offset_;
+    boost::uint64_t compressed_size_;
+    boost::uint64_t size_;
+    boost::uint32_t crc_;
+  };
+
+  struct Array
+  {
+    boost::uint64_t size_;
+    std::vector<Chunk> chunks_;
+  };
+
+  template <class T> void gen_io(T&, const char *);
+  void raw_io(void* data, size_t bytes, const char *iotype);
+
+  bool write_array(const char* data, size_t bytes, Array& array);
+  bool write_index();
+  bool read_index();
+
+  virtual void reset_post_header();
+
+  FILE* fp_;
+  std::vector<Array> arrays_;
+  std::vector<char> structure_;
+  size_t structure_pos_;
+  size_t next_array_;
+  boost::uint64_t write_pos_;
+};
+
+} // End namespace SCIRun
+
+#endif
@@ -41,6 +41,7 @@
 #include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 #include <Core/Persistent/Persistent.h>
 #include <Core/Persistent/Pstreams.h>
+#include <Core/Persistent/ChunkedPiostream.h>
 #ifdef SCIRUN4_CODE_TO_BE_ENABLED_LATER
 #include <Core/Persistent/GZstream.h>
 #endif
@@ -134,6 +135,19 @@ Piostream::peek_class()
   return peekname_;
 }
 
+//----------------------------------------------------------------------
+std::string
+Piostream::peek_object_class()
+{
+  if (err || dir != Read) return std::string();
+  begin_cheap_delim();
+  int have_data;
+  int pointer_id;
+  emit_pointer(have_data, pointer_id);
+  if (err || !have_data) return std::string();
+  return peek_class();
+}
+
 //----------------------------------------------------------------------
 int
 Piostream::begin_class(const std::string& classname, int current_version)
@@ -455,6 +469,10 @@ auto_istream(const std::string& filename, LoggerHandle pr)
   {
     return PiostreamPtr(new TextPiostream(filename, Piostream::Read, pr));
   }
+  else if (m1 == 'C' && m2 == 'N' && m3 == 'K')
+  {
+    return PiostreamPtr(new ChunkedPiostream(filename, Piostream::Read, pr));
+  }
 
   if (pr) pr->error(filename + " is an unknown type!");
   else std::cerr << filename << " is an unknown type!" << std::endl;
@@ -470,6 +488,7 @@ auto_ostream(const std::string& filename, const std::string& type, LoggerHandle
   //     Binary:  Return a BinaryPiostream 
   //     Fast:    Return FastPiostream
   //     Text:    Return a TextPiostream
+  //     Chunked: Return a ChunkedPiostream
   //     Default: Return BinaryPiostream 
   // NOTE: Binary will never return BinarySwap so we always write
   //       out the endianness of the machine we are on
@@ -486,6 +505,10 @@ auto_ostream(const std::string& filename, const std::string& type, LoggerHandle
   {
     stream = new FastPiostream(filename, Piostream::Write, pr);
   }
+  else if (type == "Chunked")
+  {
+    stream = new ChunkedPiostream(filename, Piostream::Write, pr);
+  }
   else
   {
     stream = new BinaryPiostream(filename, Piostream::Write, -1, pr);
@@ -141,6 +141,9 @@ class SCISHARE Piostream {
     virtual ~Piostream();
 
     virtual std::string peek_class();
+    // Read the pointer header of the next object and return its class name
+    // without reading the object. Only useful on a freshly opened stream.
+    std::string peek_object_class();
     virtual int begin_class(const std::string& name, int current_version);
     virtual void end_class();
     virtual void begin_cheap_delim();
@@ -180,6 +183,11 @@ class SCISHARE Piostream {
     
     // Returns true if block_io was supported (even on error).
     virtual bool block_io(void*, size_t, size_t) { return false; }
+
+    // Returns true if containers of variable sized records may be written as
+    // one block per record member. Only streams whose format was never
+    // written element wise can do this.
+    virtual bool supports_split_records() { return false; }
     
     void disable_pointer_hashing() { disable_pointer_hashing_ = true; }
 
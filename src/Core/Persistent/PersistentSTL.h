@@ -69,6 +69,23 @@ Pio( Piostream &stream, std::pair<T,S>& pair);
 SCISHARE void 
 Pio_index(Piostream& stream, std::vector<index_type>& data);
 
+// Indices stored in a narrower type (compact meshes) are written in the same
+// format as full indices, so files do not depend on the storage type.
+template <class T>
+inline void
+Pio_index(Piostream& stream, std::vector<T>& data)
+{
+  std::vector<index_type> temp;
+  if (!stream.reading()) temp.assign(data.begin(), data.end());
+  Pio_index(stream, temp);
+  if (stream.reading())
+  {
+    data.resize(temp.size());
+    for (size_t i = 0; i < temp.size(); i++)
+      data[i] = static_cast<T>(temp[i]);
+  }
+}
+
 //////////
 // Persistent io for maps
 template <class Key, class Data>
@@ -172,6 +189,40 @@ void Pio(Piostream& stream, std::vector<T>& data)
   stream.end_class();  
 }
 
+// Vectors of records made of N doubles (points, vectors) use the format of
+// the element wise Pio above, which has no delimiters in binary streams, but
+// all records go through one block_io call.
+template <class T, size_t N>
+void Pio_double_records(Piostream& stream, std::vector<T>& data)
+{
+  static_assert(sizeof(T) == N * sizeof(double), "record has to be N packed doubles");
+  if (stream.reading() && stream.peek_class() == "Array1")
+  {
+    stream.begin_class("Array1", STLVECTOR_VERSION);
+  }
+  else
+  {
+    stream.begin_class("STLVector", STLVECTOR_VERSION);
+  }
+
+  int size=static_cast<int>(data.size());
+  stream.io(size);
+
+  if(stream.reading()){
+    data.resize(size);
+  }
+
+  if (size > 0 && !stream.block_io(&data.front(), sizeof(double), N * data.size()))
+  {
+    for (int i = 0; i < size; i++)
+    {
+      Pio(stream, data[i]);
+    }
+  }
+
+  stream.end_class();
+}
+
 template <class T> 
 void Pio(Piostream& stream, std::vector<T*>& data)
 { 
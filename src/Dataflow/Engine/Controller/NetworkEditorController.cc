@@ -76,7 +76,8 @@ NetworkEditorController::NetworkEditorController(ModuleFactoryHandle mf, ModuleS
   eventCmdFactory_(eventCmdFactory ? eventCmdFactory : boost::make_shared<NullCommandFactory>()),
   serializationManager_(nesm),
   signalSwitch_(true),
-  loadingContext_(false)
+  loadingContext_(false),
+  prefetchMemoryBudget_(0)
 {
   dynamicPortManager_.reset(new DynamicPortManager(connectionAdded_, connectionRemoved_, this));
 
@@ -93,7 +94,8 @@ NetworkEditorController::NetworkEditorController(NetworkHandle network, Executio
   : theNetwork_(network), executorFactory_(executorFactory),
   eventCmdFactory_(new NullCommandFactory),
   serializationManager_(nesm),
-  signalSwitch_(true)
+  signalSwitch_(true),
+  prefetchMemoryBudget_(0)
 {
 }
 
@@ -378,7 +380,13 @@ boost::optional<ConnectionId> NetworkEditorController::requestConnection(const P
     auto id = theNetwork_->connect(ConnectionOutputPort(theNetwork_->lookupModule(desc.out_.moduleId_), desc.out_.portId_),
       ConnectionInputPort(theNetwork_->lookupModule(desc.in_.moduleId_), desc.in_.portId_));
     if (!id.id_.empty())
-      connectionAdded_(desc);
+    {
+      if (signalSwitch_)
+        connectionAdded_(desc);
+      // While a network is loaded, listeners are told about all connections at the end, but dynamic ports are needed right away.
+      else if (dynamicPortManager_)
+        dynamicPortManager_->connectionAddedNeedToCloneAPort(desc);
+    }
 
     printNetwork();
     return id;
@@ -515,6 +523,7 @@ void NetworkEditorController::loadNetwork(const NetworkFileHandle& xml)
 #endif
       }
       networkDoneLoading_(static_cast<int>(theNetwork_->nmodules()) + 1);
+      prefetchModuleOutputs();
     }
     catch (ExceptionBase& e)
     {
@@ -681,6 +690,17 @@ void NetworkEditorController::setExecutorType(int type)
   executionManager_.setExecutionStrategy(executorFactory_->create(static_cast<ExecutionStrategy::Type>(type)));
 }
 
+void NetworkEditorController::prefetchModuleOutputs()
+{
+  auto budget = prefetchMemoryBudget_;
+  for (size_t i = 0; i < theNetwork_->nmodules() && budget > 0; ++i)
+  {
+    auto module = theNetwork_->module(i);
+    if (!module->executionDisabled())
+      budget -= std::min(budget, module->prefetchOutputs(budget));
+  }
+}
+
 const ModuleDescriptionMap& NetworkEditorController::getAllAvailableModuleDescriptions() const
 {
   return moduleFactory_->getAllAvailableModuleDescriptions();
@@ -149,6 +149,9 @@ namespace Engine {
 
     void setExecutorType(int type);
 
+    /// Bytes that reader modules may load in the background when a network is loaded; 0 disables prefetching.
+    void setPrefetchMemoryBudget(size_t bytes) { prefetchMemoryBudget_ = bytes; }
+
     /// @todo: eek, getting bloated here. Figure out a better way to wire this one in.
     void setSerializationManager(Networks::NetworkEditorSerializationManager* nesm) { serializationManager_ = nesm; }
 
@@ -170,6 +173,7 @@ namespace Engine {
 
     boost::shared_ptr<boost::thread> executeGeneric(const Networks::ExecutableLookup* lookup, Networks::ModuleFilter filter);
     void initExecutor();
+    void prefetchModuleOutputs();
     ExecutionContextHandle createExecutionContext(const Networks::ExecutableLookup* lookup, Networks::ModuleFilter filter);
 
     Networks::NetworkHandle theNetwork_;
@@ -194,6 +198,7 @@ namespace Engine {
 
     boost::shared_ptr<DynamicPortManager> dynamicPortManager_;
     bool signalSwitch_, loadingContext_;
+    size_t prefetchMemoryBudget_;
     boost::shared_ptr<Networks::ReplacementImpl::ModuleReplacementFilter> replacementFilter_;
 
     struct LoadingContext
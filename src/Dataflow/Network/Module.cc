@@ -179,6 +179,7 @@ namespace SCIRun
         ExecuteBeginsSignalType executeBegins_;
         ExecuteEndsSignalType executeEnds_;
         ErrorSignalType errorSignal_;
+        ModuleInterface::IdChangedSignalType idChanged_;
         std::vector<boost::shared_ptr<boost::signals2::scoped_connection>> portConnections_;
         ModuleInterface::ExecutionSelfRequestSignalType executionSelfRequested_;
 
@@ -239,7 +240,9 @@ void Module::set_id(const std::string& id)
   ModuleId newId(id);
   if (!DefaultModuleFactories::idGenerator_->takeId(newId.name_, newId.idNumber_))
     THROW_INVALID_ARGUMENT("Duplicate module IDs, invalid network file.");
+  const ModuleId oldId = impl_->id_;
   impl_->id_ = newId;
+  impl_->idChanged_(oldId, newId);
 }
 
 Module::~Module()
@@ -743,6 +746,11 @@ boost::signals2::connection Module::connectErrorListener(const ErrorSignalType::
   return impl_->errorSignal_.connect(subscriber);
 }
 
+boost::signals2::connection Module::connectIdChanged(const IdChangedSignalType::slot_type& subscriber)
+{
+  return impl_->idChanged_.connect(subscriber);
+}
+
 void Module::setUiVisible(bool visible)
 {
   if (impl_->uiToggleFunc_)
@@ -72,6 +72,8 @@ namespace Networks {
     virtual ModuleExecutionState& executionState() = 0;
     /// @todo for deserialization
     virtual void set_id(const std::string& id) = 0;
+    typedef boost::signals2::signal<void(const ModuleId& oldId, const ModuleId& newId)> IdChangedSignalType;
+    virtual boost::signals2::connection connectIdChanged(const IdChangedSignalType::slot_type& subscriber) = 0;
     virtual void set_state(ModuleStateHandle state) = 0;
     virtual SCIRun::Core::Datatypes::DatatypeHandleOption get_input_handle(const PortId& id) = 0;
     virtual std::vector<SCIRun::Core::Datatypes::DatatypeHandleOption> get_dynamic_input_handles(const PortId& id) = 0;
@@ -90,6 +92,9 @@ namespace Networks {
     virtual bool isStoppable() const = 0;
     virtual bool executionDisabled() const = 0;
     virtual void setExecutionDisabled(bool disable) = 0;
+    /// Start producing outputs in the background before the module executes, using at most
+    /// memoryBudget bytes. Returns the number of bytes committed; most modules commit nothing.
+    virtual size_t prefetchOutputs(size_t memoryBudget) { return 0; }
   };
 
   class SCISHARE ModuleInterface :
@@ -45,7 +45,7 @@ using namespace SCIRun::Dataflow::Networks;
 using namespace SCIRun::Core::Algorithms;
 
 Network::Network(ModuleFactoryHandle moduleFactory, ModuleStateFactoryHandle stateFactory, AlgorithmFactoryHandle algoFactory, ReexecuteStrategyFactoryHandle reexFactory)
-  : moduleFactory_(moduleFactory), stateFactory_(stateFactory), errorCode_(0)
+  : moduleFactory_(moduleFactory), stateFactory_(stateFactory), errorCode_(0), moduleIndexLock_("module index")
 {
   moduleFactory_->setStateFactory(stateFactory_);
   moduleFactory_->setAlgorithmFactory(algoFactory);
@@ -54,6 +54,7 @@ Network::Network(ModuleFactoryHandle moduleFactory, ModuleStateFactoryHandle sta
 
 Network::~Network()
 {
+  clear();
 }
 
 ModuleHandle Network::add_module(const ModuleLookupInfo& info)
@@ -63,6 +64,9 @@ ModuleHandle Network::add_module(const ModuleLookupInfo& info)
   if (module)
   {
     module->connectErrorListener(boost::bind(&NetworkInterface::incrementErrorCode, this, _1));
+    Core::Thread::Guard g(moduleIndexLock_.get());
+    moduleIndex_[module->get_id().id_] = module;
+    idListeners_[module.get()] = module->connectIdChanged([this](const ModuleId& oldId, const ModuleId& newId) { moduleIdChanged(oldId, newId); });
   }
   return module;
 }
@@ -73,7 +77,16 @@ bool Network::remove_module(const ModuleId& id)
   if (loc != modules_.end())
   {
     // Inform the module that it is about to be erased from the network...
+    ModuleHandle module = *loc;
     modules_.erase(loc);
+    Core::Thread::Guard g(moduleIndexLock_.get());
+    moduleIndex_.erase(id.id_);
+    auto listener = idListeners_.find(module.get());
+    if (listener != idListeners_.end())
+    {
+      listener->second.disconnect();
+      idListeners_.erase(listener);
+    }
     return true;
   }
   return false;
@@ -160,8 +173,20 @@ ModuleHandle Network::module(size_t i) const
 
 ModuleHandle Network::lookupModule(const ModuleId& id) const
 {
-  Modules::const_iterator i = std::find_if(modules_.begin(), modules_.end(), boost::lambda::bind(&ModuleInterface::get_id, *boost::lambda::_1) == id);
-  return i == modules_.end() ? nullptr : *i;
+  Core::Thread::Guard g(moduleIndexLock_.get());
+  auto found = moduleIndex_.find(id.id_);
+  return found == moduleIndex_.end() ? nullptr : found->second;
+}
+
+void Network::moduleIdChanged(const ModuleId& oldId, const ModuleId& newId)
+{
+  Core::Thread::Guard g(moduleIndexLock_.get());
+  auto found = moduleIndex_.find(oldId.id_);
+  if (found == moduleIndex_.end())
+    return;
+  ModuleHandle module = found->second;
+  moduleIndex_.erase(found);
+  moduleIndex_[newId.id_] = module;
 }
 
 ExecutableObject* Network::lookupExecutable(const ModuleId& id) const
@@ -252,6 +277,11 @@ void Network::clear()
 {
   connections_.clear();
   modules_.clear();
+  Core::Thread::Guard g(moduleIndexLock_.get());
+  moduleIndex_.clear();
+  for (auto& listener : idListeners_)
+    listener.second.disconnect();
+  idListeners_.clear();
 }
 
 bool Network::containsViewScene() const
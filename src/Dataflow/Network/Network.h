@@ -36,6 +36,8 @@
 #include <Dataflow/Network/NetworkInterface.h>
 #include <Dataflow/Network/ConnectionId.h>
 #include <Dataflow/Network/NetworkSettings.h>
+#include <Core/Thread/Mutex.h>
+#include <unordered_map>
 #include <Dataflow/Network/share.h>
 
 namespace SCIRun {
@@ -74,6 +76,8 @@ namespace Networks {
     void interruptModuleRequest(const ModuleId& id) override;
     void clear() override;
   private:
+    void moduleIdChanged(const ModuleId& oldId, const ModuleId& newId);
+
     ModuleFactoryHandle moduleFactory_;
     ModuleStateFactoryHandle stateFactory_;
     Connections connections_;
@@ -81,6 +85,10 @@ namespace Networks {
     int errorCode_;
     NetworkGlobalSettings settings_;
     mutable ModuleInterruptedSignal interruptModule_;
+    // Kept up to date by add_module, remove_module and the modules' id change signals.
+    std::unordered_map<std::string, ModuleHandle> moduleIndex_;
+    std::map<ModuleInterface*, boost::signals2::connection> idListeners_;
+    mutable Core::Thread::Mutex moduleIndexLock_;
   };
 
 }}}
@@ -79,6 +79,7 @@ namespace SCIRun {
           MOCK_METHOD1(connectExecuteBegins, boost::signals2::connection(const ExecuteBeginsSignalType::slot_type&));
           MOCK_METHOD1(connectExecuteEnds, boost::signals2::connection(const ExecuteEndsSignalType::slot_type&));
           MOCK_METHOD1(connectErrorListener, boost::signals2::connection(const ErrorSignalType::slot_type&));
+          MOCK_METHOD1(connectIdChanged, boost::signals2::connection(const IdChangedSignalType::slot_type&));
           MOCK_CONST_METHOD0(needToExecute, bool());
           MOCK_CONST_METHOD0(isStoppable, bool());
           MOCK_METHOD0(setStateDefaults, void());
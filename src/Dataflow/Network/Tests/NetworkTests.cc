@@ -30,6 +30,7 @@
 #include <boost/assign.hpp>
 #include <boost/assign/list_of.hpp>
 #include <Dataflow/Network/Network.h>
+#include <Dataflow/Network/Module.h>
 #include <Dataflow/Network/Connection.h>
 #include <Dataflow/Network/ModuleDescription.h>
 #include <Dataflow/Network/Tests/MockModule.h>
@@ -171,3 +172,49 @@ TEST_F(NetworkTests, CannotConnectNonExistentPorts)
 
   EXPECT_THROW(network.connect(ConnectionOutputPort(m1, 3), ConnectionInputPort(m2, 2)), std::out_of_range);
 }
+
+namespace
+{
+  class RenamableModule : public Module
+  {
+  public:
+    explicit RenamableModule(const ModuleLookupInfo& info) : Module(info, false, nullptr, nullptr, nullptr) {}
+    void execute() override {}
+    void setStateDefaults() override {}
+  };
+
+  class RenamableModuleFactory : public MockModuleFactory
+  {
+  public:
+    ModuleHandle create(const ModuleDescription& info) const override
+    {
+      return boost::make_shared<RenamableModule>(info.lookupInfo_);
+    }
+  };
+}
+
+TEST_F(NetworkTests, LookupFollowsRenamedAndRemovedModules)
+{
+  Network network(boost::make_shared<RenamableModuleFactory>(), sf_, af_, reex_);
+
+  ModuleLookupInfo mli;
+  mli.module_name_ = "RenamedModule";
+  ModuleHandle m1 = network.add_module(mli);
+  ModuleHandle m2 = network.add_module(mli);
+  const ModuleId original = m1->get_id();
+  EXPECT_EQ(m1, network.lookupModule(original));
+  EXPECT_EQ(m2, network.lookupModule(m2->get_id()));
+
+  m1->set_id("RenamedModule:100");
+  EXPECT_EQ(nullptr, network.lookupModule(original));
+  EXPECT_EQ(m1, network.lookupModule(ModuleId("RenamedModule:100")));
+  EXPECT_EQ(m2, network.lookupModule(m2->get_id()));
+
+  EXPECT_TRUE(network.remove_module(m1->get_id()));
+  EXPECT_EQ(nullptr, network.lookupModule(ModuleId("RenamedModule:100")));
+
+  // A removed module no longer updates the index
+  m1->set_id("RenamedModule:101");
+  EXPECT_EQ(nullptr, network.lookupModule(ModuleId("RenamedModule:101")));
+  EXPECT_EQ(m2, network.lookupModule(m2->get_id()));
+}
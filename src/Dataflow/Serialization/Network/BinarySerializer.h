@@ -0,0 +1,117 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+/// @todo Documentation Dataflow/Serialization/Network/BinarySerializer.h
+
+
+#ifndef CORE_SERIALIZATION_NETWORK_BINARY_SERIALIZER_H
+#define CORE_SERIALIZATION_NETWORK_BINARY_SERIALIZER_H
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/shared_ptr.hpp>
+#include <fstream>
+#include <string>
+
+#include <Dataflow/Serialization/Network/share.h>
+
+namespace SCIRun {
+namespace Dataflow {
+namespace Networks {
+
+  /// Compact counterpart of XMLSerializer, using the same serialize functions. Binary archives
+  /// depend on the platform and boost version, so XML stays the format for exchanging files.
+  namespace BinarySerializer
+  {
+    /// Written in front of every archive, so that readers can tell binary files from XML ones.
+    inline const std::string& magic()
+    {
+      static const std::string m("SCIRunBinaryArchive");
+      return m;
+    }
+
+    inline bool is_binary(std::istream& istr)
+    {
+      const auto& m = magic();
+      std::string head(m.size(), '\0');
+      const auto start = istr.tellg();
+      istr.read(&head[0], m.size());
+      const bool binary = istr.gcount() == static_cast<std::streamsize>(m.size()) && head == m;
+      istr.clear();
+      istr.seekg(start);
+      return binary;
+    }
+
+    inline bool is_binary(const std::string& filename)
+    {
+      std::ifstream ifs(filename.c_str(), std::ios::binary);
+      return ifs && is_binary(ifs);
+    }
+
+    template <class Serializable>
+    bool save_binary(const Serializable& data, std::ostream& ostr)
+    {
+      if (!ostr.good())
+        return false;
+      ostr.write(magic().c_str(), magic().size());
+      boost::archive::binary_oarchive oa(ostr);
+      oa << data;
+      return ostr.good();
+    }
+
+    template <class Serializable>
+    bool save_binary(const Serializable& data, const std::string& filename)
+    {
+      std::ofstream ofs(filename.c_str(), std::ios::binary);
+      if (!ofs)
+        return false;
+      return save_binary(data, ofs);
+    }
+
+    template <class Serializable>
+    boost::shared_ptr<Serializable> load_binary(std::istream& istr)
+    {
+      if (!istr.good() || !is_binary(istr))
+        return nullptr;
+      istr.seekg(magic().size(), std::ios::cur);
+      boost::archive::binary_iarchive ia(istr);
+      boost::shared_ptr<Serializable> nh(new Serializable);
+      ia >> *nh;
+      return nh;
+    }
+
+    template <class Serializable>
+    boost::shared_ptr<Serializable> load_binary(const std::string& filename)
+    {
+      std::ifstream ifs(filename.c_str(), std::ios::binary);
+      return load_binary<Serializable>(ifs);
+    }
+  }
+}}}
+
+#endif
@@ -28,6 +28,8 @@
 
 #include <Dataflow/Serialization/Network/NetworkDescriptionSerialization.h>
 #include <Dataflow/Serialization/Network/XMLSerializer.h>
+#include <Dataflow/Serialization/Network/BinarySerializer.h>
+#include <boost/algorithm/string/predicate.hpp>
 #include <boost/filesystem/operations.hpp>
 
 using namespace SCIRun::Dataflow::Networks;
@@ -88,3 +90,19 @@ ToolkitFile SCIRun::Dataflow::Networks::makeToolkitFromDirectory(const boost::fi
   }
   return toolkit;
 }
+
+const char* const SCIRun::Dataflow::Networks::BinaryNetworkFileExtension = ".srn5b";
+
+NetworkFileHandle SCIRun::Dataflow::Networks::loadNetworkFile(const std::string& filename)
+{
+  if (BinarySerializer::is_binary(filename))
+    return BinarySerializer::load_binary<NetworkFile>(filename);
+  return XMLSerializer::load_xml<NetworkFile>(filename);
+}
+
+bool SCIRun::Dataflow::Networks::saveNetworkFile(const NetworkFile& file, const std::string& filename)
+{
+  if (boost::algorithm::ends_with(filename, BinaryNetworkFileExtension))
+    return BinarySerializer::save_binary(file, filename);
+  return XMLSerializer::save_xml(file, filename, "networkFile");
+}
@@ -188,6 +188,12 @@ namespace Networks {
 
   SCISHARE ToolkitFile makeToolkitFromDirectory(const boost::filesystem::path& toolkitPath);
 
+  /// Network files ending in this extension are saved in the binary format.
+  SCISHARE extern const char* const BinaryNetworkFileExtension;
+  /// Reads a network file saved either as XML or in the binary format.
+  SCISHARE NetworkFileHandle loadNetworkFile(const std::string& filename);
+  SCISHARE bool saveNetworkFile(const NetworkFile& file, const std::string& filename);
+
   template <class Value>
   std::map<std::string, Value> remapIdBasedContainer(const std::map<std::string, Value>& keyedByOriginalId, const std::map<std::string, std::string>& idMapping)
   {
@@ -77,22 +77,24 @@ NetworkHandle NetworkXMLConverter::from_xml_data(const NetworkXML& data)
   NetworkHandle network(boost::make_shared<Network>(moduleFactory_, stateFactory_, algoFactory_, reexFactory_));
   controller_->setNetwork(network);
 
+  // The controller announces the loaded modules and connections once everything is in place,
+  // so signals stay off while the network is built.
+  ScopedControllerSignalDisabler scsd(controller_);
+  std::map<std::string, ModuleHandle> modulesById;
+  for (const auto& modPair : data.modules)
   {
-    ScopedControllerSignalDisabler scsd(controller_);
-    for (const auto& modPair : data.modules)
+    try
     {
-      try
-      {
-        auto module = controller_->addModule(modPair.second.module);
-        module->set_id(modPair.first);
-        ModuleStateHandle state(new SimpleMapModuleState(std::move(modPair.second.state)));
-        module->set_state(state);
-      }
-      catch (Core::InvalidArgumentException& e)
-      {
-        static std::ofstream missingModulesFile((Core::Logging::Log::logDirectory() / "missingModules.log").string());
-        missingModulesFile << "File load problem: " << e.what() << std::endl;
-      }
+      auto module = controller_->addModule(modPair.second.module);
+      module->set_id(modPair.first);
+      ModuleStateHandle state(new SimpleMapModuleState(std::move(modPair.second.state)));
+      module->set_state(state);
+      modulesById[modPair.first] = module;
+    }
+    catch (Core::InvalidArgumentException& e)
+    {
+      static std::ofstream missingModulesFile((Core::Logging::Log::logDirectory() / "missingModules.log").string());
+      missingModulesFile << "File load problem: " << e.what() << std::endl;
     }
   }
 
@@ -100,11 +102,11 @@ NetworkHandle NetworkXMLConverter::from_xml_data(const NetworkXML& data)
   std::sort(connectionsSorted.begin(), connectionsSorted.end());
   for (const auto& conn : connectionsSorted)
   {
-    auto from = network->lookupModule(conn.out_.moduleId_);
-    auto to = network->lookupModule(conn.in_.moduleId_);
+    auto from = modulesById.find(conn.out_.moduleId_);
+    auto to = modulesById.find(conn.in_.moduleId_);
 
-    if (from && to)
-      controller_->requestConnection(from->getOutputPort(conn.out_.portId_).get(), to->getInputPort(conn.in_.portId_).get());
+    if (from != modulesById.end() && to != modulesById.end())
+      controller_->requestConnection(from->second->getOutputPort(conn.out_.portId_).get(), to->second->getInputPort(conn.in_.portId_).get());
     else
     {
       Core::Logging::Log::get() << Core::Logging::ERROR_LOG << "File load error: connection not created between modules " << conn.out_.moduleId_ << " and " << conn.in_.moduleId_ << std::endl;
@@ -119,25 +121,23 @@ NetworkXMLConverter::NetworkAppendInfo NetworkXMLConverter::appendXmlData(const
   auto network = controller_->getNetwork();
   NetworkAppendInfo info;
   info.newModuleStartIndex = network->nmodules();
+  ScopedControllerSignalDisabler scsd(controller_);
+  for (const auto& modPair : data.modules)
   {
-    ScopedControllerSignalDisabler scsd(controller_);
-    for (const auto& modPair : data.modules)
+    ModuleId newId(modPair.first);
+    while (network->lookupModule(newId))
     {
-      ModuleId newId(modPair.first);
-      while (network->lookupModule(newId))
-      {
-        //std::cout << "found module by ID : " << modPair.first << std::endl;
-        ++newId;
-      }
+      //std::cout << "found module by ID : " << modPair.first << std::endl;
+      ++newId;
+    }
 
-      auto module = controller_->addModule(modPair.second.module);
+    auto module = controller_->addModule(modPair.second.module);
 
-      //std::cout << "setting module id to " << newId << std::endl;
-      info.moduleIdMapping[modPair.first] = newId;
-      module->set_id(newId);
-      ModuleStateHandle state(new SimpleMapModuleState(std::move(modPair.second.state)));
-      module->set_state(state);
-    }
+    //std::cout << "setting module id to " << newId << std::endl;
+    info.moduleIdMapping[modPair.first] = newId;
+    module->set_id(newId);
+    ModuleStateHandle state(new SimpleMapModuleState(std::move(modPair.second.state)));
+    module->set_state(state);
   }
 
   auto connectionsSorted(data.connections);
@@ -29,6 +29,7 @@
 #include <Dataflow/Serialization/Network/ModuleDescriptionSerialization.h>
 #include <Dataflow/Serialization/Network/NetworkDescriptionSerialization.h>
 #include <Dataflow/Serialization/Network/NetworkXMLSerializer.h>
+#include <Dataflow/Serialization/Network/BinarySerializer.h>
 #include <Modules/Factory/HardCodedModuleFactory.h>
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
@@ -63,6 +64,8 @@ using namespace SCIRun::Dataflow::State;
 using namespace SCIRun::Core::Algorithms;
 
 #include <boost/assign.hpp>
+#include <boost/filesystem.hpp>
+#include <chrono>
 
 using namespace SCIRun::Dataflow::Networks;
 using namespace boost::assign;
@@ -347,6 +350,132 @@ TEST(SerializeNetworkTest, FullTestWithDynamicPorts)
   EXPECT_NE(net.get(), deserialized.get());
 }
 
+namespace
+{
+  std::string toXmlString(const NetworkFile& file)
+  {
+    std::ostringstream ostr;
+    XMLSerializer::save_xml(file, ostr, "networkFile");
+    return ostr.str();
+  }
+
+  NetworkFileHandle makeChainNetwork(NetworkEditorController& controller, size_t length)
+  {
+    Module::resetIdGenerator();
+    auto net = controller.getNetwork();
+    auto previous = controller.addModule("CreateMatrix");
+    for (size_t i = 0; i < length; ++i)
+    {
+      auto next = controller.addModule("EvaluateLinearAlgebraUnary");
+      next->get_state()->setValue(Variables::Operator, EvaluateLinearAlgebraUnaryAlgorithm::SCALAR_MULTIPLY);
+      next->get_state()->setValue(Variables::ScalarValue, static_cast<double>(i));
+      net->connect(ConnectionOutputPort(previous, 0), ConnectionInputPort(next, 0));
+      previous = next;
+    }
+    return controller.saveNetwork();
+  }
+}
+
+TEST(SerializeNetworkTest, BinaryRoundTripMatchesXml)
+{
+  ModuleFactoryHandle mf(new HardCodedModuleFactory);
+  ModuleStateFactoryHandle sf(new SimpleMapModuleStateFactory);
+  NetworkEditorController controller(mf, sf, nullptr, nullptr, nullptr, nullptr, nullptr);
+
+  auto file = makeChainNetwork(controller, 10);
+
+  std::stringstream binary;
+  ASSERT_TRUE(BinarySerializer::save_binary(*file, binary));
+  EXPECT_TRUE(BinarySerializer::is_binary(binary));
+
+  auto copy = BinarySerializer::load_binary<NetworkFile>(binary);
+  ASSERT_TRUE(copy != nullptr);
+  EXPECT_EQ(toXmlString(*file), toXmlString(*copy));
+
+  NetworkEditorController controller2(mf, sf, nullptr, nullptr, nullptr, nullptr, nullptr);
+  controller2.loadNetwork(copy);
+
+  auto deserialized = controller2.getNetwork();
+  EXPECT_EQ(11, deserialized->nmodules());
+  EXPECT_EQ(10, deserialized->nconnections());
+
+  auto last = deserialized->lookupModule(ModuleId("EvaluateLinearAlgebraUnary", 10));
+  ASSERT_TRUE(last != nullptr);
+  EXPECT_EQ(9.0, last->get_state()->getValue(Variables::ScalarValue).toDouble());
+}
+
+TEST(SerializeNetworkTest, XmlInputIsNotMistakenForBinary)
+{
+  std::istringstream xml("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\" ?>");
+  EXPECT_FALSE(BinarySerializer::is_binary(xml));
+  EXPECT_TRUE(BinarySerializer::load_binary<NetworkFile>(xml) == nullptr);
+}
+
+TEST(SerializeNetworkTest, NetworkFileFormatFollowsExtension)
+{
+  ModuleFactoryHandle mf(new HardCodedModuleFactory);
+  ModuleStateFactoryHandle sf(new SimpleMapModuleStateFactory);
+  NetworkEditorController controller(mf, sf, nullptr, nullptr, nullptr, nullptr, nullptr);
+
+  auto file = makeChainNetwork(controller, 5);
+
+  auto dir = boost::filesystem::temp_directory_path();
+  auto binaryName = (dir / boost::filesystem::unique_path(std::string("%%%%-%%%%-net") + BinaryNetworkFileExtension)).string();
+  auto xmlName = (dir / boost::filesystem::unique_path("%%%%-%%%%-net.srn5")).string();
+
+  ASSERT_TRUE(saveNetworkFile(*file, binaryName));
+  ASSERT_TRUE(saveNetworkFile(*file, xmlName));
+  EXPECT_TRUE(BinarySerializer::is_binary(binaryName));
+  EXPECT_FALSE(BinarySerializer::is_binary(xmlName));
+
+  auto fromBinary = loadNetworkFile(binaryName);
+  auto fromXml = loadNetworkFile(xmlName);
+  ASSERT_TRUE(fromBinary != nullptr);
+  ASSERT_TRUE(fromXml != nullptr);
+  EXPECT_EQ(toXmlString(*fromXml), toXmlString(*fromBinary));
+
+  boost::filesystem::remove(binaryName);
+  boost::filesystem::remove(xmlName);
+}
+
+TEST(SerializeNetworkTest, DISABLED_LargeNetworkLoadTiming)
+{
+  ModuleFactoryHandle mf(new HardCodedModuleFactory);
+  ModuleStateFactoryHandle sf(new SimpleMapModuleStateFactory);
+  NetworkEditorController controller(mf, sf, nullptr, nullptr, nullptr, nullptr, nullptr);
+
+  const size_t length = 2000;
+  auto file = makeChainNetwork(controller, length);
+
+  auto dir = boost::filesystem::temp_directory_path();
+  auto binaryName = (dir / boost::filesystem::unique_path(std::string("%%%%-%%%%-large") + BinaryNetworkFileExtension)).string();
+  auto xmlName = (dir / boost::filesystem::unique_path("%%%%-%%%%-large.srn5")).string();
+  ASSERT_TRUE(saveNetworkFile(*file, binaryName));
+  ASSERT_TRUE(saveNetworkFile(*file, xmlName));
+
+  for (const auto& name : { xmlName, binaryName })
+  {
+    auto start = std::chrono::steady_clock::now();
+    auto loaded = loadNetworkFile(name);
+    auto parsed = std::chrono::steady_clock::now();
+
+    NetworkEditorController controller2(mf, sf, nullptr, nullptr, nullptr, nullptr, nullptr);
+    controller2.loadNetwork(loaded);
+    auto built = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(length + 1, controller2.getNetwork()->nmodules());
+    EXPECT_EQ(length, controller2.getNetwork()->nconnections());
+
+    std::cout << boost::filesystem::path(name).extension().string()
+      << ": " << boost::filesystem::file_size(name) << " bytes, parse "
+      << std::chrono::duration_cast<std::chrono::milliseconds>(parsed - start).count() << " ms, build "
+      << std::chrono::duration_cast<std::chrono::milliseconds>(built - parsed).count() << " ms" << std::endl;
+  }
+
+  boost::filesystem::remove(binaryName);
+  boost::filesystem::remove(xmlName);
+}
+
 TEST(ToolkitSerializationTest, Experimenting)
 {
   ToolkitFile toolkit;
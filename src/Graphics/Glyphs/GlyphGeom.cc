@@ -160,25 +160,27 @@ void GlyphGeom::buildObject(GeometryHandle geom, const std::string& uniqueNodeID
   for (auto a : indices_)
     iboBuffer->write(a);
 
+  const bool writeNormals = normals_.size() == points_.size();
+  const bool writeColors = colorScheme == ColorScheme::COLOR_MAP || colorScheme == ColorScheme::COLOR_IN_SITU;
   for (size_t i = 0; i < points_.size(); i++)
   {
     // Write first point on line
-    vboBuffer->write(static_cast<float>(points_.at(i).x()));
-    vboBuffer->write(static_cast<float>(points_.at(i).y()));
-    vboBuffer->write(static_cast<float>(points_.at(i).z()));
+    vboBuffer->write(static_cast<float>(points_[i].x()));
+    vboBuffer->write(static_cast<float>(points_[i].y()));
+    vboBuffer->write(static_cast<float>(points_[i].z()));
     // Write normal
-    if (normals_.size() == points_.size())
+    if (writeNormals)
     {
-      vboBuffer->write(static_cast<float>(normals_.at(i).x()));
-      vboBuffer->write(static_cast<float>(normals_.at(i).y()));
-      vboBuffer->write(static_cast<float>(normals_.at(i).z()));
+      vboBuffer->write(static_cast<float>(normals_[i].x()));
+      vboBuffer->write(static_cast<float>(normals_[i].y()));
+      vboBuffer->write(static_cast<float>(normals_[i].z()));
     }
-    if (colorScheme == ColorScheme::COLOR_MAP || colorScheme == ColorScheme::COLOR_IN_SITU)
+    if (writeColors)
     {
-      vboBuffer->write(static_cast<float>(colors_.at(i).r()));
-      vboBuffer->write(static_cast<float>(colors_.at(i).g()));
-      vboBuffer->write(static_cast<float>(colors_.at(i).b()));
-      vboBuffer->write(static_cast<float>(colors_.at(i).a()));
+      vboBuffer->write(static_cast<float>(colors_[i].r()));
+      vboBuffer->write(static_cast<float>(colors_[i].g()));
+      vboBuffer->write(static_cast<float>(colors_[i].b()));
+      vboBuffer->write(static_cast<float>(colors_[i].a()));
       //vboBuffer->write(static_cast<float>(1.f));
     } // no color writing otherwise
   }
@@ -219,7 +221,7 @@ void GlyphGeom::addArrow(const Point& p1, const Point& p2, double radius, double
 
 void GlyphGeom::addSphere(const Point& p, double radius, double resolution, const ColorRGB& color)
 {
-  generateSphere(p, radius, radius, resolution, color, numVBOElements_, points_, normals_, indices_, colors_);
+  generateSphere(p, radius, resolution, color, numVBOElements_, points_, normals_, indices_, colors_);
 }
 
 void GlyphGeom::addEllipsoid(const Point& p, double radius1, double radius2, double resolution, const ColorRGB& color)
@@ -284,8 +286,6 @@ void GlyphGeom::generateCylinder(const Point& p1, const Point& p2, double radius
   int64_t& numVBOElements, std::vector<Vector>& points, std::vector<Vector>& normals,
   std::vector<uint32_t>& indices, std::vector<ColorRGB>& colors)
 {
-  double num_strips = resolution;
-  if (num_strips < 0) num_strips = 20.0;
   double r1 = radius1 < 0 ? 1.0 : radius1;
   double r2 = radius2 < 0 ? 1.0 : radius2;
 
@@ -294,11 +294,10 @@ void GlyphGeom::generateCylinder(const Point& p1, const Point& p2, double radius
   Vector crx = Cross(u, n).normal();
   u = Cross(crx, n).normal();
   Vector p;
-  for (double strips = 0.; strips <= num_strips; strips += 1.)
+  for (const auto& cosSin : unitCircle(resolution))
   {
     uint32_t offset = static_cast<uint32_t>(numVBOElements);
-    p = std::cos(2. * M_PI * strips / num_strips) * u +
-      std::sin(2. * M_PI * strips / num_strips) * crx;
+    p = cosSin.first * u + cosSin.second * crx;
     p.normalize();
     points.push_back(r1 * p + Vector(p1));
     colors.push_back(color1);
@@ -318,42 +317,89 @@ void GlyphGeom::generateCylinder(const Point& p1, const Point& p2, double radius
   for (int jj = 0; jj < 6; jj++) indices.pop_back();
 }
 
-void GlyphGeom::generateSphere(const Point& center, double radius1, double radius2,
-  double resolution, const ColorRGB& color, int64_t& numVBOElements, std::vector<Vector>& points, 
+void GlyphGeom::generateSphere(const Point& center, double radius,
+  double resolution, const ColorRGB& color, int64_t& numVBOElements, std::vector<Vector>& points,
   std::vector<Vector>& normals, std::vector<uint32_t>& indices, std::vector<ColorRGB>& colors)
+{
+  const auto& sphere = unitSphere(resolution);
+  double r = radius < 0 ? 1.0 : radius;
+  uint32_t offset = static_cast<uint32_t>(numVBOElements);
+
+  for (const auto& direction : sphere.directions)
+  {
+    points.push_back(r * direction + Vector(center));
+    normals.push_back(direction);
+    colors.push_back(color);
+  }
+  for (auto index : sphere.indices)
+    indices.push_back(index + offset);
+
+  numVBOElements += sphere.directions.size();
+}
+
+const GlyphGeom::UnitSphere& GlyphGeom::unitSphere(double resolution)
 {
   double num_strips = resolution;
   if (num_strips < 0) num_strips = 20.0;
-  double r1 = radius1 < 0 ? 1.0 : radius1;
-  double r2 = radius2 < 0 ? 1.0 : radius2;
-  Vector pp1, pp2;
+
+  auto cached = unitSpheres_.find(num_strips);
+  if (cached != unitSpheres_.end())
+    return cached->second;
+
   double theta_inc = 2. * M_PI / num_strips, phi_inc = M_PI / num_strips;
 
-  //generate triangles for the spheres
+  // Each band between two latitudes is a strip of quads. Neighboring bands share their
+  // boundary row of vertices, so there is one row more than there are bands.
+  std::vector<double> phis;
   for (double phi = 0.; phi <= M_PI; phi += phi_inc)
+    phis.push_back(phi);
+  std::vector<double> thetas;
+  for (double theta = 0.; theta <= 2. * M_PI; theta += theta_inc)
+    thetas.push_back(theta);
+  const size_t numBands = phis.size();
+  phis.push_back(phis.back() + phi_inc);
+
+  UnitSphere& sphere = unitSpheres_[num_strips];
+  for (double phi : phis)
   {
-    for (double theta = 0.; theta <= 2. * M_PI; theta += theta_inc)
+    for (double theta : thetas)
+      sphere.directions.push_back(Vector(sin(theta) * cos(phi), sin(theta) * sin(phi), cos(theta)));
+  }
+
+  const uint32_t rowSize = static_cast<uint32_t>(thetas.size());
+  for (uint32_t band = 0; band < numBands; ++band)
+  {
+    for (uint32_t j = 0; j + 1 < rowSize; ++j)
     {
-      uint32_t offset = static_cast<uint32_t>(numVBOElements);
-      pp1 = Vector(sin(theta) * cos(phi), sin(theta) * sin(phi), cos(theta));
-      pp2 = Vector(sin(theta) * cos(phi + phi_inc), sin(theta) * sin(phi + phi_inc), cos(theta));
-      points.push_back(r1 * pp1 + Vector(center));
-      colors.push_back(color);
-      numVBOElements++;
-      points.push_back(r2 * pp2 + Vector(center));
-      colors.push_back(color);
-      numVBOElements++;
-      normals.push_back(pp1);
-      normals.push_back(pp2);
-      indices.push_back(0 + offset);
-      indices.push_back(1 + offset);
-      indices.push_back(2 + offset);
-      indices.push_back(2 + offset);
-      indices.push_back(1 + offset);
-      indices.push_back(3 + offset);
+      uint32_t top = band * rowSize + j;
+      uint32_t bottom = top + rowSize;
+      sphere.indices.push_back(top);
+      sphere.indices.push_back(bottom);
+      sphere.indices.push_back(top + 1);
+      sphere.indices.push_back(top + 1);
+      sphere.indices.push_back(bottom);
+      sphere.indices.push_back(bottom + 1);
     }
-    for (int jj = 0; jj < 6; jj++) indices.pop_back();
   }
+  return sphere;
+}
+
+const GlyphGeom::UnitCircle& GlyphGeom::unitCircle(double resolution)
+{
+  double num_strips = resolution;
+  if (num_strips < 0) num_strips = 20.0;
+
+  auto cached = unitCircles_.find(num_strips);
+  if (cached != unitCircles_.end())
+    return cached->second;
+
+  UnitCircle& circle = unitCircles_[num_strips];
+  for (double strips = 0.; strips <= num_strips; strips += 1.)
+  {
+    circle.push_back(std::make_pair(std::cos(2. * M_PI * strips / num_strips),
+      std::sin(2. * M_PI * strips / num_strips)));
+  }
+  return circle;
 }
 
 void GlyphGeom::generateEllipsoid(const Point& center, double radius1, double radius2,
@@ -35,6 +35,8 @@ DEALINGS IN THE SOFTWARE.
 #include <Graphics/Datatypes/GeometryImpl.h>
 #include <Core/Datatypes/Color.h>
 
+#include <map>
+
 #include <Graphics/Glyphs/share.h>
 
 namespace SCIRun {
@@ -82,6 +84,20 @@ namespace SCIRun {
       void addSphere(const Core::Geometry::Point& center, double radius, int nu=20, int nv=20, int half=0);      
       
     private:
+      /// Glyph shapes at unit size, tessellated once per resolution. Every glyph of that
+      /// resolution is a scaled and translated copy, so no trigonometry is done per glyph.
+      struct UnitSphere
+      {
+        std::vector<Core::Geometry::Vector> directions;
+        std::vector<uint32_t> indices;
+      };
+      typedef std::vector<std::pair<double, double>> UnitCircle;
+
+      const UnitSphere& unitSphere(double resolution);
+      const UnitCircle& unitCircle(double resolution);
+
+      std::map<double, UnitSphere> unitSpheres_;
+      std::map<double, UnitCircle> unitCircles_;
       std::vector<SinCosTable> tables_;
       std::vector<Core::Geometry::Vector> points_;
       std::vector<Core::Geometry::Vector> normals_;
@@ -94,7 +110,7 @@ namespace SCIRun {
         int64_t& numVBOElements, std::vector<Core::Geometry::Vector>& points, std::vector<Core::Geometry::Vector>& normals, std::vector<uint32_t>& indices, std::vector<Core::Datatypes::ColorRGB>& colors);
       void generateEllipsoid(const Core::Geometry::Point& center, double radius1, double radius2, double resolution, const Core::Datatypes::ColorRGB& color,
         int64_t& numVBOElements, std::vector<Core::Geometry::Vector>& points, std::vector<Core::Geometry::Vector>& normals, std::vector<uint32_t>& indices, std::vector<Core::Datatypes::ColorRGB>& colors);
-      void generateSphere(const Core::Geometry::Point& center, double radius1, double radius2, double resolution, const Core::Datatypes::ColorRGB& color,
+      void generateSphere(const Core::Geometry::Point& center, double radius, double resolution, const Core::Datatypes::ColorRGB& color,
         int64_t& numVBOElements, std::vector<Core::Geometry::Vector>& points, std::vector<Core::Geometry::Vector>& normals, std::vector<uint32_t>& indices, std::vector<Core::Datatypes::ColorRGB>& colors);
       void generateLine(const Core::Geometry::Point& p1, const Core::Geometry::Point& p2, const Core::Datatypes::ColorRGB& color1, const Core::Datatypes::ColorRGB& color2,
         int64_t& numVBOElements, std::vector<Core::Geometry::Vector>& points, std::vector<uint32_t>& indices, std::vector<Core::Datatypes::ColorRGB>& colors);
@@ -265,7 +265,7 @@ FileOpenCommand::FileOpenCommand()
 
 NetworkFileHandle FileOpenCommand::processXmlFile(const std::string& filename)
 {
-  return XMLSerializer::load_xml<NetworkFile>(filename);
+  return loadNetworkFile(filename);
 }
 
 NetworkFileHandle FileImportCommand::processXmlFile(const std::string& filename)
@@ -713,7 +713,7 @@ void NetworkEditor::dropEvent(QDropEvent* event)
     {
       auto file = urls[0].toLocalFile();
       QFileInfo check_file(file);
-      if (check_file.exists() && check_file.isFile() && file.endsWith("srn5"))
+      if (check_file.exists() && check_file.isFile() && (file.endsWith("srn5") || file.endsWith("srn5b")))
       {
         Q_EMIT requestLoadNetwork(file);
         return;
@@ -33,6 +33,9 @@
 #include <Interface/Modules/DataIO/WriteMatrixDialog.h>
 #include <Interface/Modules/DataIO/ReadFieldDialog.h>
 #include <Interface/Modules/DataIO/ReadNrrdDialog.h>
+#if HAVE_HDF5
+#include <Interface/Modules/DataIO/ReadHDF5FileDialog.h>
+#endif
 #include <Interface/Modules/DataIO/WriteFieldDialog.h>
 #include <Interface/Modules/Math/EvaluateLinearAlgebraUnaryDialog.h>
 #include <Interface/Modules/Math/EvaluateLinearAlgebraBinaryDialog.h>
@@ -77,6 +80,7 @@
 #include <Interface/Modules/Fields/CalculateDistanceToFieldBoundaryDialog.h>
 #include <Interface/Modules/Fields/MapFieldDataOntoElemsDialog.h>
 #include <Interface/Modules/Fields/MapFieldDataOntoNodesDialog.h>
+#include <Interface/Modules/Fields/MapFieldDataOntoNodesRadialbasisDialog.h>
 #include <Interface/Modules/Fields/MapFieldDataFromSourceToDestinationDialog.h>
 #include <Interface/Modules/Fields/ClipFieldByFunctionDialog.h>
 #include <Interface/Modules/Fields/BuildMappingMatrixDialog.h>
@@ -130,6 +134,9 @@ void ModuleDialogFactory::addDialogsToMakerMap1()
     ADD_MODULE_DIALOG(ReadMatrix, ReadMatrixClassicDialog)
     ADD_MODULE_DIALOG(WriteMatrix, WriteMatrixDialog)
     ADD_MODULE_DIALOG(ReadField, ReadFieldDialog)
+#if HAVE_HDF5
+    ADD_MODULE_DIALOG(ReadHDF5File, ReadHDF5FileDialog)
+#endif
     ADD_MODULE_DIALOG(WriteField, WriteFieldDialog)
     ADD_MODULE_DIALOG(ReadBundle, ReadBundleDialog)
     ADD_MODULE_DIALOG(EvaluateLinearAlgebraUnary, EvaluateLinearAlgebraUnaryDialog)
@@ -174,6 +181,7 @@ void ModuleDialogFactory::addDialogsToMakerMap1()
 #endif
     ADD_MODULE_DIALOG(MapFieldDataOntoElements, MapFieldDataOntoElemsDialog)
     ADD_MODULE_DIALOG(MapFieldDataOntoNodes, MapFieldDataOntoNodesDialog)
+    ADD_MODULE_DIALOG(MapFieldDataOntoNodesRadialbasis, MapFieldDataOntoNodesRadialbasisDialog)
     ADD_MODULE_DIALOG(MapFieldDataFromSourceToDestination, MapFieldDataFromSourceToDestinationDialog)
     ADD_MODULE_DIALOG(SplitFieldByConnectedRegion, SplitFieldByConnectedRegionDialog)
     ADD_MODULE_DIALOG(ClipFieldByFunction, ClipFieldByFunctionDialog)
@@ -44,5 +44,6 @@ CalculateDistanceToFieldDialog::CalculateDistanceToFieldDialog(const std::string
   addCheckBoxManager(truncateDistanceCheckBox_, Parameters::Truncate);
   addDoubleSpinBoxManager(truncateDoubleSpinBox_, Parameters::TruncateDistance);
   addComboBoxManager(basisTypeComboBox_, Parameters::BasisType);
+  addCheckBoxManager(distanceTransformCheckBox_, Parameters::UseDistanceTransform);
   addComboBoxManager(dataTypeComboBox_, Parameters::OutputFieldDatatype);
 }
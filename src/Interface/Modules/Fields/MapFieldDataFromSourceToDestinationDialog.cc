@@ -63,6 +63,7 @@ MapFieldDataFromSourceToDestinationDialog::MapFieldDataFromSourceToDestinationDi
   addComboBoxManager(methodComboBox_, Parameters::MappingMethod, impl_->mappingNameLookup_);
   addDoubleSpinBoxManager(maxDistanceSpinBox_, Parameters::MaxDistance);
   addDoubleSpinBoxManager(defaultValueDoubleSpinBox_, Parameters::DefaultValue);
+  addCheckBoxManager(reuseMappingMatrixCheckBox_, Parameters::ReuseMappingMatrix);
   connect(noMaxCheckBox_, SIGNAL(stateChanged(int)), this, SLOT(setNoMaximumValue(int)));
   connect(useNanForUnassignedValuesCheckBox_, SIGNAL(stateChanged(int)), this, SLOT(setUseNanForUnassignedValues(int)));
 }
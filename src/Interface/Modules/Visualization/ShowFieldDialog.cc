@@ -65,6 +65,7 @@ ShowFieldDialog::ShowFieldDialog(const std::string& name, ModuleStateHandle stat
   addCheckBoxManager(textAlwaysVisibleCheckBox_, ShowField::TextAlwaysVisible);
   addCheckBoxManager(renderIndicesLocationsCheckBox_, ShowField::RenderAsLocation);
   addCheckBoxManager(useFaceNormalsCheckBox_, ShowField::UseFaceNormals);
+  addCheckBoxManager(showInteriorFacesCheckBox_, ShowField::ShowInteriorFaces);
   addDoubleSpinBoxManager(transparencyDoubleSpinBox_, ShowField::FaceTransparencyValue);
   addDoubleSpinBoxManager(nodeTransparencyDoubleSpinBox_, ShowField::NodeTransparencyValue);
   addDoubleSpinBoxManager(edgeTransparencyDoubleSpinBox_, ShowField::EdgeTransparencyValue);
@@ -74,6 +75,7 @@ ShowFieldDialog::ShowFieldDialog(const std::string& name, ModuleStateHandle stat
   addSpinBoxManager(sphereResolutionSpinBox, ShowField::SphereResolution);
   addSpinBoxManager(textSizeSpinBox_, ShowField::TextSize);
   addSpinBoxManager(textPrecisionSpinBox_, ShowField::TextPrecision);
+  addSpinBoxManager(faceTriangleBudgetSpinBox_, ShowField::FaceTriangleBudget);
   addRadioButtonGroupManager({ edgesAsLinesButton_, edgesAsCylindersButton_ }, ShowField::EdgesAsCylinders);
   addRadioButtonGroupManager({ nodesAsPointsButton_, nodesAsSpheresButton_ }, ShowField::NodeAsSpheres);
   addRadioButtonGroupManager({ defaultNodeColoringButton_, colormapLookupNodeColoringButton_/*, conversionRGBNodeColoringButton_*/ }, ShowField::NodesColoring);
@@ -93,6 +95,7 @@ ShowFieldDialog::ShowFieldDialog(const std::string& name, ModuleStateHandle stat
     defaultMeshColorButton_, textColorPushButton_ });
 
   connectButtonToExecuteSignal(useFaceNormalsCheckBox_);
+  connectButtonToExecuteSignal(showInteriorFacesCheckBox_);
 
   createExecuteInteractivelyToggleAction();
   
@@ -53,6 +53,7 @@ SimulateForwardMagneticField::SimulateForwardMagneticField() : Module(staticInfo
 
 void SimulateForwardMagneticField::setStateDefaults()
 {
+  setStateDoubleFromAlgo(Parameters::TreecodeOpeningAngle);
 }
 
 void SimulateForwardMagneticField::execute()
@@ -64,7 +65,8 @@ void SimulateForwardMagneticField::execute()
 
   if (needToExecute())
   {
-     auto output = algo().run(make_input((ElectricField, EField)(ConductivityTensor, CondTensor)(DipoleSources, Dipoles)(DetectorLocations, Detectors)));
+    setAlgoDoubleFromState(Parameters::TreecodeOpeningAngle);
+    auto output = algo().run(make_input((ElectricField, EField)(ConductivityTensor, CondTensor)(DipoleSources, Dipoles)(DetectorLocations, Detectors)));
     sendOutputFromAlgorithm(MagneticField, output);
     sendOutputFromAlgorithm(MagneticFieldMagnitudes, output);
   }
@@ -38,7 +38,9 @@
 #ifndef MODULES_DATAIO_GENERIC_READER_H
 #define MODULES_DATAIO_GENERIC_READER_H
 
+#include <future>
 #include <boost/filesystem.hpp>
+#include <boost/function.hpp>
 #include <Core/Datatypes/String.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
 #include <Core/Thread/Mutex.h>
@@ -57,8 +59,9 @@ class GenericReader : public SCIRun::Dataflow::Networks::Module,
 public:
   GenericReader(const std::string &name, const std::string &category, const std::string &package, const std::string& stateFilename);
 
-  virtual void setStateDefaults() override final;
+  virtual void setStateDefaults() override;
   virtual void execute() override;
+  virtual size_t prefetchOutputs(size_t memoryBudget) override;
   INPUT_PORT(0, Filename, String);
   //OUTPUT_PORT(0, Object, PortType);
   OUTPUT_PORT(1, FileLoaded, String);
@@ -75,8 +78,21 @@ protected:
   virtual bool useCustomImporter(const std::string& filename) const = 0;
   virtual bool call_importer(const std::string &filename, HType & handle) { return false; }
 
+  typedef boost::function<HType()> Loader;
+  /// Returns a function that reads the file without referring back to this module, so that
+  /// it can run on a background thread. An empty function means the file cannot be prefetched.
+  virtual Loader makeLoader(const std::string& filename) const;
+  /// Returns a handle that only reads the file once its contents are used, or a null handle
+  /// if the file has to be read right away.
+  virtual HType makeDeferredHandle(const std::string& filename) const { return HType(); }
+
   static Core::Thread::Mutex fileCheckMutex_;
   static bool file_exists(const std::string & filename);
+
+private:
+  std::future<HType> prefetched_;
+  std::string prefetchedFilename_;
+  time_t prefetchedModification_;
 };
 
 
@@ -87,7 +103,8 @@ GenericReader<HType, PortTag>::GenericReader(const std::string &name,
     //gui_filename_(get_ctx()->subVar("filename"), ""),
     //gui_from_env_(get_ctx()->subVar("from-env"),""),
     objectPortName_(SCIRun::Dataflow::Networks::PortId(0, objectPortName)),
-    old_filemodification_(0)
+    old_filemodification_(0),
+    prefetchedModification_(0)
 {
   INITIALIZE_PORT(Filename);
   INITIALIZE_PORT(FileLoaded);
@@ -114,6 +131,57 @@ bool
   return boost::filesystem::exists(filename);
 }
 
+template <class HType, class PortTag>
+typename GenericReader<HType, PortTag>::Loader
+GenericReader<HType, PortTag>::makeLoader(const std::string& filename) const
+{
+  if (useCustomImporter(filename))
+    return Loader();
+
+  auto log = getLogger();
+  return [filename, log]()
+  {
+    HType handle;
+    auto stream = auto_istream(filename, log);
+    if (stream)
+    {
+      Pio(*stream, handle);
+      if (stream->error())
+        handle.reset();
+    }
+    return handle;
+  };
+}
+
+template <class HType, class PortTag>
+size_t
+GenericReader<HType, PortTag>::prefetchOutputs(size_t memoryBudget)
+{
+  auto state = get_state();
+  // Filenames taken from the environment or an upstream module are only known at execution time.
+  if (!state->getValue(Core::Algorithms::Variables::ScriptEnvironmentVariable).toString().empty()
+    || getInputPort(Filename)->nconnections() > 0)
+    return 0;
+
+  auto filename = state->getValue(Core::Algorithms::Variables::Filename).toFilename().string();
+  if (filename.empty() || !file_exists(filename))
+    return 0;
+
+  // The size on disk is a reasonable estimate of the loaded size for SCIRun and most importer formats.
+  auto size = static_cast<size_t>(boost::filesystem::file_size(filename));
+  if (size > memoryBudget)
+    return 0;
+
+  auto loader = makeLoader(filename);
+  if (!loader)
+    return 0;
+
+  prefetchedFilename_ = filename;
+  prefetchedModification_ = boost::filesystem::last_write_time(filename);
+  prefetched_ = std::async(std::launch::async, loader);
+  return size;
+}
+
 template <class HType, class PortTag>
 void
 GenericReader<HType, PortTag>::execute()
@@ -181,29 +249,55 @@ GenericReader<HType, PortTag>::execute()
 
     HType handle;
 
-    remark("loading file " +filename_);
-
-    if (useCustomImporter(filename_))
+    if (prefetched_.valid())
     {
-      if (!call_importer(filename_, handle))
+      // Always drain the prefetch so its memory is released, but only use it if the file is unchanged.
+      try
       {
-        MODULE_ERROR_WITH_TYPE(Dataflow::Networks::GeneralModuleError, "Import failed.");
+        handle = prefetched_.get();
       }
+      catch (...)
+      {
+        // Read again below, which reports the error.
+      }
+      if (prefetchedFilename_ != filename_ || prefetchedModification_ != new_filemodification)
+        handle.reset();
+    }
+
+    if (handle)
+    {
+      remark("using prefetched file " + filename_);
     }
     else
     {
-      auto stream = auto_istream(filename_, getLogger());
-      if (!stream)
+      remark("loading file " +filename_);
+
+      if (useCustomImporter(filename_))
       {
-        MODULE_ERROR_WITH_TYPE(Dataflow::Networks::GeneralModuleError, "Error reading file '" + filename_ + "'.");
+        if (!call_importer(filename_, handle))
+        {
+          MODULE_ERROR_WITH_TYPE(Dataflow::Networks::GeneralModuleError, "Import failed.");
+        }
       }
-
-      // Read the file
-      Pio(*stream, handle);
-
-      if (!handle || stream->error())
+      else
       {
-        MODULE_ERROR_WITH_TYPE(Dataflow::Networks::GeneralModuleError, "Error reading data from file '" + filename_ + "'.");
+        handle = makeDeferredHandle(filename_);
+        if (!handle)
+        {
+          auto stream = auto_istream(filename_, getLogger());
+          if (!stream)
+          {
+            MODULE_ERROR_WITH_TYPE(Dataflow::Networks::GeneralModuleError, "Error reading file '" + filename_ + "'.");
+          }
+
+          // Read the file
+          Pio(*stream, handle);
+
+          if (!handle || stream->error())
+          {
+            MODULE_ERROR_WITH_TYPE(Dataflow::Networks::GeneralModuleError, "Error reading data from file '" + filename_ + "'.");
+          }
+        }
       }
     }
 
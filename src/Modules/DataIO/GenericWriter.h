@@ -169,6 +169,10 @@ GenericWriter<HType, PortTag>::execute()
       {
         stream = auto_ostream(filename_, "Binary", getLogger());
       }
+      else if (filetype_ == "Chunked")
+      {
+        stream = auto_ostream(filename_, "Chunked", getLogger());
+      }
       else
       {
         stream = auto_ostream(filename_, "Text", getLogger());
@@ -39,6 +39,7 @@
 ///
 
 #include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/LazyField.h>
 #include <Modules/DataIO/ReadField.h>
 #include <Core/ImportExport/Field/FieldIEPlugin.h>
 #include <Core/Algorithms/Base/AlgorithmVariableNames.h>
@@ -64,6 +65,12 @@ ReadField::ReadField()
   INITIALIZE_PORT(Field);
 }
 
+void ReadField::setStateDefaults()
+{
+  my_base::setStateDefaults();
+  get_state()->setValue(DeferReading, false);
+}
+
 std::string ReadField::fileTypeList()
 {
   FieldIEPluginManager mgr;
@@ -78,17 +85,40 @@ std::string ReadField::defaultFileTypeName() const
 
 bool ReadField::call_importer(const std::string& filename, FieldHandle& fHandle)
 {
-  ///@todo: how will this work via python? need more code to set the filetype based on the extension...
-  FieldIEPluginManager mgr;
-  auto pl = mgr.get_plugin(get_state()->getValue(Variables::FileTypeName).toString());
-  if (pl)
+  auto loader = makeLoader(filename);
+  if (loader)
   {
-    fHandle = pl->readFile(filename, getLogger());
+    fHandle = loader();
     return fHandle != nullptr;
   }
   return false;
 }
 
+ReadField::Loader ReadField::makeLoader(const std::string& filename) const
+{
+  if (!useCustomImporter(filename))
+    return my_base::makeLoader(filename);
+
+  ///@todo: how will this work via python? need more code to set the filetype based on the extension...
+  FieldIEPluginManager mgr;
+  auto pl = mgr.get_plugin(cstate()->getValue(Variables::FileTypeName).toString());
+  if (!pl)
+    return Loader();
+
+  // Plugins are registered for the lifetime of the application.
+  auto log = getLogger();
+  return [pl, filename, log]() { return pl->readFile(filename, log); };
+}
+
+FieldHandle ReadField::makeDeferredHandle(const std::string& filename) const
+{
+  if (!cstate()->getValue(DeferReading).toBool())
+    return FieldHandle();
+  // Only the field type is read here, so that modules looking at the type alone, or
+  // networks whose downstream branch is disabled, do not pay for reading the mesh and data.
+  return CreateLazyField(filename, getLogger());
+}
+
 void
 ReadField::execute()
 {
@@ -102,3 +132,5 @@ bool ReadField::useCustomImporter(const std::string& filename) const
 {
   return boost::filesystem::extension(filename) != ".fld";
 }
+
+const AlgorithmParameterName ReadField::DeferReading("DeferReading");
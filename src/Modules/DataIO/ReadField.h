@@ -45,13 +45,18 @@ namespace DataIO {
   public:
     typedef GenericReader<FieldHandle, FieldPortTag> my_base;
     ReadField();
+    virtual void setStateDefaults() override;
     virtual void execute() override;
     virtual bool useCustomImporter(const std::string& filename) const override;
     virtual bool call_importer(const std::string& filename, FieldHandle& handle) override;
+    virtual Loader makeLoader(const std::string& filename) const override;
+    virtual FieldHandle makeDeferredHandle(const std::string& filename) const override;
 
     OUTPUT_PORT(0, Field, Field);
 
     static std::string fileTypeList();
+    /// When set, .fld files are only read once the mesh or data is used downstream.
+    static const Core::Algorithms::AlgorithmParameterName DeferReading;
 
     MODULE_TRAITS_AND_INFO(ModuleHasUI)
   protected:
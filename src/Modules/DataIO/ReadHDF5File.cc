@@ -0,0 +1,95 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Modules/DataIO/ReadHDF5File.h>
+#include <Core/Algorithms/DataIO/ReadHDF5Dataset.h>
+#include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <Core/Datatypes/Legacy/Nrrd/NrrdData.h>
+#include <boost/lexical_cast.hpp>
+
+using namespace SCIRun;
+using namespace SCIRun::Modules::DataIO;
+using namespace SCIRun::Dataflow::Networks;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::DataIO;
+
+MODULE_INFO_DEF(ReadHDF5File, DataIO, SCIRun)
+
+const AlgorithmParameterName ReadHDF5File::DatasetName("DatasetName");
+const AlgorithmParameterName ReadHDF5File::FirstSlice("FirstSlice");
+const AlgorithmParameterName ReadHDF5File::NumSlices("NumSlices");
+
+ReadHDF5File::ReadHDF5File() : Module(staticInfo_)
+{
+  INITIALIZE_PORT(Output_Data);
+}
+
+void ReadHDF5File::setStateDefaults()
+{
+  auto state = get_state();
+  state->setValue(Variables::Filename, std::string());
+  state->setValue(DatasetName, std::string());
+  state->setValue(FirstSlice, 0);
+  // Zero reads all slices from the first one on.
+  state->setValue(NumSlices, 0);
+}
+
+void ReadHDF5File::execute()
+{
+  if (needToExecute())
+  {
+    auto state = get_state();
+    const auto filename = state->getValue(Variables::Filename).toFilename().string();
+    const auto dataset = state->getValue(DatasetName).toString();
+    if (filename.empty() || dataset.empty())
+    {
+      error("Please specify an HDF5 file and a dataset.");
+      return;
+    }
+
+    ReadHDF5DatasetAlgo reader;
+    if (!reader.open(filename, dataset))
+    {
+      error("Can not read the numeric dataset '" + dataset + "' from file '" + filename + "'.");
+      return;
+    }
+
+    const int first = state->getValue(FirstSlice).toInt();
+    const int count = state->getValue(NumSlices).toInt();
+    const size_t numSlices = reader.numSlices();
+    if (first < 0 || static_cast<size_t>(first) >= numSlices || count < 0
+      || static_cast<size_t>(first) + count > numSlices)
+    {
+      error("The dataset has " + boost::lexical_cast<std::string>(numSlices) + " slices, the selected range is not inside.");
+      return;
+    }
+
+    auto nrrd = reader.readNrrd(first, count > 0 ? count : numSlices - first);
+    sendOutput(Output_Data, nrrd);
+  }
+}
@@ -0,0 +1,62 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   License for the specific language governing rights and limitations under
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MODULES_DATAIO_READ_HDF5_FILE_H
+#define MODULES_DATAIO_READ_HDF5_FILE_H
+
+#include <Dataflow/Network/Module.h>
+#include <Modules/DataIO/share.h>
+
+namespace SCIRun {
+namespace Modules {
+namespace DataIO {
+
+  /// Reads one numeric dataset of an HDF5 file into a nrrd of doubles. A
+  /// range of slices along the first dataset dimension, e.g. time steps,
+  /// can be selected; the dataset is read in chunk-aligned blocks.
+  class SCISHARE ReadHDF5File : public Dataflow::Networks::Module,
+    public HasNoInputPorts,
+    public Has1OutputPort<NrrdPortTag>
+  {
+  public:
+    ReadHDF5File();
+    virtual void execute() override;
+    virtual void setStateDefaults() override;
+
+    OUTPUT_PORT(0, Output_Data, NrrdDataType);
+
+    static const Core::Algorithms::AlgorithmParameterName DatasetName;
+    static const Core::Algorithms::AlgorithmParameterName FirstSlice;
+    static const Core::Algorithms::AlgorithmParameterName NumSlices;
+
+    MODULE_TRAITS_AND_INFO(ModuleHasUI)
+  };
+
+}}}
+
+#endif
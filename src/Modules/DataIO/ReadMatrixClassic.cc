@@ -61,17 +61,31 @@ std::string ReadMatrix::fileTypeList()
 
 bool ReadMatrix::call_importer(const std::string& filename, MatrixHandle& fHandle)
 {
-  ///@todo: how will this work via python? need more code to set the filetype based on the extension...
-  MatrixIEPluginManager mgr;
-  auto pl = mgr.get_plugin(get_state()->getValue(Variables::FileTypeName).toString());
-  if (pl)
+  auto loader = makeLoader(filename);
+  if (loader)
   {
-    fHandle = pl->readFile(filename, getLogger());
+    fHandle = loader();
     return fHandle != nullptr;
   }
   return false;
 }
 
+ReadMatrix::Loader ReadMatrix::makeLoader(const std::string& filename) const
+{
+  if (!useCustomImporter(filename))
+    return my_base::makeLoader(filename);
+
+  ///@todo: how will this work via python? need more code to set the filetype based on the extension...
+  MatrixIEPluginManager mgr;
+  auto pl = mgr.get_plugin(cstate()->getValue(Variables::FileTypeName).toString());
+  if (!pl)
+    return Loader();
+
+  // Plugins are registered for the lifetime of the application.
+  auto log = getLogger();
+  return [pl, filename, log]() { return pl->readFile(filename, log); };
+}
+
 void
 ReadMatrix::execute()
 {
@@ -46,6 +46,7 @@ namespace DataIO {
     virtual void execute() override;
     virtual bool useCustomImporter(const std::string& filename) const override;
     virtual bool call_importer(const std::string& filename, Core::Datatypes::MatrixHandle& handle) override;
+    virtual Loader makeLoader(const std::string& filename) const override;
 
     OUTPUT_PORT(0, Matrix, Matrix);
 
@@ -0,0 +1,128 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   License for the specific language governing rights and limitations under
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Dataflow/Network/ModuleInterface.h>
+#include <Dataflow/Network/ModuleStateInterface.h>
+#include <Testing/ModuleTestBase/ModuleTestBase.h>
+#include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <Core/Datatypes/Legacy/Nrrd/NrrdData.h>
+#include <Modules/DataIO/ReadHDF5File.h>
+#include <boost/filesystem.hpp>
+#include <hdf5.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Testing;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Modules::DataIO;
+using namespace SCIRun::Dataflow::Networks;
+
+class ReadHDF5FileModuleTests : public ModuleTest
+{
+};
+
+namespace
+{
+  const hsize_t STEPS = 6;
+  const hsize_t ROWS = 2;
+  const hsize_t COLS = 3;
+
+  /// A time series of floats in chunks of two time steps, value 100 * step + index.
+  boost::filesystem::path writeFile()
+  {
+    auto dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("hdf5-%%%%-%%%%");
+    boost::filesystem::create_directories(dir);
+    auto filename = dir / "series.h5";
+
+    std::vector<float> values;
+    for (size_t i = 0; i < STEPS * ROWS * COLS; ++i)
+      values.push_back(static_cast<float>(100 * (i / (ROWS * COLS)) + i % (ROWS * COLS)));
+
+    const hsize_t dims[] = { STEPS, ROWS, COLS };
+    const hsize_t chunk[] = { 2, ROWS, COLS };
+    hid_t file = H5Fcreate(filename.string().c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    hid_t space = H5Screate_simple(3, dims, nullptr);
+    hid_t plist = H5Pcreate(H5P_DATASET_CREATE);
+    H5Pset_chunk(plist, 3, chunk);
+    hid_t dataset = H5Dcreate2(file, "/potential", H5T_IEEE_F32LE, space, H5P_DEFAULT, plist, H5P_DEFAULT);
+    H5Dwrite(dataset, H5T_NATIVE_FLOAT, H5S_ALL, H5S_ALL, H5P_DEFAULT, &values[0]);
+    H5Dclose(dataset);
+    H5Pclose(plist);
+    H5Sclose(space);
+    H5Fclose(file);
+    return filename;
+  }
+}
+
+TEST_F(ReadHDF5FileModuleTests, OutputsSelectedSlicesAsNrrd)
+{
+  UseRealModuleStateFactory f;
+  auto filename = writeFile();
+
+  auto read = makeModule("ReadHDF5File");
+  read->get_state()->setValue(Variables::Filename, filename.string());
+  read->get_state()->setValue(ReadHDF5File::DatasetName, std::string("/potential"));
+  read->get_state()->setValue(ReadHDF5File::FirstSlice, 1);
+  read->get_state()->setValue(ReadHDF5File::NumSlices, 3);
+  read->execute();
+
+  auto output = boost::dynamic_pointer_cast<NrrdData>(getDataOnThisOutputPort(read, 0));
+  ASSERT_TRUE(output != nullptr);
+  const Nrrd* nrrd = output->getNrrd();
+  ASSERT_EQ(3u, nrrd->dim);
+  EXPECT_EQ(COLS, nrrd->axis[0].size);
+  EXPECT_EQ(ROWS, nrrd->axis[1].size);
+  EXPECT_EQ(3u, nrrd->axis[2].size);
+  ASSERT_EQ(nrrdTypeDouble, nrrd->type);
+
+  const double* values = static_cast<const double*>(nrrd->data);
+  for (size_t step = 0; step < 3; ++step)
+    for (size_t i = 0; i < ROWS * COLS; ++i)
+      EXPECT_EQ(100.0 * (step + 1) + i, values[step * ROWS * COLS + i]);
+
+  boost::filesystem::remove_all(filename.parent_path());
+}
+
+TEST_F(ReadHDF5FileModuleTests, ReadsAllSlicesByDefault)
+{
+  UseRealModuleStateFactory f;
+  auto filename = writeFile();
+
+  auto read = makeModule("ReadHDF5File");
+  read->get_state()->setValue(Variables::Filename, filename.string());
+  read->get_state()->setValue(ReadHDF5File::DatasetName, std::string("/potential"));
+  read->execute();
+
+  auto output = boost::dynamic_pointer_cast<NrrdData>(getDataOnThisOutputPort(read, 0));
+  ASSERT_TRUE(output != nullptr);
+  EXPECT_EQ(STEPS, output->getNrrd()->axis[2].size);
+  const double* values = static_cast<const double*>(output->getNrrd()->data);
+  EXPECT_EQ(100.0 * (STEPS - 1) + ROWS * COLS - 1, values[STEPS * ROWS * COLS - 1]);
+
+  boost::filesystem::remove_all(filename.parent_path());
+}
@@ -30,10 +30,19 @@
 #include <gmock/gmock.h>
 #include <Dataflow/Network/Network.h>
 #include <Dataflow/Network/ModuleInterface.h>
+#include <Dataflow/Network/ModuleStateInterface.h>
 #include <Dataflow/Network/ConnectionId.h>
 #include <Dataflow/Network/Tests/MockNetwork.h>
+#include <Testing/ModuleTestBase/ModuleTestBase.h>
+#include <Core/Datatypes/DenseMatrix.h>
+#include <Core/Datatypes/MatrixIO.h>
+#include <Core/Algorithms/Base/AlgorithmVariableNames.h>
+#include <boost/filesystem.hpp>
 
 using namespace SCIRun;
+using namespace SCIRun::Testing;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Core::Algorithms;
 using namespace SCIRun::Dataflow::Networks;
 using namespace SCIRun::Dataflow::Networks::Mocks;
 using ::testing::_;
@@ -41,4 +50,31 @@ using ::testing::NiceMock;
 using ::testing::DefaultValue;
 using ::testing::Return;
 
-/// @todo
+class ReadMatrixModuleTests : public ModuleTest
+{
+};
+
+TEST_F(ReadMatrixModuleTests, ExecuteUsesMatrixPrefetchedOnLoad)
+{
+  UseRealModuleStateFactory f;
+  auto filename = boost::filesystem::temp_directory_path() / "prefetchedMatrix.mat";
+  MatrixHandle written(new DenseMatrix(DenseMatrix::Identity(3, 3)));
+  {
+    auto stream = auto_ostream(filename.string(), "Binary");
+    Pio(*stream, written);
+  }
+
+  auto read = makeModule("ReadMatrix");
+  read->get_state()->setValue(Variables::Filename, filename.string());
+  read->get_state()->setValue(Variables::FileTypeName, std::string("SCIRun Matrix File"));
+
+  EXPECT_EQ(0u, read->prefetchOutputs(10));
+  EXPECT_EQ(boost::filesystem::file_size(filename), read->prefetchOutputs(1 << 20));
+
+  read->execute();
+  auto output = boost::dynamic_pointer_cast<DenseMatrix>(getDataOnThisOutputPort(read, 0));
+  ASSERT_TRUE(output != nullptr);
+  EXPECT_EQ(DenseMatrix(DenseMatrix::Identity(3, 3)), *output);
+
+  boost::filesystem::remove(filename);
+}
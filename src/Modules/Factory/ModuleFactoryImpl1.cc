@@ -62,6 +62,7 @@ DEALINGS IN THE SOFTWARE.
 #include <Modules/Legacy/Fields/CalculateDistanceToFieldBoundary.h>
 #include <Modules/Legacy/Fields/MapFieldDataOntoElems.h>
 #include <Modules/Legacy/Fields/MapFieldDataOntoNodes.h>
+#include <Modules/Legacy/Fields/MapFieldDataOntoNodesRadialbasis.h>
 #include <Modules/Legacy/Fields/ClipFieldByFunction3.h>
 #include <Modules/Legacy/Fields/MapFieldDataFromSourceToDestination.h>
 #include <Modules/Legacy/Fields/RefineMesh.h>
@@ -87,6 +88,9 @@ DEALINGS IN THE SOFTWARE.
 #include <Modules/DataIO/WriteMatrix.h>
 #include <Modules/DataIO/ReadField.h>
 #include <Modules/DataIO/WriteField.h>
+#ifdef HAVE_HDF5
+#include <Modules/DataIO/ReadHDF5File.h>
+#endif
 #include <Modules/String/CreateString.h>
 #include <Modules/String/NetworkNotes.h>
 #include <Modules/Visualization/ShowField.h>
@@ -122,6 +126,9 @@ void ModuleDescriptionLookup::addEssentialModules()
   addModuleDesc<WriteMatrix>("WriteMatrix", "DataIO", "SCIRun", "Functional, outputs text files or binary .mat only.", "...");
   addModuleDesc<ReadField>("ReadField", "DataIO", "SCIRun", "Functional, needs GUI and algorithm work.", "...");
   addModuleDesc<WriteField>("WriteField", "DataIO", "SCIRun", "Functional, outputs binary .fld only.", "...");
+#ifdef HAVE_HDF5
+  addModuleDesc<ReadHDF5File>("Real ported module", "Reads one dataset, no dataset browser yet.");
+#endif
   addModuleDesc<PrintDatatype>("PrintDatatype", "String", "SCIRun", "...", "...");
   addModuleDesc<ReportMatrixInfo>("ReportMatrixInfo", "Math", "SCIRun", "Functional, needs GUI work.", "...");
   addModuleDesc<ReportFieldInfo>("ReportFieldInfo", "MiscField", "SCIRun", "Same as v4", "...");
@@ -159,6 +166,7 @@ void ModuleDescriptionLookup::addEssentialModules()
   addModuleDesc<CalculateDistanceToField>("Real ported module", "...");
   addModuleDesc<CalculateDistanceToFieldBoundary>("Real ported module", "...");
   addModuleDesc<MapFieldDataOntoNodes>("Real ported module", "...");
+  addModuleDesc<MapFieldDataOntoNodesRadialbasis>("Real ported module", "...");
   addModuleDesc<MapFieldDataOntoElements>("Real ported module", "...");
   addModuleDesc<ClipFieldByFunction>("In progress", "...");
   addModuleDesc<MapFieldDataFromSourceToDestination>("Real ported module", "...");
@@ -0,0 +1,101 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Testing/ModuleTestBase/ModuleTestBase.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Algorithms/Legacy/Fields/Mapping/MapFieldDataOntoNodesRadialbasis.h>
+#include <Modules/Legacy/Fields/MapFieldDataOntoNodesRadialbasis.h>
+#include <Testing/Utils/SCIRunUnitTests.h>
+
+using namespace SCIRun;
+using namespace SCIRun::Testing;
+using namespace SCIRun::Modules::Fields;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Core::Algorithms;
+using namespace SCIRun::Core::Algorithms::Fields;
+using namespace SCIRun::Dataflow::Networks;
+
+class MapFieldDataOntoNodesRadialbasisModuleTests : public ModuleTest
+{
+};
+
+namespace
+{
+  FieldHandle PointSamples()
+  {
+    FieldInformation fi(POINTCLOUDMESH_E, LINEARDATA_E, DOUBLE_E);
+    FieldHandle samples = CreateField(fi);
+    VMesh* vmesh = samples->vmesh();
+    // Not at unit distance: the thin plate spline r^2 log(r) vanishes there.
+    vmesh->add_point(Point(0, 0, 0));
+    vmesh->add_point(Point(0.5, 0, 0));
+    vmesh->add_point(Point(0, 0.5, 0));
+    vmesh->add_point(Point(0, 0, 0.5));
+    VField* vfield = samples->vfield();
+    vfield->resize_values();
+    for (VMesh::Node::index_type i = 0; i < vmesh->num_nodes(); i++)
+      vfield->set_value(1.0 + i, i);
+    return samples;
+  }
+}
+
+TEST_F(MapFieldDataOntoNodesRadialbasisModuleTests, ThrowsForNullInput)
+{
+  auto test = makeModule("MapFieldDataOntoNodesRadialbasis");
+  FieldHandle nullField;
+  stubPortNWithThisData(test, 0, nullField);
+  stubPortNWithThisData(test, 1, nullField);
+  EXPECT_THROW(test->execute(), NullHandleOnPortException);
+}
+
+TEST_F(MapFieldDataOntoNodesRadialbasisModuleTests, InterpolatesSourceValues)
+{
+  for (const std::string function : { "thin-plate-spline", "wendland" })
+  {
+    auto test = makeModule("MapFieldDataOntoNodesRadialbasis");
+    test->get_state()->setValue(Parameters::RadialBasisFunction, function);
+    // Every sample lies within the support of every other one.
+    test->get_state()->setValue(Parameters::SupportRadius, 2.0);
+    stubPortNWithThisData(test, 0, PointSamples());
+    stubPortNWithThisData(test, 1, PointSamples());
+    test->execute();
+
+    auto output = boost::dynamic_pointer_cast<Field>(getDataOnThisOutputPort(test, 0));
+    ASSERT_TRUE(output != nullptr);
+    ASSERT_EQ(4, output->vfield()->num_values());
+    for (VMesh::Node::index_type i = 0; i < 4; i++)
+    {
+      double value;
+      output->vfield()->get_value(value, i);
+      EXPECT_NEAR(1.0 + i, value, 1e-8) << function;
+    }
+  }
+}
@@ -32,7 +32,8 @@
 #include <Dataflow/Network/Ports/MatrixPort.h>
 #include <Dataflow/Network/Ports/StringPort.h>
 #include <Dataflow/Network/Module.h>
-#include <Core/Algorithms/DataStreaming/StreamMatrix.h>
+#include <Core/Algorithms/DataIO/StreamMatrix.h>
+#include <Core/Algorithms/Base/AlgorithmPreconditions.h>
 
 
 namespace SCIRun {
@@ -63,7 +64,7 @@ class StreamMatrixFromDisk : public Module {
     bool      use_row_;
     bool      didrun_;
 
-    SCIRunAlgo::StreamMatrixAlgo datafile_; 
+    SCIRun::Core::Algorithms::DataIO::StreamMatrixAlgo datafile_;
     
     void send_selection(int which, int amount);
     int increment(int which, int lower, int upper);  
@@ -91,7 +92,6 @@ StreamMatrixFromDisk::StreamMatrixFromDisk(GuiContext* ctx)
     use_row_(false),
     didrun_(false)
 {
-  datafile_.set_progress_reporter(this);
 }
 
 
@@ -133,12 +133,12 @@ StreamMatrixFromDisk::execute()
   if (use_row)
   {
     slider_min_.set(0);
-    slider_max_.set(datafile_.get_numrows()-1);  
+    slider_max_.set(datafile_.numRows()-1);  
   }
   else
   {
     slider_min_.set(0);
-    slider_max_.set(datafile_.get_numcols()-1);    
+    slider_max_.set(datafile_.numCols()-1);    
   }
   TCLInterface::execute(get_id() + " update_range");
   reset_vars();
@@ -148,12 +148,12 @@ StreamMatrixFromDisk::execute()
     if (use_row)
     {
       range_min_.set(0);
-      range_max_.set(datafile_.get_numrows()-1);  
+      range_max_.set(datafile_.numRows()-1);  
     }
     else
     {
       range_min_.set(0);
-      range_max_.set(datafile_.get_numcols()-1);  
+      range_max_.set(datafile_.numCols()-1);  
     }    
     execmode_.set("play");
     get_ctx()->reset();
@@ -257,11 +257,11 @@ StreamMatrixFromDisk::execute()
 
     if (use_row_)
     {
-      amount = Max(1, Min(datafile_.get_numrows()-current,amount));
+      amount = Max(1, Min(datafile_.numRows()-current,amount));
     }
     else
     {
-      amount = Max(1, Min(datafile_.get_numcols()-current,amount));    
+      amount = Max(1, Min(datafile_.numCols()-current,amount));    
     }
 
     // Put the input from the GUI in the matrix Indices
@@ -275,17 +275,29 @@ StreamMatrixFromDisk::execute()
 
   MatrixHandle Output;
   MatrixHandle ScaledIndices;
-  
+
+  std::vector<int> indices;
+  if (Indices.get_rep())
+  {
+    const double* indexptr = Indices->get_data_pointer();
+    for (size_type p=0; p<Indices->get_data_size(); p++)
+      indices.push_back(static_cast<int>(indexptr[p]));
+  }
+
+  // Columns are served from a window of blocks that a background thread
+  // reads ahead of the playback position, rows are streamed block by block.
+  try
+  {
   if (use_row)
   {
     if (Indices.get_rep())
     {
-      if (!(datafile_.getrowmatrix(Output,Indices))) return;
+      Output = datafile_.getRows(indices);
   
       ScaledIndices = Indices;
       ScaledIndices.detach();
       double* data = ScaledIndices->get_data_pointer();
-      double spacing = datafile_.get_rowspacing();
+      double spacing = datafile_.rowSpacing();
 
       for (size_type p=0;p<ScaledIndices->get_data_size();p++)
       {
@@ -294,19 +306,19 @@ StreamMatrixFromDisk::execute()
     }
     else if (Weights.get_rep())
     {
-      if (!(datafile_.getrowmatrix_weights(Output,Weights))) return;    
+      Output = datafile_.getWeightedRows(*Weights->sparse());
     }
   }
   else
   {
     if (Indices.get_rep())
     {
-      if (!(datafile_.getcolmatrix(Output,Indices))) return;
+      Output = datafile_.getColumns(indices);
 
       ScaledIndices = Indices;
       ScaledIndices.detach();
       double* data = ScaledIndices->get_data_pointer();
-      double spacing = datafile_.get_colspacing();
+      double spacing = datafile_.colSpacing();
 
       for (size_type p=0;p<ScaledIndices->get_data_size();p++)
       {
@@ -315,9 +327,15 @@ StreamMatrixFromDisk::execute()
     }
     else if (Weights.get_rep())
     {
-      if (!(datafile_.getcolmatrix_weights(Output,Weights))) return;    
+      Output = datafile_.getWeightedColumns(*Weights->sparse());
     }  
   }
+  }
+  catch (SCIRun::Core::Algorithms::AlgorithmInputException& e)
+  {
+    error(e.what());
+    return;
+  }
 
   send_output_handle("DataVector",Output,true);
   send_output_handle("Index",Indices,true);
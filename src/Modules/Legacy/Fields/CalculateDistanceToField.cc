@@ -56,6 +56,7 @@ void CalculateDistanceToField::setStateDefaults()
 {
   setStateBoolFromAlgo(Parameters::Truncate);
   setStateDoubleFromAlgo(Parameters::TruncateDistance);
+  setStateBoolFromAlgo(Parameters::UseDistanceTransform);
   setStateStringFromAlgoOption(Parameters::BasisType);
   setStateStringFromAlgoOption(Parameters::OutputFieldDatatype);
 }
@@ -72,6 +73,7 @@ CalculateDistanceToField::execute()
   {
     setAlgoBoolFromState(Parameters::Truncate);
     setAlgoDoubleFromState(Parameters::TruncateDistance);
+    setAlgoBoolFromState(Parameters::UseDistanceTransform);
     setAlgoOptionFromState(Parameters::BasisType);
     setAlgoOptionFromState(Parameters::OutputFieldDatatype);
 
@@ -30,6 +30,7 @@
 #include <Core/Datatypes/Legacy/Field/Field.h>
 
 #include <Core/Algorithms/Legacy/Fields/DistanceField/CalculateSignedDistanceField.h>
+#include <Core/Algorithms/Legacy/Fields/DistanceField/RegularGridDistanceTransform.h>
 
 using namespace SCIRun;
 using namespace SCIRun::Core::Datatypes;
@@ -46,6 +47,11 @@ CalculateSignedDistanceToField::CalculateSignedDistanceToField()
   INITIALIZE_PORT(ValueField);
 }
 
+void CalculateSignedDistanceToField::setStateDefaults()
+{
+  setStateBoolFromAlgo(Parameters::UseDistanceTransform);
+}
+
 void CalculateSignedDistanceToField::execute()
 {
   FieldHandle input = getRequiredInput(InputField);
@@ -55,6 +61,8 @@ void CalculateSignedDistanceToField::execute()
 
   if (needToExecute())
   {
+    setAlgoBoolFromState(Parameters::UseDistanceTransform);
+
     auto inputs = make_input((InputField, input)(ObjectField, object));
 
     algo().set(CalculateSignedDistanceFieldAlgo::OutputValueField, value_connected);
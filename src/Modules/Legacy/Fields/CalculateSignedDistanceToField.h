@@ -50,7 +50,7 @@ namespace SCIRun {
         CalculateSignedDistanceToField();
 
         virtual void execute() override;
-        virtual void setStateDefaults() override {}
+        virtual void setStateDefaults() override;
 
         INPUT_PORT(0, InputField, Field);
         INPUT_PORT(1, ObjectField, Field);
@@ -42,7 +42,9 @@ using namespace SCIRun::Core::Algorithms::Fields;
 ///
 /// @detail The MapFieldDataFromSourceToDestination module takes two Fields as
 /// input, the first of which, Source, contains geometry and data values;
-/// the second, Destination, contains geometry only.
+/// the second, Destination, contains geometry only. When the mapping matrix
+/// is reused, the interpolation weights are computed once for a pair of
+/// meshes and sent out on the Mapping port.
 
 MODULE_INFO_DEF(MapFieldDataFromSourceToDestination, ChangeFieldData, SCIRun)
 
@@ -52,6 +54,7 @@ MapFieldDataFromSourceToDestination::MapFieldDataFromSourceToDestination() :
   INITIALIZE_PORT(Source);
   INITIALIZE_PORT(Destination);
   INITIALIZE_PORT(Remapped_Destination);
+  INITIALIZE_PORT(Mapping);
 }
 
 void MapFieldDataFromSourceToDestination::setStateDefaults()
@@ -59,6 +62,7 @@ void MapFieldDataFromSourceToDestination::setStateDefaults()
   setStateDoubleFromAlgo(Parameters::DefaultValue);
   setStateStringFromAlgoOption(Parameters::MappingMethod);
   setStateDoubleFromAlgo(Parameters::MaxDistance);
+  setStateBoolFromAlgo(Parameters::ReuseMappingMatrix);
 }
 
 void MapFieldDataFromSourceToDestination::execute()
@@ -71,8 +75,11 @@ void MapFieldDataFromSourceToDestination::execute()
     setAlgoOptionFromState(Parameters::MappingMethod);
     setAlgoDoubleFromState(Parameters::DefaultValue);
     setAlgoDoubleFromState(Parameters::MaxDistance);
+    setAlgoBoolFromState(Parameters::ReuseMappingMatrix);
 
     auto output = algo().run(withInputData((Source, source)(Destination, destination)));
     sendOutputFromAlgorithm(Remapped_Destination, output);
+    if (get_state()->getValue(Parameters::ReuseMappingMatrix).toBool())
+      sendOutputFromAlgorithm(Mapping, output);
   }
 }
@@ -39,7 +39,7 @@ namespace Fields {
 
   class SCISHARE MapFieldDataFromSourceToDestination : public Dataflow::Networks::Module,
     public Has2InputPorts<FieldPortTag, FieldPortTag>,
-    public Has1OutputPort<FieldPortTag>,
+    public Has2OutputPorts<FieldPortTag, MatrixPortTag>,
     public Core::Thread::Interruptible
   {
   public:
@@ -51,6 +51,7 @@ namespace Fields {
     INPUT_PORT(0, Source, Field);
     INPUT_PORT(1, Destination, Field);
     OUTPUT_PORT(0, Remapped_Destination, Field);
+    OUTPUT_PORT(1, Mapping, Matrix);
 
     MODULE_TRAITS_AND_INFO(ModuleHasUIAndAlgorithm)
   };
@@ -27,6 +27,7 @@ DEALINGS IN THE SOFTWARE.
 */
 
 #include <Modules/Visualization/ShowField.h>
+#include <Modules/Visualization/SurfaceDecimation.h>
 #include <Core/Datatypes/Geometry.h>
 #include <Core/Algorithms/Visualization/RenderFieldState.h>
 #include <Core/Datatypes/Legacy/Field/VMesh.h>
@@ -34,6 +35,8 @@ DEALINGS IN THE SOFTWARE.
 #include <Core/Datatypes/Legacy/Field/VField.h>
 #include <Core/Datatypes/Color.h>
 #include <Core/Datatypes/ColorMap.h>
+#include <Core/Thread/Parallel.h>
+#include <limits>
 #include <Core/GeometryPrimitives/Vector.h>
 #include <Core/GeometryPrimitives/Tensor.h>
 #include <Graphics/Glyphs/GlyphGeom.h>
@@ -96,6 +99,62 @@ public:
     unsigned int approxDiv,
     const std::string& id);
 
+  /// True when every vertex attribute of a face corner depends only on its node, so faces can
+  /// index one shared vertex per node instead of writing their own corners.
+  bool canShareFaceVertices(
+    FieldHandle field,
+    boost::optional<ColorMapHandle> colorMap,
+    const RenderState& state,
+    ColorScheme colorScheme,
+    bool withNormals) const;
+
+  /// Face buffers are built in parallel over contiguous face ranges; the ranges are joined in
+  /// order, so the output does not depend on the number of threads. Both builders record which
+  /// field value each vertex color came from, and return false if that was not possible.
+  bool buildSharedVertexFaceBuffers(
+    FieldHandle field,
+    boost::optional<ColorMapHandle> colorMap,
+    Interruptible* interruptible,
+    ColorScheme colorScheme,
+    bool withNormals,
+    const std::vector<VMesh::index_type>* faceSubset,
+    std::shared_ptr<spire::VarBuffer>& iboBuffer,
+    std::shared_ptr<spire::VarBuffer>& vboBuffer);
+
+  bool buildFaceBuffers(
+    FieldHandle field,
+    boost::optional<ColorMapHandle> colorMap,
+    Interruptible* interruptible,
+    const RenderState& state,
+    ColorScheme colorScheme,
+    bool withNormals,
+    const std::vector<VMesh::index_type>* faceSubset,
+    std::shared_ptr<spire::VarBuffer>& iboBuffer,
+    std::shared_ptr<spire::VarBuffer>& vboBuffer);
+
+  /// Reuses the indices, positions and normals of the last face build and only rewrites the
+  /// vertex colors from the given color map.
+  void recolorFaceBuffers(
+    FieldHandle field,
+    boost::optional<ColorMapHandle> colorMap,
+    Interruptible* interruptible,
+    std::shared_ptr<spire::VarBuffer>& iboBuffer,
+    std::shared_ptr<spire::VarBuffer>& vboBuffer);
+
+  /// Faces of a volume mesh with a single adjacent element, cached per mesh.
+  const std::vector<VMesh::index_type>& boundaryFaces(FieldHandle field, Interruptible* interruptible);
+
+  /// Index buffer of the finest simplified level of shared-vertex faces within the triangle
+  /// budget, or null if the surface cannot be simplified. Levels index the full-resolution
+  /// vertex buffer and are built once per mesh.
+  std::shared_ptr<spire::VarBuffer> faceLevelWithin(
+    const std::string& mesh,
+    size_t triangleBudget,
+    size_t vertexStride,
+    Interruptible* interruptible,
+    spire::VarBuffer& iboBuffer,
+    spire::VarBuffer& vboBuffer);
+
   void addFaceGeom(
     const std::vector<Point>  &points,
     const std::vector<Vector> &normals,
@@ -124,6 +183,30 @@ private:
   float nodeTransparencyValue_ = 0.65f;
   std::string moduleId_;
   ModuleStateHandle state_;
+  Mesh::id_type boundaryFacesMeshId_ = -1;
+  std::vector<VMesh::index_type> boundaryFaces_;
+
+  /// Face buffers of the last build. When only the color map changes, the next build copies
+  /// them and looks up new colors instead of walking the mesh again.
+  struct FaceBufferCache
+  {
+    std::string layout;
+    std::shared_ptr<spire::VarBuffer> ibo;
+    std::shared_ptr<spire::VarBuffer> vbo;
+    size_t vertexStride = 0;
+    size_t colorOffset = 0;
+    size_t colorsPerVertex = 0;
+    std::vector<VMesh::index_type> colorSources;
+  };
+  FaceBufferCache faceBuffers_;
+
+  /// Simplified index buffers of the shared-vertex faces of one mesh, finest first.
+  struct FaceLevelCache
+  {
+    std::string mesh;
+    std::vector<std::shared_ptr<spire::VarBuffer>> ibos;
+  };
+  FaceLevelCache faceLevels_;
 };
 }}}}
 
@@ -183,6 +266,8 @@ void ShowField::setStateDefaults()
 
   state->setValue(UseFaceNormals, false);
   state->setValue(FaceInvertNormals, false);
+  state->setValue(ShowInteriorFaces, false);
+  state->setValue(FaceTriangleBudget, 0);
 
   state->setValue(FieldName, std::string());
 
@@ -455,10 +540,6 @@ void GeometryBuilder::renderFacesLinear(
 
   bool invertNormals = state_->getValue(ShowField::FaceInvertNormals).toBool();
   ColorScheme colorScheme = ColorScheme::COLOR_UNIFORM;
-  std::vector<double> svals;
-  std::vector<Vector> vvals;
-  std::vector<Tensor> tvals;
-  std::vector<ColorRGB> face_colors;
 
   if (fld->basis_order() < 0 || state.get(RenderState::USE_DEFAULT_COLOR))
   {
@@ -473,256 +554,82 @@ void GeometryBuilder::renderFacesLinear(
     colorScheme = ColorScheme::COLOR_IN_SITU;
   }
 
-  // Three 32 bit ints to index into the VBO
-  uint32_t iboSize = static_cast<uint32_t>(mesh->num_faces() * sizeof(uint32_t) * 3);
-  //Seven floats per VBO: Pos (3) XYZ, and Color (4) RGBA
-  uint32_t vboSize = static_cast<uint32_t>(mesh->num_faces() * sizeof(float) * 7);
-
-  // Construct VBO and IBO that will be used to render the faces. Once again,
-  // IBOs are not strictly needed. But, we may be able to optimize this code
-  // somewhat.
-  /// \todo Switch to unique_ptrs and move semantics.
-  std::shared_ptr<spire::VarBuffer> iboBufferSPtr(
-    new spire::VarBuffer(vboSize));
-  std::shared_ptr<spire::VarBuffer> vboBufferSPtr(
-    new spire::VarBuffer(iboSize));
-
-  // Accessing the pointers like this is contrived. We only do this for
-  // speed since we will be using the pointers in a tight inner loop.
-  auto iboBuffer = iboBufferSPtr.get();
-  auto vboBuffer = vboBufferSPtr.get();
-
-  uint32_t iboIndex = 0;
-  int64_t numVBOElements = 0;
-
-  VMesh::Face::iterator fiter, fiterEnd;
-  VMesh::Node::array_type nodes;
-
-  mesh->begin(fiter);
-  mesh->end(fiterEnd);
-
-  Point idpt;
-  mesh->get_nodes(nodes, *fiter);
-  mesh->get_point(idpt, nodes[0]);
+  // Cell data on volumes colors the two sides of each face separately.
+  if (colorScheme != ColorScheme::COLOR_UNIFORM && fld->basis_order() == 0 && mesh->dimensionality() == 3)
+  {
+    state.set(RenderState::IS_DOUBLE_SIDED, true);
+  }
 
-  while (fiter != fiterEnd)
+  // Interior faces of a volume are hidden behind its boundary, unless faces are see-through
+  // or the user asks for them (e.g. to look through a clipping plane).
+  const std::vector<VMesh::index_type>* faceSubset = nullptr;
+  if (mesh->dimensionality() == 3 && !state.get(RenderState::USE_TRANSPARENCY) &&
+    !state_->getValue(ShowField::ShowInteriorFaces).toBool())
   {
-    interruptible->checkForInterruption();
+    faceSubset = &boundaryFaces(field, interruptible);
+  }
 
-    mesh->get_nodes(nodes, *fiter);
+  std::shared_ptr<spire::VarBuffer> iboBufferSPtr;
+  std::shared_ptr<spire::VarBuffer> vboBufferSPtr;
 
-    std::vector<Point> points(nodes.size());
-    std::vector<Vector> normals(nodes.size());
+  // Everything but the color map that goes into the face buffers. Field ids are never reused,
+  // so a matching layout means only the colors can differ from the last build.
+  std::ostringstream layout;
+  layout << field->id() << ' ' << static_cast<int>(colorScheme) << withNormals
+    << state.get(RenderState::USE_FACE_NORMALS) << invertNormals
+    << state.get(RenderState::IS_DOUBLE_SIDED) << (faceSubset != nullptr);
 
-    for (size_t i = 0; i < nodes.size(); i++)
-    {
-      mesh->get_point(points[i], nodes[i]);
-    }
+  const bool sharedVertices = canShareFaceVertices(field, colorMap, state, colorScheme, withNormals);
 
-    //TODO fix so the withNormals tp be woth lighting is called correctly, and the meshes are fixed.
-    if (withNormals)
-    {
-      bool useFaceNormals = state.get(RenderState::USE_FACE_NORMALS) && mesh->has_normals();
-      if (useFaceNormals)
-      {
-        for (size_t i = 0; i < nodes.size(); i++)
-        {
-          auto norm = normals[i];
-          normals[i] = invertNormals ? -norm : norm;
-          mesh->get_normal(normals[i], nodes[i]);
-        }
-      }
-      else
-      {
-        /// Fix normal of Quads
-        if (points.size() == 4)
-        {
-          Vector edge1 = points[1] - points[0];
-          Vector edge2 = points[2] - points[1];
-          Vector edge3 = points[3] - points[2];
-          Vector edge4 = points[0] - points[3];
-
-          Vector norm = Cross(edge1, edge2) + Cross(edge2, edge3) + Cross(edge3, edge4) + Cross(edge4, edge1);
-
-          norm.normalize();
-
-          for (size_t i = 0; i < nodes.size(); i++)
-          {
-            normals[i] = invertNormals ? -norm : norm;
-          }
-        }
-        /// Fix Normals of Tris
-        else
-        {
-          Vector edge1 = points[1] - points[0];
-          Vector edge2 = points[2] - points[1];
-          Vector norm = Cross(edge1, edge2);
+  if (layout.str() == faceBuffers_.layout)
+  {
+    recolorFaceBuffers(field, colorMap, interruptible, iboBufferSPtr, vboBufferSPtr);
+  }
+  else
+  {
+    faceBuffers_ = FaceBufferCache();
 
-          norm.normalize();
+    const bool recolorable = sharedVertices ?
+      buildSharedVertexFaceBuffers(field, colorMap, interruptible, colorScheme, withNormals,
+        faceSubset, iboBufferSPtr, vboBufferSPtr) :
+      buildFaceBuffers(field, colorMap, interruptible, state, colorScheme, withNormals,
+        faceSubset, iboBufferSPtr, vboBufferSPtr);
 
-          for (size_t i = 0; i < nodes.size(); i++)
-          {
-            normals[i] = invertNormals ? -norm : norm;
-          }
-          //For future reference for a try at smoother rendering
-          /*
-          for (size_t i = 0; i < nodes.size(); i++)
-          {
-          mesh->get_normal(normals[i], nodes[i]);
-          }
-          */
-        }
-      }
-    }
-    // Default color single face no matter the element data.
-    if (colorScheme == ColorScheme::COLOR_UNIFORM)
+    if (recolorable)
     {
-      addFaceGeom(points, normals, withNormals, iboIndex, iboBuffer, vboBuffer,
-        colorScheme, face_colors, state);
+      faceBuffers_.layout = layout.str();
+      faceBuffers_.colorsPerVertex = colorScheme == ColorScheme::COLOR_UNIFORM ? 0 :
+        (state.get(RenderState::IS_DOUBLE_SIDED) ? 2 : 1);
+      faceBuffers_.colorOffset = 3 + (withNormals ? 3 : 0);
+      faceBuffers_.vertexStride = faceBuffers_.colorOffset + 4 * faceBuffers_.colorsPerVertex;
     }
-    // Element data (Cells) so two sided faces.
-    else if (fld->basis_order() == 0 && mesh->dimensionality() == 3)
+    else
     {
-      auto map = colorMap.get();
-      //two possible colors.
-      svals.resize(2);
-      vvals.resize(2);
-      tvals.resize(2);
-      face_colors = {{ColorRGB(1.,1.,1.),ColorRGB(1.,1.,1.)}};
-
-      VMesh::Elem::array_type cells;
-      mesh->get_elems(cells, *fiter);
-
-      if (fld->is_scalar())
-      {
-        fld->get_value(svals[0], cells[0]);
-
-        if (cells.size() > 1)
-        {
-          fld->get_value(svals[1], cells[1]);
-        }
-        else
-        {
-          svals[1] = svals[0];
-        }
-        face_colors[0] = map->valueToColor(svals[0]);
-        face_colors[1] = map->valueToColor(svals[1]);
-      }
-      else if (fld->is_vector())
-      {
-        fld->get_value(vvals[0], cells[0]);
-
-        if (cells.size() > 1)
-        {
-          fld->get_value(vvals[1], cells[1]);
-        }
-        else
-        {
-          svals[1] = svals[0];
-        }
-
-        face_colors[0] = map->valueToColor(vvals[0]);
-        face_colors[1] = map->valueToColor(vvals[1]);
-      }
-      else if (fld->is_tensor())
-      {
-        fld->get_value(tvals[0], cells[0]);
-
-        if (cells.size() > 1)
-        {
-          fld->get_value(tvals[1], cells[1]);
-        }
-        else
-        {
-          svals[1] = svals[0];
-        }
-
-        face_colors[0] = map->valueToColor(tvals[0]);
-        face_colors[1] = map->valueToColor(tvals[1]);
-      }
-
-      state.set(RenderState::IS_DOUBLE_SIDED, true);
-
-      addFaceGeom(points, normals, withNormals, iboIndex, iboBuffer, vboBuffer,
-        colorScheme, face_colors, state);
+      faceBuffers_.colorSources.clear();
     }
-    // Element data (faces)
-    else if (fld->basis_order() == 0 && mesh->dimensionality() == 2)
-    {
-      auto map = colorMap.get();
-      //one possible color, each node that color.
-      svals.resize(1);
-      vvals.resize(1);
-      tvals.resize(1);
-      face_colors.resize(nodes.size());
-      if (fld->is_scalar())
-      {
-        fld->get_value(svals[0], *fiter);
-        face_colors[0] = map->valueToColor(svals[0]);
-      }
-      else if (fld->is_vector())
-      {
-        fld->get_value(vvals[0], *fiter);
-        face_colors[0] = map->valueToColor(vvals[0]);
-      }
-      else if (fld->is_tensor())
-      {
-        fld->get_value(tvals[0], *fiter);
-        face_colors[0] = map->valueToColor(tvals[0]);
-      }
-
-      // Same color at all corners.
-      for (size_t i = 0; i<nodes.size(); ++i)
-      {
-        face_colors[i] = face_colors[0];
-      }
-
-      addFaceGeom(points, normals, withNormals, iboIndex, iboBuffer, vboBuffer,
-        colorScheme, face_colors,  state);
-    }
-
-    // Data at nodes
-    else if (fld->basis_order() == 1)
-    {
-      auto map = colorMap.get();
-      svals.resize(nodes.size());
-      vvals.resize(nodes.size());
-      tvals.resize(nodes.size());
-      face_colors.resize(nodes.size());
-      //node.size() possible colors.
-      if (fld->is_scalar())
-      {
-        for (size_t i = 0; i<nodes.size(); i++)
-        {
-          fld->get_value(svals[i], nodes[i]);
-          face_colors[i] = map->valueToColor(svals[i]);
-        }
-      }
-      else if (fld->is_vector())
-      {
-        for (size_t i = 0; i<nodes.size(); i++)
-        {
-          fld->get_value(vvals[i], nodes[i]);
-          face_colors[i] = map->valueToColor(vvals[i]);
-        }
-      }
-      else if (fld->is_tensor())
-      {
-        for (size_t i = 0; i<nodes.size(); i++)
-        {
-          fld->get_value(tvals[i], nodes[i]);
-          face_colors[i] = map->valueToColor(tvals[i]);
-        }
-      }
+  }
 
-      addFaceGeom(points, normals, withNormals, iboIndex, iboBuffer, vboBuffer,
-        colorScheme, face_colors, state);
-    }
+  if (!faceBuffers_.layout.empty())
+  {
+    faceBuffers_.ibo = iboBufferSPtr;
+    faceBuffers_.vbo = vboBufferSPtr;
+  }
 
-    ++fiter;
-    ++numVBOElements;
+  // Huge surfaces can be drawn from a simplified level instead. Only the index buffer changes,
+  // so positions, normals and colors stay those of the full-resolution vertices.
+  const size_t triangleBudget = static_cast<size_t>(std::max(0, state_->getValue(ShowField::FaceTriangleBudget).toInt()));
+  if (sharedVertices && triangleBudget > 0 &&
+    iboBufferSPtr->getBufferSize() / (3 * sizeof(uint32_t)) > triangleBudget)
+  {
+    std::ostringstream mesh;
+    mesh << field->mesh()->id() << ' ' << (faceSubset != nullptr);
+    const size_t stride = 3 + (withNormals ? 3 : 0) + (colorScheme == ColorScheme::COLOR_UNIFORM ? 0 : 4);
+    if (auto level = faceLevelWithin(mesh.str(), triangleBudget, stride, interruptible, *iboBufferSPtr, *vboBufferSPtr))
+      iboBufferSPtr = level;
   }
 
+  const int64_t numVBOElements = faceSubset ? static_cast<int64_t>(faceSubset->size()) : static_cast<int64_t>(numFaces);
+
   std::stringstream ss;
   ss << invertNormals << static_cast<int>(colorScheme) << faceTransparencyValue_;
 
@@ -879,6 +786,746 @@ void GeometryBuilder::renderFacesLinear(
   ///       build up to geometry / tessellation shaders if support is present.
 }
 
+namespace
+{
+  /// Ranges smaller than this are not worth a thread of their own.
+  const size_t minFacesPerTask = 4096;
+
+  /// Simplified face levels stop around this many triangles, which any renderer draws quickly.
+  const size_t minLevelTriangles = 1000;
+
+  int faceTaskCount(size_t numFaces)
+  {
+    return static_cast<int>(std::max<size_t>(1,
+      std::min<size_t>(Parallel::NumCores(), numFaces / minFacesPerTask)));
+  }
+
+  VMesh::index_type rangeBegin(size_t size, int proc, int np)
+  {
+    return static_cast<VMesh::index_type>((size * proc) / np);
+  }
+
+  uint32_t bufferSize(size_t bytes)
+  {
+    return static_cast<uint32_t>(std::max<size_t>(bytes, 1));
+  }
+
+  /// Colors count vertices by the scalars at sources[0], sources[sourceStride], ..., through
+  /// the bulk lookup of the color map. Colors are written rgbaStride floats apart.
+  void mapScalarColors(VField* fld, const ColorMap& map, const VMesh::index_type* sources,
+    size_t sourceStride, size_t count, float* rgba, size_t rgbaStride)
+  {
+    const size_t blockSize = 1024;
+    double values[blockSize];
+    auto scalarValues = fld->view<double>();
+    for (size_t begin = 0; begin < count; begin += blockSize)
+    {
+      const size_t size = std::min(blockSize, count - begin);
+      const VMesh::index_type* blockSources = sources + begin * sourceStride;
+      if (scalarValues)
+      {
+        for (size_t i = 0; i < size; ++i)
+          values[i] = scalarValues[blockSources[i * sourceStride]];
+      }
+      else
+      {
+        for (size_t i = 0; i < size; ++i)
+          fld->get_value(values[i], blockSources[i * sourceStride]);
+      }
+      map.valuesToColors(values, size, rgba + begin * rgbaStride, rgbaStride);
+    }
+  }
+}
+
+bool GeometryBuilder::canShareFaceVertices(
+  FieldHandle field,
+  boost::optional<boost::shared_ptr<ColorMap>> colorMap,
+  const RenderState& state,
+  ColorScheme colorScheme,
+  bool withNormals) const
+{
+  VField* fld = field->vfield();
+  VMesh*  mesh = field->vmesh();
+
+  if (state.get(RenderState::IS_DOUBLE_SIDED))
+    return false;
+
+  // Flat normals belong to the face, not the node.
+  if (withNormals && !(state.get(RenderState::USE_FACE_NORMALS) && mesh->has_normals()))
+    return false;
+
+  if (colorScheme == ColorScheme::COLOR_UNIFORM)
+    return true;
+
+  return colorMap && fld->basis_order() == 1 &&
+    (fld->is_scalar() || fld->is_vector() || fld->is_tensor());
+}
+
+const std::vector<VMesh::index_type>& GeometryBuilder::boundaryFaces(FieldHandle field, Interruptible* interruptible)
+{
+  // Mesh ids are never reused, so the cached faces stay valid until another mesh comes in.
+  if (field->mesh()->id() == boundaryFacesMeshId_)
+    return boundaryFaces_;
+
+  VMesh* mesh = field->vmesh();
+  const size_t numFaces = mesh->num_faces();
+
+  const int np = faceTaskCount(numFaces);
+  std::vector<std::vector<VMesh::index_type>> chunks(np);
+
+  auto task_i = [&](int proc)
+  {
+    VMesh::Elem::array_type elems;
+    const VMesh::index_type faceEnd = rangeBegin(numFaces, proc + 1, np);
+    for (VMesh::index_type idx = rangeBegin(numFaces, proc, np); idx < faceEnd; ++idx)
+    {
+      interruptible->checkForInterruption();
+
+      mesh->get_elems(elems, VMesh::Face::index_type(idx));
+      if (elems.size() < 2)
+        chunks[proc].push_back(idx);
+    }
+  };
+  Parallel::RunTasks(task_i, np);
+
+  boundaryFaces_.clear();
+  for (const auto& chunk : chunks)
+    boundaryFaces_.insert(boundaryFaces_.end(), chunk.begin(), chunk.end());
+  boundaryFacesMeshId_ = field->mesh()->id();
+
+  return boundaryFaces_;
+}
+
+bool GeometryBuilder::buildSharedVertexFaceBuffers(
+  FieldHandle field,
+  boost::optional<boost::shared_ptr<ColorMap>> colorMap,
+  Interruptible* interruptible,
+  ColorScheme colorScheme,
+  bool withNormals,
+  const std::vector<VMesh::index_type>* faceSubset,
+  std::shared_ptr<spire::VarBuffer>& iboBufferSPtr,
+  std::shared_ptr<spire::VarBuffer>& vboBufferSPtr)
+{
+  VField* fld = field->vfield();
+  VMesh*  mesh = field->vmesh();
+
+  const size_t numNodes = mesh->num_nodes();
+  const size_t numFaces = faceSubset ? faceSubset->size() : static_cast<size_t>(mesh->num_faces());
+  const bool withColors = colorScheme != ColorScheme::COLOR_UNIFORM;
+  const size_t stride = 3 + (withNormals ? 3 : 0) + (withColors ? 4 : 0);
+  auto map = withColors ? colorMap.get() : ColorMapHandle();
+
+  auto nodePoints = mesh->node_points_view();
+
+  const int np = faceTaskCount(numFaces);
+  std::vector<std::vector<uint32_t>> indices(np);
+
+  // Triangulate the faces, indexing mesh nodes for now.
+  auto triangulate_i = [&](int proc)
+  {
+    auto& faceIndices = indices[proc];
+    VMesh::Node::array_type nodes;
+
+    const VMesh::index_type faceEnd = rangeBegin(numFaces, proc + 1, np);
+    for (VMesh::index_type idx = rangeBegin(numFaces, proc, np); idx < faceEnd; ++idx)
+    {
+      interruptible->checkForInterruption();
+
+      mesh->get_nodes(nodes, VMesh::Face::index_type(faceSubset ? (*faceSubset)[idx] : idx));
+
+      // Same triangulation as addFaceGeom.
+      if (nodes.size() == 4)
+      {
+        faceIndices.push_back(static_cast<uint32_t>(nodes[0]));
+        faceIndices.push_back(static_cast<uint32_t>(nodes[1]));
+        faceIndices.push_back(static_cast<uint32_t>(nodes[2]));
+
+        faceIndices.push_back(static_cast<uint32_t>(nodes[2]));
+        faceIndices.push_back(static_cast<uint32_t>(nodes[3]));
+        faceIndices.push_back(static_cast<uint32_t>(nodes[0]));
+      }
+      else
+      {
+        for (size_t i = 2; i < nodes.size(); i++)
+        {
+          faceIndices.push_back(static_cast<uint32_t>(nodes[0]));
+          faceIndices.push_back(static_cast<uint32_t>(nodes[i - 1]));
+          faceIndices.push_back(static_cast<uint32_t>(nodes[i]));
+        }
+      }
+    }
+  };
+  Parallel::RunTasks(triangulate_i, np);
+
+  // Only nodes on a drawn face get a vertex, numbered in node order. Interior nodes of a
+  // volume mesh are left out this way.
+  const uint32_t unused = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> vertexOfNode(numNodes, unused);
+  size_t numIndices = 0;
+  for (const auto& chunk : indices)
+  {
+    for (auto node : chunk)
+      vertexOfNode[node] = 0;
+    numIndices += chunk.size();
+  }
+
+  std::vector<VMesh::index_type> usedNodes;
+  for (size_t node = 0; node < numNodes; ++node)
+  {
+    if (vertexOfNode[node] != unused)
+    {
+      vertexOfNode[node] = static_cast<uint32_t>(usedNodes.size());
+      usedNodes.push_back(static_cast<VMesh::index_type>(node));
+    }
+  }
+
+  // Same vertex layout as addFaceGeom, but written once per node.
+  std::vector<float> vertices(usedNodes.size() * stride);
+
+  auto vertices_i = [&](int proc)
+  {
+    for (auto& index : indices[proc])
+      index = vertexOfNode[index];
+
+    Point point;
+    Vector normal;
+    ColorRGB color;
+    Vector vval;
+    Tensor tval;
+
+    const VMesh::index_type vertexBegin = rangeBegin(usedNodes.size(), proc, np);
+    const VMesh::index_type vertexEnd = rangeBegin(usedNodes.size(), proc + 1, np);
+    for (VMesh::index_type v = vertexBegin; v < vertexEnd; ++v)
+    {
+      const VMesh::Node::index_type node(usedNodes[v]);
+      float* vertex = &vertices[v * stride];
+
+      if (nodePoints)
+        point = nodePoints[node];
+      else
+        mesh->get_point(point, node);
+      *vertex++ = static_cast<float>(point.x());
+      *vertex++ = static_cast<float>(point.y());
+      *vertex++ = static_cast<float>(point.z());
+
+      if (withNormals)
+      {
+        mesh->get_normal(normal, node);
+        *vertex++ = static_cast<float>(normal.x());
+        *vertex++ = static_cast<float>(normal.y());
+        *vertex++ = static_cast<float>(normal.z());
+      }
+
+      if (withColors && !fld->is_scalar())
+      {
+        if (fld->is_vector())
+        {
+          fld->get_value(vval, node);
+          color = map->valueToColor(vval);
+        }
+        else
+        {
+          fld->get_value(tval, node);
+          color = map->valueToColor(tval);
+        }
+        *vertex++ = static_cast<float>(color.r());
+        *vertex++ = static_cast<float>(color.g());
+        *vertex++ = static_cast<float>(color.b());
+        *vertex++ = 1.f;
+      }
+    }
+
+    // Scalar colors are filled in afterwards, a block of vertices at a time.
+    if (withColors && fld->is_scalar() && vertexEnd > vertexBegin)
+    {
+      const size_t colorOffset = withNormals ? 6 : 3;
+      mapScalarColors(fld, *map, &usedNodes[0] + vertexBegin, 1, vertexEnd - vertexBegin,
+        &vertices[0] + vertexBegin * stride + colorOffset, stride);
+    }
+  };
+  Parallel::RunTasks(vertices_i, np);
+
+  iboBufferSPtr.reset(new spire::VarBuffer(bufferSize(numIndices * sizeof(uint32_t))));
+  for (const auto& chunk : indices)
+  {
+    if (!chunk.empty())
+      iboBufferSPtr->writeBytes(reinterpret_cast<const char*>(&chunk[0]), chunk.size() * sizeof(uint32_t));
+  }
+
+  vboBufferSPtr.reset(new spire::VarBuffer(bufferSize(vertices.size() * sizeof(float))));
+  if (!vertices.empty())
+    vboBufferSPtr->writeBytes(reinterpret_cast<const char*>(&vertices[0]), vertices.size() * sizeof(float));
+
+  // Each vertex is colored by the value at its node.
+  if (withColors)
+    faceBuffers_.colorSources.swap(usedNodes);
+  return true;
+}
+
+bool GeometryBuilder::buildFaceBuffers(
+  FieldHandle field,
+  boost::optional<boost::shared_ptr<ColorMap>> colorMap,
+  Interruptible* interruptible,
+  const RenderState& state,
+  ColorScheme colorScheme,
+  bool withNormals,
+  const std::vector<VMesh::index_type>* faceSubset,
+  std::shared_ptr<spire::VarBuffer>& iboBufferSPtr,
+  std::shared_ptr<spire::VarBuffer>& vboBufferSPtr)
+{
+  VField* fld = field->vfield();
+  VMesh*  mesh = field->vmesh();
+
+  const size_t numFaces = faceSubset ? faceSubset->size() : static_cast<size_t>(mesh->num_faces());
+  bool invertNormals = state_->getValue(ShowField::FaceInvertNormals).toBool();
+
+  // Read positions and scalar values straight from the storage when possible
+  auto nodePoints = mesh->node_points_view();
+  auto scalarValues = fld->view<double>();
+
+  const bool doubleSided = state.get(RenderState::IS_DOUBLE_SIDED);
+
+  struct FaceChunk
+  {
+    spire::VarBuffer ibo;
+    spire::VarBuffer vbo;
+    uint32_t numVertices = 0;
+    std::vector<VMesh::index_type> colorSources;
+    bool recolorable = true;
+  };
+
+  const int np = faceTaskCount(numFaces);
+  std::vector<std::unique_ptr<FaceChunk>> chunks(np);
+  for (auto& chunk : chunks)
+    chunk.reset(new FaceChunk);
+
+  auto task_i = [&](int proc)
+  {
+    auto& chunk = *chunks[proc];
+    uint32_t iboIndex = 0;
+    VMesh::Node::array_type nodes;
+    std::vector<double> svals;
+    std::vector<Vector> vvals;
+    std::vector<Tensor> tvals;
+    std::vector<ColorRGB> face_colors;
+    std::vector<VMesh::index_type> faceSources;
+
+    // Field value behind each color addFaceGeom writes. Only triangles and quads write one
+    // vertex per corner.
+    auto recordColorSources = [&]()
+    {
+      if (nodes.size() < 3 || nodes.size() > 4 || (!doubleSided && faceSources.size() < nodes.size()))
+      {
+        chunk.recolorable = false;
+        return;
+      }
+      for (size_t i = 0; i < nodes.size(); ++i)
+      {
+        if (doubleSided)
+        {
+          chunk.colorSources.push_back(faceSources[0]);
+          chunk.colorSources.push_back(faceSources[1]);
+        }
+        else
+        {
+          chunk.colorSources.push_back(faceSources[i]);
+        }
+      }
+    };
+
+    const VMesh::index_type faceEnd = rangeBegin(numFaces, proc + 1, np);
+    for (VMesh::index_type idx = rangeBegin(numFaces, proc, np); idx < faceEnd; ++idx)
+    {
+      const VMesh::Face::index_type face(faceSubset ? (*faceSubset)[idx] : idx);
+
+      interruptible->checkForInterruption();
+
+      mesh->get_nodes(nodes, face);
+
+      std::vector<Point> points(nodes.size());
+      std::vector<Vector> normals(nodes.size());
+
+      for (size_t i = 0; i < nodes.size(); i++)
+      {
+        if (nodePoints)
+          points[i] = nodePoints[nodes[i]];
+        else
+          mesh->get_point(points[i], nodes[i]);
+      }
+
+      //TODO fix so the withNormals tp be woth lighting is called correctly, and the meshes are fixed.
+      if (withNormals)
+      {
+        bool useFaceNormals = state.get(RenderState::USE_FACE_NORMALS) && mesh->has_normals();
+        if (useFaceNormals)
+        {
+          for (size_t i = 0; i < nodes.size(); i++)
+          {
+            auto norm = normals[i];
+            normals[i] = invertNormals ? -norm : norm;
+            mesh->get_normal(normals[i], nodes[i]);
+          }
+        }
+        else
+        {
+          /// Fix normal of Quads
+          if (points.size() == 4)
+          {
+            Vector edge1 = points[1] - points[0];
+            Vector edge2 = points[2] - points[1];
+            Vector edge3 = points[3] - points[2];
+            Vector edge4 = points[0] - points[3];
+
+            Vector norm = Cross(edge1, edge2) + Cross(edge2, edge3) + Cross(edge3, edge4) + Cross(edge4, edge1);
+
+            norm.normalize();
+
+            for (size_t i = 0; i < nodes.size(); i++)
+            {
+              normals[i] = invertNormals ? -norm : norm;
+            }
+          }
+          /// Fix Normals of Tris
+          else
+          {
+            Vector edge1 = points[1] - points[0];
+            Vector edge2 = points[2] - points[1];
+            Vector norm = Cross(edge1, edge2);
+
+            norm.normalize();
+
+            for (size_t i = 0; i < nodes.size(); i++)
+            {
+              normals[i] = invertNormals ? -norm : norm;
+            }
+            //For future reference for a try at smoother rendering
+            /*
+            for (size_t i = 0; i < nodes.size(); i++)
+            {
+            mesh->get_normal(normals[i], nodes[i]);
+            }
+            */
+          }
+        }
+      }
+      // Default color single face no matter the element data.
+      if (colorScheme == ColorScheme::COLOR_UNIFORM)
+      {
+        addFaceGeom(points, normals, withNormals, iboIndex, &chunk.ibo, &chunk.vbo,
+          colorScheme, face_colors, state);
+      }
+      // Element data (Cells) so two sided faces.
+      else if (fld->basis_order() == 0 && mesh->dimensionality() == 3)
+      {
+        auto map = colorMap.get();
+        //two possible colors.
+        svals.resize(2);
+        vvals.resize(2);
+        tvals.resize(2);
+        face_colors = {{ColorRGB(1.,1.,1.),ColorRGB(1.,1.,1.)}};
+
+        VMesh::Elem::array_type cells;
+        mesh->get_elems(cells, face);
+        faceSources = { cells[0], cells.size() > 1 ? cells[1] : cells[0] };
+
+        if (fld->is_scalar())
+        {
+          fld->get_value(svals[0], cells[0]);
+
+          if (cells.size() > 1)
+          {
+            fld->get_value(svals[1], cells[1]);
+          }
+          else
+          {
+            svals[1] = svals[0];
+          }
+          face_colors[0] = map->valueToColor(svals[0]);
+          face_colors[1] = map->valueToColor(svals[1]);
+        }
+        else if (fld->is_vector())
+        {
+          fld->get_value(vvals[0], cells[0]);
+
+          if (cells.size() > 1)
+          {
+            fld->get_value(vvals[1], cells[1]);
+          }
+          else
+          {
+            vvals[1] = vvals[0];
+          }
+
+          face_colors[0] = map->valueToColor(vvals[0]);
+          face_colors[1] = map->valueToColor(vvals[1]);
+        }
+        else if (fld->is_tensor())
+        {
+          fld->get_value(tvals[0], cells[0]);
+
+          if (cells.size() > 1)
+          {
+            fld->get_value(tvals[1], cells[1]);
+          }
+          else
+          {
+            tvals[1] = tvals[0];
+          }
+
+          face_colors[0] = map->valueToColor(tvals[0]);
+          face_colors[1] = map->valueToColor(tvals[1]);
+        }
+
+        addFaceGeom(points, normals, withNormals, iboIndex, &chunk.ibo, &chunk.vbo,
+          colorScheme, face_colors, state);
+        recordColorSources();
+      }
+      // Element data (faces)
+      else if (fld->basis_order() == 0 && mesh->dimensionality() == 2)
+      {
+        auto map = colorMap.get();
+        //one possible color, each node that color.
+        svals.resize(1);
+        vvals.resize(1);
+        tvals.resize(1);
+        face_colors.resize(nodes.size());
+        if (fld->is_scalar())
+        {
+          if (scalarValues)
+            svals[0] = scalarValues[face];
+          else
+            fld->get_value(svals[0], face);
+          face_colors[0] = map->valueToColor(svals[0]);
+        }
+        else if (fld->is_vector())
+        {
+          fld->get_value(vvals[0], face);
+          face_colors[0] = map->valueToColor(vvals[0]);
+        }
+        else if (fld->is_tensor())
+        {
+          fld->get_value(tvals[0], face);
+          face_colors[0] = map->valueToColor(tvals[0]);
+        }
+
+        // Same color at all corners.
+        for (size_t i = 0; i<nodes.size(); ++i)
+        {
+          face_colors[i] = face_colors[0];
+        }
+        faceSources.assign(nodes.size(), face);
+
+        addFaceGeom(points, normals, withNormals, iboIndex, &chunk.ibo, &chunk.vbo,
+          colorScheme, face_colors,  state);
+        recordColorSources();
+      }
+
+      // Data at nodes
+      else if (fld->basis_order() == 1)
+      {
+        auto map = colorMap.get();
+        svals.resize(nodes.size());
+        vvals.resize(nodes.size());
+        tvals.resize(nodes.size());
+        face_colors.resize(nodes.size());
+        //node.size() possible colors.
+        if (fld->is_scalar())
+        {
+          for (size_t i = 0; i<nodes.size(); i++)
+          {
+            if (scalarValues)
+              svals[i] = scalarValues[nodes[i]];
+            else
+              fld->get_value(svals[i], nodes[i]);
+            face_colors[i] = map->valueToColor(svals[i]);
+          }
+        }
+        else if (fld->is_vector())
+        {
+          for (size_t i = 0; i<nodes.size(); i++)
+          {
+            fld->get_value(vvals[i], nodes[i]);
+            face_colors[i] = map->valueToColor(vvals[i]);
+          }
+        }
+        else if (fld->is_tensor())
+        {
+          for (size_t i = 0; i<nodes.size(); i++)
+          {
+            fld->get_value(tvals[i], nodes[i]);
+            face_colors[i] = map->valueToColor(tvals[i]);
+          }
+        }
+        faceSources.assign(nodes.begin(), nodes.end());
+
+        addFaceGeom(points, normals, withNormals, iboIndex, &chunk.ibo, &chunk.vbo,
+          colorScheme, face_colors, state);
+        recordColorSources();
+      }
+
+    }
+
+    chunk.numVertices = iboIndex;
+  };
+  Parallel::RunTasks(task_i, np);
+
+  size_t iboBytes = 0;
+  size_t vboBytes = 0;
+  for (const auto& chunk : chunks)
+  {
+    iboBytes += chunk->ibo.getBufferSize();
+    vboBytes += chunk->vbo.getBufferSize();
+  }
+
+  iboBufferSPtr.reset(new spire::VarBuffer(bufferSize(iboBytes)));
+  vboBufferSPtr.reset(new spire::VarBuffer(bufferSize(vboBytes)));
+
+  // Each chunk indexes its own vertices from zero; shift them past the chunks before it.
+  uint32_t firstVertex = 0;
+  for (auto& chunk : chunks)
+  {
+    auto chunkIndices = reinterpret_cast<uint32_t*>(chunk->ibo.getBuffer());
+    const size_t numIndices = chunk->ibo.getBufferSize() / sizeof(uint32_t);
+    for (size_t i = 0; i < numIndices; ++i)
+      chunkIndices[i] += firstVertex;
+
+    iboBufferSPtr->writeBytes(chunk->ibo.getBuffer(), chunk->ibo.getBufferSize());
+    vboBufferSPtr->writeBytes(chunk->vbo.getBuffer(), chunk->vbo.getBufferSize());
+    firstVertex += chunk->numVertices;
+  }
+
+  for (const auto& chunk : chunks)
+  {
+    if (!chunk->recolorable)
+      return false;
+  }
+  for (const auto& chunk : chunks)
+  {
+    faceBuffers_.colorSources.insert(faceBuffers_.colorSources.end(),
+      chunk->colorSources.begin(), chunk->colorSources.end());
+  }
+  return true;
+}
+
+void GeometryBuilder::recolorFaceBuffers(
+  FieldHandle field,
+  boost::optional<boost::shared_ptr<ColorMap>> colorMap,
+  Interruptible* interruptible,
+  std::shared_ptr<spire::VarBuffer>& iboBufferSPtr,
+  std::shared_ptr<spire::VarBuffer>& vboBufferSPtr)
+{
+  // Buffers already handed to a geometry object are never written again, so anything without
+  // colors is shared as is.
+  iboBufferSPtr = faceBuffers_.ibo;
+  if (faceBuffers_.colorsPerVertex == 0)
+  {
+    vboBufferSPtr = faceBuffers_.vbo;
+    return;
+  }
+
+  auto& cached = *faceBuffers_.vbo;
+  vboBufferSPtr.reset(new spire::VarBuffer(bufferSize(cached.getBufferSize())));
+  vboBufferSPtr->writeBytes(cached.getBuffer(), cached.getBufferSize());
+
+  VField* fld = field->vfield();
+  auto map = colorMap.get();
+  auto vertices = reinterpret_cast<float*>(vboBufferSPtr->getBuffer());
+  const auto& sources = faceBuffers_.colorSources;
+  const size_t colorsPerVertex = faceBuffers_.colorsPerVertex;
+  const size_t stride = faceBuffers_.vertexStride;
+  const size_t numVertices = sources.size() / colorsPerVertex;
+
+  const int np = faceTaskCount(numVertices);
+  auto task_i = [&](int proc)
+  {
+    ColorRGB color;
+    Vector vval;
+    Tensor tval;
+
+    const VMesh::index_type begin = rangeBegin(numVertices, proc, np);
+    const VMesh::index_type end = rangeBegin(numVertices, proc + 1, np);
+    if (fld->is_scalar())
+    {
+      // Slot k of every vertex is one strided run of the vertex buffer.
+      for (VMesh::index_type chunk = begin; chunk < end; chunk += minFacesPerTask)
+      {
+        interruptible->checkForInterruption();
+        const size_t count = std::min<size_t>(minFacesPerTask, end - chunk);
+        for (size_t slot = 0; slot < colorsPerVertex; ++slot)
+        {
+          mapScalarColors(fld, *map, &sources[chunk * colorsPerVertex + slot], colorsPerVertex, count,
+            vertices + chunk * stride + faceBuffers_.colorOffset + 4 * slot, stride);
+        }
+      }
+      return;
+    }
+
+    for (VMesh::index_type i = begin * colorsPerVertex; i < end * colorsPerVertex; ++i)
+    {
+      if (i % minFacesPerTask == 0)
+        interruptible->checkForInterruption();
+
+      const VMesh::index_type value = sources[i];
+      if (fld->is_vector())
+      {
+        fld->get_value(vval, value);
+        color = map->valueToColor(vval);
+      }
+      else
+      {
+        fld->get_value(tval, value);
+        color = map->valueToColor(tval);
+      }
+
+      const size_t vertex = i / colorsPerVertex;
+      const size_t slot = i % colorsPerVertex;
+      float* rgba = vertices + vertex * stride + faceBuffers_.colorOffset + 4 * slot;
+      rgba[0] = static_cast<float>(color.r());
+      rgba[1] = static_cast<float>(color.g());
+      rgba[2] = static_cast<float>(color.b());
+      rgba[3] = 1.f;
+    }
+  };
+  Parallel::RunTasks(task_i, np);
+}
+
+std::shared_ptr<spire::VarBuffer> GeometryBuilder::faceLevelWithin(
+  const std::string& mesh,
+  size_t triangleBudget,
+  size_t vertexStride,
+  Interruptible* interruptible,
+  spire::VarBuffer& iboBuffer,
+  spire::VarBuffer& vboBuffer)
+{
+  // Shared vertices are numbered the same for every build of a mesh, whatever the attributes.
+  if (mesh != faceLevels_.mesh)
+  {
+    faceLevels_ = FaceLevelCache();
+
+    const size_t numTriangles = iboBuffer.getBufferSize() / (3 * sizeof(uint32_t));
+    const size_t numVertices = vboBuffer.getBufferSize() / (vertexStride * sizeof(float));
+    SurfaceDecimation decimation(reinterpret_cast<const float*>(vboBuffer.getBuffer()), vertexStride, numVertices,
+      reinterpret_cast<const uint32_t*>(iboBuffer.getBuffer()), numTriangles);
+
+    for (const auto& level : decimation.buildLevels(minLevelTriangles, interruptible))
+    {
+      std::shared_ptr<spire::VarBuffer> ibo(new spire::VarBuffer(bufferSize(level.size() * sizeof(uint32_t))));
+      if (!level.empty())
+        ibo->writeBytes(reinterpret_cast<const char*>(&level[0]), level.size() * sizeof(uint32_t));
+      faceLevels_.ibos.push_back(ibo);
+    }
+    faceLevels_.mesh = mesh;
+  }
+
+  for (const auto& ibo : faceLevels_.ibos)
+  {
+    if (ibo->getBufferSize() / (3 * sizeof(uint32_t)) <= triangleBudget)
+      return ibo;
+  }
+  // The coarsest level stands in when none fits.
+  return faceLevels_.ibos.empty() ? nullptr : faceLevels_.ibos.back();
+}
+
 // This function needs to be reorganized.
 // The fact that we are only rendering triangles helps us dramatically and
 // we get rid of the quads renderer pointers. Additionally, we can re-order
@@ -1497,3 +2144,5 @@ const AlgorithmParameterName ShowField::TextSize("TextSize");
 const AlgorithmParameterName ShowField::TextPrecision("TextPrecision");
 const AlgorithmParameterName ShowField::TextColoring("TextColoring");
 const AlgorithmParameterName ShowField::UseFaceNormals("UseFaceNormals");
+const AlgorithmParameterName ShowField::ShowInteriorFaces("ShowInteriorFaces");
+const AlgorithmParameterName ShowField::FaceTriangleBudget("FaceTriangleBudget");
@@ -104,6 +104,8 @@ namespace SCIRun {
         static const Core::Algorithms::AlgorithmParameterName TextPrecision;
         static const Core::Algorithms::AlgorithmParameterName TextColoring;
         static const Core::Algorithms::AlgorithmParameterName UseFaceNormals;
+        static const Core::Algorithms::AlgorithmParameterName ShowInteriorFaces;
+        static const Core::Algorithms::AlgorithmParameterName FaceTriangleBudget;
 
 
         INPUT_PORT(0, Field, Field);
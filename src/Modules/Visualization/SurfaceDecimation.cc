@@ -0,0 +1,384 @@
+/*
+For more information, please see: http://software.sci.utah.edu
+
+The MIT License
+
+Copyright (c) 2016 Scientific Computing and Imaging Institute,
+University of Utah.
+
+License for the specific language governing rights and limitations under
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Modules/Visualization/SurfaceDecimation.h>
+#include <Core/GeometryPrimitives/PointVectorOperators.h>
+#include <algorithm>
+#include <limits>
+
+using namespace SCIRun;
+using namespace Modules::Visualization;
+using namespace Core::Geometry;
+
+namespace
+{
+  /// Weight of the planes that hold open boundaries in place, relative to the surface planes.
+  const double boundaryWeight = 1000.0;
+
+  /// Squared cosine of the largest turn of a triangle normal in one collapse, about 60 degrees.
+  const double maxNormalTurn = 0.25;
+
+  /// Collapses between checks for interruption.
+  const size_t collapsesPerCheck = 4096;
+
+  bool hasVertex(const uint32_t* triangle, uint32_t v)
+  {
+    return triangle[0] == v || triangle[1] == v || triangle[2] == v;
+  }
+}
+
+SurfaceDecimation::Quadric::Quadric()
+{
+  std::fill(q, q + 10, 0.0);
+}
+
+void SurfaceDecimation::Quadric::addPlane(const Vector& n, double d, double weight)
+{
+  q[0] += weight * n.x() * n.x(); q[1] += weight * n.x() * n.y(); q[2] += weight * n.x() * n.z(); q[3] += weight * n.x() * d;
+  q[4] += weight * n.y() * n.y(); q[5] += weight * n.y() * n.z(); q[6] += weight * n.y() * d;
+  q[7] += weight * n.z() * n.z(); q[8] += weight * n.z() * d;
+  q[9] += weight * d * d;
+}
+
+void SurfaceDecimation::Quadric::add(const Quadric& other)
+{
+  for (int i = 0; i < 10; ++i)
+    q[i] += other.q[i];
+}
+
+double SurfaceDecimation::Quadric::error(const Vector& p) const
+{
+  const double x = p.x(), y = p.y(), z = p.z();
+  return q[0] * x * x + 2 * q[1] * x * y + 2 * q[2] * x * z + 2 * q[3] * x
+    + q[4] * y * y + 2 * q[5] * y * z + 2 * q[6] * y
+    + q[7] * z * z + 2 * q[8] * z
+    + q[9];
+}
+
+SurfaceDecimation::SurfaceDecimation(const float* positions, size_t stride, size_t numVertices,
+  const uint32_t* triangles, size_t numTriangles)
+  : points_(numVertices),
+  triangles_(triangles, triangles + 3 * numTriangles),
+  triangleAlive_(numTriangles, 0),
+  numAlive_(0),
+  vertexTriangles_(numVertices),
+  quadrics_(numVertices),
+  lastPass_(numVertices, 0),
+  marks_(numVertices, 0),
+  mark_(0),
+  boundary_(numVertices, 0)
+{
+  for (size_t v = 0; v < numVertices; ++v)
+  {
+    const float* p = positions + v * stride;
+    points_[v] = Vector(p[0], p[1], p[2]);
+  }
+
+  for (size_t t = 0; t < numTriangles; ++t)
+  {
+    const uint32_t* tri = &triangles_[3 * t];
+    if (tri[0] == tri[1] || tri[1] == tri[2] || tri[2] == tri[0])
+      continue;
+
+    triangleAlive_[t] = 1;
+    ++numAlive_;
+    for (int i = 0; i < 3; ++i)
+      vertexTriangles_[tri[i]].push_back(static_cast<uint32_t>(t));
+
+    // Area weighted, so slivers do not pull as hard as large faces.
+    Vector normal = Cross(points_[tri[1]] - points_[tri[0]], points_[tri[2]] - points_[tri[0]]);
+    const double doubleArea = normal.normalize();
+    if (doubleArea > 0)
+    {
+      const double d = -Dot(normal, points_[tri[0]]);
+      for (int i = 0; i < 3; ++i)
+        quadrics_[tri[i]].addPlane(normal, d, 0.5 * doubleArea);
+    }
+  }
+
+  findBoundaries();
+}
+
+void SurfaceDecimation::findBoundaries()
+{
+  // Edges are visited once from their lower vertex. An edge of one triangle is an open
+  // boundary; an edge of more than two is non-manifold and is never collapsed.
+  std::vector<uint32_t> others;
+  for (uint32_t a = 0; a < vertexTriangles_.size(); ++a)
+  {
+    others.clear();
+    for (auto t : vertexTriangles_[a])
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        if (triangles_[3 * t + i] > a)
+          others.push_back(triangles_[3 * t + i]);
+      }
+    }
+    std::sort(others.begin(), others.end());
+
+    for (size_t begin = 0; begin < others.size();)
+    {
+      const uint32_t b = others[begin];
+      size_t end = begin;
+      while (end < others.size() && others[end] == b)
+        ++end;
+
+      if (end - begin != 2)
+      {
+        boundary_[a] = boundary_[b] = 1;
+      }
+      if (end - begin == 1)
+      {
+        // A plane through the edge, perpendicular to its triangle.
+        for (auto t : vertexTriangles_[a])
+        {
+          const uint32_t* tri = &triangles_[3 * t];
+          if (!hasVertex(tri, b))
+            continue;
+          Vector faceNormal = Cross(points_[tri[1]] - points_[tri[0]], points_[tri[2]] - points_[tri[0]]);
+          const Vector edge = points_[b] - points_[a];
+          Vector normal = Cross(edge, faceNormal);
+          if (faceNormal.length2() > 0 && normal.normalize() > 0)
+          {
+            const double d = -Dot(normal, points_[a]);
+            quadrics_[a].addPlane(normal, d, boundaryWeight * edge.length2());
+            quadrics_[b].addPlane(normal, d, boundaryWeight * edge.length2());
+          }
+        }
+      }
+      begin = end;
+    }
+  }
+}
+
+void SurfaceDecimation::collectCollapses()
+{
+  // Every edge once, from the triangle that walks it upwards; edges between boundary vertices
+  // may come twice, since boundary edges have only one triangle to walk them.
+  collapses_.clear();
+  for (size_t t = 0; t < triangleAlive_.size(); ++t)
+  {
+    if (!triangleAlive_[t])
+      continue;
+    for (int i = 0; i < 3; ++i)
+    {
+      const uint32_t a = triangles_[3 * t + i];
+      const uint32_t b = triangles_[3 * t + (i + 1) % 3];
+      if (a > b && !(boundary_[a] && boundary_[b]))
+        continue;
+
+      // Boundary vertices only move along the boundary.
+      const bool aToB = !boundary_[a] || boundary_[b];
+      const bool bToA = !boundary_[b] || boundary_[a];
+
+      Quadric q = quadrics_[a];
+      q.add(quadrics_[b]);
+
+      Collapse c;
+      c.from = a;
+      c.to = b;
+      c.cost = aToB ? q.error(points_[b]) : std::numeric_limits<double>::max();
+      if (bToA)
+      {
+        const double cost = q.error(points_[a]);
+        if (cost < c.cost)
+        {
+          c.cost = cost;
+          std::swap(c.from, c.to);
+        }
+      }
+      collapses_.push_back(c);
+    }
+  }
+}
+
+bool SurfaceDecimation::canCollapse(uint32_t from, uint32_t to)
+{
+  size_t shared = 0;
+  for (auto t : vertexTriangles_[from])
+  {
+    if (!triangleAlive_[t])
+      continue;
+    const uint32_t* tri = &triangles_[3 * t];
+    if (hasVertex(tri, to))
+    {
+      ++shared;
+      continue;
+    }
+
+    // Moving from onto to must not flip the remaining triangles, or turn them far enough that
+    // a few more collapses could.
+    Vector p[3], q[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      p[i] = points_[tri[i]];
+      q[i] = tri[i] == from ? points_[to] : p[i];
+    }
+    const Vector before = Cross(p[1] - p[0], p[2] - p[0]);
+    const Vector after = Cross(q[1] - q[0], q[2] - q[0]);
+    const double cosine = Dot(before, after);
+    if (cosine <= 0 || cosine * cosine < maxNormalTurn * before.length2() * after.length2())
+      return false;
+  }
+
+  if (shared == 1 && !(boundary_[from] && boundary_[to]))
+    return false;
+  if (shared == 2 && boundary_[from])
+    return false;
+  if (shared == 0 || shared > 2)
+    return false;
+
+  // Link condition: the only vertices next to both ends are the tips of the shared triangles,
+  // otherwise the collapse pinches the surface. Neighbors of to get this call's mark, and
+  // each is counted once when seen again around from.
+  if (mark_ > std::numeric_limits<uint32_t>::max() - 2)
+  {
+    std::fill(marks_.begin(), marks_.end(), 0);
+    mark_ = 0;
+  }
+  mark_ += 2;
+  const uint32_t seen = mark_, counted = mark_ + 1;
+  for (auto t : vertexTriangles_[to])
+  {
+    if (!triangleAlive_[t])
+      continue;
+    for (int i = 0; i < 3; ++i)
+      marks_[triangles_[3 * t + i]] = seen;
+  }
+  size_t common = 0;
+  for (auto t : vertexTriangles_[from])
+  {
+    if (!triangleAlive_[t])
+      continue;
+    for (int i = 0; i < 3; ++i)
+    {
+      const uint32_t w = triangles_[3 * t + i];
+      if (w != from && w != to && marks_[w] == seen)
+      {
+        marks_[w] = counted;
+        ++common;
+      }
+    }
+  }
+  return common == shared;
+}
+
+void SurfaceDecimation::collapse(uint32_t from, uint32_t to)
+{
+  auto& toTriangles = vertexTriangles_[to];
+  for (auto t : vertexTriangles_[from])
+  {
+    if (!triangleAlive_[t])
+      continue;
+    uint32_t* tri = &triangles_[3 * t];
+    if (hasVertex(tri, to))
+    {
+      triangleAlive_[t] = 0;
+      --numAlive_;
+      continue;
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+      if (tri[i] == from)
+        tri[i] = to;
+    }
+    toTriangles.push_back(t);
+  }
+  std::vector<uint32_t>().swap(vertexTriangles_[from]);
+  toTriangles.erase(std::remove_if(toTriangles.begin(), toTriangles.end(),
+    [this](uint32_t t) { return !triangleAlive_[t]; }), toTriangles.end());
+
+  quadrics_[to].add(quadrics_[from]);
+}
+
+SurfaceDecimation::Triangles SurfaceDecimation::aliveTriangles() const
+{
+  Triangles result;
+  result.reserve(3 * numAlive_);
+  for (size_t t = 0; t < triangleAlive_.size(); ++t)
+  {
+    if (triangleAlive_[t])
+      result.insert(result.end(), &triangles_[3 * t], &triangles_[3 * t] + 3);
+  }
+  return result;
+}
+
+std::vector<SurfaceDecimation::Triangles> SurfaceDecimation::buildLevels(size_t minTriangles,
+  Core::Thread::Interruptible* interruptible)
+{
+  std::vector<Triangles> levels;
+  size_t target = numAlive_ / 2;
+  size_t lastLevel = numAlive_;
+  size_t collapses = 0;
+
+  // Edges are collapsed in passes, cheapest first. A vertex moves at most once per pass, so
+  // the costs sorted at the start of a pass stay exact for the collapses it makes.
+  for (uint32_t pass = 1; target >= minTriangles; ++pass)
+  {
+    collectCollapses();
+
+    // Only the cheapest quarter of the edges is tried, at least twice as many as the collapses
+    // still needed (each removes about two triangles). The expensive ones are left for later
+    // passes, when cheaper edges have opened up.
+    const size_t window = std::min(collapses_.size(), std::max(collapses_.size() / 4, numAlive_ - target));
+    std::nth_element(collapses_.begin(), collapses_.begin() + window, collapses_.end());
+    std::sort(collapses_.begin(), collapses_.begin() + window);
+
+    const size_t aliveBefore = numAlive_;
+    for (size_t i = 0; i < window && numAlive_ > target; ++i)
+    {
+      const Collapse& c = collapses_[i];
+      if (lastPass_[c.from] == pass || lastPass_[c.to] == pass || !canCollapse(c.from, c.to))
+        continue;
+
+      collapse(c.from, c.to);
+      lastPass_[c.from] = lastPass_[c.to] = pass;
+      if (interruptible && ++collapses % collapsesPerCheck == 0)
+        interruptible->checkForInterruption();
+    }
+
+    if (numAlive_ <= target)
+    {
+      levels.push_back(aliveTriangles());
+      lastLevel = numAlive_;
+      target = numAlive_ / 2;
+    }
+    else if (numAlive_ == aliveBefore)
+    {
+      break;
+    }
+  }
+
+  // Stuck before the next cut; keep what was reached.
+  if (numAlive_ < lastLevel && target >= minTriangles)
+    levels.push_back(aliveTriangles());
+
+  collapses_.clear();
+  return levels;
+}
@@ -0,0 +1,101 @@
+/*
+For more information, please see: http://software.sci.utah.edu
+
+The MIT License
+
+Copyright (c) 2016 Scientific Computing and Imaging Institute,
+University of Utah.
+
+License for the specific language governing rights and limitations under
+Permission is hereby granted, free of charge, to any person obtaining a
+copy of this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MODULES_VISUALIZATION_SURFACE_DECIMATION_H
+#define MODULES_VISUALIZATION_SURFACE_DECIMATION_H
+
+#include <Core/GeometryPrimitives/Vector.h>
+#include <Core/Thread/Interruptible.h>
+#include <cstdint>
+#include <vector>
+#include <Modules/Visualization/share.h>
+
+namespace SCIRun {
+  namespace Modules {
+    namespace Visualization {
+
+      /// Simplifies an indexed triangle surface into a chain of levels of detail by quadric
+      /// error metric edge collapses (Garland and Heckbert, 1997). Each edge is collapsed onto
+      /// one of its end vertices, so every level indexes the vertices of the full-resolution
+      /// surface and can be drawn from its vertex buffer. Open boundaries are kept in place.
+      class SCISHARE SurfaceDecimation
+      {
+      public:
+        typedef std::vector<uint32_t> Triangles;
+
+        /// positions[i * stride] holds x, y and z of vertex i.
+        SurfaceDecimation(const float* positions, size_t stride, size_t numVertices,
+          const uint32_t* triangles, size_t numTriangles);
+
+        /// Collapses edges, cutting a level each time the triangle count halves, until the next
+        /// level would have fewer than minTriangles triangles or nothing can be collapsed.
+        /// Levels are ordered finest first. Call once; the collapses are not undone.
+        std::vector<Triangles> buildLevels(size_t minTriangles, Core::Thread::Interruptible* interruptible = nullptr);
+
+      private:
+        /// Symmetric 4x4 matrix summing the squared distances to a set of planes.
+        struct Quadric
+        {
+          double q[10];
+          Quadric();
+          void addPlane(const Core::Geometry::Vector& normal, double d, double weight);
+          void add(const Quadric& other);
+          double error(const Core::Geometry::Vector& p) const;
+        };
+
+        struct Collapse
+        {
+          double cost;
+          uint32_t from, to;
+          bool operator<(const Collapse& other) const { return cost < other.cost; }
+        };
+
+        void findBoundaries();
+        void collectCollapses();
+        bool canCollapse(uint32_t from, uint32_t to);
+        void collapse(uint32_t from, uint32_t to);
+        Triangles aliveTriangles() const;
+
+        std::vector<Core::Geometry::Vector> points_;
+        Triangles triangles_;
+        std::vector<char> triangleAlive_;
+        size_t numAlive_;
+        std::vector<std::vector<uint32_t>> vertexTriangles_;
+        std::vector<Quadric> quadrics_;
+        std::vector<uint32_t> lastPass_;
+        std::vector<char> boundary_;
+        std::vector<Collapse> collapses_;
+        std::vector<uint32_t> marks_;
+        uint32_t mark_;
+      };
+
+    }
+  }
+}
+
+#endif
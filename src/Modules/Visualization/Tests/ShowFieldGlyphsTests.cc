@@ -0,0 +1,173 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   License for the specific language governing rights and limitations under
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Testing/ModuleTestBase/ModuleTestBase.h>
+#include <Modules/Visualization/ShowFieldGlyphs.h>
+#include <Core/Datatypes/Legacy/Field/Field.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Core/Logging/Log.h>
+#include <Graphics/Datatypes/GeometryImpl.h>
+#include <Graphics/Glyphs/GlyphGeom.h>
+#include <chrono>
+
+using namespace SCIRun::Testing;
+using namespace SCIRun::Core::Datatypes;
+using namespace SCIRun::Dataflow::Networks;
+using namespace SCIRun::Modules::Visualization;
+using namespace SCIRun::Core::Logging;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Graphics;
+using namespace SCIRun::Graphics::Datatypes;
+using namespace SCIRun;
+
+namespace
+{
+  FieldHandle CreatePointCloudWithScalars(int size)
+  {
+    FieldInformation fi("PointCloudMesh", LINEARDATA_E, "double");
+    auto field = CreateField(fi);
+    auto mesh = field->vmesh();
+    for (int i = 0; i < size; ++i)
+      mesh->add_point(Point(i % 100, (i / 100) % 100, i / 10000));
+
+    auto vfield = field->vfield();
+    vfield->resize_values();
+    for (VMesh::index_type n = 0; n < vfield->num_values(); ++n)
+      vfield->set_value(0.1 + 0.01 * (n % 30), n);
+    return field;
+  }
+}
+
+class ShowFieldGlyphsTest : public ModuleTest
+{
+protected:
+  virtual void SetUp()
+  {
+    Log::get().setVerbose(false);
+  }
+
+  boost::shared_ptr<GeometryObjectSpire> buildSphereGlyphs(FieldHandle field, int resolution)
+  {
+    auto showGlyphs = makeModule("ShowFieldGlyphs");
+    showGlyphs->setStateDefaults();
+    showGlyphs->get_state()->setValue(ShowFieldGlyphs::ShowScalars, true);
+    showGlyphs->get_state()->setValue(ShowFieldGlyphs::ScalarsDisplayType, 1);
+    showGlyphs->get_state()->setValue(ShowFieldGlyphs::ScalarsResolution, resolution);
+    stubPortNWithThisData(showGlyphs, 0, field);
+    showGlyphs->execute();
+    return boost::dynamic_pointer_cast<GeometryObjectSpire>(getDataOnThisOutputPort(showGlyphs, 0));
+  }
+
+  UseRealModuleStateFactory f;
+};
+
+TEST_F(ShowFieldGlyphsTest, SphereGlyphsAreCopiesOfOneUnitSphere)
+{
+  const int numGlyphs = 50;
+  auto field = CreatePointCloudWithScalars(numGlyphs);
+  auto geom = buildSphereGlyphs(field, 10);
+  ASSERT_TRUE(geom != nullptr);
+  ASSERT_EQ(1, geom->mVBOs.size());
+
+  const size_t stride = 6; // position, normal
+  auto& vbo = *geom->mVBOs.front().data;
+  auto& ibo = *geom->mIBOs.front().data;
+  const size_t numVertices = vbo.getBufferSize() / (stride * sizeof(float));
+  const size_t numIndices = ibo.getBufferSize() / sizeof(uint32_t);
+  ASSERT_EQ(0, numVertices % numGlyphs);
+
+  // Bands of the sphere share their boundary vertices, so most vertices are a corner of
+  // four or more triangles.
+  EXPECT_GT(numIndices, 4 * numVertices);
+
+  const size_t verticesPerGlyph = numVertices / numGlyphs;
+  auto vertices = reinterpret_cast<const float*>(vbo.getBuffer());
+  for (size_t v = 0; v < numVertices; ++v)
+  {
+    const VMesh::Node::index_type node(v / verticesPerGlyph);
+    Point center;
+    field->vmesh()->get_point(center, node);
+    double radius;
+    field->vfield()->get_value(radius, node);
+
+    const float* vertex = vertices + v * stride;
+    Vector offset = Point(vertex[0], vertex[1], vertex[2]) - center;
+    Vector normal(vertex[3], vertex[4], vertex[5]);
+    EXPECT_NEAR(radius, offset.length(), 1e-5);
+    EXPECT_NEAR(0, (offset / radius - normal).length(), 1e-5);
+  }
+}
+
+TEST_F(ShowFieldGlyphsTest, DISABLED_SphereGlyphBuildTiming)
+{
+  auto field = CreatePointCloudWithScalars(200000);
+  for (int resolution : { 5, 10, 20 })
+  {
+    auto start = std::chrono::steady_clock::now();
+    auto geom = buildSphereGlyphs(field, resolution);
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "resolution " << resolution << ": "
+      << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms, "
+      << geom->mVBOs.front().data->getBufferSize() / (1024 * 1024) << " MB of vertices" << std::endl;
+  }
+}
+
+TEST(GlyphGeomTest, SpheresAreCopiesOfTheSharedUnitSphere)
+{
+  GlyphGeom glyphs;
+  const Point center(1, 2, 3), other(-4, 0, 2);
+  glyphs.addSphere(center, 2.0, 10, ColorRGB(1, 0, 0));
+  glyphs.addSphere(other, 0.5, 10, ColorRGB(0, 1, 0));
+
+  int64_t numVBOElements;
+  std::vector<Vector> points, normals;
+  std::vector<ColorRGB> colors;
+  std::vector<uint32_t> indices;
+  glyphs.getBufferInfo(numVBOElements, points, normals, colors, indices);
+  ASSERT_EQ(numVBOElements, points.size());
+  ASSERT_EQ(0, points.size() % 2);
+  ASSERT_EQ(0, indices.size() % 2);
+
+  const size_t verticesPerGlyph = points.size() / 2;
+  for (size_t v = 0; v < verticesPerGlyph; ++v)
+  {
+    // Both glyphs place the same unit direction at the same vertex
+    Vector p = (points[v] - center) / 2.0;
+    Vector q = (points[v + verticesPerGlyph] - other) / 0.5;
+    EXPECT_NEAR(1, p.length(), 1e-12);
+    EXPECT_NEAR(0, (p - q).length(), 1e-12);
+    EXPECT_NEAR(0, (p - normals[v]).length(), 1e-12);
+    EXPECT_EQ(1, colors[v].r());
+    EXPECT_EQ(1, colors[v + verticesPerGlyph].g());
+  }
+  const size_t indicesPerGlyph = indices.size() / 2;
+  for (size_t i = 0; i < indicesPerGlyph; ++i)
+    EXPECT_EQ(indices[i] + verticesPerGlyph, indices[i + indicesPerGlyph]);
+}
@@ -33,6 +33,12 @@
 #include <Core/Utils/Exception.h>
 #include <Core/Logging/Log.h>
 #include <Core/Datatypes/ColorMap.h>
+#include <Core/Datatypes/Legacy/Field/FieldInformation.h>
+#include <Core/Datatypes/Legacy/Field/VMesh.h>
+#include <Core/Datatypes/Legacy/Field/VField.h>
+#include <Graphics/Datatypes/GeometryImpl.h>
+#include <chrono>
+#include <cstring>
 
 using namespace SCIRun::Testing;
 using namespace SCIRun::TestUtils;
@@ -44,6 +50,8 @@ using namespace SCIRun::Modules::Visualization;
 using namespace SCIRun::Core;
 using namespace SCIRun;
 using namespace SCIRun::Core::Logging;
+using namespace SCIRun::Core::Geometry;
+using namespace SCIRun::Graphics::Datatypes;
 using ::testing::Values;
 using ::testing::Combine;
 using ::testing::Range;
@@ -128,3 +136,242 @@ TEST_F(ShowFieldStateGeometryNameSynchronizationTest, GeometryNameSynchronizesWi
   EXPECT_NE(hash1, addInputShouldBeDifferent);
   EXPECT_NE(inputChangeShouldBeDifferent, hash1);
 }
+
+namespace
+{
+  FieldHandle CreateTriSurfGrid(int size)
+  {
+    FieldInformation fi("TriSurfMesh", LINEARDATA_E, "double");
+    auto field = CreateField(fi);
+    auto mesh = field->vmesh();
+
+    for (int j = 0; j <= size; ++j)
+      for (int i = 0; i <= size; ++i)
+        mesh->add_point(Point(i, j, std::sin(0.1 * i) * std::cos(0.1 * j)));
+
+    VMesh::Node::array_type tri(3);
+    for (int j = 0; j < size; ++j)
+    {
+      for (int i = 0; i < size; ++i)
+      {
+        VMesh::index_type corner = j * (size + 1) + i;
+        tri[0] = corner; tri[1] = corner + 1; tri[2] = corner + size + 2;
+        mesh->add_elem(tri);
+        tri[0] = corner; tri[1] = corner + size + 2; tri[2] = corner + size + 1;
+        mesh->add_elem(tri);
+      }
+    }
+
+    auto vfield = field->vfield();
+    vfield->resize_values();
+    for (VMesh::index_type n = 0; n < vfield->num_values(); ++n)
+      vfield->set_value(static_cast<double>(n % 101), n);
+    return field;
+  }
+
+  // Position and color of every triangle corner, in drawing order.
+  std::vector<std::vector<float>> faceCorners(const SpireVBO& vbo, const SpireIBO& ibo)
+  {
+    const size_t stride = 10; // position, normal, color
+    auto vertices = reinterpret_cast<const float*>(vbo.data->getBuffer());
+    auto indices = reinterpret_cast<const uint32_t*>(ibo.data->getBuffer());
+    std::vector<std::vector<float>> corners;
+    for (size_t i = 0; i < ibo.data->getBufferSize() / sizeof(uint32_t); ++i)
+    {
+      auto vertex = vertices + indices[i] * stride;
+      std::vector<float> corner(vertex, vertex + 3);
+      corner.insert(corner.end(), vertex + 6, vertex + 10);
+      corners.push_back(corner);
+    }
+    return corners;
+  }
+}
+
+class ShowFieldFaceGeometryTest : public ModuleTest
+{
+protected:
+  virtual void SetUp()
+  {
+    Log::get().setVerbose(false);
+  }
+
+  GeometryObjectSpire& buildFaces(FieldHandle field, bool useNodeNormals, bool showInteriorFaces = false,
+    ColorMapHandle colorMap = StandardColorMapFactory::create())
+  {
+    auto showField = makeModule("ShowField");
+    showField->setStateDefaults();
+    showField->get_state()->setValue(ShowField::ShowEdges, false);
+    showField->get_state()->setValue(ShowField::UseFaceNormals, useNodeNormals);
+    showField->get_state()->setValue(ShowField::ShowInteriorFaces, showInteriorFaces);
+    stubPortNWithThisData(showField, 0, field);
+    stubPortNWithThisData(showField, 1, colorMap);
+    showField->execute();
+
+    geoms_.push_back(boost::dynamic_pointer_cast<GeometryObjectSpire>(getDataOnThisOutputPort(showField, 0)));
+    return *geoms_.back();
+  }
+
+  UseRealModuleStateFactory f;
+  std::vector<boost::shared_ptr<GeometryObjectSpire>> geoms_;
+};
+
+TEST_F(ShowFieldFaceGeometryTest, SharedVerticesDescribeSameTrianglesAsPerFaceVertices)
+{
+  auto field = CreateTriSurfGrid(40);
+
+  // Flat normals need a vertex per face corner; node normals let faces share vertices.
+  auto& perFace = buildFaces(field, false);
+  auto& shared = buildFaces(field, true);
+
+  ASSERT_EQ(1, perFace.mVBOs.size());
+  ASSERT_EQ(1, shared.mVBOs.size());
+  EXPECT_EQ(perFace.mIBOs.front().data->getBufferSize(), shared.mIBOs.front().data->getBufferSize());
+  EXPECT_LT(shared.mVBOs.front().data->getBufferSize(), perFace.mVBOs.front().data->getBufferSize());
+  EXPECT_EQ(faceCorners(perFace.mVBOs.front(), perFace.mIBOs.front()), faceCorners(shared.mVBOs.front(), shared.mIBOs.front()));
+}
+
+TEST_F(ShowFieldFaceGeometryTest, VolumeMeshDrawsOnlyBoundaryFacesByDefault)
+{
+  const int cells = 6;
+  auto latVol = CreateEmptyLatVol(cells + 1, cells + 1, cells + 1);
+  const size_t indicesPerQuad = 6;
+
+  auto& boundary = buildFaces(latVol, false);
+  EXPECT_EQ(6 * cells * cells * indicesPerQuad, boundary.mIBOs.front().data->getBufferSize() / sizeof(uint32_t));
+
+  auto& all = buildFaces(latVol, false, true);
+  EXPECT_EQ(3 * cells * cells * (cells + 1) * indicesPerQuad, all.mIBOs.front().data->getBufferSize() / sizeof(uint32_t));
+}
+
+TEST_F(ShowFieldFaceGeometryTest, ColorMapChangeOnlyRewritesColors)
+{
+  auto field = CreateTriSurfGrid(40);
+  auto rescaled = StandardColorMapFactory::create("Grayscale", 256, 0.0, false, 0.01, 0.0);
+
+  for (bool useNodeNormals : { false, true })
+  {
+    auto showField = makeModule("ShowField");
+    showField->setStateDefaults();
+    showField->get_state()->setValue(ShowField::ShowEdges, false);
+    showField->get_state()->setValue(ShowField::UseFaceNormals, useNodeNormals);
+    stubPortNWithThisData(showField, 0, field);
+    stubPortNWithThisData(showField, 1, StandardColorMapFactory::create());
+    showField->execute();
+    auto before = boost::dynamic_pointer_cast<GeometryObjectSpire>(getDataOnThisOutputPort(showField, 0));
+
+    stubPortNWithThisData(showField, 1, rescaled);
+    showField->execute();
+    auto after = boost::dynamic_pointer_cast<GeometryObjectSpire>(getDataOnThisOutputPort(showField, 0));
+
+    ASSERT_TRUE(before && after);
+    ASSERT_NE(before, after);
+    EXPECT_EQ(before->mIBOs.front().data, after->mIBOs.front().data);
+    EXPECT_NE(before->mVBOs.front().data, after->mVBOs.front().data);
+
+    auto& fresh = buildFaces(field, useNodeNormals, false, rescaled);
+    EXPECT_EQ(faceCorners(fresh.mVBOs.front(), fresh.mIBOs.front()), faceCorners(after->mVBOs.front(), after->mIBOs.front()));
+    EXPECT_NE(faceCorners(before->mVBOs.front(), before->mIBOs.front()), faceCorners(after->mVBOs.front(), after->mIBOs.front()));
+  }
+}
+
+TEST_F(ShowFieldFaceGeometryTest, TriangleBudgetSelectsSimplifiedLevel)
+{
+  auto field = CreateTriSurfGrid(100);
+  const size_t numTriangles = 2 * 100 * 100;
+  auto& full = buildFaces(field, true);
+
+  auto showField = makeModule("ShowField");
+  showField->setStateDefaults();
+  showField->get_state()->setValue(ShowField::ShowEdges, false);
+  showField->get_state()->setValue(ShowField::UseFaceNormals, true);
+  stubPortNWithThisData(showField, 0, field);
+  stubPortNWithThisData(showField, 1, StandardColorMapFactory::create());
+
+  size_t previous = numTriangles;
+  for (int budget : { 15000, 6000, 2500, 1 })
+  {
+    showField->get_state()->setValue(ShowField::FaceTriangleBudget, budget);
+    showField->execute();
+    auto geom = boost::dynamic_pointer_cast<GeometryObjectSpire>(getDataOnThisOutputPort(showField, 0));
+    ASSERT_TRUE(geom != nullptr);
+
+    // Same vertices as the full-resolution build, fewer triangles between them.
+    auto& vbo = *geom->mVBOs.front().data;
+    auto& fullVbo = *full.mVBOs.front().data;
+    ASSERT_EQ(fullVbo.getBufferSize(), vbo.getBufferSize());
+    EXPECT_EQ(0, memcmp(fullVbo.getBuffer(), vbo.getBuffer(), vbo.getBufferSize()));
+
+    auto& ibo = *geom->mIBOs.front().data;
+    const size_t triangles = ibo.getBufferSize() / (3 * sizeof(uint32_t));
+    if (budget > 1)
+      EXPECT_LE(triangles, static_cast<size_t>(budget));
+    EXPECT_GT(triangles, 0u);
+    EXPECT_LE(triangles, previous);
+    previous = triangles;
+
+    auto indices = reinterpret_cast<const uint32_t*>(ibo.getBuffer());
+    const size_t numVertices = vbo.getBufferSize() / (10 * sizeof(float));
+    for (size_t i = 0; i < 3 * triangles; ++i)
+      ASSERT_LT(indices[i], numVertices);
+  }
+
+  showField->get_state()->setValue(ShowField::FaceTriangleBudget, 0);
+  showField->execute();
+  auto geom = boost::dynamic_pointer_cast<GeometryObjectSpire>(getDataOnThisOutputPort(showField, 0));
+  EXPECT_EQ(faceCorners(full.mVBOs.front(), full.mIBOs.front()), faceCorners(geom->mVBOs.front(), geom->mIBOs.front()));
+}
+
+TEST_F(ShowFieldFaceGeometryTest, DISABLED_FaceGeometryBuildTiming)
+{
+  auto field = CreateTriSurfGrid(1000);
+  field->vmesh()->synchronize(Mesh::FACES_E | Mesh::NORMALS_E);
+
+  for (bool useNodeNormals : { false, true })
+  {
+    auto start = std::chrono::steady_clock::now();
+    buildFaces(field, useNodeNormals);
+    auto end = std::chrono::steady_clock::now();
+    std::cout << (useNodeNormals ? "shared vertices: " : "per-face vertices: ")
+      << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms" << std::endl;
+  }
+}
+
+TEST_F(ShowFieldFaceGeometryTest, DISABLED_TriangleBudgetTiming)
+{
+  auto field = CreateTriSurfGrid(1000);
+  auto showField = makeModule("ShowField");
+  showField->setStateDefaults();
+  showField->get_state()->setValue(ShowField::ShowEdges, false);
+  stubPortNWithThisData(showField, 0, field);
+  stubPortNWithThisData(showField, 1, StandardColorMapFactory::create());
+
+  for (int budget : { 0, 500000, 100000, 10000 })
+  {
+    showField->get_state()->setValue(ShowField::FaceTriangleBudget, budget);
+    auto start = std::chrono::steady_clock::now();
+    showField->execute();
+    auto end = std::chrono::steady_clock::now();
+    auto geom = boost::dynamic_pointer_cast<GeometryObjectSpire>(getDataOnThisOutputPort(showField, 0));
+    std::cout << "budget " << budget << ": " << geom->mIBOs.front().data->getBufferSize() / (3 * sizeof(uint32_t))
+      << " triangles, " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms" << std::endl;
+  }
+}
+
+TEST_F(ShowFieldFaceGeometryTest, DISABLED_ColorMapChangeTiming)
+{
+  auto field = CreateTriSurfGrid(1000);
+  auto showField = makeModule("ShowField");
+  showField->setStateDefaults();
+  showField->get_state()->setValue(ShowField::ShowEdges, false);
+  stubPortNWithThisData(showField, 0, field);
+
+  for (const auto& name : { "Rainbow", "Grayscale", "Blackbody" })
+  {
+    stubPortNWithThisData(showField, 1, StandardColorMapFactory::create(name));
+    auto start = std::chrono::steady_clock::now();
+    showField->execute();
+    auto end = std::chrono::steady_clock::now();
+    std::cout << name << ": "
+      << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms" << std::endl;
+  }
+}
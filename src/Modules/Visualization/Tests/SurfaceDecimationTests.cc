@@ -0,0 +1,226 @@
+/*
+   For more information, please see: http://software.sci.utah.edu
+
+   The MIT License
+
+   Copyright (c) 2015 Scientific Computing and Imaging Institute,
+   University of Utah.
+
+   License for the specific language governing rights and limitations under
+   Permission is hereby granted, free of charge, to any person obtaining a
+   copy of this software and associated documentation files (the "Software"),
+   to deal in the Software without restriction, including without limitation
+   the rights to use, copy, modify, merge, publish, distribute, sublicense,
+   and/or sell copies of the Software, and to permit persons to whom the
+   Software is furnished to do so, subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be included
+   in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+   THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+   DEALINGS IN THE SOFTWARE.
+*/
+
+#include <gtest/gtest.h>
+#include <Core/Math/MiscMath.h>
+#include <Modules/Visualization/SurfaceDecimation.h>
+#include <Core/GeometryPrimitives/PointVectorOperators.h>
+#include <chrono>
+#include <set>
+
+using namespace SCIRun::Modules::Visualization;
+using namespace SCIRun::Core::Geometry;
+
+namespace
+{
+  struct Surface
+  {
+    std::vector<float> positions;
+    std::vector<uint32_t> triangles;
+  };
+
+  // Unit square in the z = 0 plane, split into 2 * n * n triangles.
+  Surface flatSquare(uint32_t n)
+  {
+    Surface s;
+    for (uint32_t j = 0; j <= n; ++j)
+    {
+      for (uint32_t i = 0; i <= n; ++i)
+      {
+        s.positions.push_back(static_cast<float>(i) / n);
+        s.positions.push_back(static_cast<float>(j) / n);
+        s.positions.push_back(0.f);
+      }
+    }
+    for (uint32_t j = 0; j < n; ++j)
+    {
+      for (uint32_t i = 0; i < n; ++i)
+      {
+        const uint32_t v = j * (n + 1) + i;
+        const uint32_t quad[] = { v, v + 1, v + n + 2, v + n + 2, v + n + 1, v };
+        s.triangles.insert(s.triangles.end(), quad, quad + 6);
+      }
+    }
+    return s;
+  }
+
+  // Closed unit sphere from a latitude/longitude grid with a vertex at each pole.
+  Surface sphere(uint32_t rings, uint32_t segments)
+  {
+    Surface s;
+    s.positions = { 0.f, 0.f, 1.f };
+    for (uint32_t r = 1; r < rings; ++r)
+    {
+      const double theta = M_PI * r / rings;
+      for (uint32_t k = 0; k < segments; ++k)
+      {
+        const double phi = 2 * M_PI * k / segments;
+        s.positions.push_back(static_cast<float>(std::sin(theta) * std::cos(phi)));
+        s.positions.push_back(static_cast<float>(std::sin(theta) * std::sin(phi)));
+        s.positions.push_back(static_cast<float>(std::cos(theta)));
+      }
+    }
+    s.positions.insert(s.positions.end(), { 0.f, 0.f, -1.f });
+
+    const uint32_t south = (rings - 1) * segments + 1;
+    auto ring = [segments](uint32_t r, uint32_t k) { return 1 + (r - 1) * segments + k % segments; };
+    for (uint32_t k = 0; k < segments; ++k)
+    {
+      s.triangles.insert(s.triangles.end(), { 0, ring(1, k), ring(1, k + 1) });
+      for (uint32_t r = 1; r + 1 < rings; ++r)
+      {
+        s.triangles.insert(s.triangles.end(), { ring(r, k), ring(r + 1, k), ring(r + 1, k + 1) });
+        s.triangles.insert(s.triangles.end(), { ring(r, k), ring(r + 1, k + 1), ring(r, k + 1) });
+      }
+      s.triangles.insert(s.triangles.end(), { ring(rings - 1, k), south, ring(rings - 1, k + 1) });
+    }
+    return s;
+  }
+
+  Vector point(const Surface& s, uint32_t v)
+  {
+    return Vector(s.positions[3 * v], s.positions[3 * v + 1], s.positions[3 * v + 2]);
+  }
+
+  // Twice the signed area of triangle t along z.
+  double signedArea(const Surface& s, const std::vector<uint32_t>& triangles, size_t t)
+  {
+    const Vector p0 = point(s, triangles[3 * t]);
+    return Cross(point(s, triangles[3 * t + 1]) - p0, point(s, triangles[3 * t + 2]) - p0).z();
+  }
+
+  // V - E + F of the vertices referenced by the triangles.
+  int eulerCharacteristic(const std::vector<uint32_t>& triangles)
+  {
+    std::set<uint32_t> vertices(triangles.begin(), triangles.end());
+    std::set<std::pair<uint32_t, uint32_t>> edges;
+    for (size_t t = 0; t < triangles.size(); t += 3)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        uint32_t a = triangles[t + i], b = triangles[t + (i + 1) % 3];
+        edges.insert(std::make_pair(std::min(a, b), std::max(a, b)));
+      }
+    }
+    return static_cast<int>(vertices.size()) - static_cast<int>(edges.size()) + static_cast<int>(triangles.size() / 3);
+  }
+}
+
+TEST(SurfaceDecimationTests, LevelsHalveTheTriangleCount)
+{
+  auto s = sphere(64, 128);
+  const size_t numTriangles = s.triangles.size() / 3;
+  SurfaceDecimation decimation(&s.positions[0], 3, s.positions.size() / 3, &s.triangles[0], numTriangles);
+  auto levels = decimation.buildLevels(500);
+
+  ASSERT_GE(levels.size(), 4u);
+  size_t previous = numTriangles;
+  for (const auto& level : levels)
+  {
+    const size_t count = level.size() / 3;
+    EXPECT_LE(count, previous / 2);
+    EXPECT_GT(count, previous / 4);
+    previous = count;
+  }
+  EXPECT_GE(previous, 500u);
+}
+
+TEST(SurfaceDecimationTests, ClosedSurfaceStaysClosedAndClose)
+{
+  auto s = sphere(40, 80);
+  SurfaceDecimation decimation(&s.positions[0], 3, s.positions.size() / 3, &s.triangles[0], s.triangles.size() / 3);
+  auto levels = decimation.buildLevels(200);
+  ASSERT_FALSE(levels.empty());
+
+  for (const auto& level : levels)
+  {
+    EXPECT_EQ(2, eulerCharacteristic(level));
+    // Triangle centers stay near the sphere and triangles keep facing out.
+    for (size_t t = 0; t < level.size(); t += 3)
+    {
+      const Vector a = point(s, level[t]), b = point(s, level[t + 1]), c = point(s, level[t + 2]);
+      const Vector center = (a + b + c) * (1.0 / 3);
+      EXPECT_GT(center.length(), 0.8);
+      EXPECT_GT(Dot(Cross(b - a, c - a), center), 0);
+    }
+  }
+}
+
+TEST(SurfaceDecimationTests, OpenBoundaryIsKept)
+{
+  auto s = flatSquare(60);
+  const size_t stride = 3;
+  SurfaceDecimation decimation(&s.positions[0], stride, s.positions.size() / 3, &s.triangles[0], s.triangles.size() / 3);
+  auto levels = decimation.buildLevels(20);
+  ASSERT_GE(levels.size(), 5u);
+
+  for (const auto& level : levels)
+  {
+    double area = 0;
+    for (size_t t = 0; t < level.size() / 3; ++t)
+    {
+      const double a = signedArea(s, level, t);
+      EXPECT_GT(a, 0);
+      area += 0.5 * a;
+    }
+    EXPECT_NEAR(1.0, area, 1e-5);
+
+    // The four corners are still there.
+    std::set<uint32_t> vertices(level.begin(), level.end());
+    EXPECT_EQ(1u, vertices.count(0));
+    EXPECT_EQ(1u, vertices.count(60));
+    EXPECT_EQ(1u, vertices.count(60 * 61));
+    EXPECT_EQ(1u, vertices.count(61 * 61 - 1));
+  }
+}
+
+TEST(SurfaceDecimationTests, SkipsAttributesBetweenPositions)
+{
+  auto s = flatSquare(10);
+  std::vector<float> interleaved;
+  for (size_t v = 0; v < s.positions.size() / 3; ++v)
+  {
+    interleaved.insert(interleaved.end(), &s.positions[3 * v], &s.positions[3 * v] + 3);
+    interleaved.insert(interleaved.end(), { 0.f, 0.f, 1.f, 1.f, 0.5f, 0.25f, 1.f });
+  }
+  SurfaceDecimation fromPositions(&s.positions[0], 3, s.positions.size() / 3, &s.triangles[0], s.triangles.size() / 3);
+  SurfaceDecimation fromVertices(&interleaved[0], 10, s.positions.size() / 3, &s.triangles[0], s.triangles.size() / 3);
+  EXPECT_EQ(fromPositions.buildLevels(10), fromVertices.buildLevels(10));
+}
+
+TEST(SurfaceDecimationTests, DISABLED_DecimationTiming)
+{
+  auto s = sphere(1000, 2000);
+  auto start = std::chrono::steady_clock::now();
+  SurfaceDecimation decimation(&s.positions[0], 3, s.positions.size() / 3, &s.triangles[0], s.triangles.size() / 3);
+  auto levels = decimation.buildLevels(1000);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  std::cout << s.triangles.size() / 3 << " triangles, " << levels.size() << " levels in "
+    << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << " ms" << std::endl;
+}